@@ -71,6 +71,9 @@ struct TrackDeriv {
   }
 };
 
+template <int N, typename... Args>
+class DCAFitterNBatch;
+
 template <int N, typename... Args>
 class DCAFitterN
 {
@@ -224,6 +227,7 @@ class DCAFitterN
   GPUdi() size_t getCallID() const { return mCallID; }
 
  protected:
+  GPUd() bool prepareSeeds();
   GPUd() bool calcPCACoefs();
   GPUd() bool calcInverseWeight();
   GPUd() void calcResidDerivatives();
@@ -238,8 +242,11 @@ class DCAFitterN
   GPUd() double calcChi2() const;
   GPUd() double calcChi2NoErr() const;
   GPUd() bool correctTracks(const VecND& corrX);
+  GPUd() bool initChi2Minimization();
+  GPUd() bool initChi2MinimizationNoErr();
   GPUd() bool minimizeChi2();
   GPUd() bool minimizeChi2NoErr();
+  GPUd() int finalizeCandidates();
   GPUd() bool roughDZCut() const;
   GPUd() bool closerToAlternative() const;
   GPUd() bool propagateToX(o2::track::TrackParCov& t, float x);
@@ -349,6 +356,10 @@ class DCAFitterN
   float mMaxStep = 2.0;                                                                           // Max step for propagation with Propagator
   int mFitterID = 0;                                                                              // locat fitter ID (mostly for debugging)
   size_t mCallID = 0;
+
+  template <int, typename...>
+  friend class DCAFitterNBatch; // batched fit reuses the seeding and finalization of the scalar one
+
   ClassDefNV(DCAFitterN, 2);
 };
 
@@ -361,27 +372,8 @@ GPUd() int DCAFitterN<N, Args...>::process(const Tr&... args)
   mCallID++;
   static_assert(sizeof...(args) == N, "incorrect number of input tracks");
   assign(0, args...);
-  clear();
-  for (int i = 0; i < N; i++) {
-    mTrAux[i].set(*mOrigTrPtr[i], mBz);
-  }
-  if (!mCrossings.set(mTrAux[0], *mOrigTrPtr[0], mTrAux[1], *mOrigTrPtr[1], mMaxDXYIni, mIsCollinear)) { // even for N>2 it should be enough to test just 1 loop
-    return 0;                                                                                            // no crossing
-  }
-  for (int ih = 0; ih < MAXHYP; ih++) {
-    mPropFailed[ih] = false;
-  }
-  if (mUseAbsDCA) {
-    calcRMatrices(); // needed for fast residuals derivatives calculation in case of abs. distance minimization
-  }
-  if (mCrossings.nDCA == MAXHYP) { // if there are 2 candidates and they are too close, chose their mean as a starting point
-    auto dst2 = (mCrossings.xDCA[0] - mCrossings.xDCA[1]) * (mCrossings.xDCA[0] - mCrossings.xDCA[1]) +
-                (mCrossings.yDCA[0] - mCrossings.yDCA[1]) * (mCrossings.yDCA[0] - mCrossings.yDCA[1]);
-    if (dst2 < mMaxDist2ToMergeSeeds) {
-      mCrossings.nDCA = 1;
-      mCrossings.xDCA[0] = 0.5 * (mCrossings.xDCA[0] + mCrossings.xDCA[1]);
-      mCrossings.yDCA[0] = 0.5 * (mCrossings.yDCA[0] + mCrossings.yDCA[1]);
-    }
+  if (!prepareSeeds()) {
+    return 0; // no crossing
   }
   // check all crossings
   for (int ic = 0; ic < mCrossings.nDCA; ic++) {
@@ -405,7 +397,44 @@ GPUd() int DCAFitterN<N, Args...>::process(const Tr&... args)
       mCurHyp++;
     }
   }
+  return finalizeCandidates();
+}
+
+//__________________________________________________________________________
+template <int N, typename... Args>
+GPUd() bool DCAFitterN<N, Args...>::prepareSeeds()
+{
+  // find the crossings of the assigned tracks which will be used as seeds for the PCA candidates
+  clear();
+  for (int i = 0; i < N; i++) {
+    mTrAux[i].set(*mOrigTrPtr[i], mBz);
+  }
+  if (!mCrossings.set(mTrAux[0], *mOrigTrPtr[0], mTrAux[1], *mOrigTrPtr[1], mMaxDXYIni, mIsCollinear)) { // even for N>2 it should be enough to test just 1 loop
+    return false;                                                                                        // no crossing
+  }
+  for (int ih = 0; ih < MAXHYP; ih++) {
+    mPropFailed[ih] = false;
+  }
+  if (mUseAbsDCA) {
+    calcRMatrices(); // needed for fast residuals derivatives calculation in case of abs. distance minimization
+  }
+  if (mCrossings.nDCA == MAXHYP) { // if there are 2 candidates and they are too close, chose their mean as a starting point
+    auto dst2 = (mCrossings.xDCA[0] - mCrossings.xDCA[1]) * (mCrossings.xDCA[0] - mCrossings.xDCA[1]) +
+                (mCrossings.yDCA[0] - mCrossings.yDCA[1]) * (mCrossings.yDCA[0] - mCrossings.yDCA[1]);
+    if (dst2 < mMaxDist2ToMergeSeeds) {
+      mCrossings.nDCA = 1;
+      mCrossings.xDCA[0] = 0.5 * (mCrossings.xDCA[0] + mCrossings.xDCA[1]);
+      mCrossings.yDCA[0] = 0.5 * (mCrossings.yDCA[0] + mCrossings.yDCA[1]);
+    }
+  }
+  return true;
+}
 
+//__________________________________________________________________________
+template <int N, typename... Args>
+GPUd() int DCAFitterN<N, Args...>::finalizeCandidates()
+{
+  // order accepted candidates in quality and recalculate their PCA if requested
   for (int i = mCurHyp; i--;) { // order in quality
     for (int j = i; j--;) {
       if (mChi2[mOrder[i]] < mChi2[mOrder[j]]) {
@@ -872,9 +901,9 @@ GPUdi() double DCAFitterN<N, Args...>::getAbsMax(const VecND& v)
 
 //___________________________________________________________________
 template <int N, typename... Args>
-GPUd() bool DCAFitterN<N, Args...>::minimizeChi2()
+GPUd() bool DCAFitterN<N, Args...>::initChi2Minimization()
 {
-  // find best chi2 (weighted DCA) of N tracks in the vicinity of the seed PCA
+  // propagate tracks to the seed PCA and calculate the starting PCA and residuals for weighted DCA minimization
   for (int i = N; i--;) {
     mCandTr[mCurHyp][i] = *mOrigTrPtr[i];
     auto x = mTrAux[i].c * mPCA[mCurHyp][0] + mTrAux[i].s * mPCA[mCurHyp][1]; // X of PCA in the track frame
@@ -894,6 +923,17 @@ GPUd() bool DCAFitterN<N, Args...>::minimizeChi2()
   }
   calcPCA();            // current PCA
   calcTrackResiduals(); // current track residuals
+  return true;
+}
+
+//___________________________________________________________________
+template <int N, typename... Args>
+GPUd() bool DCAFitterN<N, Args...>::minimizeChi2()
+{
+  // find best chi2 (weighted DCA) of N tracks in the vicinity of the seed PCA
+  if (!initChi2Minimization()) {
+    return false;
+  }
   float chi2Upd, chi2 = calcChi2();
   do {
     calcTrackDerivatives(); // current track derivatives (1st and 2nd)
@@ -929,10 +969,9 @@ GPUd() bool DCAFitterN<N, Args...>::minimizeChi2()
 
 //___________________________________________________________________
 template <int N, typename... Args>
-GPUd() bool DCAFitterN<N, Args...>::minimizeChi2NoErr()
+GPUd() bool DCAFitterN<N, Args...>::initChi2MinimizationNoErr()
 {
-  // find best chi2 (absolute DCA) of N tracks in the vicinity of the PCA seed
-
+  // propagate tracks to the seed PCA and calculate the starting PCA and residuals for absolute DCA minimization
   for (int i = N; i--;) {
     mCandTr[mCurHyp][i] = *mOrigTrPtr[i];
     auto x = mTrAux[i].c * mPCA[mCurHyp][0] + mTrAux[i].s * mPCA[mCurHyp][1]; // X of PCA in the track frame
@@ -947,6 +986,17 @@ GPUd() bool DCAFitterN<N, Args...>::minimizeChi2NoErr()
 
   calcPCANoErr();       // current PCA
   calcTrackResiduals(); // current track residuals
+  return true;
+}
+
+//___________________________________________________________________
+template <int N, typename... Args>
+GPUd() bool DCAFitterN<N, Args...>::minimizeChi2NoErr()
+{
+  // find best chi2 (absolute DCA) of N tracks in the vicinity of the PCA seed
+  if (!initChi2MinimizationNoErr()) {
+    return false;
+  }
   float chi2Upd, chi2 = calcChi2NoErr();
   do {
     calcTrackDerivatives();      // current track derivatives (1st and 2nd)
@@ -0,0 +1,551 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file DCAFitterNBatch.h
+/// \brief Batched N-prongs secondary vertex fit, Newton iterations of many combinations in SIMD lanes
+
+#ifndef _ALICEO2_DCA_FITTERN_BATCH_
+#define _ALICEO2_DCA_FITTERN_BATCH_
+
+#include "DCAFitter/DCAFitterN.h"
+#include <gsl/span>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace o2
+{
+namespace vertexing
+{
+
+///__________________________________________________________________________________
+///< Fit of many track combinations with the DCAFitterN algorithm.
+///< The combinations are made of the i-th track of each of the N input spans (SoA input).
+///< The seeding (crossings, propagation to the seeds) is done per combination with the scalar
+///< fitter, then the Newton minimization of all vertex hypotheses is carried out in SIMD lanes
+///< of NLanes hypotheses, masking the lanes which converged or failed. The derivatives of the
+///< residuals over the track X parameters do not change during the minimization, so the lanes
+///< only need the constant coefficients of the chi2 derivatives.
+///< load(i) brings the wrapped fitter in the state the scalar process() leaves it for the i-th
+///< combination (candidates ordering, propagation to the PCA, weighted final PCA), so all its
+///< getters can be used as usual. Results agree with the scalar fit within rounding.
+///< The settings of the fitter must not be changed between process() and load().
+template <int N, typename... Args>
+class DCAFitterNBatch
+{
+  static_assert(N == 2 || N == 3, "batched fit is implemented for 2 and 3 prongs");
+
+ public:
+  using Fitter = DCAFitterN<N, Args...>;
+  using Track = o2::track::TrackParCov;
+  static constexpr int NLanes = 4; ///< number of vertex hypotheses iterated together
+
+  DCAFitterNBatch() = default;
+  explicit DCAFitterNBatch(const Fitter& fitter) : mFitter(fitter) {}
+
+  ///< fitter providing the settings, after load(i) it holds the candidates of the i-th combination
+  Fitter& getFitter() { return mFitter; }
+  const Fitter& getFitter() const { return mFitter; }
+
+  ///< fit all combinations of the i-th tracks of every span, spans must have the same size. Returns the number of combinations
+  size_t process(const std::array<gsl::span<const Track>, N>& prongs);
+
+  ///< set the fitter to the result of the i-th combination, returns its number of candidates
+  int load(size_t i);
+
+  size_t getNCombinations() const { return mCombinations.size(); }
+
+  void clear();
+
+ private:
+  static constexpr int MAXHYP = Fitter::MAXHYP;
+  using TrackAuxPar = typename Fitter::TrackAuxPar;
+  using CrossInfo = typename Fitter::CrossInfo;
+  using Vec3D = typename Fitter::Vec3D;
+  using ArrTrack = typename Fitter::ArrTrack;
+  using ArrTrPos = typename Fitter::ArrTrPos;
+
+  enum HypStatus : uint8_t {
+    kEmpty,       // lane not in use
+    kRejected,    // rejected before the minimization
+    kRunning,     // minimization in progress
+    kConverged,   // minimization finished
+    kFailed,      // singular chi2 2nd derivatives matrix
+    kAltPreferred // converging to the alternative seed
+  };
+
+  struct Combination {
+    o2::gpu::gpustd::array<const Track*, N> tracks{};
+    o2::gpu::gpustd::array<TrackAuxPar, N> trAux;
+    CrossInfo crossings;
+    std::array<int, MAXHYP> hyp{-1, -1}; // vertex hypothesis of each crossing, -1 if rejected by radius
+    bool hasCrossing = false;
+  };
+
+  struct Hypothesis {
+    ArrTrack candTr; // tracks at the seed
+    ArrTrPos trPos;  // track positions at the minimum
+    Vec3D pca;
+    float chi2 = -1.;
+    int nIters = 0;
+    int lane = -1; // global lane index in the blocks of the crossing, -1 if rejected before minimization
+    uint8_t status = kRejected;
+    bool propFailed = false;
+  };
+
+  ///< structure-of-arrays state of NLanes vertex hypotheses, [..][lane]
+  struct LaneBlock {
+    // constant during the minimization
+    alignas(64) double cs[N][2][NLanes]{};          // cos, sin of tracks alpha
+    alignas(64) double trCoef[N][3][3][NLanes]{};   // tracks contribution matrices to the PCA (weighted DCA only)
+    alignas(64) double trDer[N][4][NLanes]{};       // track position derivatives over X: dydx, dzdx, d2ydx2, d2zdx2
+    alignas(64) double covI[N][4][NLanes]{};        // inverse cov.matrices: sxx, syy, syz, szz
+    alignas(64) double gradCoef[N][N][3][NLanes]{}; // DChi2/Dx_i = sum_j res_j * gradCoef[i][j]
+    alignas(64) double hessConst[N][N][NLanes]{};   // D2Chi2/Dx_i/Dx_j = hessConst[i][j] + res_m * hessCoef[i][j] (j <= i),
+    alignas(64) double hessCoef[N][N][3][NLanes]{}; // m = i for the abs. DCA, m = j for the weighted one
+    alignas(64) double seedCur[2][NLanes]{};        // XY of the seed
+    alignas(64) double seedAlt[2][NLanes]{};        // XY of the alternative seed
+    uint8_t checkAlt[NLanes]{};                     // abandon the hypothesis when it gets closer to the alternative seed
+    // updated by the minimization
+    alignas(64) double trPos[N][3][NLanes]{};
+    alignas(64) double res[N][3][NLanes]{};
+    alignas(64) double pca[3][NLanes]{};
+    alignas(64) float chi2[NLanes]{};
+    int nIters[NLanes]{};
+    uint8_t status[NLanes]{};
+
+    void reset()
+    {
+      for (int l = 0; l < NLanes; l++) {
+        status[l] = kEmpty;
+        checkAlt[l] = 0;
+        chi2[l] = 0.f;
+        nIters[l] = 0;
+      }
+    }
+  };
+
+  void seedCombination(Combination& comb);
+  void seedHypothesis(Combination& comb, int ic);
+  template <bool AbsDCA>
+  void minimize(LaneBlock& blk) const;
+  LaneBlock& getLaneBlock(int pass, int lane) { return mBlocks[pass][lane / NLanes]; }
+
+  Fitter mFitter;
+  std::vector<Combination> mCombinations;
+  std::vector<Hypothesis> mHypotheses;
+  std::array<std::vector<LaneBlock>, MAXHYP> mBlocks; // blocks of the hypotheses seeded by the 1st and 2nd crossings
+  std::array<int, MAXHYP> mNLanesUsed{};
+};
+
+///_________________________________________________________________________
+template <int N, typename... Args>
+void DCAFitterNBatch<N, Args...>::clear()
+{
+  mCombinations.clear();
+  mHypotheses.clear();
+  mNLanesUsed.fill(0);
+}
+
+///_________________________________________________________________________
+template <int N, typename... Args>
+size_t DCAFitterNBatch<N, Args...>::process(const std::array<gsl::span<const Track>, N>& prongs)
+{
+  clear();
+  const size_t nComb = prongs[0].size();
+  for (int i = 1; i < N; i++) {
+    if (prongs[i].size() != nComb) {
+      throw std::invalid_argument("all prongs must have the same number of tracks");
+    }
+  }
+  mCombinations.resize(nComb);
+  for (size_t icomb = 0; icomb < nComb; icomb++) {
+    auto& comb = mCombinations[icomb];
+    for (int i = 0; i < N; i++) {
+      comb.tracks[i] = &prongs[i][icomb];
+    }
+    seedCombination(comb);
+  }
+
+  // hypotheses of the 1st crossing first: if they converge to the 2nd crossing, the latter
+  // is tested without the alternative seed preference, as in the scalar fit
+  for (int pass = 0; pass < MAXHYP; pass++) {
+    if (pass > 0) {
+      for (const auto& comb : mCombinations) {
+        if (comb.hyp[0] < 0 || comb.hyp[pass] < 0) {
+          continue;
+        }
+        const auto &hyp0 = mHypotheses[comb.hyp[0]], &hyp = mHypotheses[comb.hyp[pass]];
+        if (hyp0.lane >= 0 && hyp.lane >= 0 && getLaneBlock(0, hyp0.lane).status[hyp0.lane % NLanes] == kAltPreferred) {
+          getLaneBlock(pass, hyp.lane).checkAlt[hyp.lane % NLanes] = 0;
+        }
+      }
+    }
+    const int nBlocks = (mNLanesUsed[pass] + NLanes - 1) / NLanes;
+    for (int ib = 0; ib < nBlocks; ib++) {
+      if (mFitter.mUseAbsDCA) {
+        minimize<true>(mBlocks[pass][ib]);
+      } else {
+        minimize<false>(mBlocks[pass][ib]);
+      }
+    }
+  }
+
+  // fetch the results of the minimization
+  for (const auto& comb : mCombinations) {
+    for (int ic = 0; ic < MAXHYP; ic++) {
+      if (comb.hyp[ic] < 0 || mHypotheses[comb.hyp[ic]].lane < 0) {
+        continue;
+      }
+      auto& hyp = mHypotheses[comb.hyp[ic]];
+      const auto& blk = getLaneBlock(ic, hyp.lane);
+      const int l = hyp.lane % NLanes;
+      hyp.status = blk.status[l];
+      if (hyp.status == kFailed) {
+        LOG(error) << "InversionFailed";
+        continue;
+      }
+      for (int i = 0; i < N; i++) {
+        for (int k = 0; k < 3; k++) {
+          hyp.trPos[i][k] = blk.trPos[i][k][l];
+        }
+      }
+      for (int k = 0; k < 3; k++) {
+        hyp.pca[k] = blk.pca[k][l];
+      }
+      hyp.chi2 = blk.chi2[l] * Fitter::NInv;
+      hyp.nIters = blk.nIters[l];
+    }
+  }
+  return nComb;
+}
+
+///_________________________________________________________________________
+template <int N, typename... Args>
+void DCAFitterNBatch<N, Args...>::seedCombination(Combination& comb)
+{
+  // find the crossings of the combination and prepare the minimization of its vertex hypotheses
+  auto& ft = mFitter;
+  ft.mOrigTrPtr = comb.tracks;
+  comb.hasCrossing = ft.prepareSeeds();
+  comb.trAux = ft.mTrAux;
+  comb.crossings = ft.mCrossings;
+  if (!comb.hasCrossing) {
+    return;
+  }
+  for (int ic = 0; ic < ft.mCrossings.nDCA; ic++) {
+    if (ft.mCrossings.xDCA[ic] * ft.mCrossings.xDCA[ic] + ft.mCrossings.yDCA[ic] * ft.mCrossings.yDCA[ic] > ft.mMaxR2) {
+      continue;
+    }
+    seedHypothesis(comb, ic);
+  }
+}
+
+///_________________________________________________________________________
+template <int N, typename... Args>
+void DCAFitterNBatch<N, Args...>::seedHypothesis(Combination& comb, int ic)
+{
+  // propagate the tracks to the seed and store the constant coefficients of the minimization in a free lane
+  auto& ft = mFitter;
+  const int h = 0; // the scalar fitter slot used for the preparation
+  comb.hyp[ic] = mHypotheses.size();
+  auto& hyp = mHypotheses.emplace_back();
+  ft.mCurHyp = h;
+  ft.mPropFailed[h] = false;
+  ft.mPCA[h][0] = ft.mCrossings.xDCA[ic];
+  ft.mPCA[h][1] = ft.mCrossings.yDCA[ic];
+  const bool absDCA = ft.mUseAbsDCA;
+  const bool ok = absDCA ? ft.initChi2MinimizationNoErr() : ft.initChi2Minimization();
+  hyp.propFailed = ft.mPropFailed[h];
+  if (!ok) {
+    return;
+  }
+  hyp.candTr = ft.mCandTr[h];
+  ft.calcTrackDerivatives();
+  if (absDCA) {
+    ft.calcResidDerivativesNoErr();
+  } else {
+    ft.calcResidDerivatives();
+  }
+
+  hyp.lane = mNLanesUsed[ic]++;
+  hyp.status = kRunning;
+  if (mBlocks[ic].size() * NLanes < size_t(mNLanesUsed[ic])) {
+    mBlocks[ic].emplace_back();
+  }
+  auto& blk = getLaneBlock(ic, hyp.lane);
+  const int l = hyp.lane % NLanes;
+  if (l == 0) {
+    blk.reset();
+  }
+
+  for (int i = 0; i < N; i++) {
+    const auto& trDer = ft.mTrDer[h][i];
+    const auto& covI = ft.mTrcEInv[h][i];
+    blk.cs[i][0][l] = ft.mTrAux[i].c;
+    blk.cs[i][1][l] = ft.mTrAux[i].s;
+    blk.trDer[i][0][l] = trDer.dydx;
+    blk.trDer[i][1][l] = trDer.dzdx;
+    blk.trDer[i][2][l] = trDer.d2ydx2;
+    blk.trDer[i][3][l] = trDer.d2zdx2;
+    blk.covI[i][0][l] = absDCA ? 1. : covI.sxx;
+    blk.covI[i][1][l] = absDCA ? 1. : covI.syy;
+    blk.covI[i][2][l] = absDCA ? 0. : covI.syz;
+    blk.covI[i][3][l] = absDCA ? 1. : covI.szz;
+    for (int r = 0; r < 3; r++) {
+      for (int c = 0; c < 3; c++) {
+        blk.trCoef[i][r][c][l] = absDCA ? 0. : ft.mTrCFVT[h][i](r, c);
+      }
+      blk.trPos[i][r][l] = ft.mTrPos[h][i][r];
+      blk.res[i][r][l] = ft.mTrRes[h][i][r];
+    }
+  }
+
+  // chi2 derivatives are linear in the residuals, with coefficients depending on the residuals derivatives only
+  Vec3D cidr[N][N]; // vectors covI_j * dres_j/dx_i for weighted DCA, dres_j/dx_i for abs. one
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) {
+      const auto& dr1 = ft.mDResidDx[j][i];
+      if (absDCA) {
+        cidr[i][j] = dr1;
+      } else {
+        const auto& covI = ft.mTrcEInv[h][j];
+        cidr[i][j][0] = covI.sxx * dr1[0];
+        cidr[i][j][1] = covI.syy * dr1[1] + covI.syz * dr1[2];
+        cidr[i][j][2] = covI.syz * dr1[1] + covI.szz * dr1[2];
+      }
+      for (int k = 0; k < 3; k++) {
+        blk.gradCoef[i][j][k][l] = cidr[i][j][k];
+      }
+    }
+  }
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j <= i; j++) {
+      double hconst = 0;
+      for (int k = N; k--;) {
+        hconst += absDCA ? o2::math_utils::Dot(ft.mDResidDx[k][i], ft.mDResidDx[k][j]) : o2::math_utils::Dot(ft.mDResidDx[k][j], cidr[i][k]);
+      }
+      Vec3D hcoef;
+      if (absDCA) {
+        hcoef = ft.mD2ResidDx2[i][j];
+      } else {
+        const auto& covI = ft.mTrcEInv[h][j];
+        const auto& dr2 = ft.mD2ResidDx2[j][j];
+        hcoef[0] = covI.sxx * dr2[0];
+        hcoef[1] = covI.syy * dr2[1] + covI.syz * dr2[2];
+        hcoef[2] = covI.syz * dr2[1] + covI.szz * dr2[2];
+      }
+      blk.hessConst[i][j][l] = hconst;
+      for (int k = 0; k < 3; k++) {
+        blk.hessCoef[i][j][k][l] = hcoef[k];
+      }
+    }
+  }
+
+  const bool hasAlt = ft.mCrossings.nDCA == 2;
+  blk.seedCur[0][l] = ft.mCrossings.xDCA[ic];
+  blk.seedCur[1][l] = ft.mCrossings.yDCA[ic];
+  blk.seedAlt[0][l] = hasAlt ? ft.mCrossings.xDCA[1 - ic] : 0.;
+  blk.seedAlt[1][l] = hasAlt ? ft.mCrossings.yDCA[1 - ic] : 0.;
+  blk.checkAlt[l] = hasAlt;
+  for (int k = 0; k < 3; k++) {
+    blk.pca[k][l] = ft.mPCA[h][k];
+  }
+  blk.chi2[l] = absDCA ? ft.calcChi2NoErr() : ft.calcChi2();
+  blk.nIters[l] = 0;
+  blk.status[l] = kRunning;
+}
+
+///_________________________________________________________________________
+template <int N, typename... Args>
+template <bool AbsDCA>
+void DCAFitterNBatch<N, Args...>::minimize(LaneBlock& blk) const
+{
+  // Newton-Raphson iterations of all lanes of the block, same steps as in DCAFitterN::minimizeChi2 (NoErr)
+  const int maxIter = mFitter.mMaxIter;
+  const double minParamChange = mFitter.mMinParamChange;
+  const float minRelChi2Change = mFitter.mMinRelChi2Change;
+  int nRunning = 1;
+  while (nRunning) {
+    nRunning = 0;
+#pragma omp simd reduction(+ : nRunning)
+    for (int l = 0; l < NLanes; l++) {
+      const bool run = blk.status[l] == kRunning;
+
+      // chi2 derivatives
+      double grad[N], hess[N][N];
+      for (int i = 0; i < N; i++) {
+        grad[i] = 0;
+        for (int j = 0; j < N; j++) {
+          for (int k = 0; k < 3; k++) {
+            grad[i] += blk.res[j][k][l] * blk.gradCoef[i][j][k][l];
+          }
+        }
+        for (int j = 0; j <= i; j++) {
+          const int m = AbsDCA ? i : j;
+          hess[i][j] = blk.hessConst[i][j][l] + blk.res[m][0][l] * blk.hessCoef[i][j][0][l] + blk.res[m][1][l] * blk.hessCoef[i][j][1][l] + blk.res[m][2][l] * blk.hessCoef[i][j][2][l];
+          hess[j][i] = hess[i][j];
+        }
+      }
+
+      // corrections = - dchi2/d{x0..xN} * [ d^2chi2/d{x0..xN}^2 ]^-1, by cofactors
+      double inv[N][N], det;
+      if constexpr (N == 2) {
+        inv[0][0] = hess[1][1];
+        inv[0][1] = inv[1][0] = -hess[1][0];
+        inv[1][1] = hess[0][0];
+        det = hess[0][0] * hess[1][1] - hess[1][0] * hess[1][0];
+      } else {
+        inv[0][0] = hess[1][1] * hess[2][2] - hess[2][1] * hess[2][1];
+        inv[1][0] = inv[0][1] = hess[2][1] * hess[2][0] - hess[1][0] * hess[2][2];
+        inv[2][0] = inv[0][2] = hess[1][0] * hess[2][1] - hess[1][1] * hess[2][0];
+        inv[1][1] = hess[0][0] * hess[2][2] - hess[2][0] * hess[2][0];
+        inv[2][1] = inv[1][2] = hess[2][0] * hess[1][0] - hess[0][0] * hess[2][1];
+        inv[2][2] = hess[0][0] * hess[1][1] - hess[1][0] * hess[1][0];
+        det = hess[0][0] * inv[0][0] + hess[1][0] * inv[1][0] + hess[2][0] * inv[2][0];
+      }
+      const bool singular = det == 0.;
+      const double detI = singular ? 0. : 1. / det;
+      double dx[N], dxMax = -1;
+      for (int i = 0; i < N; i++) {
+        dx[i] = 0;
+        for (int j = 0; j < N; j++) {
+          dx[i] += inv[i][j] * detI * grad[j];
+        }
+        dxMax = std::max(dxMax, std::abs(dx[i]));
+      }
+
+      // updated track positions and PCA
+      double pos[N][3], pca[3] = {0., 0., 0.};
+      for (int i = 0; i < N; i++) {
+        const double dx2h = 0.5 * dx[i] * dx[i];
+        pos[i][0] = blk.trPos[i][0][l] - dx[i];
+        pos[i][1] = blk.trPos[i][1][l] - (blk.trDer[i][0][l] * dx[i] - dx2h * blk.trDer[i][2][l]);
+        pos[i][2] = blk.trPos[i][2][l] - (blk.trDer[i][1][l] * dx[i] - dx2h * blk.trDer[i][3][l]);
+      }
+      for (int i = N; i--;) {
+        if constexpr (AbsDCA) {
+          pca[0] += pos[i][0] * blk.cs[i][0][l] - pos[i][1] * blk.cs[i][1][l];
+          pca[1] += pos[i][0] * blk.cs[i][1][l] + pos[i][1] * blk.cs[i][0][l];
+          pca[2] += pos[i][2];
+        } else {
+          for (int r = 0; r < 3; r++) {
+            pca[r] += blk.trCoef[i][r][0][l] * pos[i][0] + blk.trCoef[i][r][1][l] * pos[i][1] + blk.trCoef[i][r][2][l] * pos[i][2];
+          }
+        }
+      }
+      if constexpr (AbsDCA) {
+        for (int r = 0; r < 3; r++) {
+          pca[r] *= Fitter::NInv;
+        }
+      }
+      const double dxCur = pca[0] - blk.seedCur[0][l], dyCur = pca[1] - blk.seedCur[1][l];
+      const double dxAlt = pca[0] - blk.seedAlt[0][l], dyAlt = pca[1] - blk.seedAlt[1][l];
+      const bool altPreferred = blk.checkAlt[l] && dxCur * dxCur + dyCur * dyCur > dxAlt * dxAlt + dyAlt * dyAlt;
+
+      // updated residuals and chi2
+      double res[N][3], chi2 = 0;
+      for (int i = N; i--;) {
+        const double c = blk.cs[i][0][l], s = blk.cs[i][1][l];
+        res[i][0] = pos[i][0] - (pca[0] * c + pca[1] * s);
+        res[i][1] = pos[i][1] - (-pca[0] * s + pca[1] * c);
+        res[i][2] = pos[i][2] - pca[2];
+        if constexpr (AbsDCA) {
+          chi2 += res[i][0] * res[i][0] + res[i][1] * res[i][1] + res[i][2] * res[i][2];
+        } else {
+          chi2 += res[i][0] * res[i][0] * blk.covI[i][0][l] + res[i][1] * res[i][1] * blk.covI[i][1][l] + res[i][2] * res[i][2] * blk.covI[i][3][l] + 2. * res[i][1] * res[i][2] * blk.covI[i][2][l];
+        }
+      }
+      const float chi2Upd = chi2;
+      const bool converged = dxMax < minParamChange || chi2Upd > blk.chi2[l] * minRelChi2Change;
+      const int nIters = blk.nIters[l] + !converged;
+      const uint8_t status = singular ? kFailed : (altPreferred ? kAltPreferred : ((converged || nIters >= maxIter) ? kConverged : kRunning));
+
+      // masked update of the running lanes
+      for (int i = 0; i < N; i++) {
+        for (int k = 0; k < 3; k++) {
+          blk.trPos[i][k][l] = run ? pos[i][k] : blk.trPos[i][k][l];
+          blk.res[i][k][l] = run ? res[i][k] : blk.res[i][k][l];
+        }
+      }
+      for (int k = 0; k < 3; k++) {
+        blk.pca[k][l] = run ? pca[k] : blk.pca[k][l];
+      }
+      blk.chi2[l] = run ? chi2Upd : blk.chi2[l];
+      blk.nIters[l] = run ? nIters : blk.nIters[l];
+      blk.status[l] = run ? status : blk.status[l];
+      nRunning += run && status == kRunning;
+    }
+  }
+}
+
+///_________________________________________________________________________
+template <int N, typename... Args>
+int DCAFitterNBatch<N, Args...>::load(size_t i)
+{
+  // replay the candidates loop of DCAFitterN::process with the minimization results of the batch
+  auto& ft = mFitter;
+  const auto& comb = mCombinations[i];
+  ft.mCallID++;
+  ft.mOrigTrPtr = comb.tracks;
+  ft.clear();
+  ft.mTrAux = comb.trAux;
+  ft.mCrossings = comb.crossings;
+  if (!comb.hasCrossing) {
+    return 0;
+  }
+  for (int ih = 0; ih < MAXHYP; ih++) {
+    ft.mPropFailed[ih] = false;
+  }
+  if (ft.mUseAbsDCA) {
+    ft.calcRMatrices(); // needed if the tracks are refitted in propagateTracksToVertex
+  }
+  for (int ic = 0; ic < ft.mCrossings.nDCA; ic++) {
+    if (comb.hyp[ic] < 0) {
+      continue;
+    }
+    const auto& hyp = mHypotheses[comb.hyp[ic]];
+    const int cand = ft.mCurHyp;
+    ft.mCrossIDCur = ic;
+    ft.mCrossIDAlt = (ft.mCrossings.nDCA == 2 && ft.mAllowAltPreference) ? 1 - ic : -1;
+    ft.mNIters[cand] = hyp.nIters;
+    ft.mTrPropDone[cand] = false;
+    ft.mChi2[cand] = -1.;
+    ft.mPCA[cand][0] = ft.mCrossings.xDCA[ic];
+    ft.mPCA[cand][1] = ft.mCrossings.yDCA[ic];
+    if (hyp.propFailed) {
+      ft.mPropFailed[cand] = true;
+    }
+    if (hyp.status == kAltPreferred) {
+      ft.mAllowAltPreference = false;
+    }
+    if (hyp.status != kConverged || !(hyp.chi2 < ft.mMaxChi2)) {
+      continue;
+    }
+    ft.mCandTr[cand] = hyp.candTr;
+    ft.mTrPos[cand] = hyp.trPos;
+    ft.mPCA[cand] = hyp.pca;
+    ft.mChi2[cand] = hyp.chi2;
+    ft.mOrder[cand] = cand;
+    if (ft.mPropagateToPCA && !ft.propagateTracksToVertex(cand)) {
+      continue; // discard candidate if failed to propagate to it
+    }
+    ft.mCurHyp++;
+  }
+  return ft.finalizeCandidates();
+}
+
+} // namespace vertexing
+} // namespace o2
+#endif // _ALICEO2_DCA_FITTERN_BATCH_
@@ -14,6 +14,7 @@
 /// \author ruben.shahoyan@cern.ch
 
 #include "DCAFitter/DCAFitterN.h"
+#include "DCAFitter/DCAFitterNBatch.h"
 
 namespace o2
 {
@@ -27,6 +28,12 @@ void __dummy_instance__()
   o2::track::TrackParCov tr;
   ft2.process(tr, tr);
   ft3.process(tr, tr, tr);
+  DCAFitterNBatch<2> ftb2;
+  DCAFitterNBatch<3> ftb3;
+  ftb2.process({gsl::span<const o2::track::TrackParCov>(&tr, 1), gsl::span<const o2::track::TrackParCov>(&tr, 1)});
+  ftb2.load(0);
+  ftb3.process({gsl::span<const o2::track::TrackParCov>(&tr, 1), gsl::span<const o2::track::TrackParCov>(&tr, 1), gsl::span<const o2::track::TrackParCov>(&tr, 1)});
+  ftb3.load(0);
 }
 
 } // namespace vertexing
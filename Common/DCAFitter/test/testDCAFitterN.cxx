@@ -15,12 +15,14 @@
 #include <boost/test/unit_test.hpp>
 
 #include "DCAFitter/DCAFitterN.h"
+#include "DCAFitter/DCAFitterNBatch.h"
 #include "CommonUtils/TreeStreamRedirector.h"
 #include <TRandom.h>
 #include <TGenPhaseSpace.h>
 #include <TLorentzVector.h>
 #include <TStopwatch.h>
 #include <Math/SVector.h>
+#include <algorithm>
 #include <array>
 
 namespace o2
@@ -552,5 +554,100 @@ BOOST_AUTO_TEST_CASE(DCAFitterNProngs)
   outStream.Close();
 }
 
+template <int N>
+void compareBatchFit(DCAFitterN<N>& ft, const std::array<std::vector<o2::track::TrackParCov>, N>& prongs)
+{
+  DCAFitterNBatch<N> batch(ft);
+  std::array<gsl::span<const o2::track::TrackParCov>, N> spans;
+  for (int i = 0; i < N; i++) {
+    spans[i] = gsl::span<const o2::track::TrackParCov>(prongs[i]);
+  }
+  BOOST_REQUIRE_EQUAL(batch.process(spans), prongs[0].size());
+  int nCandTot = 0;
+  for (size_t icomb = 0; icomb < prongs[0].size(); icomb++) {
+    int nc = 0;
+    if constexpr (N == 2) {
+      nc = ft.process(prongs[0][icomb], prongs[1][icomb]);
+    } else {
+      nc = ft.process(prongs[0][icomb], prongs[1][icomb], prongs[2][icomb]);
+    }
+    int ncB = batch.load(icomb);
+    BOOST_REQUIRE_EQUAL(nc, ncB);
+    const auto& ftB = batch.getFitter();
+    for (int ic = 0; ic < nc; ic++) {
+      const auto &pca = ft.getPCACandidate(ic), &pcaB = ftB.getPCACandidate(ic);
+      for (int k = 0; k < 3; k++) {
+        BOOST_CHECK_SMALL(pca[k] - pcaB[k], 1e-4);
+      }
+      // same minimization up to rounding, which may only change the iteration at which the convergence is declared
+      float chi2 = ft.getChi2AtPCACandidate(ic), chi2B = ftB.getChi2AtPCACandidate(ic);
+      BOOST_CHECK_SMALL(chi2 - chi2B, 1e-3f * std::max(1.f, chi2));
+      for (int i = 0; i < N; i++) {
+        BOOST_CHECK_SMALL(ft.getTrack(i, ic).getY() - ftB.getTrack(i, ic).getY(), 1e-4f);
+        BOOST_CHECK_SMALL(ft.getTrack(i, ic).getZ() - ftB.getTrack(i, ic).getZ(), 1e-4f);
+      }
+    }
+    nCandTot += nc;
+  }
+  BOOST_CHECK(nCandTot > 0.99 * prongs[0].size());
+}
+
+BOOST_AUTO_TEST_CASE(DCAFitterNBatchVsScalar)
+{
+  constexpr int NTest = 1000;
+  TGenPhaseSpace genPHS;
+  constexpr double pion = 0.13957;
+  constexpr double k0 = 0.49761;
+  constexpr double kch = 0.49368;
+  constexpr double dch = 1.86965;
+  std::vector<double> k0dec = {pion, pion};
+  std::vector<double> dchdec = {pion, kch, pion};
+  std::vector<o2::track::TrackParCov> vctracks;
+  Vec3D vtxGen;
+  double bz = 5.0;
+
+  // 2 prongs vertices
+  {
+    std::vector<int> forceQ{1, 1};
+    std::array<std::vector<o2::track::TrackParCov>, 2> prongs;
+    for (int iev = 0; iev < NTest; iev++) {
+      generate(vtxGen, vctracks, bz, genPHS, k0, k0dec, forceQ);
+      for (int i = 0; i < 2; i++) {
+        prongs[i].push_back(vctracks[i]);
+      }
+    }
+    o2::vertexing::DCAFitterN<2> ft; // 2 prong fitter
+    ft.setBz(bz);
+    ft.setUseAbsDCA(true);
+    compareBatchFit(ft, prongs);
+    ft.setWeightedFinalPCA(true);
+    compareBatchFit(ft, prongs);
+    ft.setUseAbsDCA(false);
+    ft.setWeightedFinalPCA(false);
+    compareBatchFit(ft, prongs);
+  }
+
+  // 3 prongs vertices
+  {
+    std::vector<int> forceQ{1, 1, 1};
+    std::array<std::vector<o2::track::TrackParCov>, 3> prongs;
+    for (int iev = 0; iev < NTest; iev++) {
+      generate(vtxGen, vctracks, bz, genPHS, dch, dchdec, forceQ);
+      for (int i = 0; i < 3; i++) {
+        prongs[i].push_back(vctracks[i]);
+      }
+    }
+    o2::vertexing::DCAFitterN<3> ft; // 3 prong fitter
+    ft.setBz(bz);
+    ft.setUseAbsDCA(true);
+    compareBatchFit(ft, prongs);
+    ft.setWeightedFinalPCA(true);
+    compareBatchFit(ft, prongs);
+    ft.setUseAbsDCA(false);
+    ft.setWeightedFinalPCA(false);
+    compareBatchFit(ft, prongs);
+  }
+}
+
 } // namespace vertexing
 } // namespace o2
@@ -110,6 +110,17 @@ class RandomRing
   /// @return position in the ring buffer
   unsigned int getRingPosition() const { return mRingPosition; }
 
+  /// set the position in the ring buffer, e.g. to decorrelate copies of the same ring
+  /// @param [in] position new position, wrapped around the ring size
+  void setRingPosition(size_t position) { mRingPosition = position % mRandomNumbers.size(); }
+
+  /// offset of the ring position between streams, multiple of the Vc vector sizes and co-prime to the default ring size / 64
+  static constexpr size_t StreamStride = 64 * 997;
+
+  /// move to the start of a given stream, such that copies of the same ring used by different threads are decorrelated
+  /// @param [in] stream index of the stream
+  void setStream(size_t stream) { setRingPosition(stream * StreamStride); }
+
  private:
   // =========================================================================
   // ===| members |===========================================================
@@ -72,6 +72,7 @@ struct SimConfigData {
   int mInternalChunkSize;                             //
   ULong_t mStartSeed;                                 // base for random number seeds
   int mSimWorkers = 1;                                // number of parallel sim workers (when it applies)
+  int mMergerThreads = 1;                             // number of threads used by the hit merger to merge/flush detector hits
   bool mFilterNoHitEvents = false;                    // whether to filter out events not leaving any response
   std::string mCCDBUrl;                               // the URL where to find CCDB
   uint64_t mTimestamp;                                // timestamp in ms to anchor transport simulation to
@@ -87,7 +88,7 @@ struct SimConfigData {
   bool mWriteToDisc = true;                           // whether we write simulation products (kine, hits) to disc
   VertexMode mVertexMode = VertexMode::kDiamondParam; // by default we should use die InteractionDiamond parameter
 
-  ClassDefNV(SimConfigData, 4);
+  ClassDefNV(SimConfigData, 5);
 };
 
 // A singleton class which can be used
@@ -167,6 +168,7 @@ class SimConfig
   int getInternalChunkSize() const { return mConfigData.mInternalChunkSize; }
   ULong_t getStartSeed() const { return mConfigData.mStartSeed; }
   int getNSimWorkers() const { return mConfigData.mSimWorkers; }
+  int getNMergerThreads() const { return mConfigData.mMergerThreads; }
   bool isFilterOutNoHitEvents() const { return mConfigData.mFilterNoHitEvents; }
   bool asService() const { return mConfigData.mAsService; }
   uint64_t getTimestamp() const { return mConfigData.mTimestamp; }
@@ -68,6 +68,7 @@ void SimConfig::initOptions(boost::program_options::options_description& options
     "seed", bpo::value<ULong_t>()->default_value(0), "initial seed as ULong_t (default: 0 == random)")(
     "field", bpo::value<std::string>()->default_value("-5"), "L3 field rounded to kGauss, allowed values +-2,+-5 and 0; +-<intKGaus>U for uniform field; \"ccdb\" for taking it from CCDB ")("vertexMode", bpo::value<std::string>()->default_value("kDiamondParam"), "Where the beam-spot vertex should come from. Must be one of kNoVertex, kDiamondParam, kCCDB")(
     "nworkers,j", bpo::value<int>()->default_value(nsimworkersdefault), "number of parallel simulation workers (only for parallel mode)")(
+    "nMergerThreads", bpo::value<int>()->default_value(1), "number of threads used by the hit merger to merge and flush the hits of different detectors concurrently (only for parallel mode)")(
     "noemptyevents", "only writes events with at least one hit")(
     "CCDBUrl", bpo::value<std::string>()->default_value("http://alice-ccdb.cern.ch"), "URL for CCDB to be used.")(
     "timestamp", bpo::value<uint64_t>(), "global timestamp value in ms (for anchoring) - default is now ... or beginning of run if ALICE run number was given")(
@@ -317,6 +318,7 @@ bool SimConfig::resetFromParsedMap(boost::program_options::variables_map const&
   mConfigData.mInternalChunkSize = vm["chunkSizeI"].as<int>();
   mConfigData.mStartSeed = vm["seed"].as<ULong_t>();
   mConfigData.mSimWorkers = vm["nworkers"].as<int>();
+  mConfigData.mMergerThreads = std::max(1, vm["nMergerThreads"].as<int>());
   if (vm.count("timestamp")) {
     mConfigData.mTimestamp = vm["timestamp"].as<uint64_t>();
     mConfigData.mTimestampMode = TimeStampMode::kManual;
@@ -212,6 +212,10 @@ class DebugStreamer
 
   GPUd() void flush() const {};
 
+  GPUd() void flush(const size_t) const {};
+
+  GPUd() static size_t getCPUID() { return 0; }
+
 #endif
 };
 
@@ -22,6 +22,12 @@
 #include <cstddef>
 #include <Rtypes.h>
 #include <any>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <thread>
 
 #include "TTree.h"
 #include "CommonUtils/StringUtils.h"
@@ -74,6 +80,46 @@ inline constexpr bool mayPack(Metadata::OptStore opt) noexcept
   return (opt == Metadata::OptStore::PACK) || (opt == Metadata::OptStore::EENCODE_OR_PACK);
 }
 
+/// execute independent per-block tasks on up to nThreads threads (the calling one included) and sum their IO sizes.
+/// The 1st exception thrown by any of the tasks is rethrown once all threads are joined.
+inline CTFIOSize runBlockTasks(const std::vector<std::function<CTFIOSize()>>& tasks, int nThreads)
+{
+  std::vector<CTFIOSize> results(tasks.size());
+  std::atomic<size_t> nextTask{0};
+  std::exception_ptr error;
+  std::mutex errorMutex;
+  auto worker = [&]() {
+    size_t it;
+    while ((it = nextTask++) < tasks.size()) {
+      try {
+        results[it] = tasks[it]();
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+  };
+  nThreads = std::max(1, std::min(nThreads, int(tasks.size())));
+  std::vector<std::thread> threads;
+  for (int i = 1; i < nThreads; i++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& th : threads) {
+    th.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  CTFIOSize iosize;
+  for (const auto& res : results) {
+    iosize += res;
+  }
+  return iosize;
+}
+
 } // namespace detail
 constexpr size_t PackingThreshold = 512;
 
@@ -512,6 +558,71 @@ class EncodedBlocks
   o2::ctf::CTFIOSize decode(D_IT dest, int slot, const std::any& decoderExt = {}) const;
 
 #ifndef __CLING__
+  /// Encoder of independent blocks on several threads: every block added is encoded into its own scratch container,
+  /// the results are then appended to the flat buffer in slot order, so that the layout is identical to the one
+  /// produced by consecutive encode calls. The source data must stay valid until process(), the external encoders are
+  /// copied into the jobs.
+  class ParallelEncoder
+  {
+   public:
+    ParallelEncoder(const EncodedBlocks& proto, int nThreads) : mHeader(proto.getHeader()), mANSHeader(proto.getANSHeader()), mNThreads(nThreads) {}
+
+    /// register the block at provided slot for encoding, arguments have the same meaning as for the encode method
+    template <typename input_IT>
+    void add(const input_IT srcBegin, const input_IT srcEnd, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, std::any encoderExt = {}, float memfc = 1.f);
+
+    /// register the vector src for encoding at provided slot
+    template <typename VE>
+    void add(const VE& src, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, std::any encoderExt = {}, float memfc = 1.f)
+    {
+      add(std::begin(src), std::end(src), slot, symbolTablePrecision, opt, std::move(encoderExt), memfc);
+    }
+
+    /// encode all registered blocks and append them to the container in the buffer, which will be expanded as needed
+    template <typename buffer_T>
+    CTFIOSize process(buffer_T& buffer);
+
+   private:
+    struct Job {
+      int slot = -1;
+      size_t nSamples = 0;
+      std::function<CTFIOSize(std::vector<BufferType>&)> encode;
+      std::vector<BufferType> scratch;
+    };
+    H mHeader;
+    ANSHeader mANSHeader;
+    int mNThreads = 1;
+    std::vector<Job> mJobs;
+  };
+
+  /// Decoder of independent blocks on several threads. The destinations must stay valid until process() and must not overlap,
+  /// the external decoders are copied into the jobs.
+  class ParallelDecoder
+  {
+   public:
+    ParallelDecoder(const EncodedBlocks& ec, int nThreads) : mEC(ec), mNThreads(nThreads) {}
+
+    /// register decoding of the block at provided slot to destination vector (resized immediately)
+    template <class container_T, std::enable_if_t<!detail::is_iterator_v<container_T>, bool> = true>
+    void add(container_T& dest, int slot, std::any decoderExt = {})
+    {
+      dest.resize(mEC.getMetadata(slot).messageLength);
+      add(std::begin(dest), slot, std::move(decoderExt));
+    }
+
+    /// register decoding of the block at provided slot to destination iterator, the needed space assumed to be available
+    template <typename D_IT, std::enable_if_t<detail::is_iterator_v<D_IT>, bool> = true>
+    void add(D_IT dest, int slot, std::any decoderExt = {});
+
+    /// decode all registered blocks
+    CTFIOSize process();
+
+   private:
+    const EncodedBlocks& mEC;
+    int mNThreads = 1;
+    std::vector<std::pair<size_t, std::function<CTFIOSize()>>> mJobs; // message length and decoding task
+  };
+
   /// create a special EncodedBlocks containing only dictionaries made from provided vector of frequency tables
   static std::vector<char> createDictionaryBlocks(const std::vector<rans::DenseHistogram<int32_t>>& vfreq, const std::vector<Metadata>& prbits);
 #endif
@@ -561,6 +672,10 @@ class EncodedBlocks
   template <typename T>
   auto expandStorage(size_t slot, size_t nElemets, T* buffer = nullptr) -> decltype(auto);
 
+  /// append the block filled at provided slot of another (scratch) container as the next block of this one
+  template <typename buffer_T>
+  void appendBlock(int slot, const EncodedBlocks& src, buffer_T* buffer);
+
   inline ANSHeader checkANSVersion(ANSHeader ansVersion) const
   {
     auto ctfANSHeader = getANSHeader();
@@ -1516,6 +1631,90 @@ o2::ctf::CTFIOSize EncodedBlocks<H, N, W>::store(const input_IT srcBegin, const
   return {0, thisMetadata->getUncompressedSize(), thisMetadata->getCompressedSize()};
 };
 
+template <typename H, int N, typename W>
+template <typename buffer_T>
+void EncodedBlocks<H, N, W>::appendBlock(int slot, const EncodedBlocks& src, buffer_T* buffer)
+{
+  assert(slot == mRegistry.nFilledBlocks);
+  mRegistry.nFilledBlocks++;
+  const auto& srcBlock = src.mBlocks[slot];
+  if (!srcBlock.payload) { // nothing was stored, e.g. empty message or constant packed data, all info is in the metadata
+    mMetadata[slot] = src.mMetadata[slot];
+    return;
+  }
+  auto [thisBlock, thisMetadata] = expandStorage(slot, srcBlock.getNStored(), buffer);
+  thisBlock->store(srcBlock.getNDict(), srcBlock.getNData(), srcBlock.getNLiterals(), srcBlock.getDict(), srcBlock.getData(), srcBlock.getLiterals());
+  *thisMetadata = src.mMetadata[slot];
+}
+
+///_____________________________________________________________________________
+template <typename H, int N, typename W>
+template <typename input_IT>
+void EncodedBlocks<H, N, W>::ParallelEncoder::add(const input_IT srcBegin, const input_IT srcEnd, int slot, uint8_t symbolTablePrecision, Metadata::OptStore opt, std::any encoderExt, float memfc)
+{
+  auto& job = mJobs.emplace_back();
+  job.slot = slot;
+  job.nSamples = std::distance(srcBegin, srcEnd);
+  job.encode = [=, ext = std::move(encoderExt)](std::vector<BufferType>& scratch) {
+    return get(scratch.data())->encode(srcBegin, srcEnd, slot, symbolTablePrecision, opt, &scratch, ext, memfc);
+  };
+}
+
+///_____________________________________________________________________________
+template <typename H, int N, typename W>
+template <typename buffer_T>
+CTFIOSize EncodedBlocks<H, N, W>::ParallelEncoder::process(buffer_T& buffer)
+{
+  std::sort(mJobs.begin(), mJobs.end(), [](const Job& a, const Job& b) { return a.slot < b.slot; });
+  // start from the largest blocks to balance the load
+  std::vector<size_t> order(mJobs.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) { return mJobs[a].nSamples > mJobs[b].nSamples; });
+  std::vector<std::function<CTFIOSize()>> tasks;
+  tasks.reserve(order.size());
+  for (auto id : order) {
+    tasks.emplace_back([this, id]() {
+      auto& job = mJobs[id];
+      auto* scratchEC = create(job.scratch);
+      scratchEC->setHeader(mHeader);
+      scratchEC->setANSHeader(mANSHeader);
+      scratchEC->mRegistry.nFilledBlocks = job.slot; // the scratch container holds this slot only
+      return job.encode(job.scratch);
+    });
+  }
+  auto iosize = detail::runBlockTasks(tasks, mNThreads);
+  for (const auto& job : mJobs) {
+    get(buffer.data())->appendBlock(job.slot, *get(job.scratch.data()), &buffer);
+  }
+  mJobs.clear();
+  return iosize;
+}
+
+///_____________________________________________________________________________
+template <typename H, int N, typename W>
+template <typename D_IT, std::enable_if_t<detail::is_iterator_v<D_IT>, bool>>
+void EncodedBlocks<H, N, W>::ParallelDecoder::add(D_IT dest, int slot, std::any decoderExt)
+{
+  mJobs.emplace_back(mEC.getMetadata(slot).messageLength, [&ec = mEC, dest, slot, ext = std::move(decoderExt)]() {
+    return ec.decode(dest, slot, ext);
+  });
+}
+
+///_____________________________________________________________________________
+template <typename H, int N, typename W>
+CTFIOSize EncodedBlocks<H, N, W>::ParallelDecoder::process()
+{
+  // start from the largest blocks to balance the load
+  std::stable_sort(mJobs.begin(), mJobs.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+  std::vector<std::function<CTFIOSize()>> tasks;
+  tasks.reserve(mJobs.size());
+  for (auto& job : mJobs) {
+    tasks.emplace_back(std::move(job.second));
+  }
+  mJobs.clear();
+  return detail::runBlockTasks(tasks, mNThreads);
+}
+
 /// create a special EncodedBlocks containing only dictionaries made from provided vector of frequency tables
 template <typename H, int N, typename W>
 std::vector<char> EncodedBlocks<H, N, W>::createDictionaryBlocks(const std::vector<rans::DenseHistogram<int32_t>>& vfreq, const std::vector<Metadata>& vmd)
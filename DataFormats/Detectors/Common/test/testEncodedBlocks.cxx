@@ -0,0 +1,121 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   testEncodedBlocks.cxx
+/// @brief  Test parallel encoding/decoding of EncodedBlocks against the serial one
+
+#define BOOST_TEST_MODULE Test EncodedBlocks class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <vector>
+#include <cstring>
+#include <random>
+#include <algorithm>
+
+#include <boost/test/unit_test.hpp>
+
+#include "DetectorsCommonDataFormats/EncodedBlocks.h"
+#include "DetectorsCommonDataFormats/CTFDictHeader.h"
+
+using namespace o2::ctf;
+
+constexpr int NBlocks = 6;
+using CTFType = EncodedBlocks<CTFDictHeader, NBlocks, uint32_t>;
+using Opt = Metadata::OptStore;
+
+struct Columns {
+  std::vector<int32_t> c0, c2, c3;
+  std::vector<uint16_t> c1;
+  std::vector<int8_t> c4;
+  std::vector<uint32_t> c5;
+  std::array<Opt, NBlocks> opts{Opt::EENCODE_OR_PACK, Opt::EENCODE, Opt::EENCODE_OR_PACK, Opt::EENCODE_OR_PACK, Opt::NONE, Opt::EENCODE_OR_PACK};
+
+  Columns()
+  {
+    std::mt19937 mt(0); // same seed we want always the same distrubution of random numbers;
+    std::binomial_distribution<int> dist(200, 0.3);
+    c0.resize(100000);
+    std::generate(c0.begin(), c0.end(), [&]() { return dist(mt); });
+    c1.resize(300000);
+    std::generate(c1.begin(), c1.end(), [&]() { return dist(mt) * 7; });
+    // c2 stays empty
+    c3.resize(500, 5); // constant, stored in the metadata only
+    c4.resize(1000);
+    std::generate(c4.begin(), c4.end(), [&]() { return dist(mt) % 100; });
+    c5.resize(20000);
+    std::generate(c5.begin(), c5.end(), [&]() { return mt(); });
+  }
+};
+
+BOOST_AUTO_TEST_CASE(EncodedBlocks_parallel)
+{
+  const Columns cols;
+
+  std::vector<BufferType> bufSerial, bufParallel;
+  CTFType::create(bufSerial)->setANSHeader(ANSVersion1);
+  CTFIOSize ioSerial;
+  ioSerial += CTFType::get(bufSerial.data())->encode(cols.c0, 0, 0, cols.opts[0], &bufSerial);
+  ioSerial += CTFType::get(bufSerial.data())->encode(cols.c1, 1, 0, cols.opts[1], &bufSerial);
+  ioSerial += CTFType::get(bufSerial.data())->encode(cols.c2, 2, 0, cols.opts[2], &bufSerial);
+  ioSerial += CTFType::get(bufSerial.data())->encode(cols.c3, 3, 0, cols.opts[3], &bufSerial);
+  ioSerial += CTFType::get(bufSerial.data())->encode(cols.c4, 4, 0, cols.opts[4], &bufSerial);
+  ioSerial += CTFType::get(bufSerial.data())->encode(cols.c5, 5, 0, cols.opts[5], &bufSerial);
+
+  auto* ecp = CTFType::create(bufParallel);
+  ecp->setANSHeader(ANSVersion1);
+  CTFType::ParallelEncoder encoder(*ecp, 4);
+  encoder.add(cols.c5, 5, 0, cols.opts[5]); // registration order must not matter
+  encoder.add(cols.c0, 0, 0, cols.opts[0]);
+  encoder.add(cols.c1.begin(), cols.c1.end(), 1, 0, cols.opts[1]);
+  encoder.add(cols.c2, 2, 0, cols.opts[2]);
+  encoder.add(cols.c3, 3, 0, cols.opts[3]);
+  encoder.add(cols.c4, 4, 0, cols.opts[4]);
+  auto ioParallel = encoder.process(bufParallel);
+  BOOST_CHECK(ioSerial == ioParallel);
+
+  // the layout of the payload must be identical to the serial one
+  const auto* ecSerial = CTFType::get(bufSerial.data());
+  const auto* ecParallel = CTFType::get(bufParallel.data());
+  const auto headSize = alignSize(sizeof(CTFType));
+  BOOST_CHECK_EQUAL(ecSerial->getRegistry().nFilledBlocks, ecParallel->getRegistry().nFilledBlocks);
+  BOOST_REQUIRE_EQUAL(ecSerial->getRegistry().offsFreeStart, ecParallel->getRegistry().offsFreeStart);
+  BOOST_CHECK(std::memcmp(bufSerial.data() + headSize, bufParallel.data() + headSize, ecSerial->getRegistry().offsFreeStart - headSize) == 0);
+  for (int i = 0; i < NBlocks; i++) {
+    const auto &bs = ecSerial->getBlock(i), &bp = ecParallel->getBlock(i);
+    BOOST_CHECK_EQUAL(bs.getNStored(), bp.getNStored());
+    BOOST_CHECK_EQUAL(bs.payload == nullptr, bp.payload == nullptr);
+    if (bs.payload) {
+      BOOST_CHECK_EQUAL(reinterpret_cast<const BufferType*>(bs.payload) - bufSerial.data(), reinterpret_cast<const BufferType*>(bp.payload) - bufParallel.data());
+    }
+    BOOST_CHECK(std::memcmp(&ecSerial->getMetadata(i), &ecParallel->getMetadata(i), sizeof(Metadata)) == 0);
+  }
+
+  // decode in parallel
+  std::vector<int32_t> c0, c2, c3;
+  std::vector<uint16_t> c1(cols.c1.size());
+  std::vector<int8_t> c4;
+  std::vector<uint32_t> c5;
+  CTFType::ParallelDecoder decoder(*ecParallel, 3);
+  decoder.add(c0, 0);
+  decoder.add(c1.begin(), 1);
+  decoder.add(c2, 2);
+  decoder.add(c3, 3);
+  decoder.add(c4, 4);
+  decoder.add(c5, 5);
+  BOOST_CHECK(decoder.process() == ioSerial);
+  BOOST_CHECK(c0 == cols.c0);
+  BOOST_CHECK(c1 == cols.c1);
+  BOOST_CHECK(c2 == cols.c2);
+  BOOST_CHECK(c3 == cols.c3);
+  BOOST_CHECK(c4 == cols.c4);
+  BOOST_CHECK(c5 == cols.c5);
+}
@@ -472,6 +472,16 @@ class AODProducerWorkflowDPL : public Task
   };
   std::vector<TPCCounters> mTPCCounters;
 
+  // barrel track information computed in parallel ahead of the (serial) filling of the track tables
+  struct BarrelTrackCache {
+    TrackExtraInfo extraInfo;
+    o2::track::TrackParCov trackPar; // track propagated to the vertex
+    bool hasExtraInfo = false;
+    bool hasPropagation = false;
+    bool isProp = false; // propagation to the vertex succeeded
+  };
+  std::vector<BarrelTrackCache> mBarrelTrackCache; // indexed as the vertex-matched track indices
+
   void updateTimeDependentParams(ProcessingContext& pc);
 
   void addRefGlobalBCsForTOF(const o2::dataformats::VtxTrackRef& trackRef, const gsl::span<const GIndex>& GIndices,
@@ -506,6 +516,11 @@ class AODProducerWorkflowDPL : public Task
   bool propagateTrackToPV(o2::track::TrackParametrizationWithError<float>& trackPar, const o2::globaltracking::RecoContainer& data, int colID);
   void extrapolateToCalorimeters(TrackExtraInfo& extraInfoHolder, const o2::track::TrackPar& track);
   void cacheTriggers(const o2::globaltracking::RecoContainer& recoData);
+  bool isBarrelTrackSource(int src) const;
+  bool needsPropagationToPV(GIndex trackIndex, const o2::track::TrackParCov& trOrig) const;
+  // process the barrel tracks of all collisions in parallel, must be called after all inputs of processBarrelTrack are ready
+  void prepareBarrelTracks(const gsl::span<const o2::dataformats::VtxTrackRef>& trackRefs, const gsl::span<const GIndex>& GIndices,
+                           const o2::globaltracking::RecoContainer& data, const std::map<uint64_t, int>& bcsMap);
 
   // helper for track tables
   // * fills tables collision by collision
@@ -481,7 +481,8 @@ void AODProducerWorkflowDPL::fillTrackTablesPerCollision(int collisionID,
           float weight = 0;
           static std::uniform_real_distribution<> distr(0., 1.);
           bool writeQAData = o2::math_utils::Tsallis::downsampleTsallisCharged(data.getTrackParam(trackIndex).getPt(), mTrackQCFraction, mSqrtS, weight, distr(mGenerator));
-          auto extraInfoHolder = processBarrelTrack(collisionID, collisionBC, trackIndex, data, bcsMap);
+          const auto& cache = mBarrelTrackCache[ti];
+          auto extraInfoHolder = cache.hasExtraInfo ? cache.extraInfo : processBarrelTrack(collisionID, collisionBC, trackIndex, data, bcsMap);
 
           if (writeQAData) {
             auto trackQAInfoHolder = processBarrelTrackQA(collisionID, collisionBC, trackIndex, data, bcsMap);
@@ -508,9 +509,12 @@ void AODProducerWorkflowDPL::fillTrackTablesPerCollision(int collisionID,
           }
           const auto& trOrig = data.getTrackParam(trackIndex);
           bool isProp = false;
-          if (mPropTracks && trOrig.getX() < mMinPropR &&
-              mGIDUsedBySVtx.find(trackIndex) == mGIDUsedBySVtx.end() &&
-              mGIDUsedByStr.find(trackIndex) == mGIDUsedByStr.end()) { // Do not propagate track assoc. to V0s and str. tracking
+          if (cache.hasPropagation) {
+            isProp = cache.isProp;
+            if (isProp) {
+              addToTracksTable(tracksCursor, tracksCovCursor, cache.trackPar, collisionID, aod::track::Track);
+            }
+          } else if (needsPropagationToPV(trackIndex, trOrig)) {
             auto trackPar(trOrig);
             isProp = propagateTrackToPV(trackPar, data, collisionID);
             if (isProp) {
@@ -553,6 +557,84 @@ void AODProducerWorkflowDPL::fillTrackTablesPerCollision(int collisionID,
   }
 }
 
+bool AODProducerWorkflowDPL::isBarrelTrackSource(int src) const
+{
+  return GIndex::isTrackSource(src) && GIndex::includesSource(src, mInputSources) &&
+         src != GIndex::Source::MFT && src != GIndex::Source::MCH && src != GIndex::Source::MFTMCH && src != GIndex::Source::MCHMID;
+}
+
+bool AODProducerWorkflowDPL::needsPropagationToPV(GIndex trackIndex, const o2::track::TrackParCov& trOrig) const
+{
+  return mPropTracks && trOrig.getX() < mMinPropR &&
+         mGIDUsedBySVtx.find(trackIndex) == mGIDUsedBySVtx.end() &&
+         mGIDUsedByStr.find(trackIndex) == mGIDUsedByStr.end(); // Do not propagate track assoc. to V0s and str. tracking
+}
+
+void AODProducerWorkflowDPL::prepareBarrelTracks(const gsl::span<const o2::dataformats::VtxTrackRef>& trackRefs, const gsl::span<const GIndex>& GIndices,
+                                                 const o2::globaltracking::RecoContainer& data, const std::map<uint64_t, int>& bcsMap)
+{
+  // The track tables are filled serially by fillTrackTablesPerCollision, which defines the row order, the table indices and the
+  // sequence of random numbers used for the QA sampling. Here only the expensive per-track parts (extra info with the extrapolation
+  // to the calorimeters and the propagation to the vertex) are computed, in parallel over collisions. An ambiguous track is
+  // precomputed for its first occurrence in the filling order only; other occurrences, if needed at all, are processed on the fly.
+  mBarrelTrackCache.clear();
+  mBarrelTrackCache.resize(GIndices.size());
+  std::vector<char> toProcess(GIndices.size(), 0);
+  std::unordered_set<GIndex> ambiguousSeen;
+  int nRefs = trackRefs.size();
+  for (int iref = -1; iref < nRefs - 1; iref++) { // same order as the filling: unassigned tracks (last slot) first
+    const auto& trackRef = trackRefs[iref < 0 ? nRefs - 1 : iref];
+    for (int src = GIndex::NSources; src--;) {
+      if (!isBarrelTrackSource(src)) {
+        continue;
+      }
+      int start = trackRef.getFirstEntryOfSource(src);
+      int end = start + trackRef.getEntriesOfSource(src);
+      for (int ti = start; ti < end; ti++) {
+        toProcess[ti] = !GIndices[ti].isAmbiguous() || ambiguousSeen.insert(GIndices[ti]).second;
+      }
+    }
+  }
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int iref = 0; iref < nRefs; iref++) {
+    int collisionID = iref == nRefs - 1 ? -1 : iref;
+    std::uint64_t collisionBC = std::uint64_t(-1);
+    if (collisionID >= 0) {
+      collisionBC = relativeTime_to_GlobalBC(data.getPrimaryVertex(collisionID).getTimeStamp().getTimeStamp() * 1E3); // mus to ns
+    }
+    const auto& trackRef = trackRefs[iref];
+    for (int src = GIndex::NSources; src--;) {
+      if (!isBarrelTrackSource(src)) {
+        continue;
+      }
+      int start = trackRef.getFirstEntryOfSource(src);
+      int end = start + trackRef.getEntriesOfSource(src);
+      for (int ti = start; ti < end; ti++) {
+        if (!toProcess[ti]) {
+          continue;
+        }
+        const auto& trackIndex = GIndices[ti];
+        auto& cache = mBarrelTrackCache[ti];
+        cache.extraInfo = processBarrelTrack(collisionID, collisionBC, trackIndex, data, bcsMap);
+        cache.hasExtraInfo = true;
+        // TPC-only tracks which are going to be thinned are propagated on demand, in case they are kept for the QA table
+        if (mThinTracks && src == GIndex::Source::TPC && mGIDUsedBySVtx.find(trackIndex) == mGIDUsedBySVtx.end() && mGIDUsedByStr.find(trackIndex) == mGIDUsedByStr.end()) {
+          continue;
+        }
+        const auto& trOrig = data.getTrackParam(trackIndex);
+        if (needsPropagationToPV(trackIndex, trOrig)) {
+          cache.trackPar = trOrig;
+          cache.isProp = propagateTrackToPV(cache.trackPar, data, collisionID);
+          cache.hasPropagation = true;
+        }
+      }
+    }
+  }
+}
+
 void AODProducerWorkflowDPL::fillIndexTablesPerCollision(const o2::dataformats::VtxTrackRef& trackRef, const gsl::span<const GIndex>& GIndices, const o2::globaltracking::RecoContainer& data)
 {
   const auto& mchmidMatches = data.getMCHMIDMatches();
@@ -1873,72 +1955,6 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
     tfNumber = mTFNumber;
   }
 
-  std::vector<float> aAmplitudes;
-  std::vector<uint8_t> aChannels;
-  fv0aCursor.reserve(fv0RecPoints.size());
-  for (auto& fv0RecPoint : fv0RecPoints) {
-    aAmplitudes.clear();
-    aChannels.clear();
-    const auto channelData = fv0RecPoint.getBunchChannelData(fv0ChData);
-    for (auto& channel : channelData) {
-      if (channel.charge > 0) {
-        aAmplitudes.push_back(truncateFloatFraction(channel.charge, mV0Amplitude));
-        aChannels.push_back(channel.channel);
-      }
-    }
-    uint64_t bc = fv0RecPoint.getInteractionRecord().toLong();
-    auto item = bcsMap.find(bc);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
-      LOG(fatal) << "Error: could not find a corresponding BC ID for a FV0 rec. point; BC = " << bc;
-    }
-    fv0aCursor(bcID,
-               aAmplitudes,
-               aChannels,
-               truncateFloatFraction(fv0RecPoint.getCollisionGlobalMeanTime() * 1E-3, mV0Time), // ps to ns
-               fv0RecPoint.getTrigger().getTriggersignals());
-  }
-
-  std::vector<float> zdcEnergy, zdcAmplitudes, zdcTime;
-  std::vector<uint8_t> zdcChannelsE, zdcChannelsT;
-  zdcCursor.reserve(zdcBCRecData.size());
-  for (auto zdcRecData : zdcBCRecData) {
-    uint64_t bc = zdcRecData.ir.toLong();
-    auto item = bcsMap.find(bc);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
-      LOG(fatal) << "Error: could not find a corresponding BC ID for a ZDC rec. point; BC = " << bc;
-    }
-    int fe, ne, ft, nt, fi, ni;
-    zdcRecData.getRef(fe, ne, ft, nt, fi, ni);
-    zdcEnergy.clear();
-    zdcChannelsE.clear();
-    zdcAmplitudes.clear();
-    zdcTime.clear();
-    zdcChannelsT.clear();
-    for (int ie = 0; ie < ne; ie++) {
-      auto& zdcEnergyData = zdcEnergies[fe + ie];
-      zdcEnergy.emplace_back(zdcEnergyData.energy());
-      zdcChannelsE.emplace_back(zdcEnergyData.ch());
-    }
-    for (int it = 0; it < nt; it++) {
-      auto& tdc = zdcTDCData[ft + it];
-      zdcAmplitudes.emplace_back(tdc.amplitude());
-      zdcTime.emplace_back(tdc.value());
-      zdcChannelsT.emplace_back(o2::zdc::TDCSignal[tdc.ch()]);
-    }
-    zdcCursor(bcID,
-              zdcEnergy,
-              zdcChannelsE,
-              zdcAmplitudes,
-              zdcTime,
-              zdcChannelsT);
-  }
-
   // keep track event/source id for each mc-collision
   // using map and not unordered_map to ensure
   // correct ordering when iterating over container elements
@@ -2001,83 +2017,172 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
   std::sort(mcColToEvSrc.begin(), mcColToEvSrc.end(),
             [](const std::vector<int>& left, const std::vector<int>& right) { return (left[0] < right[0]); });
 
-  // vector of FDD amplitudes
-  int16_t aFDDAmplitudesA[8] = {0u};
-  int16_t aFDDAmplitudesC[8] = {0u};
-  // filling FDD table
-  fddCursor.reserve(fddRecPoints.size());
-  for (const auto& fddRecPoint : fddRecPoints) {
-    for (int i = 0; i < 8; i++) {
-      aFDDAmplitudesA[i] = 0;
-      aFDDAmplitudesC[i] = 0;
+  // the FIT and ZDC tables are independent of each other: fill them concurrently, each into its own table builder
+#ifdef WITH_OPENMP
+#pragma omp parallel sections num_threads(mNThreads)
+#endif
+  {
+#ifdef WITH_OPENMP
+#pragma omp section
+#endif
+    {
+      std::vector<float> aAmplitudes;
+      std::vector<uint8_t> aChannels;
+      fv0aCursor.reserve(fv0RecPoints.size());
+      for (auto& fv0RecPoint : fv0RecPoints) {
+        aAmplitudes.clear();
+        aChannels.clear();
+        const auto channelData = fv0RecPoint.getBunchChannelData(fv0ChData);
+        for (auto& channel : channelData) {
+          if (channel.charge > 0) {
+            aAmplitudes.push_back(truncateFloatFraction(channel.charge, mV0Amplitude));
+            aChannels.push_back(channel.channel);
+          }
+        }
+        uint64_t bc = fv0RecPoint.getInteractionRecord().toLong();
+        auto item = bcsMap.find(bc);
+        int bcID = -1;
+        if (item != bcsMap.end()) {
+          bcID = item->second;
+        } else {
+          LOG(fatal) << "Error: could not find a corresponding BC ID for a FV0 rec. point; BC = " << bc;
+        }
+        fv0aCursor(bcID,
+                   aAmplitudes,
+                   aChannels,
+                   truncateFloatFraction(fv0RecPoint.getCollisionGlobalMeanTime() * 1E-3, mV0Time), // ps to ns
+                   fv0RecPoint.getTrigger().getTriggersignals());
+      }
     }
-
-    const auto channelData = fddRecPoint.getBunchChannelData(fddChData);
-    for (const auto& channel : channelData) {
-      if (channel.mPMNumber < 8) {
-        aFDDAmplitudesC[channel.mPMNumber] = channel.mChargeADC; // amplitude
-      } else {
-        aFDDAmplitudesA[channel.mPMNumber - 8] = channel.mChargeADC; // amplitude
+#ifdef WITH_OPENMP
+#pragma omp section
+#endif
+    {
+      std::vector<float> zdcEnergy, zdcAmplitudes, zdcTime;
+      std::vector<uint8_t> zdcChannelsE, zdcChannelsT;
+      zdcCursor.reserve(zdcBCRecData.size());
+      for (auto zdcRecData : zdcBCRecData) {
+        uint64_t bc = zdcRecData.ir.toLong();
+        auto item = bcsMap.find(bc);
+        int bcID = -1;
+        if (item != bcsMap.end()) {
+          bcID = item->second;
+        } else {
+          LOG(fatal) << "Error: could not find a corresponding BC ID for a ZDC rec. point; BC = " << bc;
+        }
+        int fe, ne, ft, nt, fi, ni;
+        zdcRecData.getRef(fe, ne, ft, nt, fi, ni);
+        zdcEnergy.clear();
+        zdcChannelsE.clear();
+        zdcAmplitudes.clear();
+        zdcTime.clear();
+        zdcChannelsT.clear();
+        for (int ie = 0; ie < ne; ie++) {
+          auto& zdcEnergyData = zdcEnergies[fe + ie];
+          zdcEnergy.emplace_back(zdcEnergyData.energy());
+          zdcChannelsE.emplace_back(zdcEnergyData.ch());
+        }
+        for (int it = 0; it < nt; it++) {
+          auto& tdc = zdcTDCData[ft + it];
+          zdcAmplitudes.emplace_back(tdc.amplitude());
+          zdcTime.emplace_back(tdc.value());
+          zdcChannelsT.emplace_back(o2::zdc::TDCSignal[tdc.ch()]);
+        }
+        zdcCursor(bcID,
+                  zdcEnergy,
+                  zdcChannelsE,
+                  zdcAmplitudes,
+                  zdcTime,
+                  zdcChannelsT);
       }
     }
+#ifdef WITH_OPENMP
+#pragma omp section
+#endif
+    {
+      // vector of FDD amplitudes
+      int16_t aFDDAmplitudesA[8] = {0u};
+      int16_t aFDDAmplitudesC[8] = {0u};
+      // filling FDD table
+      fddCursor.reserve(fddRecPoints.size());
+      for (const auto& fddRecPoint : fddRecPoints) {
+        for (int i = 0; i < 8; i++) {
+          aFDDAmplitudesA[i] = 0;
+          aFDDAmplitudesC[i] = 0;
+        }
 
-    uint64_t globalBC = fddRecPoint.getInteractionRecord().toLong();
-    uint64_t bc = globalBC;
-    auto item = bcsMap.find(bc);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
-      LOG(fatal) << "Error: could not find a corresponding BC ID for a FDD rec. point; BC = " << bc;
-    }
-    fddCursor(bcID,
-              aFDDAmplitudesA,
-              aFDDAmplitudesC,
-              truncateFloatFraction(fddRecPoint.getCollisionTimeA() * 1E-3, mFDDTime), // ps to ns
-              truncateFloatFraction(fddRecPoint.getCollisionTimeC() * 1E-3, mFDDTime), // ps to ns
-              fddRecPoint.getTrigger().getTriggersignals());
-  }
+        const auto channelData = fddRecPoint.getBunchChannelData(fddChData);
+        for (const auto& channel : channelData) {
+          if (channel.mPMNumber < 8) {
+            aFDDAmplitudesC[channel.mPMNumber] = channel.mChargeADC; // amplitude
+          } else {
+            aFDDAmplitudesA[channel.mPMNumber - 8] = channel.mChargeADC; // amplitude
+          }
+        }
 
-  // filling FT0 table
-  std::vector<float> aAmplitudesA, aAmplitudesC;
-  std::vector<uint8_t> aChannelsA, aChannelsC;
-  ft0Cursor.reserve(ft0RecPoints.size());
-  for (auto& ft0RecPoint : ft0RecPoints) {
-    aAmplitudesA.clear();
-    aAmplitudesC.clear();
-    aChannelsA.clear();
-    aChannelsC.clear();
-    const auto channelData = ft0RecPoint.getBunchChannelData(ft0ChData);
-    for (auto& channel : channelData) {
-      // TODO: switch to calibrated amplitude
-      if (channel.QTCAmpl > 0) {
-        constexpr int nFT0ChannelsAside = o2::ft0::Geometry::NCellsA * 4;
-        if (channel.ChId < nFT0ChannelsAside) {
-          aChannelsA.push_back(channel.ChId);
-          aAmplitudesA.push_back(truncateFloatFraction(channel.QTCAmpl, mT0Amplitude));
+        uint64_t globalBC = fddRecPoint.getInteractionRecord().toLong();
+        uint64_t bc = globalBC;
+        auto item = bcsMap.find(bc);
+        int bcID = -1;
+        if (item != bcsMap.end()) {
+          bcID = item->second;
         } else {
-          aChannelsC.push_back(channel.ChId - nFT0ChannelsAside);
-          aAmplitudesC.push_back(truncateFloatFraction(channel.QTCAmpl, mT0Amplitude));
+          LOG(fatal) << "Error: could not find a corresponding BC ID for a FDD rec. point; BC = " << bc;
         }
+        fddCursor(bcID,
+                  aFDDAmplitudesA,
+                  aFDDAmplitudesC,
+                  truncateFloatFraction(fddRecPoint.getCollisionTimeA() * 1E-3, mFDDTime), // ps to ns
+                  truncateFloatFraction(fddRecPoint.getCollisionTimeC() * 1E-3, mFDDTime), // ps to ns
+                  fddRecPoint.getTrigger().getTriggersignals());
       }
     }
-    uint64_t globalBC = ft0RecPoint.getInteractionRecord().toLong();
-    uint64_t bc = globalBC;
-    auto item = bcsMap.find(bc);
-    int bcID = -1;
-    if (item != bcsMap.end()) {
-      bcID = item->second;
-    } else {
-      LOG(fatal) << "Error: could not find a corresponding BC ID for a FT0 rec. point; BC = " << bc;
+#ifdef WITH_OPENMP
+#pragma omp section
+#endif
+    {
+      // filling FT0 table
+      std::vector<float> aAmplitudesA, aAmplitudesC;
+      std::vector<uint8_t> aChannelsA, aChannelsC;
+      ft0Cursor.reserve(ft0RecPoints.size());
+      for (auto& ft0RecPoint : ft0RecPoints) {
+        aAmplitudesA.clear();
+        aAmplitudesC.clear();
+        aChannelsA.clear();
+        aChannelsC.clear();
+        const auto channelData = ft0RecPoint.getBunchChannelData(ft0ChData);
+        for (auto& channel : channelData) {
+          // TODO: switch to calibrated amplitude
+          if (channel.QTCAmpl > 0) {
+            constexpr int nFT0ChannelsAside = o2::ft0::Geometry::NCellsA * 4;
+            if (channel.ChId < nFT0ChannelsAside) {
+              aChannelsA.push_back(channel.ChId);
+              aAmplitudesA.push_back(truncateFloatFraction(channel.QTCAmpl, mT0Amplitude));
+            } else {
+              aChannelsC.push_back(channel.ChId - nFT0ChannelsAside);
+              aAmplitudesC.push_back(truncateFloatFraction(channel.QTCAmpl, mT0Amplitude));
+            }
+          }
+        }
+        uint64_t globalBC = ft0RecPoint.getInteractionRecord().toLong();
+        uint64_t bc = globalBC;
+        auto item = bcsMap.find(bc);
+        int bcID = -1;
+        if (item != bcsMap.end()) {
+          bcID = item->second;
+        } else {
+          LOG(fatal) << "Error: could not find a corresponding BC ID for a FT0 rec. point; BC = " << bc;
+        }
+        ft0Cursor(bcID,
+                  aAmplitudesA,
+                  aChannelsA,
+                  aAmplitudesC,
+                  aChannelsC,
+                  truncateFloatFraction(ft0RecPoint.getCollisionTimeA() * 1E-3, mT0Time), // ps to ns
+                  truncateFloatFraction(ft0RecPoint.getCollisionTimeC() * 1E-3, mT0Time), // ps to ns
+                  ft0RecPoint.getTrigger().getTriggersignals());
+      }
     }
-    ft0Cursor(bcID,
-              aAmplitudesA,
-              aChannelsA,
-              aAmplitudesC,
-              aChannelsC,
-              truncateFloatFraction(ft0RecPoint.getCollisionTimeA() * 1E-3, mT0Time), // ps to ns
-              truncateFloatFraction(ft0RecPoint.getCollisionTimeC() * 1E-3, mT0Time), // ps to ns
-              ft0RecPoint.getTrigger().getTriggersignals());
   }
 
   if (mUseMC) {
@@ -2141,6 +2246,10 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
     }
   }
 
+  if (!primVer2TRefs.empty()) {
+    prepareBarrelTracks(primVer2TRefs, primVerGIs, recoData, bcsMap);
+  }
+
   // filling unassigned tracks first
   // so that all unassigned tracks are stored in the beginning of the table together
   auto& trackRef = primVer2TRefs.back(); // references to unassigned tracks are at the end
@@ -2217,56 +2326,74 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
     }
   }
 
-  // filling BC table
-  bcCursor.reserve(bcsMap.size());
-  for (auto& item : bcsMap) {
-    uint64_t bc = item.first;
-    std::pair<uint64_t, uint64_t> masks{0, 0};
-    if (mInputSources[GID::CTP]) {
-      auto bcClassPair = bcToClassMask.find(bc);
-      if (bcClassPair != bcToClassMask.end()) {
-        masks = bcClassPair->second;
+  // BC, BC flags and CPV tables are independent of each other
+#ifdef WITH_OPENMP
+#pragma omp parallel sections num_threads(mNThreads)
+#endif
+  {
+#ifdef WITH_OPENMP
+#pragma omp section
+#endif
+    {
+      // filling BC table
+      bcCursor.reserve(bcsMap.size());
+      for (auto& item : bcsMap) {
+        uint64_t bc = item.first;
+        std::pair<uint64_t, uint64_t> masks{0, 0};
+        if (mInputSources[GID::CTP]) {
+          auto bcClassPair = bcToClassMask.find(bc);
+          if (bcClassPair != bcToClassMask.end()) {
+            masks = bcClassPair->second;
+          }
+        }
+        bcCursor(runNumber,
+                 bc,
+                 masks.first,
+                 masks.second);
       }
     }
-    bcCursor(runNumber,
-             bc,
-             masks.first,
-             masks.second);
-  }
-
-  bcToClassMask.clear();
-
-  // filling BC flags table:
-  auto bcFlags = fillBCFlags(recoData, bcsMap);
-  bcFlagsCursor.reserve(bcFlags.size());
-  for (auto f : bcFlags) {
-    bcFlagsCursor(f);
-  }
-
-  // fill cpvcluster table
-  if (mInputSources[GIndex::CPV]) {
-    float posX, posZ;
-    cpvClustersCursor.reserve(cpvTrigRecs.size());
-    for (auto& cpvEvent : cpvTrigRecs) {
-      uint64_t bc = cpvEvent.getBCData().toLong();
-      auto item = bcsMap.find(bc);
-      int bcID = -1;
-      if (item != bcsMap.end()) {
-        bcID = item->second;
-      } else {
-        LOG(fatal) << "Error: could not find a corresponding BC ID for a CPV Trigger Record; BC = " << bc;
+#ifdef WITH_OPENMP
+#pragma omp section
+#endif
+    {
+      // filling BC flags table:
+      auto bcFlags = fillBCFlags(recoData, bcsMap);
+      bcFlagsCursor.reserve(bcFlags.size());
+      for (auto f : bcFlags) {
+        bcFlagsCursor(f);
       }
-      for (int iClu = cpvEvent.getFirstEntry(); iClu < cpvEvent.getFirstEntry() + cpvEvent.getNumberOfObjects(); iClu++) {
-        auto& clu = cpvClusters[iClu];
-        clu.getLocalPosition(posX, posZ);
-        cpvClustersCursor(bcID,
-                          truncateFloatFraction(posX, mCPVPos),
-                          truncateFloatFraction(posZ, mCPVPos),
-                          truncateFloatFraction(clu.getEnergy(), mCPVAmpl),
-                          clu.getPackedClusterStatus());
+    }
+#ifdef WITH_OPENMP
+#pragma omp section
+#endif
+    {
+      // fill cpvcluster table
+      if (mInputSources[GIndex::CPV]) {
+        float posX, posZ;
+        cpvClustersCursor.reserve(cpvTrigRecs.size());
+        for (auto& cpvEvent : cpvTrigRecs) {
+          uint64_t bc = cpvEvent.getBCData().toLong();
+          auto item = bcsMap.find(bc);
+          int bcID = -1;
+          if (item != bcsMap.end()) {
+            bcID = item->second;
+          } else {
+            LOG(fatal) << "Error: could not find a corresponding BC ID for a CPV Trigger Record; BC = " << bc;
+          }
+          for (int iClu = cpvEvent.getFirstEntry(); iClu < cpvEvent.getFirstEntry() + cpvEvent.getNumberOfObjects(); iClu++) {
+            auto& clu = cpvClusters[iClu];
+            clu.getLocalPosition(posX, posZ);
+            cpvClustersCursor(bcID,
+                              truncateFloatFraction(posX, mCPVPos),
+                              truncateFloatFraction(posZ, mCPVPos),
+                              truncateFloatFraction(clu.getEnergy(), mCPVAmpl),
+                              clu.getPackedClusterStatus());
+          }
+        }
       }
     }
   }
+  bcToClassMask.clear();
 
   if (mUseMC) {
     TStopwatch timer;
@@ -2320,6 +2447,7 @@ void AODProducerWorkflowDPL::run(ProcessingContext& pc)
 
   mGIDUsedBySVtx.clear();
   mGIDUsedByStr.clear();
+  mBarrelTrackCache.clear();
 
   originCursor(tfNumber);
 
@@ -12,6 +12,12 @@
 /// @file   CTFReaderSpec.cxx
 
 #include <vector>
+#include <algorithm>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstring>
 #include <TFile.h>
 #include <TTree.h>
 
@@ -81,12 +87,27 @@ class CTFReaderSpec : public o2::framework::Task
   void run(o2::framework::ProcessingContext& pc) final;
 
  private:
+  /// CTF tree entry deserialised by the read-ahead thread before it is requested by the processing
+  struct CTFEntry {
+    long treeEntry = -1;
+    CTFHeader header;
+    std::array<std::vector<o2::ctf::BufferType>, DetID::nDetectors> buffers;
+    std::string error; // exception caught by the read-ahead thread, rethrown on the processing thread
+  };
+
   void openCTFFile(const std::string& flname);
   bool processTF(ProcessingContext& pc);
   void checkTreeEntries();
   void stopReader();
+  void startReadAhead();
+  void stopReadAhead();
+  void readAheadLoop(long firstCTFCounter);
+  std::unique_ptr<CTFEntry> getReadAheadEntry();
+  void readCTFEntry(CTFEntry& entry) const;
   template <typename C>
-  void processDetector(DetID det, const CTFHeader& ctfHeader, ProcessingContext& pc) const;
+  void readDetector(DetID det, CTFEntry& entry) const;
+  template <typename C>
+  void processDetector(DetID det, const CTFHeader& ctfHeader, ProcessingContext& pc, const CTFEntry* entry) const;
   void setMessageHeader(ProcessingContext& pc, const CTFHeader& ctfHeader, const std::string& lbl, unsigned subspec) const; // keep just for the reference
   void tryToFixCTFHeader(CTFHeader& ctfHeader) const;
   CTFReaderInp mInput{};
@@ -104,8 +125,16 @@ class CTFReaderSpec : public o2::framework::Task
   long mTotalWaitTime = 0;
   long mLastSendTime = 0L;
   long mCurrTreeEntry = 0L;
+  long mNTreeEntries = 0L;
   long mImposeRunStartMS = 0L;
-  size_t mSelIDEntry = 0; // next CTFID to select from the mInput.ctfIDs (if non-empty)
+  int mReadAhead = 0;                                    // number of CTF entries to deserialise ahead in a background thread, 0: none
+  std::thread mReadAheadThread;                          // reads entries of the current tree ahead of their processing
+  std::mutex mReadAheadMutex;                            // protects the read-ahead queue and flags
+  std::condition_variable mReadAheadCond;                // signals changes of the read-ahead queue
+  std::deque<std::unique_ptr<CTFEntry>> mReadAheadQueue; // entries ready for injection, ordered in tree entry
+  bool mReadAheadDone = false;                           // read-ahead thread has no more entries to provide
+  bool mStopReadAhead = false;                           // request to the read-ahead thread to stop
+  size_t mSelIDEntry = 0;                                // next CTFID to select from the mInput.ctfIDs (if non-empty)
   TStopwatch mTimer;
 };
 
@@ -134,6 +163,7 @@ void CTFReaderSpec::stopReader()
   mRunning = false;
   mFileFetcher->stop();
   mFileFetcher.reset();
+  stopReadAhead();
   mCTFTree.reset();
   if (mCTFFile) {
     mCTFFile->Close();
@@ -148,6 +178,7 @@ void CTFReaderSpec::init(InitContext& ic)
   mUseLocalTFCounter = ic.options().get<bool>("local-tf-counter");
   mImposeRunStartMS = ic.options().get<int64_t>("impose-run-start-timstamp");
   mInput.checkTFLimitBeforeReading = ic.options().get<bool>("limit-tf-before-reading");
+  mReadAhead = ic.options().get<int>("ctf-read-ahead");
   mRunning = true;
   mFileFetcher = std::make_unique<o2::utils::FileFetcher>(mInput.inpdata, mInput.tffileRegex, mInput.remoteRegex, mInput.copyCmd);
   mFileFetcher->setMaxFilesInQueue(mInput.maxFileCache);
@@ -178,6 +209,7 @@ void CTFReaderSpec::openCTFFile(const std::string& flname)
     if (mCTFTree->GetEntries() < 1) {
       throw std::runtime_error(fmt::format("CTF tree in {} has 0 entries, skipping", flname));
     }
+    mNTreeEntries = mCTFTree->GetEntries();
   } catch (const std::exception& e) {
     LOG(error) << "Cannot process " << flname << ", reason: " << e.what();
     mCTFTree.reset();
@@ -188,6 +220,135 @@ void CTFReaderSpec::openCTFFile(const std::string& flname)
     }
   }
   mCurrTreeEntry = 0;
+  if (mCTFTree && mReadAhead > 0) {
+    startReadAhead();
+  }
+}
+
+///_______________________________________
+void CTFReaderSpec::startReadAhead()
+{
+  mReadAheadQueue.clear();
+  mReadAheadDone = false;
+  mStopReadAhead = false;
+  mReadAheadThread = std::thread(&CTFReaderSpec::readAheadLoop, this, long(mCTFCounter));
+}
+
+///_______________________________________
+void CTFReaderSpec::stopReadAhead()
+{
+  if (!mReadAheadThread.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mReadAheadMutex);
+    mStopReadAhead = true;
+  }
+  mReadAheadCond.notify_all();
+  mReadAheadThread.join();
+  mReadAheadQueue.clear();
+}
+
+///_______________________________________
+void CTFReaderSpec::readAheadLoop(long firstCTFCounter)
+{
+  // the CTF counter is incremented for every tree entry, including the skipped ones
+  for (long ient = 0; ient < mNTreeEntries; ient++) {
+    {
+      std::unique_lock<std::mutex> lock(mReadAheadMutex);
+      mReadAheadCond.wait(lock, [this]() { return mStopReadAhead || mReadAheadQueue.size() < size_t(mReadAhead); });
+      if (mStopReadAhead) {
+        break;
+      }
+    }
+    if (!mInput.ctfIDs.empty() && std::find(mInput.ctfIDs.begin(), mInput.ctfIDs.end(), firstCTFCounter + ient) == mInput.ctfIDs.end()) {
+      continue; // will be skipped anyway
+    }
+    auto entry = std::make_unique<CTFEntry>();
+    entry->treeEntry = ient;
+    try {
+      readCTFEntry(*entry);
+    } catch (const std::exception& e) {
+      entry->error = e.what();
+    }
+    {
+      std::lock_guard<std::mutex> lock(mReadAheadMutex);
+      mReadAheadQueue.push_back(std::move(entry));
+    }
+    mReadAheadCond.notify_all();
+  }
+  {
+    std::lock_guard<std::mutex> lock(mReadAheadMutex);
+    mReadAheadDone = true;
+  }
+  mReadAheadCond.notify_all();
+}
+
+///_______________________________________
+std::unique_ptr<CTFReaderSpec::CTFEntry> CTFReaderSpec::getReadAheadEntry()
+{
+  std::unique_lock<std::mutex> lock(mReadAheadMutex);
+  auto isReady = [this]() {
+    bool dropped = false;
+    while (!mReadAheadQueue.empty() && mReadAheadQueue.front()->treeEntry < mCurrTreeEntry) { // entries skipped by the selection
+      mReadAheadQueue.pop_front();
+      dropped = true;
+    }
+    if (dropped) {
+      mReadAheadCond.notify_all();
+    }
+    return !mReadAheadQueue.empty() || mReadAheadDone;
+  };
+  if (!isReady()) {
+    long startWait = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::system_clock::now()).time_since_epoch().count();
+    mReadAheadCond.wait(lock, isReady);
+    mTotalWaitTime += std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::system_clock::now()).time_since_epoch().count() - startWait;
+    mNWaits++;
+  }
+  if (mReadAheadQueue.empty() || mReadAheadQueue.front()->treeEntry != mCurrTreeEntry) {
+    throw std::runtime_error(fmt::format("CTF entry {} was not provided by the read-ahead", mCurrTreeEntry));
+  }
+  auto entry = std::move(mReadAheadQueue.front());
+  mReadAheadQueue.pop_front();
+  lock.unlock();
+  mReadAheadCond.notify_all();
+  if (!entry->error.empty()) {
+    throw std::runtime_error(entry->error);
+  }
+  return entry;
+}
+
+///_______________________________________
+void CTFReaderSpec::readCTFEntry(CTFEntry& entry) const
+{
+  if (!readFromTree(*(mCTFTree.get()), "CTFHeader", entry.header, entry.treeEntry)) {
+    throw std::runtime_error("did not find CTFHeader");
+  }
+  readDetector<o2::itsmft::CTF>(DetID::ITS, entry);
+  readDetector<o2::itsmft::CTF>(DetID::MFT, entry);
+  readDetector<o2::emcal::CTF>(DetID::EMC, entry);
+  readDetector<o2::hmpid::CTF>(DetID::HMP, entry);
+  readDetector<o2::phos::CTF>(DetID::PHS, entry);
+  readDetector<o2::tpc::CTF>(DetID::TPC, entry);
+  readDetector<o2::trd::CTF>(DetID::TRD, entry);
+  readDetector<o2::ft0::CTF>(DetID::FT0, entry);
+  readDetector<o2::fv0::CTF>(DetID::FV0, entry);
+  readDetector<o2::fdd::CTF>(DetID::FDD, entry);
+  readDetector<o2::tof::CTF>(DetID::TOF, entry);
+  readDetector<o2::mid::CTF>(DetID::MID, entry);
+  readDetector<o2::mch::CTF>(DetID::MCH, entry);
+  readDetector<o2::cpv::CTF>(DetID::CPV, entry);
+  readDetector<o2::zdc::CTF>(DetID::ZDC, entry);
+  readDetector<o2::ctp::CTF>(DetID::CTP, entry);
+}
+
+///_______________________________________
+template <typename C>
+void CTFReaderSpec::readDetector(DetID det, CTFEntry& entry) const
+{
+  if (mInput.detMask[det] && entry.header.detectors[det]) {
+    C::readFromTree(entry.buffers[det], *(mCTFTree.get()), det.getName(), entry.treeEntry);
+  }
 }
 
 ///_______________________________________
@@ -210,7 +371,7 @@ void CTFReaderSpec::run(ProcessingContext& pc)
         }
       }
       // explict CTF ID selection list or IRFrame was provided and current entry is not selected
-      LOGP(info, "Skipping CTF#{} ({} of {} in {})", mCTFCounter, mCurrTreeEntry, mCTFTree->GetEntries(), mCTFFile->GetName());
+      LOGP(info, "Skipping CTF#{} ({} of {} in {})", mCTFCounter, mCurrTreeEntry, mNTreeEntries, mCTFFile->GetName());
       checkTreeEntries();
       mCTFCounter++;
       continue;
@@ -263,7 +424,11 @@ bool CTFReaderSpec::processTF(ProcessingContext& pc)
 
   static RateLimiter limiter;
   CTFHeader ctfHeader;
-  if (!readFromTree(*(mCTFTree.get()), "CTFHeader", ctfHeader, mCurrTreeEntry)) {
+  std::unique_ptr<CTFEntry> readAheadEntry;
+  if (mReadAhead > 0) {
+    readAheadEntry = getReadAheadEntry();
+    ctfHeader = readAheadEntry->header;
+  } else if (!readFromTree(*(mCTFTree.get()), "CTFHeader", ctfHeader, mCurrTreeEntry)) {
     throw std::runtime_error("did not find CTFHeader");
   }
   if (mImposeRunStartMS > 0) {
@@ -309,22 +474,22 @@ bool CTFReaderSpec::processTF(ProcessingContext& pc)
   // send CTF Header
   pc.outputs().snapshot({"header", mInput.subspec}, ctfHeader);
 
-  processDetector<o2::itsmft::CTF>(DetID::ITS, ctfHeader, pc);
-  processDetector<o2::itsmft::CTF>(DetID::MFT, ctfHeader, pc);
-  processDetector<o2::emcal::CTF>(DetID::EMC, ctfHeader, pc);
-  processDetector<o2::hmpid::CTF>(DetID::HMP, ctfHeader, pc);
-  processDetector<o2::phos::CTF>(DetID::PHS, ctfHeader, pc);
-  processDetector<o2::tpc::CTF>(DetID::TPC, ctfHeader, pc);
-  processDetector<o2::trd::CTF>(DetID::TRD, ctfHeader, pc);
-  processDetector<o2::ft0::CTF>(DetID::FT0, ctfHeader, pc);
-  processDetector<o2::fv0::CTF>(DetID::FV0, ctfHeader, pc);
-  processDetector<o2::fdd::CTF>(DetID::FDD, ctfHeader, pc);
-  processDetector<o2::tof::CTF>(DetID::TOF, ctfHeader, pc);
-  processDetector<o2::mid::CTF>(DetID::MID, ctfHeader, pc);
-  processDetector<o2::mch::CTF>(DetID::MCH, ctfHeader, pc);
-  processDetector<o2::cpv::CTF>(DetID::CPV, ctfHeader, pc);
-  processDetector<o2::zdc::CTF>(DetID::ZDC, ctfHeader, pc);
-  processDetector<o2::ctp::CTF>(DetID::CTP, ctfHeader, pc);
+  processDetector<o2::itsmft::CTF>(DetID::ITS, ctfHeader, pc, readAheadEntry.get());
+  processDetector<o2::itsmft::CTF>(DetID::MFT, ctfHeader, pc, readAheadEntry.get());
+  processDetector<o2::emcal::CTF>(DetID::EMC, ctfHeader, pc, readAheadEntry.get());
+  processDetector<o2::hmpid::CTF>(DetID::HMP, ctfHeader, pc, readAheadEntry.get());
+  processDetector<o2::phos::CTF>(DetID::PHS, ctfHeader, pc, readAheadEntry.get());
+  processDetector<o2::tpc::CTF>(DetID::TPC, ctfHeader, pc, readAheadEntry.get());
+  processDetector<o2::trd::CTF>(DetID::TRD, ctfHeader, pc, readAheadEntry.get());
+  processDetector<o2::ft0::CTF>(DetID::FT0, ctfHeader, pc, readAheadEntry.get());
+  processDetector<o2::fv0::CTF>(DetID::FV0, ctfHeader, pc, readAheadEntry.get());
+  processDetector<o2::fdd::CTF>(DetID::FDD, ctfHeader, pc, readAheadEntry.get());
+  processDetector<o2::tof::CTF>(DetID::TOF, ctfHeader, pc, readAheadEntry.get());
+  processDetector<o2::mid::CTF>(DetID::MID, ctfHeader, pc, readAheadEntry.get());
+  processDetector<o2::mch::CTF>(DetID::MCH, ctfHeader, pc, readAheadEntry.get());
+  processDetector<o2::cpv::CTF>(DetID::CPV, ctfHeader, pc, readAheadEntry.get());
+  processDetector<o2::zdc::CTF>(DetID::ZDC, ctfHeader, pc, readAheadEntry.get());
+  processDetector<o2::ctp::CTF>(DetID::CTP, ctfHeader, pc, readAheadEntry.get());
 
   // send sTF acknowledge message
   if (!mInput.sup0xccdb) {
@@ -334,7 +499,7 @@ bool CTFReaderSpec::processTF(ProcessingContext& pc)
     stfDist.runNumber = uint32_t(ctfHeader.run);
   }
 
-  auto entryStr = fmt::format("({} of {} in {})", mCurrTreeEntry, mCTFTree->GetEntries(), mCTFFile->GetName());
+  auto entryStr = fmt::format("({} of {} in {})", mCurrTreeEntry, mNTreeEntries, mCTFFile->GetName());
   checkTreeEntries();
   mTimer.Stop();
 
@@ -360,7 +525,8 @@ bool CTFReaderSpec::processTF(ProcessingContext& pc)
 void CTFReaderSpec::checkTreeEntries()
 {
   // check if the tree has entries left, if needed, close current tree/file
-  if (++mCurrTreeEntry >= mCTFTree->GetEntries()) { // this file is done, check if there are other files
+  if (++mCurrTreeEntry >= mNTreeEntries) { // this file is done, check if there are other files
+    stopReadAhead();
     mCTFTree.reset();
     mCTFFile->Close();
     mCTFFile.reset();
@@ -387,13 +553,18 @@ void CTFReaderSpec::setMessageHeader(ProcessingContext& pc, const CTFHeader& ctf
 
 ///_______________________________________
 template <typename C>
-void CTFReaderSpec::processDetector(DetID det, const CTFHeader& ctfHeader, ProcessingContext& pc) const
+void CTFReaderSpec::processDetector(DetID det, const CTFHeader& ctfHeader, ProcessingContext& pc, const CTFEntry* entry) const
 {
   if (mInput.detMask[det]) {
     const auto lbl = det.getName();
-    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({lbl, mInput.subspec}, ctfHeader.detectors[det] ? sizeof(C) : 0);
+    size_t sz = ctfHeader.detectors[det] ? (entry ? entry->buffers[det].size() : sizeof(C)) : 0;
+    auto& bufVec = pc.outputs().make<std::vector<o2::ctf::BufferType>>({lbl, mInput.subspec}, sz);
     if (ctfHeader.detectors[det]) {
-      C::readFromTree(bufVec, *(mCTFTree.get()), lbl, mCurrTreeEntry);
+      if (entry) { // already deserialised by the read-ahead thread, the flat CTF image can be copied as is
+        std::memcpy(bufVec.data(), entry->buffers[det].data(), sz);
+      } else {
+        C::readFromTree(bufVec, *(mCTFTree.get()), lbl, mCurrTreeEntry);
+      }
     } else if (!mInput.allowMissingDetectors) {
       throw std::runtime_error(fmt::format("Requested detector {} is missing in the CTF", lbl));
     }
@@ -474,6 +645,7 @@ DataProcessorSpec getCTFReaderSpec(const CTFReaderInp& inp)
   options.emplace_back(ConfigParamSpec{"local-tf-counter", VariantType::Bool, false, {"reassign header.tfCounter from local TF counter"}});
   options.emplace_back(ConfigParamSpec{"fetch-failure-threshold", VariantType::Float, 0.f, {"Fail if too many failures( >0: fraction, <0: abs number, 0: no threshold)"}});
   options.emplace_back(ConfigParamSpec{"limit-tf-before-reading", VariantType::Bool, false, {"Check TF limiting before reading new TF, otherwhise before injecting it"}});
+  options.emplace_back(ConfigParamSpec{"ctf-read-ahead", VariantType::Int, 0, {"Number of CTF entries to deserialise ahead in a background thread (0: read on demand)"}});
   if (!inp.metricChannel.empty()) {
     options.emplace_back(ConfigParamSpec{"channel-config", VariantType::String, inp.metricChannel, {"Out-of-band channel config for TF throttling"}});
   }
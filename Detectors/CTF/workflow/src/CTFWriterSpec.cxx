@@ -16,6 +16,7 @@
 #include "Framework/ConfigParamRegistry.h"
 #include "Framework/InputSpec.h"
 #include "Framework/RawDeviceService.h"
+#include "Framework/CallbackService.h"
 #include "Framework/CommonServices.h"
 #include "Framework/DataTakingContext.h"
 #include "Framework/TimingInfo.h"
@@ -63,6 +64,13 @@
 #include <unistd.h>
 #include <regex>
 #include <numeric>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cassert>
+#include <TROOT.h>
 
 using namespace o2::framework;
 
@@ -91,6 +99,12 @@ size_t appendToTree(TTree& tree, const std::string brname, T& ptr)
   return s;
 }
 
+template <typename C>
+size_t appendImageToTree(TTree& tree, o2::detectors::DetID det, const std::vector<o2::ctf::BufferType>& buffer)
+{
+  return buffer.empty() ? 0 : C::getImage(buffer.data()).appendToTree(tree, det.getName());
+}
+
 using DetID = o2::detectors::DetID;
 using FTrans = o2::rans::DenseHistogram<int32_t>;
 
@@ -107,6 +121,12 @@ class CTFWriterSpec : public o2::framework::Task
   bool isPresent(DetID id) const { return mDets[id]; }
 
  private:
+  /// CTF whose flat detector images are kept until the write-behind I/O thread appends them to the tree
+  struct PendingCTF {
+    CTFHeader header;
+    std::array<std::vector<o2::ctf::BufferType>, DetID::nDetectors> buffers;
+  };
+
   void updateTimeDependentParams(ProcessingContext& pc);
   template <typename C>
   size_t processDet(o2::framework::ProcessingContext& pc, DetID det, CTFHeader& header, TTree* tree);
@@ -119,7 +139,13 @@ class CTFWriterSpec : public o2::framework::Task
   size_t getAvailableDiskSpace(const std::string& path, int level);
   void createLockFile(int level);
   void removeLockFile();
+  static void releaseLockFile(int lockFD, const std::string& lockFileName);
   void finalize();
+  void writePendingCTF(const PendingCTF& ctf, TTree& tree) const;
+  void runIO(std::function<void()>&& task);
+  void ioLoop();
+  void startIOThread();
+  void stopIOThread();
 
   DetID::mask_t mDets; // detectors
   bool mFinalized = false;
@@ -151,6 +177,9 @@ class CTFWriterSpec : public o2::framework::Task
   int mMaxCTFPerFile = 0;          // max CTFs per files to store
   int mRejRate = 0;                // CTF rejection rule (>0: percentage to reject randomly, <0: reject if timeslice%|value|!=0)
   int mCTFFileCompression = 0;     // CTF file compression level (if >= 0)
+  int mWriteBehind = 0;            // if > 0, max number of I/O tasks queued for the write-behind thread
+  int mNIOWaits = 0;               // number of times the processing was blocked by the full write-behind queue
+  long mIOWaitTime = 0;            // total time (in us) the processing was blocked by the full write-behind queue
   bool mFillMD5 = false;
   std::vector<uint32_t> mTFOrbits{}; // 1st orbits of TF accumulated in current file
   o2::framework::DataTakingContext mDataTakingContext{};
@@ -171,6 +200,16 @@ class CTFWriterSpec : public o2::framework::Task
   std::unique_ptr<TFile> mCTFFileOut;
   std::unique_ptr<TTree> mCTFTreeOut;
 
+  // write-behind: the tree filling (and hence basket compression), file closing and renaming are done by the
+  // I/O thread, executing the queued tasks in order
+  std::unique_ptr<PendingCTF> mPendingCTF;
+  std::thread mIOThread;
+  std::mutex mIOMutex;
+  std::condition_variable mIOCond;
+  std::deque<std::function<void()>> mIOTasks;
+  std::string mIOError{};
+  bool mStopIO = false;
+
   std::unique_ptr<TFile> mDictFileOut; // file to store dictionary
   std::unique_ptr<TTree> mDictTreeOut; // tree to store dictionary
 
@@ -268,6 +307,18 @@ void CTFWriterSpec::init(InitContext& ic)
   mChkSize = std::max(size_t(mMinSize * 1.1), mMaxSize);
   o2::utils::createDirectoriesIfAbsent(LOCKFileDir);
 
+  mWriteBehind = ic.options().get<int>("write-behind");
+  if (mWriteCTF && mWriteBehind > 0) {
+    LOGP(info, "CTF trees will be filled and files closed by the write-behind thread, up to {} I/O tasks can be queued", mWriteBehind);
+    ROOT::EnableThreadSafety();
+    startIOThread();
+  }
+  // the I/O thread is stopped by finalize() on stop, restart it (and rearm the finalization) if the device is started again
+  ic.services().get<CallbackService>().set<CallbackService::Id::Start>([this]() {
+    mFinalized = false;
+    startIOThread();
+  });
+
   if (mCreateDict) { // make sure that there is no local dictonary
     std::string dictFileName = fmt::format("{}{}.root", mDictDir, o2::base::NameConf::CTFDICT);
     if (std::filesystem::exists(dictFileName)) {
@@ -314,7 +365,12 @@ size_t CTFWriterSpec::processDet(o2::framework::ProcessingContext& pc, DetID det
     const auto ctfImage = C::getImage(bdata);
     ctfImage.print(o2::utils::Str::concat_string(det.getName(), ": "), mVerbosity);
     if (mWriteCTF && !mRejectCurrentTF) {
-      sz = ctfImage.appendToTree(*tree, det.getName());
+      if (mPendingCTF) { // keep the flat image, the tree is filled by the write-behind thread
+        mPendingCTF->buffers[det].assign(bdata, bdata + ctfBuffer.size());
+        sz = ctfBuffer.size();
+      } else {
+        sz = ctfImage.appendToTree(*tree, det.getName());
+      }
       header.detectors.set(det);
     } else {
       sz = ctfBuffer.size();
@@ -459,6 +515,7 @@ void CTFWriterSpec::run(ProcessingContext& pc)
         if (nwaitCycles) {
           if (mWaitDiskFullMax > 0 && totalWait > mWaitDiskFullMax) {
             closeTFTreeAndFile(); // try to save whatever we have
+            stopIOThread();
             LOGP(fatal, "Disk has {} MB available out of {} MB after waiting for {} ms", si.available / MB, si.capacity / MB, mWaitDiskFullMax);
           }
           if (nwaitCycles < showFirstN + 1 || (prsecaleWarnings && (nwaitCycles % prsecaleWarnings) == 0)) {
@@ -474,6 +531,9 @@ void CTFWriterSpec::run(ProcessingContext& pc)
       break;
     }
   }
+  if (mWriteCTF && !mRejectCurrentTF && mIOThread.joinable()) {
+    mPendingCTF = std::make_unique<PendingCTF>();
+  }
   // create header
   CTFHeader header{mTimingInfo.runNumber, mTimingInfo.creation, mTimingInfo.firstTForbit, mTimingInfo.tfCounter};
   size_t szCTF = 0;
@@ -503,10 +563,20 @@ void CTFWriterSpec::run(ProcessingContext& pc)
   mTimer.Stop();
 
   if (mWriteCTF && !mRejectCurrentTF) {
-    szCTF += appendToTree(*mCTFTreeOut.get(), "CTFHeader", header);
     size_t prevSizeMB = mAccCTFSize / (1 << 20);
+    if (mPendingCTF) {
+      szCTF += sizeof(CTFHeader);
+      mPendingCTF->header = header;
+      runIO([this, ctf = std::shared_ptr<PendingCTF>(std::move(mPendingCTF)), tree = mCTFTreeOut.get(), nEntries = mNAccCTF + 1]() {
+        writePendingCTF(*ctf, *tree);
+        tree->SetEntries(nEntries);
+      });
+      ++mNAccCTF;
+    } else {
+      szCTF += appendToTree(*mCTFTreeOut.get(), "CTFHeader", header);
+      mCTFTreeOut->SetEntries(++mNAccCTF);
+    }
     mAccCTFSize += szCTF;
-    mCTFTreeOut->SetEntries(++mNAccCTF);
     mTFOrbits.push_back(mTimingInfo.firstTForbit);
     LOG(info) << "TF#" << mNCTF << ": wrote CTF{" << header << "} of size " << szCTF << " to " << mCurrentCTFFileNameFull << " in " << mTimer.CpuTime() - cput << " s";
     if (mNAccCTF > 1) {
@@ -523,7 +593,7 @@ void CTFWriterSpec::run(ProcessingContext& pc)
     if (mAccCTFSize >= mMinSize || (mMaxCTFPerFile > 0 && mNAccCTF >= mMaxCTFPerFile)) {
       closeTFTreeAndFile();
     } else if ((mCTFAutoSave > 0 && mNAccCTF % mCTFAutoSave == 0) || (mCTFAutoSave < 0 && int(prevSizeMB / (-mCTFAutoSave)) != size_t(mAccCTFSize / (1 << 20)) / (-mCTFAutoSave))) {
-      mCTFTreeOut->AutoSave("override");
+      runIO([tree = mCTFTreeOut.get()]() { tree->AutoSave("override"); });
     }
   } else {
     LOG(info) << "TF#" << mNCTF << " {" << header << "} CTF writing is disabled, size was " << szCTF << " bytes";
@@ -550,6 +620,10 @@ void CTFWriterSpec::finalize()
   if (mWriteCTF) {
     closeTFTreeAndFile();
   }
+  stopIOThread();
+  if (mNIOWaits) {
+    LOGP(info, "CTF writing was blocked by the full write-behind queue for {:.3f} s in {} waits", 1e-6 * mIOWaitTime, mNIOWaits);
+  }
   LOGF(info, "CTF writing total timing: Cpu: %.3e Real: %.3e s in %d slots",
        mTimer.CpuTime(), mTimer.RealTime(), mTimer.Counter() - 1);
   mFinalized = true;
@@ -611,49 +685,157 @@ void CTFWriterSpec::prepareTFTreeAndFile()
 void CTFWriterSpec::closeTFTreeAndFile()
 {
   if (mCTFTreeOut) {
-    try {
-      mCTFFileOut->cd();
-      mCTFTreeOut->Write();
-      mCTFTreeOut.reset();
-      mCTFFileOut->Close();
-      mCTFFileOut.reset();
-      // write CTF file metaFile data
-      auto actualFileName = TMPFileEnding.empty() ? mCurrentCTFFileNameFull : o2::utils::Str::concat_string(mCurrentCTFFileNameFull, TMPFileEnding);
-      if (mStoreMetaFile) {
-        o2::dataformats::FileMetaData ctfMetaData;
-        if (!ctfMetaData.fillFileData(actualFileName, mFillMD5, TMPFileEnding)) {
-          throw std::runtime_error("metadata file was requested but not created");
-        }
-        ctfMetaData.setDataTakingContext(mDataTakingContext);
-        ctfMetaData.type = mMetaDataType;
-        ctfMetaData.priority = mFallBackDirUsed ? "low" : "high";
-        ctfMetaData.tfOrbits.swap(mTFOrbits);
-        auto metaFileNameTmp = fmt::format("{}{}.tmp", mCTFMetaFileDir, mCurrentCTFFileName);
-        auto metaFileName = fmt::format("{}{}.done", mCTFMetaFileDir, mCurrentCTFFileName);
-        try {
-          std::ofstream metaFileOut(metaFileNameTmp);
-          metaFileOut << ctfMetaData;
-          metaFileOut.close();
-          if (!TMPFileEnding.empty()) {
-            std::filesystem::rename(actualFileName, mCurrentCTFFileNameFull);
+    // the file state is handed over to the closing task, which may be executed by the write-behind thread while the next file is already filled
+    auto closeFile = [this, fileOut = std::shared_ptr<TFile>(std::move(mCTFFileOut)), treeOut = std::shared_ptr<TTree>(std::move(mCTFTreeOut)),
+                      fileName = mCurrentCTFFileName, fileNameFull = mCurrentCTFFileNameFull, tfOrbits = std::move(mTFOrbits),
+                      dataTakingContext = mDataTakingContext, metaDataType = mMetaDataType, fallBackDirUsed = mFallBackDirUsed,
+                      lockFD = mLockFD, lockFileName = mLockFileName]() mutable {
+      try {
+        fileOut->cd();
+        treeOut->Write();
+        treeOut.reset();
+        fileOut->Close();
+        fileOut.reset();
+        // write CTF file metaFile data
+        auto actualFileName = TMPFileEnding.empty() ? fileNameFull : o2::utils::Str::concat_string(fileNameFull, TMPFileEnding);
+        if (mStoreMetaFile) {
+          o2::dataformats::FileMetaData ctfMetaData;
+          if (!ctfMetaData.fillFileData(actualFileName, mFillMD5, TMPFileEnding)) {
+            throw std::runtime_error("metadata file was requested but not created");
+          }
+          ctfMetaData.setDataTakingContext(dataTakingContext);
+          ctfMetaData.type = metaDataType;
+          ctfMetaData.priority = fallBackDirUsed ? "low" : "high";
+          ctfMetaData.tfOrbits.swap(tfOrbits);
+          auto metaFileNameTmp = fmt::format("{}{}.tmp", mCTFMetaFileDir, fileName);
+          auto metaFileName = fmt::format("{}{}.done", mCTFMetaFileDir, fileName);
+          try {
+            std::ofstream metaFileOut(metaFileNameTmp);
+            metaFileOut << ctfMetaData;
+            metaFileOut.close();
+            if (!TMPFileEnding.empty()) {
+              std::filesystem::rename(actualFileName, fileNameFull);
+            }
+            std::filesystem::rename(metaFileNameTmp, metaFileName);
+          } catch (std::exception const& e) {
+            LOG(error) << "Failed to store CTF meta data file " << metaFileName << ", reason: " << e.what();
           }
-          std::filesystem::rename(metaFileNameTmp, metaFileName);
-        } catch (std::exception const& e) {
-          LOG(error) << "Failed to store CTF meta data file " << metaFileName << ", reason: " << e.what();
+        } else if (!TMPFileEnding.empty()) {
+          std::filesystem::rename(actualFileName, fileNameFull);
         }
-      } else if (!TMPFileEnding.empty()) {
-        std::filesystem::rename(actualFileName, mCurrentCTFFileNameFull);
+      } catch (std::exception const& e) {
+        LOG(error) << "Failed to finalize CTF file " << fileNameFull << ", reason: " << e.what();
       }
-    } catch (std::exception const& e) {
-      LOG(error) << "Failed to finalize CTF file " << mCurrentCTFFileNameFull << ", reason: " << e.what();
-    }
+      releaseLockFile(lockFD, lockFileName);
+    };
+    mLockFD = -1; // the lock is released by the closing task
     mTFOrbits.clear();
     mNAccCTF = 0;
     mAccCTFSize = 0;
-    removeLockFile();
+    runIO(std::move(closeFile));
+  }
+}
+
+//___________________________________________________________________
+void CTFWriterSpec::writePendingCTF(const PendingCTF& ctf, TTree& tree) const
+{
+  appendImageToTree<o2::itsmft::CTF>(tree, DetID::ITS, ctf.buffers[DetID::ITS]);
+  appendImageToTree<o2::tpc::CTF>(tree, DetID::TPC, ctf.buffers[DetID::TPC]);
+  appendImageToTree<o2::trd::CTF>(tree, DetID::TRD, ctf.buffers[DetID::TRD]);
+  appendImageToTree<o2::tof::CTF>(tree, DetID::TOF, ctf.buffers[DetID::TOF]);
+  appendImageToTree<o2::phos::CTF>(tree, DetID::PHS, ctf.buffers[DetID::PHS]);
+  appendImageToTree<o2::cpv::CTF>(tree, DetID::CPV, ctf.buffers[DetID::CPV]);
+  appendImageToTree<o2::emcal::CTF>(tree, DetID::EMC, ctf.buffers[DetID::EMC]);
+  appendImageToTree<o2::hmpid::CTF>(tree, DetID::HMP, ctf.buffers[DetID::HMP]);
+  appendImageToTree<o2::itsmft::CTF>(tree, DetID::MFT, ctf.buffers[DetID::MFT]);
+  appendImageToTree<o2::mch::CTF>(tree, DetID::MCH, ctf.buffers[DetID::MCH]);
+  appendImageToTree<o2::mid::CTF>(tree, DetID::MID, ctf.buffers[DetID::MID]);
+  appendImageToTree<o2::zdc::CTF>(tree, DetID::ZDC, ctf.buffers[DetID::ZDC]);
+  appendImageToTree<o2::ft0::CTF>(tree, DetID::FT0, ctf.buffers[DetID::FT0]);
+  appendImageToTree<o2::fv0::CTF>(tree, DetID::FV0, ctf.buffers[DetID::FV0]);
+  appendImageToTree<o2::fdd::CTF>(tree, DetID::FDD, ctf.buffers[DetID::FDD]);
+  appendImageToTree<o2::ctp::CTF>(tree, DetID::CTP, ctf.buffers[DetID::CTP]);
+  auto header = ctf.header;
+  appendToTree(tree, "CTFHeader", header);
+}
+
+//___________________________________________________________________
+void CTFWriterSpec::runIO(std::function<void()>&& task)
+{
+  // execute the I/O task immediately or, in the write-behind mode, queue it for the I/O thread, blocking if the queue is full
+  if (!mIOThread.joinable()) {
+    task();
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mIOMutex);
+  if (mIOTasks.size() >= size_t(mWriteBehind)) {
+    long startWait = std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::system_clock::now()).time_since_epoch().count();
+    mIOCond.wait(lock, [this]() { return mIOTasks.size() < size_t(mWriteBehind); });
+    mIOWaitTime += std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::system_clock::now()).time_since_epoch().count() - startWait;
+    mNIOWaits++;
+  }
+  if (!mIOError.empty()) {
+    throw std::runtime_error(fmt::format("CTF write-behind failed: {}", mIOError));
+  }
+  mIOTasks.push_back(std::move(task));
+  lock.unlock();
+  mIOCond.notify_all();
+}
+
+//___________________________________________________________________
+void CTFWriterSpec::ioLoop()
+{
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mIOMutex);
+      mIOCond.wait(lock, [this]() { return mStopIO || !mIOTasks.empty(); });
+      if (mIOTasks.empty()) { // stop was requested and everything is written
+        break;
+      }
+      task = std::move(mIOTasks.front());
+    }
+    try {
+      task();
+    } catch (std::exception const& e) {
+      LOG(error) << "CTF write-behind task failed, reason: " << e.what();
+      std::lock_guard<std::mutex> lock(mIOMutex);
+      mIOError = e.what();
+    }
+    {
+      std::lock_guard<std::mutex> lock(mIOMutex);
+      mIOTasks.pop_front(); // the task is kept in the queue while executed to account it in the backpressure
+    }
+    mIOCond.notify_all();
   }
 }
 
+//___________________________________________________________________
+void CTFWriterSpec::startIOThread()
+{
+  if (!mWriteCTF || mWriteBehind < 1 || mIOThread.joinable()) {
+    return;
+  }
+  assert(mIOTasks.empty());
+  mStopIO = false;
+  mIOError.clear();
+  mIOThread = std::thread(&CTFWriterSpec::ioLoop, this);
+}
+
+//___________________________________________________________________
+void CTFWriterSpec::stopIOThread()
+{
+  if (!mIOThread.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mIOMutex);
+    mStopIO = true;
+  }
+  mIOCond.notify_all();
+  mIOThread.join();
+}
+
 //___________________________________________________________________
 void CTFWriterSpec::storeDictionaries()
 {
@@ -729,13 +911,19 @@ void CTFWriterSpec::createLockFile(int level)
 void CTFWriterSpec::removeLockFile()
 {
   // remove CTF lock file
-  if (mLockFD != -1) {
-    if (lockf(mLockFD, F_ULOCK, 0)) {
-      throw std::runtime_error(fmt::format("Error unlocking file {}", mLockFileName));
+  releaseLockFile(mLockFD, mLockFileName);
+  mLockFD = -1;
+}
+
+//___________________________________________________________________
+void CTFWriterSpec::releaseLockFile(int lockFD, const std::string& lockFileName)
+{
+  if (lockFD != -1) {
+    if (lockf(lockFD, F_ULOCK, 0)) {
+      throw std::runtime_error(fmt::format("Error unlocking file {}", lockFileName));
     }
-    mLockFD = -1;
     std::error_code ec;
-    std::filesystem::remove(mLockFileName, ec); // use non-throwing version
+    std::filesystem::remove(lockFileName, ec); // use non-throwing version
   }
 }
 
@@ -817,6 +1005,7 @@ DataProcessorSpec getCTFWriterSpec(DetID::mask_t dets, const std::string& outTyp
             {"max-ctf-per-file", VariantType::Int, 0, {"if > 0, avoid storing more than requested CTFs per file"}},
             {"ctf-rejection", VariantType::Int, 0, {">0: percentage to reject randomly, <0: reject if timeslice%|value|!=0"}},
             {"ctf-file-compression", VariantType::Int, 0, {"if >= 0: impose CTF file compression level"}},
+            {"write-behind", VariantType::Int, 0, {"if > 0: fill CTF trees and close files in a dedicated I/O thread, queueing up to this number of I/O tasks"}},
             {"require-free-disk", VariantType::Float, 0.f, {"pause writing op. if available disk space is below this margin, in bytes if >0, as a fraction of total if <0"}},
             {"wait-for-free-disk", VariantType::Float, 10.f, {"if paused due to the low disk space, recheck after this time (in s)"}},
             {"max-wait-for-free-disk", VariantType::Float, 60.f, {"produce fatal if paused due to the low disk space for more than this amount in s."}},
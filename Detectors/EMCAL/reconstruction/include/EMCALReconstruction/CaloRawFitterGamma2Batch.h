@@ -0,0 +1,150 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef ALICEO2_EMCAL_CALORAWFITTERGAMMA2BATCH_H
+#define ALICEO2_EMCAL_CALORAWFITTERGAMMA2BATCH_H
+
+#include <optional>
+#include <tuple>
+#include <vector>
+#include <Rtypes.h>
+#include <gsl/span>
+#include "DataFormatsEMCAL/Constants.h"
+#include "EMCALReconstruction/Bunch.h"
+#include "EMCALReconstruction/CaloFitResults.h"
+#include "EMCALReconstruction/CaloRawFitter.h"
+#include "EMCALReconstruction/Gamma2BatchKernel.h"
+
+namespace o2
+{
+
+namespace emcal
+{
+
+/// \class CaloRawFitterGamma2Batch
+/// \brief  Raw data fitting: Gamma-2 function, fitting many channels at once
+/// \ingroup EMCALreconstruction
+///
+/// Same fit as CaloRawFitterGamma2, but channels are first collected
+/// (i.e. all channels of a link) with addChannel and then fitted together
+/// with fit(). The Newton iterations run on structure-of-arrays batches
+/// of NLanes channels (see fitGamma2Batch), the results are identical to
+/// the ones of CaloRawFitterGamma2::evaluate for every channel.
+///
+/// Usage:
+/// ~~~{.cxx}
+/// for (auto& chan : decoder.getChannels()) {
+///   fitter.addChannel(chan.getBunches());
+/// }
+/// fitter.fit();
+/// for (std::size_t ichan = 0; ichan < fitter.getNumberOfChannels(); ichan++) {
+///   try {
+///     auto& result = fitter.getFitResults(ichan);
+///     ...
+///   } catch (CaloRawFitter::RawFitterError_t& e) {
+///     ...
+///   }
+/// }
+/// fitter.clear();
+/// ~~~
+class CaloRawFitterGamma2Batch final : public CaloRawFitter
+{
+
+ public:
+  static constexpr int NLanes = 8; ///< Number of channels fitted together
+
+  /// \brief Constructor
+  CaloRawFitterGamma2Batch();
+
+  /// \brief Destructor
+  ~CaloRawFitterGamma2Batch() final = default;
+
+  void setNiterationsMax(int n) { mNiterationsMax = n; }
+  int getNiterationsMax() const { return mNiterationsMax; }
+
+  /// \brief Evaluation Amplitude and TOF of a single channel
+  /// \param bunchvector ALTRO bunches for the current channel
+  /// \throw RawFitterError_t in case the channel could not be fitted
+  /// \return Container with the fit results (amp, time, chi2, ...)
+  ///
+  /// Discards channels added before and not yet cleared.
+  CaloFitResults evaluate(const gsl::span<const Bunch> bunchvector) final;
+
+  /// \brief Add channel to the current batch
+  /// \param bunchvector ALTRO bunches of the channel
+  /// \return Index of the channel in the batch
+  ///
+  /// Pre-fit evaluation of the samples and initial guess are done immediately,
+  /// with the zero suppression and pedestal settings at the time of the call.
+  /// Errors are not thrown but stored, and rethrown by getFitResults.
+  std::size_t addChannel(const gsl::span<const Bunch> bunchvector);
+
+  /// \brief Fit all channels added since the last clear
+  void fit();
+
+  /// \brief Remove all channels from the batch
+  void clear();
+
+  /// \brief Get the number of channels in the batch
+  std::size_t getNumberOfChannels() const { return mChannels.size(); }
+
+  /// \brief Get the fit results of a channel
+  /// \param channel Index of the channel as returned by addChannel
+  /// \return Fit results (amp, time, chi2, ...)
+  /// \throw RawFitterError_t in case the channel could not be fitted
+  const CaloFitResults& getFitResults(std::size_t channel) const;
+
+  /// \brief Get the error of a channel
+  /// \param channel Index of the channel as returned by addChannel
+  /// \return Error raised in the fit, empty in case of success
+  std::optional<RawFitterError_t> getFitError(std::size_t channel) const { return mChannels[channel].mError; }
+
+ private:
+  using Batch = Gamma2Batch<NLanes, constants::EMCAL_MAXTIMEBINS>;
+
+  /// \struct ChannelInfo
+  /// \brief Per-channel information from the pre-fit evaluation
+  struct ChannelInfo {
+    CaloFitResults mResults;                ///< Fit results
+    std::optional<RawFitterError_t> mError; ///< Error of the channel, if any
+    float mAmpEstimate = 0;                 ///< Amplitude estimate from the max. sample
+    float mPedEstimate = 0;                 ///< Pedestal estimate
+    short mMaxADC = 0;                      ///< Max. ADC value
+    short mTimeEstimate = 0;                ///< Time bin of the max. sample
+    int mTimebinOffset = 0;                 ///< Start time of the selected bunch
+    int mNsamples = 0;                      ///< Number of samples in the peak region
+    bool mAboveThreshold = false;           ///< Amplitude estimate above the amplitude cut
+    int mLane = -1;                         ///< Global lane index in the batches, -1 if no fit needed
+  };
+
+  /// \brief Fits the raw signal time distribution
+  /// \param maxTimeBin Time bin of the max. amplitude
+  /// \return the fit parameters: amplitude, time.
+  ///
+  /// Same parabola fit as in CaloRawFitterGamma2, used as initial guess
+  std::tuple<float, float> doParabolaFit(int maxTimeBin) const;
+
+  /// \brief Build fit results from the estimates and the outcome of the peak fit
+  /// \param channel Channel to finalize
+  void finalizeChannel(ChannelInfo& channel);
+
+  int mNiterationsMax = 15;           ///< max number of iterations
+  double mSmearing = 0;               ///< Smearing of the amplitude of channels for which the fit is not used
+  std::vector<ChannelInfo> mChannels; ///<! Channels in the batch
+  std::vector<Batch> mBatches;        ///<! Lanes of the channels to fit
+  std::size_t mNLanesUsed = 0;        ///< Number of lanes filled
+
+  ClassDefNV(CaloRawFitterGamma2Batch, 1);
+}; // End of CaloRawFitterGamma2Batch
+
+} // namespace emcal
+
+} // namespace o2
+#endif
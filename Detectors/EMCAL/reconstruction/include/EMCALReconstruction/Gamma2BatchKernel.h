@@ -0,0 +1,160 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#ifndef ALICEO2_EMCAL_GAMMA2BATCHKERNEL_H
+#define ALICEO2_EMCAL_GAMMA2BATCHKERNEL_H
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+
+namespace o2::emcal
+{
+
+/// \struct Gamma2Batch
+/// \brief Structure-of-arrays container of up to NLanes pulses fitted together by fitGamma2Batch
+/// \ingroup EMCALreconstruction
+///
+/// Samples are stored time bin major, so that the same time bin of all
+/// lanes is contiguous in memory. Lanes not in use must have nSamples = 0.
+/// The container is free of ROOT and detector dependencies and can be used
+/// by any calorimeter reading out pulses with a gamma-2 shape.
+template <int NLanes, int NMaxSamples>
+struct Gamma2Batch {
+  /// \enum Status
+  /// \brief Result of the fit of a single lane
+  enum Status : uint8_t {
+    kEmpty,     ///< Lane not in use
+    kRunning,   ///< Fit not yet finished
+    kConverged, ///< Fit converged
+    kFailed     ///< Singular matrix or max. number of iterations exceeded
+  };
+
+  static constexpr int getNLanes() { return NLanes; }
+  static constexpr int getNMaxSamples() { return NMaxSamples; }
+
+  /// \brief Mark all lanes as unused
+  void reset()
+  {
+    nSamples.fill(0);
+    status.fill(kEmpty);
+  }
+
+  alignas(64) std::array<std::array<double, NLanes>, NMaxSamples> samples{}; ///< Pedestal subtracted samples [time bin][lane]
+  alignas(64) std::array<float, NLanes> amp{};                               ///< Initial guess for the amplitude, fit result after fitGamma2Batch
+  alignas(64) std::array<float, NLanes> time{};                              ///< Initial guess for the time (in time bins), fit result after fitGamma2Batch
+  alignas(64) std::array<float, NLanes> chi2{};                              ///< chi2 of the last iteration
+  std::array<int, NLanes> nSamples{};                                        ///< Number of samples of the lane, 0 for unused lanes
+  std::array<uint8_t, NLanes> status{};                                      ///< Fit status of the lane
+};
+
+/// \brief Fit of all lanes of a batch with the gamma-2 function, iterating with Newton's method
+/// \param batch Lanes to fit, amp and time hold the initial guess
+/// \param tau Shaping time of the pulse in units of time bins
+/// \param maxIterations Number of iterations after which the fit is declared failed
+///
+/// The iterations are those of CaloRawFitterGamma2::doFit_1peak carried out for all lanes at
+/// once: every lane accumulates its sums in the same order and with the same precision as the
+/// scalar fit, so that converged lanes reproduce its results bit by bit. Lanes which
+/// converged or failed are masked and keep their result while the others continue iterating.
+/// The arithmetic on the sums is vectorised over lanes, the exponential is evaluated per lane
+/// with the standard library in order not to change the results.
+template <int NLanes, int NMaxSamples>
+void fitGamma2Batch(Gamma2Batch<NLanes, NMaxSamples>& batch, double tau, int maxIterations)
+{
+  using batch_t = Gamma2Batch<NLanes, NMaxSamples>;
+  int nRunning = 0, maxSamples = 0;
+  for (int lane = 0; lane < NLanes; lane++) {
+    if (batch.nSamples[lane] < 3) {
+      batch.status[lane] = batch.nSamples[lane] ? batch_t::kFailed : batch_t::kEmpty;
+      continue;
+    }
+    batch.status[lane] = batch_t::kRunning;
+    maxSamples = std::max(maxSamples, batch.nSamples[lane]);
+    nRunning++;
+  }
+
+  alignas(64) std::array<double, NLanes> c11, c12, c21, c22, d1, d2;
+  alignas(64) std::array<float, NLanes> chi2;
+  alignas(64) std::array<uint8_t, NLanes> active;
+
+  // the scalar fit recurses as long as it did not converge and throws once called more than maxIterations + 1 times
+  for (int iteration = 0; iteration <= maxIterations && nRunning; iteration++) {
+    c11.fill(0.);
+    c12.fill(0.);
+    c21.fill(0.);
+    c22.fill(0.);
+    d1.fill(0.);
+    d2.fill(0.);
+    chi2.fill(0.f);
+    for (int lane = 0; lane < NLanes; lane++) {
+      active[lane] = batch.status[lane] == batch_t::kRunning;
+    }
+
+    for (int itbin = 0; itbin < maxSamples; itbin++) {
+      const auto& samples = batch.samples[itbin];
+#pragma omp simd
+      for (int lane = 0; lane < NLanes; lane++) {
+        const float ampl = batch.amp[lane];
+        const double ti = (itbin - batch.time[lane]) / tau;
+        const bool use = (active[lane] != 0) & (itbin < batch.nSamples[lane]) & !((ti + 1) < 0);
+        // masked lanes must not contribute, also not through a non-finite exponential
+        const double expo = use ? std::exp(-2 * ti) : 0.;
+        const double g_1i = (ti + 1) * expo;
+        const double g_i = (ti + 1) * g_1i;
+        const double gp_i = 2 * (g_i - g_1i);
+        const double q1_i = (2 * ti + 1) * expo;
+        const double q2_i = g_1i * g_1i * (4 * ti + 1);
+        const double delta = ampl * g_i - samples[lane];
+        c11[lane] += use ? (samples[lane] - ampl * 2 * g_i) * gp_i : 0.;
+        c12[lane] += use ? g_i * g_i : 0.;
+        c21[lane] += use ? samples[lane] * q1_i - ampl * q2_i : 0.;
+        c22[lane] += use ? g_i * g_1i : 0.;
+        d1[lane] += use ? delta * g_i : 0.;
+        d2[lane] += use ? delta * g_1i : 0.;
+        chi2[lane] += use ? delta * delta : 0.;
+      }
+    }
+
+    for (int lane = 0; lane < NLanes; lane++) {
+      if (!active[lane]) {
+        continue;
+      }
+      const double D = c11[lane] * c22[lane] - c12[lane] * c21[lane];
+      if (std::abs(D) < DBL_EPSILON) {
+        batch.status[lane] = batch_t::kFailed;
+        nRunning--;
+        continue;
+      }
+      const double dt = (d1[lane] * c22[lane] - d2[lane] * c12[lane]) / D * tau;
+      const double dA = (d1[lane] * c21[lane] - d2[lane] * c11[lane]) / D;
+      batch.time[lane] += dt;
+      batch.amp[lane] += dA;
+      batch.chi2[lane] = chi2[lane];
+      // written as the negation of the scalar continuation condition, so that NaNs terminate the fit in the same way
+      if (!(std::abs(dA) > 1 || std::abs(dt) > 0.01)) {
+        batch.status[lane] = batch_t::kConverged;
+        nRunning--;
+      }
+    }
+  }
+
+  for (int lane = 0; lane < NLanes; lane++) {
+    if (batch.status[lane] == batch_t::kRunning) {
+      batch.status[lane] = batch_t::kFailed;
+    }
+  }
+}
+
+} // namespace o2::emcal
+
+#endif // ALICEO2_EMCAL_GAMMA2BATCHKERNEL_H
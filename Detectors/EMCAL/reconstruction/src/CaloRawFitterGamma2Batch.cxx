@@ -0,0 +1,194 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file CaloRawFitterGamma2Batch.cxx
+
+#include <cfloat>
+#include <cmath>
+#include <random>
+
+#include "EMCALReconstruction/Bunch.h"
+#include "EMCALReconstruction/CaloFitResults.h"
+#include "DataFormatsEMCAL/Constants.h"
+
+#include "EMCALReconstruction/CaloRawFitterGamma2Batch.h"
+
+using namespace o2::emcal;
+
+CaloRawFitterGamma2Batch::CaloRawFitterGamma2Batch() : CaloRawFitter("Chi Square ( Gamma2 ) batched", "Gamma2Batch")
+{
+  mAlgo = FitAlgorithm::Gamma2;
+  // CaloRawFitterGamma2 draws the smearing from a freshly constructed generator,
+  // hence always applies the same value
+  std::default_random_engine generator;
+  std::uniform_real_distribution<float> distribution(0.0, 1.0);
+  mSmearing = 0.5 - distribution(generator);
+}
+
+CaloFitResults CaloRawFitterGamma2Batch::evaluate(const gsl::span<const Bunch> bunchlist)
+{
+  clear();
+  addChannel(bunchlist);
+  fit();
+  return getFitResults(0);
+}
+
+std::size_t CaloRawFitterGamma2Batch::addChannel(const gsl::span<const Bunch> bunchlist)
+{
+  auto& channel = mChannels.emplace_back();
+  try {
+    auto [nsamples, bunchIndex, ampEstimate,
+          maxADC, timeEstimate, pedEstimate, first, last] = preFitEvaluateSamples(bunchlist, mAmpCut);
+    channel.mAmpEstimate = ampEstimate;
+    channel.mPedEstimate = pedEstimate;
+    channel.mMaxADC = maxADC;
+    channel.mTimeEstimate = timeEstimate;
+    channel.mNsamples = nsamples;
+
+    if (bunchIndex >= 0 && ampEstimate >= mAmpCut) {
+      channel.mAboveThreshold = true;
+      channel.mTimebinOffset = bunchlist[bunchIndex].getStartTime() - (bunchlist[bunchIndex].getBunchLength() - 1);
+      if (nsamples > 2 && maxADC < constants::OVERFLOWCUT) {
+        channel.mLane = mNLanesUsed++;
+        if (mBatches.size() * NLanes < mNLanesUsed) {
+          mBatches.emplace_back();
+        }
+        auto& batch = mBatches[channel.mLane / NLanes];
+        const int lane = channel.mLane % NLanes;
+        if (lane == 0) {
+          batch.reset();
+        }
+        // the peak fit runs over the first nsamples samples, independent of the peak region
+        for (int itbin = 0; itbin < nsamples; itbin++) {
+          batch.samples[itbin][lane] = getReversed(itbin);
+        }
+        batch.nSamples[lane] = nsamples;
+        std::tie(batch.amp[lane], batch.time[lane]) = doParabolaFit(timeEstimate - 1);
+      }
+    }
+  } catch (RawFitterError_t& e) {
+    channel.mError = e;
+  }
+  return mChannels.size() - 1;
+}
+
+void CaloRawFitterGamma2Batch::fit()
+{
+  const std::size_t nBatches = (mNLanesUsed + NLanes - 1) / NLanes;
+  for (std::size_t ibatch = 0; ibatch < nBatches; ibatch++) {
+    fitGamma2Batch(mBatches[ibatch], constants::TAU, mNiterationsMax);
+  }
+  for (auto& channel : mChannels) {
+    finalizeChannel(channel);
+  }
+}
+
+void CaloRawFitterGamma2Batch::clear()
+{
+  mChannels.clear();
+  mNLanesUsed = 0;
+}
+
+const CaloFitResults& CaloRawFitterGamma2Batch::getFitResults(std::size_t channel) const
+{
+  const auto& info = mChannels[channel];
+  if (info.mError) {
+    throw info.mError.value();
+  }
+  return info.mResults;
+}
+
+void CaloRawFitterGamma2Batch::finalizeChannel(ChannelInfo& channel)
+{
+  if (channel.mError) {
+    return;
+  }
+
+  // same steps as in CaloRawFitterGamma2::evaluate
+  float time = 0;
+  float amp = 0;
+  float chi2 = 0;
+  int ndf = 0;
+  bool fitDone = false;
+  float ampEstimate = channel.mAmpEstimate;
+  short timeEstimate = channel.mTimeEstimate;
+
+  if (channel.mAboveThreshold) {
+    time = timeEstimate;
+    amp = ampEstimate;
+
+    if (channel.mLane >= 0) {
+      const auto& batch = mBatches[channel.mLane / NLanes];
+      const int lane = channel.mLane % NLanes;
+      if (batch.status[lane] == Batch::kConverged) {
+        amp = batch.amp[lane];
+        time = batch.time[lane];
+        chi2 = batch.chi2[lane];
+        fitDone = true;
+      } else {
+        // Fit has failed, set values to estimates
+        amp = ampEstimate;
+        time = timeEstimate;
+        chi2 = 1.e9;
+      }
+
+      time += channel.mTimebinOffset;
+      timeEstimate += channel.mTimebinOffset;
+      ndf = channel.mNsamples - 2;
+    }
+  }
+
+  if (fitDone) {
+    float ampAsymm = (amp - ampEstimate) / (amp + ampEstimate);
+    float timeDiff = time - timeEstimate;
+
+    if ((std::abs(ampAsymm) > 0.1) || (std::abs(timeDiff) > 2)) {
+      amp = ampEstimate;
+      time = timeEstimate;
+      fitDone = false;
+    }
+  }
+  if (amp >= mAmpCut) {
+    if (!fitDone) {
+      amp += mSmearing;
+    }
+    time = time * constants::EMCAL_TIMESAMPLE;
+    time -= mL1Phase;
+
+    channel.mResults = CaloFitResults(channel.mMaxADC, channel.mPedEstimate, 0, amp, time, (int)time, chi2, ndf);
+    return;
+  }
+  channel.mError = RawFitterError_t::FIT_ERROR;
+}
+
+std::tuple<float, float> CaloRawFitterGamma2Batch::doParabolaFit(int maxTimeBin) const
+{
+  float amp(0.), time(0.);
+
+  // The equation of parabola is "y = a*x^2 + b*x + c"
+  // We have to find "a", "b", and "c"
+
+  double a = (getReversed(maxTimeBin + 2) + getReversed(maxTimeBin) - 2. * getReversed(maxTimeBin + 1)) / 2.;
+
+  if (std::abs(a) < DBL_EPSILON) {
+    amp = getReversed(maxTimeBin + 1);
+    time = maxTimeBin + 1;
+    return std::make_tuple(amp, time);
+  }
+
+  double b = getReversed(maxTimeBin + 1) - getReversed(maxTimeBin) - a * (2. * maxTimeBin + 1);
+  double c = getReversed(maxTimeBin) - b * maxTimeBin - a * maxTimeBin * maxTimeBin;
+
+  time = -b / 2. / a;
+  amp = a * time * time + b * time + c;
+
+  return std::make_tuple(amp, time);
+}
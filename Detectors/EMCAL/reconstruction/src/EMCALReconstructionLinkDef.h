@@ -24,6 +24,7 @@
 #pragma link C++ class o2::emcal::CaloRawFitter + ;
 #pragma link C++ class o2::emcal::CaloRawFitterStandard + ;
 #pragma link C++ class o2::emcal::CaloRawFitterGamma2 + ;
+#pragma link C++ class o2::emcal::CaloRawFitterGamma2Batch + ;
 #pragma link C++ class o2::emcal::StuDecoder + ;
 #pragma link C++ class o2::emcal::FastORTimeSeries + ;
 #pragma link C++ class o2::emcal::TRUDataHandler + ;
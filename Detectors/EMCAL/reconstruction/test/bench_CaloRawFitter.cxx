@@ -0,0 +1,94 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file bench_CaloRawFitter.cxx
+/// \brief Throughput (channels/s) of the EMCAL raw fitters on simulated gamma-2 pulses
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "DataFormatsEMCAL/Constants.h"
+#include "EMCALReconstruction/Bunch.h"
+#include "EMCALReconstruction/CaloRawFitterStandard.h"
+#include "EMCALReconstruction/CaloRawFitterGamma2.h"
+#include "EMCALReconstruction/CaloRawFitterGamma2Batch.h"
+
+using namespace o2::emcal;
+
+/// Channels of a link: single bunch with a gamma-2 pulse, ALTRO sample order
+std::vector<std::vector<Bunch>> generateChannels(int nChannels)
+{
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<double> ampDist(0., 900.), timeDist(2., 9.);
+  std::normal_distribution<double> noiseDist(0., 1.);
+  const int bunchlength = constants::EMCAL_MAXTIMEBINS;
+  std::vector<std::vector<Bunch>> channels(nChannels);
+  for (auto& channel : channels) {
+    double amp = ampDist(generator), t0 = timeDist(generator);
+    auto& bunch = channel.emplace_back(bunchlength, 20);
+    for (int sample = bunchlength - 1; sample >= 0; sample--) {
+      double x = (sample - t0) / constants::TAU, signal = noiseDist(generator);
+      if (x > -1) {
+        signal += amp * (x + 1) * (x + 1) * std::exp(-2 * x);
+      }
+      bunch.addADC(static_cast<uint16_t>(std::clamp(signal, 0., 1023.)));
+    }
+  }
+  return channels;
+}
+
+template <typename Fitter>
+void BM_CaloRawFitterScalar(benchmark::State& state)
+{
+  auto channels = generateChannels(state.range(0));
+  Fitter fitter;
+  fitter.setAmpCut(3);
+  fitter.setIsZeroSuppressed(true);
+  for (auto _ : state) {
+    for (const auto& channel : channels) {
+      try {
+        benchmark::DoNotOptimize(fitter.evaluate(channel));
+      } catch (CaloRawFitter::RawFitterError_t& e) {
+      }
+    }
+  }
+  state.counters["channels"] = benchmark::Counter(static_cast<double>(channels.size() * state.iterations()), benchmark::Counter::kIsRate);
+}
+
+void BM_CaloRawFitterGamma2Batch(benchmark::State& state)
+{
+  auto channels = generateChannels(state.range(0));
+  CaloRawFitterGamma2Batch fitter;
+  fitter.setAmpCut(3);
+  fitter.setIsZeroSuppressed(true);
+  for (auto _ : state) {
+    fitter.clear();
+    for (const auto& channel : channels) {
+      fitter.addChannel(channel);
+    }
+    fitter.fit();
+    for (std::size_t ichan = 0; ichan < fitter.getNumberOfChannels(); ichan++) {
+      benchmark::DoNotOptimize(fitter.getFitError(ichan));
+    }
+  }
+  state.counters["channels"] = benchmark::Counter(static_cast<double>(channels.size() * state.iterations()), benchmark::Counter::kIsRate);
+}
+
+// number of channels per link
+BENCHMARK_TEMPLATE(BM_CaloRawFitterScalar, CaloRawFitterStandard)->RangeMultiplier(4)->Range(64, 1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_CaloRawFitterScalar, CaloRawFitterGamma2)->RangeMultiplier(4)->Range(64, 1024)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_CaloRawFitterGamma2Batch)->RangeMultiplier(4)->Range(64, 1024)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
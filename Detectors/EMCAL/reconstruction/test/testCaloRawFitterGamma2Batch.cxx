@@ -0,0 +1,113 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#define BOOST_TEST_MODULE Test EMCAL Reconstruction
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <optional>
+#include <random>
+#include <vector>
+#include "DataFormatsEMCAL/Constants.h"
+#include "EMCALReconstruction/Bunch.h"
+#include "EMCALReconstruction/CaloRawFitterGamma2.h"
+#include "EMCALReconstruction/CaloRawFitterGamma2Batch.h"
+
+namespace o2
+{
+
+namespace emcal
+{
+
+/// Single bunch with a gamma-2 pulse on top of a pedestal, samples stored in ALTRO order (latest sample first)
+std::vector<Bunch> generateChannel(std::mt19937& generator)
+{
+  std::uniform_real_distribution<double> ampDist(0., 1100.), timeDist(2., 9.), pedDist(0., 10.);
+  std::normal_distribution<double> noiseDist(0., 1.);
+  const int bunchlength = constants::EMCAL_MAXTIMEBINS;
+  const int starttime = 20;
+  double amp = ampDist(generator), t0 = timeDist(generator), pedestal = pedDist(generator);
+  std::vector<Bunch> bunches;
+  auto& bunch = bunches.emplace_back(bunchlength, starttime);
+  for (int sample = bunchlength - 1; sample >= 0; sample--) {
+    double x = (sample - t0) / constants::TAU, signal = pedestal + noiseDist(generator);
+    if (x > -1) {
+      signal += amp * (x + 1) * (x + 1) * std::exp(-2 * x);
+    }
+    bunch.addADC(static_cast<uint16_t>(std::clamp(signal, 0., 1023.)));
+  }
+  return bunches;
+}
+
+void compareFitters(bool zerosuppressed)
+{
+  std::mt19937 generator(0);
+  std::vector<std::vector<Bunch>> channels(1000);
+  std::generate(channels.begin(), channels.end(), [&generator]() { return generateChannel(generator); });
+
+  CaloRawFitterGamma2 scalarfitter;
+  CaloRawFitterGamma2Batch batchfitter;
+  for (auto* fitter : std::initializer_list<CaloRawFitter*>{&scalarfitter, &batchfitter}) {
+    fitter->setAmpCut(3);
+    fitter->setIsZeroSuppressed(zerosuppressed);
+  }
+  for (const auto& bunches : channels) {
+    batchfitter.addChannel(bunches);
+  }
+  batchfitter.fit();
+  BOOST_REQUIRE_EQUAL(batchfitter.getNumberOfChannels(), channels.size());
+
+  int nfitted = 0;
+  for (std::size_t ichan = 0; ichan < channels.size(); ichan++) {
+    std::optional<CaloFitResults> expected;
+    std::optional<CaloRawFitter::RawFitterError_t> expectedError;
+    try {
+      expected = scalarfitter.evaluate(channels[ichan]);
+    } catch (CaloRawFitter::RawFitterError_t& e) {
+      expectedError = e;
+    }
+    BOOST_CHECK(batchfitter.getFitError(ichan) == expectedError);
+    if (expected) {
+      BOOST_REQUIRE(!batchfitter.getFitError(ichan));
+      const auto& result = batchfitter.getFitResults(ichan);
+      BOOST_CHECK(result == *expected);
+      nfitted += expected->getChi2() > 0 && expected->getChi2() < 1.e9;
+    }
+  }
+  // make sure the peak fit was exercised
+  BOOST_CHECK_GT(nfitted, 100);
+
+  // single channel interface, discards the batch
+  for (std::size_t ichan = 0; ichan < 10; ichan++) {
+    try {
+      auto expected = scalarfitter.evaluate(channels[ichan]);
+      BOOST_CHECK(batchfitter.evaluate(channels[ichan]) == expected);
+    } catch (CaloRawFitter::RawFitterError_t& e) {
+      BOOST_CHECK_THROW(batchfitter.evaluate(channels[ichan]), CaloRawFitter::RawFitterError_t);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CaloRawFitterGamma2Batch_ZeroSuppressed)
+{
+  compareFitters(true);
+}
+
+BOOST_AUTO_TEST_CASE(CaloRawFitterGamma2Batch_Pedestal)
+{
+  compareFitters(false);
+}
+
+} // namespace emcal
+
+} // namespace o2
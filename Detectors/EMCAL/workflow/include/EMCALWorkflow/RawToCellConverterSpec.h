@@ -27,6 +27,7 @@
 #include "EMCALBase/Mapper.h"
 #include "EMCALBase/TriggerMappingV2.h"
 #include "EMCALReconstruction/CaloRawFitter.h"
+#include "EMCALReconstruction/CaloRawFitterGamma2Batch.h"
 #include "EMCALReconstruction/RawReaderMemory.h"
 #include "EMCALReconstruction/RecoContainer.h"
 #include "EMCALReconstruction/ReconstructionErrors.h"
@@ -267,6 +268,16 @@ class RawToCellConverterSpec : public framework::Task
     uint8_t mRow;            ///< Row in supermodule
   };
 
+  /// \struct FEECellInfo
+  /// \brief Cell properties of a FEE channel, kept until the raw fit of the channel is available
+  struct FEECellInfo {
+    int mCellID;             ///< Cell ID (or LEDMON ID)
+    bool mIsLowGain;         ///< Low gain channel
+    ChannelType_t mChanType; ///< Channel type (High Gain, Low Gain, LEDMON)
+    int mHardwareAddress;    ///< Hardware address of the channel
+    uint16_t mFeeID;         ///< FEE ID
+  };
+
   using TRUContainer = std::vector<o2::emcal::CompressedTRU>;
   using PatchContainer = std::vector<o2::emcal::CompressedTriggerPatch>;
 
@@ -324,8 +335,24 @@ class RawToCellConverterSpec : public framework::Task
   ///
   /// Performing a raw fit of the bunches in the channel to extract energy and time, and
   /// adding them to the container for FEE data of the given event.
+  /// In case the batched raw fitter is used the channel is only added to the batch, and the
+  /// cell is added to the event by fitBatchedFEEChannels.
   void addFEEChannelToEvent(o2::emcal::EventContainer& currentEvent, const o2::emcal::Channel& currentchannel, const CellTimeCorrection& timeCorrector, const LocalPosition& position, ChannelType_t chantype);
 
+  /// \brief Fit the FEE channels collected by the batched raw fitter and add them to the event
+  /// \param currentEvent Event to add the channels to
+  /// \param timeCorrector Handler for correction of the time
+  ///
+  /// No-op in case the batched raw fitter is not used.
+  void fitBatchedFEEChannels(o2::emcal::EventContainer& currentEvent, const CellTimeCorrection& timeCorrector);
+
+  /// \brief Add a fitted FEE channel to the event
+  /// \param currentEvent Event to add the channel to
+  /// \param fitResults Results of the raw fit
+  /// \param timeCorrector Handler for correction of the time
+  /// \param channel Cell properties of the channel
+  void addFitResultToEvent(o2::emcal::EventContainer& currentEvent, CaloFitResults fitResults, const CellTimeCorrection& timeCorrector, const FEECellInfo& channel);
+
   /// \brief Add TRU channel to the event
   /// \param currentEvent Event to add the channel to
   /// \param currentchannel Current TRU channel
@@ -519,6 +546,8 @@ class RawToCellConverterSpec : public framework::Task
   std::unique_ptr<MappingHandler> mMapper = nullptr;                 ///!<! Mapper
   std::unique_ptr<TriggerMappingV2> mTriggerMapping;                 ///!<! Trigger mapping
   std::unique_ptr<CaloRawFitter> mRawFitter;                         ///!<! Raw fitter
+  CaloRawFitterGamma2Batch* mBatchFitter = nullptr;                  ///!<! Raw fitter if fitting all channels of a link together, owned by mRawFitter
+  std::vector<FEECellInfo> mBatchedFEEChannels;                      ///!<! FEE channels in the batch of the raw fitter
   std::vector<Cell> mOutputCells;                                    ///< Container with output cells
   std::vector<TriggerRecord> mOutputTriggerRecords;                  ///< Container with output trigger records for cells
   std::vector<ErrorTypeFEE> mOutputDecoderErrors;                    ///< Container with decoder errors
@@ -38,6 +38,7 @@
 #include "EMCALReconstruction/Bunch.h"
 #include "EMCALReconstruction/CaloRawFitterStandard.h"
 #include "EMCALReconstruction/CaloRawFitterGamma2.h"
+#include "EMCALReconstruction/CaloRawFitterGamma2Batch.h"
 #include "EMCALReconstruction/AltroDecoder.h"
 #include "EMCALReconstruction/RawDecodingError.h"
 #include "EMCALReconstruction/RecoParam.h"
@@ -88,6 +89,10 @@ void RawToCellConverterSpec::init(framework::InitContext& ctx)
   } else if (fitmethod == "gamma2") {
     LOG(info) << "Using gamma2 raw fitter";
     mRawFitter = std::unique_ptr<CaloRawFitter>(new o2::emcal::CaloRawFitterGamma2);
+  } else if (fitmethod == "gamma2batch") {
+    LOG(info) << "Using gamma2 raw fitter, fitting all channels of a link together";
+    mBatchFitter = new o2::emcal::CaloRawFitterGamma2Batch;
+    mRawFitter = std::unique_ptr<CaloRawFitter>(mBatchFitter);
   } else {
     LOG(fatal) << "Unknown fit method" << fitmethod;
   }
@@ -309,6 +314,7 @@ void RawToCellConverterSpec::run(framework::ProcessingContext& ctx)
             continue;
           }
         }
+        fitBatchedFEEChannels(currentEvent, timeCorrector);
       } catch (o2::emcal::MappingHandler::DDLInvalid& ddlerror) {
         // Unable to catch mapping
         handleDDLError(ddlerror, feeID);
@@ -467,34 +473,63 @@ void RawToCellConverterSpec::addFEEChannelToEvent(o2::emcal::EventContainer& cur
     return;
   }
 
+  FEECellInfo channel{CellID, isLowGain, chantype, currentchannel.getHardwareAddress(), position.mFeeID};
+  if (mBatchFitter) {
+    // the channel is fitted together with the other channels of the link in fitBatchedFEEChannels
+    mBatchFitter->addChannel(currentchannel.getBunches());
+    mBatchedFEEChannels.push_back(channel);
+    return;
+  }
+
   // define the conatiner for the fit results, and perform the raw fitting using the stadnard raw fitter
-  CaloFitResults fitResults;
   try {
-    fitResults = mRawFitter->evaluate(currentchannel.getBunches());
-    // Prevent negative entries - we should no longer get here as the raw fit usually will end in an error state
-    if (fitResults.getAmp() < 0) {
-      fitResults.setAmp(0.);
-    }
-    if (fitResults.getTime() < 0) {
-      fitResults.setTime(0.);
-    }
-    // apply correction for bc mod 4
-    double celltime = timeCorrector.getCorrectedTime(fitResults.getTime());
-    double amp = fitResults.getAmp() * o2::emcal::constants::EMCAL_ADCENERGY;
-    if (isLowGain) {
-      amp *= o2::emcal::constants::EMCAL_HGLGFACTOR;
-    }
-    if (chantype == o2::emcal::ChannelType_t::LEDMON) {
-      // Mark LEDMONs as HIGH_GAIN/LOW_GAIN for gain type merging - will be flagged as LEDMON later when pushing to the output container
-      currentEvent.setLEDMONCell(CellID, amp, celltime, isLowGain ? o2::emcal::ChannelType_t::LOW_GAIN : o2::emcal::ChannelType_t::HIGH_GAIN, currentchannel.getHardwareAddress(), position.mFeeID, mMergeLGHG);
-    } else {
-      currentEvent.setCell(CellID, amp, celltime, chantype, currentchannel.getHardwareAddress(), position.mFeeID, mMergeLGHG);
-    }
+    addFitResultToEvent(currentEvent, mRawFitter->evaluate(currentchannel.getBunches()), timeCorrector, channel);
   } catch (CaloRawFitter::RawFitterError_t& fiterror) {
     handleFitError(fiterror, position.mFeeID, CellID, currentchannel.getHardwareAddress());
   }
 }
 
+void RawToCellConverterSpec::fitBatchedFEEChannels(o2::emcal::EventContainer& currentEvent, const CellTimeCorrection& timeCorrector)
+{
+  if (!mBatchFitter) {
+    return;
+  }
+  mBatchFitter->fit();
+  for (std::size_t ichan = 0; ichan < mBatchedFEEChannels.size(); ichan++) {
+    const auto& channel = mBatchedFEEChannels[ichan];
+    try {
+      addFitResultToEvent(currentEvent, mBatchFitter->getFitResults(ichan), timeCorrector, channel);
+    } catch (CaloRawFitter::RawFitterError_t& fiterror) {
+      handleFitError(fiterror, channel.mFeeID, channel.mCellID, channel.mHardwareAddress);
+    }
+  }
+  mBatchFitter->clear();
+  mBatchedFEEChannels.clear();
+}
+
+void RawToCellConverterSpec::addFitResultToEvent(o2::emcal::EventContainer& currentEvent, CaloFitResults fitResults, const CellTimeCorrection& timeCorrector, const FEECellInfo& channel)
+{
+  // Prevent negative entries - we should no longer get here as the raw fit usually will end in an error state
+  if (fitResults.getAmp() < 0) {
+    fitResults.setAmp(0.);
+  }
+  if (fitResults.getTime() < 0) {
+    fitResults.setTime(0.);
+  }
+  // apply correction for bc mod 4
+  double celltime = timeCorrector.getCorrectedTime(fitResults.getTime());
+  double amp = fitResults.getAmp() * o2::emcal::constants::EMCAL_ADCENERGY;
+  if (channel.mIsLowGain) {
+    amp *= o2::emcal::constants::EMCAL_HGLGFACTOR;
+  }
+  if (channel.mChanType == o2::emcal::ChannelType_t::LEDMON) {
+    // Mark LEDMONs as HIGH_GAIN/LOW_GAIN for gain type merging - will be flagged as LEDMON later when pushing to the output container
+    currentEvent.setLEDMONCell(channel.mCellID, amp, celltime, channel.mIsLowGain ? o2::emcal::ChannelType_t::LOW_GAIN : o2::emcal::ChannelType_t::HIGH_GAIN, channel.mHardwareAddress, channel.mFeeID, mMergeLGHG);
+  } else {
+    currentEvent.setCell(channel.mCellID, amp, celltime, channel.mChanType, channel.mHardwareAddress, channel.mFeeID, mMergeLGHG);
+  }
+}
+
 void RawToCellConverterSpec::addTRUChannelToEvent(o2::emcal::EventContainer& currentEvent, const o2::emcal::Channel& currentchannel, const LocalPosition& position)
 {
   try {
@@ -1058,7 +1093,7 @@ o2::framework::DataProcessorSpec o2::emcal::reco_workflow::getRawToCellConverter
     outputs,
     o2::framework::adaptFromTask<o2::emcal::reco_workflow::RawToCellConverterSpec>(subspecification, !disableDecodingErrors, !disableTriggerReconstruction, calibhandler),
     o2::framework::Options{
-      {"fitmethod", o2::framework::VariantType::String, "gamma2", {"Fit method (standard or gamma2)"}},
+      {"fitmethod", o2::framework::VariantType::String, "gamma2", {"Fit method (standard, gamma2 or gamma2batch)"}},
       {"maxmessage", o2::framework::VariantType::Int, 100, {"Max. amout of error messages to be displayed"}},
       {"printtrailer", o2::framework::VariantType::Bool, false, {"Print RCU trailer (for debugging)"}},
       {"no-mergeHGLG", o2::framework::VariantType::Bool, false, {"Do not merge HG and LG channels for same tower"}},
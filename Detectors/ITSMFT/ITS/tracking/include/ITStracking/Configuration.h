@@ -75,6 +75,7 @@ struct TrackingParameters {
   int ZBins{256};
   int PhiBins{128};
   int nROFsPerIterations = -1;
+  int nROFsPerTask = -1; // >0: trackleting and cell finding are split in (ROF slice x layer) tasks, dynamically scheduled
   bool UseDiamond = false;
   float Diamond[3] = {0.f, 0.f, 0.f};
 
@@ -80,6 +80,7 @@ struct TrackerParamConfig : public o2::conf::ConfigurableParamHelper<TrackerPara
   int nThreads = 1;
   int nOrbitsPerIterations = 0;
   int nROFsPerIterations = 0;
+  int nROFsPerTask = 0; // >0: number of ROFs per (ROF slice x layer) task in tracklet and cell finding, <=0: parallelise over layers only
   bool perPrimaryVertexProcessing = false;
   bool saveTimeBenchmarks = false;
   bool overrideBeamEstimation = false; // used by gpuwf only
@@ -488,6 +488,7 @@ void Tracker::getGlobalConfiguration()
     params.CellDeltaTanLambdaSigma *= tc.deltaTanLres > 0 ? tc.deltaTanLres : 1.f;
     params.TrackletMinPt *= tc.minPt > 0 ? tc.minPt : 1.f;
     params.nROFsPerIterations = nROFsPerIterations;
+    params.nROFsPerTask = tc.nROFsPerTask > 0 ? tc.nROFsPerTask : -1;
     params.PerPrimaryVertexProcessing = tc.perPrimaryVertexProcessing;
     params.SaveTimeBenchmarks = tc.saveTimeBenchmarks;
     for (int iD{0}; iD < 3; ++iD) {
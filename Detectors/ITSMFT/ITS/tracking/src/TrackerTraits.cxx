@@ -72,131 +72,171 @@ void TrackerTraits::computeLayerTracklets(const int iteration, int iROFslice, in
   gsl::span<const Vertex> diamondSpan(&diamondVert, 1);
   int startROF{mTrkParams[iteration].nROFsPerIterations > 0 ? iROFslice * mTrkParams[iteration].nROFsPerIterations : 0};
   int endROF{mTrkParams[iteration].nROFsPerIterations > 0 ? (iROFslice + 1) * mTrkParams[iteration].nROFsPerIterations + mTrkParams[iteration].DeltaROF : tf->getNrof()};
-  for (int rof0{startROF}; rof0 < endROF; ++rof0) {
+
+  /// Tracklets of the clusters of layer iLayer in rof0, appended to the given container
+  auto computeROFLayerTracklets = [&](int rof0, int iLayer, std::vector<Tracklet>& tracklets) {
     gsl::span<const Vertex> primaryVertices = mTrkParams[iteration].UseDiamond ? diamondSpan : tf->getPrimaryVertices(rof0);
     const int startVtx{iVertex >= 0 ? iVertex : 0};
     const int endVtx{iVertex >= 0 ? std::min(iVertex + 1, static_cast<int>(primaryVertices.size())) : static_cast<int>(primaryVertices.size())};
     int minRof = std::max(startROF, rof0 - mTrkParams[iteration].DeltaROF);
     int maxRof = std::min(endROF - 1, rof0 + mTrkParams[iteration].DeltaROF);
-#pragma omp parallel for num_threads(mNThreads)
-    for (int iLayer = 0; iLayer < mTrkParams[iteration].TrackletsPerRoad(); ++iLayer) {
-      gsl::span<const Cluster> layer0 = tf->getClustersOnLayer(rof0, iLayer);
-      if (layer0.empty()) {
+    gsl::span<const Cluster> layer0 = tf->getClustersOnLayer(rof0, iLayer);
+    if (layer0.empty()) {
+      return;
+    }
+    float meanDeltaR{mTrkParams[iteration].LayerRadii[iLayer + 1] - mTrkParams[iteration].LayerRadii[iLayer]};
+
+    const int currentLayerClustersNum{static_cast<int>(layer0.size())};
+    for (int iCluster{0}; iCluster < currentLayerClustersNum; ++iCluster) {
+      const Cluster& currentCluster{layer0[iCluster]};
+      const int currentSortedIndex{tf->getSortedIndex(rof0, iLayer, iCluster)};
+
+      if (tf->isClusterUsed(iLayer, currentCluster.clusterId)) {
         continue;
       }
-      float meanDeltaR{mTrkParams[iteration].LayerRadii[iLayer + 1] - mTrkParams[iteration].LayerRadii[iLayer]};
-
-      const int currentLayerClustersNum{static_cast<int>(layer0.size())};
-      for (int iCluster{0}; iCluster < currentLayerClustersNum; ++iCluster) {
-        const Cluster& currentCluster{layer0[iCluster]};
-        const int currentSortedIndex{tf->getSortedIndex(rof0, iLayer, iCluster)};
+      const float inverseR0{1.f / currentCluster.radius};
 
-        if (tf->isClusterUsed(iLayer, currentCluster.clusterId)) {
+      for (int iV{startVtx}; iV < endVtx; ++iV) {
+        auto& primaryVertex{primaryVertices[iV]};
+        if (primaryVertex.isFlagSet(2) && iteration != 3) {
           continue;
         }
-        const float inverseR0{1.f / currentCluster.radius};
+        const float resolution = o2::gpu::CAMath::Sqrt(Sq(mTrkParams[iteration].PVres) / primaryVertex.getNContributors() + Sq(tf->getPositionResolution(iLayer)));
 
-        for (int iV{startVtx}; iV < endVtx; ++iV) {
-          auto& primaryVertex{primaryVertices[iV]};
-          if (primaryVertex.isFlagSet(2) && iteration != 3) {
-            continue;
-          }
-          const float resolution = o2::gpu::CAMath::Sqrt(Sq(mTrkParams[iteration].PVres) / primaryVertex.getNContributors() + Sq(tf->getPositionResolution(iLayer)));
+        const float tanLambda{(currentCluster.zCoordinate - primaryVertex.getZ()) * inverseR0};
 
-          const float tanLambda{(currentCluster.zCoordinate - primaryVertex.getZ()) * inverseR0};
+        const float zAtRmin{tanLambda * (tf->getMinR(iLayer + 1) - currentCluster.radius) + currentCluster.zCoordinate};
+        const float zAtRmax{tanLambda * (tf->getMaxR(iLayer + 1) - currentCluster.radius) + currentCluster.zCoordinate};
 
-          const float zAtRmin{tanLambda * (tf->getMinR(iLayer + 1) - currentCluster.radius) + currentCluster.zCoordinate};
-          const float zAtRmax{tanLambda * (tf->getMaxR(iLayer + 1) - currentCluster.radius) + currentCluster.zCoordinate};
+        const float sqInverseDeltaZ0{1.f / (Sq(currentCluster.zCoordinate - primaryVertex.getZ()) + 2.e-8f)}; /// protecting from overflows adding the detector resolution
+        const float sigmaZ{o2::gpu::CAMath::Sqrt(Sq(resolution) * Sq(tanLambda) * ((Sq(inverseR0) + sqInverseDeltaZ0) * Sq(meanDeltaR) + 1.f) + Sq(meanDeltaR * tf->getMSangle(iLayer)))};
 
-          const float sqInverseDeltaZ0{1.f / (Sq(currentCluster.zCoordinate - primaryVertex.getZ()) + 2.e-8f)}; /// protecting from overflows adding the detector resolution
-          const float sigmaZ{o2::gpu::CAMath::Sqrt(Sq(resolution) * Sq(tanLambda) * ((Sq(inverseR0) + sqInverseDeltaZ0) * Sq(meanDeltaR) + 1.f) + Sq(meanDeltaR * tf->getMSangle(iLayer)))};
+        const int4 selectedBinsRect{getBinsRect(currentCluster, iLayer, zAtRmin, zAtRmax,
+                                                sigmaZ * mTrkParams[iteration].NSigmaCut, tf->getPhiCut(iLayer))};
+        if (selectedBinsRect.x == 0 && selectedBinsRect.y == 0 && selectedBinsRect.z == 0 && selectedBinsRect.w == 0) {
+          continue;
+        }
 
-          const int4 selectedBinsRect{getBinsRect(currentCluster, iLayer, zAtRmin, zAtRmax,
-                                                  sigmaZ * mTrkParams[iteration].NSigmaCut, tf->getPhiCut(iLayer))};
-          if (selectedBinsRect.x == 0 && selectedBinsRect.y == 0 && selectedBinsRect.z == 0 && selectedBinsRect.w == 0) {
-            continue;
-          }
+        int phiBinsNum{selectedBinsRect.w - selectedBinsRect.y + 1};
 
-          int phiBinsNum{selectedBinsRect.w - selectedBinsRect.y + 1};
+        if (phiBinsNum < 0) {
+          phiBinsNum += mTrkParams[iteration].PhiBins;
+        }
 
-          if (phiBinsNum < 0) {
-            phiBinsNum += mTrkParams[iteration].PhiBins;
+        for (int rof1{minRof}; rof1 <= maxRof; ++rof1) {
+          gsl::span<const Cluster> layer1 = tf->getClustersOnLayer(rof1, iLayer + 1);
+          if (layer1.empty()) {
+            continue;
           }
 
-          for (int rof1{minRof}; rof1 <= maxRof; ++rof1) {
-            gsl::span<const Cluster> layer1 = tf->getClustersOnLayer(rof1, iLayer + 1);
-            if (layer1.empty()) {
-              continue;
-            }
-
-            for (int iPhiCount{0}; iPhiCount < phiBinsNum; iPhiCount++) {
-              int iPhiBin = (selectedBinsRect.y + iPhiCount) % mTrkParams[iteration].PhiBins;
-              const int firstBinIndex{tf->mIndexTableUtils.getBinIndex(selectedBinsRect.x, iPhiBin)};
-              const int maxBinIndex{firstBinIndex + selectedBinsRect.z - selectedBinsRect.x + 1};
-              if constexpr (debugLevel) {
-                if (firstBinIndex < 0 || firstBinIndex > tf->getIndexTable(rof1, iLayer + 1).size() ||
-                    maxBinIndex < 0 || maxBinIndex > tf->getIndexTable(rof1, iLayer + 1).size()) {
-                  std::cout << iLayer << "\t" << iCluster << "\t" << zAtRmin << "\t" << zAtRmax << "\t" << sigmaZ * mTrkParams[iteration].NSigmaCut << "\t" << tf->getPhiCut(iLayer) << std::endl;
-                  std::cout << currentCluster.zCoordinate << "\t" << primaryVertex.getZ() << "\t" << currentCluster.radius << std::endl;
-                  std::cout << tf->getMinR(iLayer + 1) << "\t" << currentCluster.radius << "\t" << currentCluster.zCoordinate << std::endl;
-                  std::cout << "Illegal access to IndexTable " << firstBinIndex << "\t" << maxBinIndex << "\t" << selectedBinsRect.z << "\t" << selectedBinsRect.x << std::endl;
-                  exit(1);
-                }
+          for (int iPhiCount{0}; iPhiCount < phiBinsNum; iPhiCount++) {
+            int iPhiBin = (selectedBinsRect.y + iPhiCount) % mTrkParams[iteration].PhiBins;
+            const int firstBinIndex{tf->mIndexTableUtils.getBinIndex(selectedBinsRect.x, iPhiBin)};
+            const int maxBinIndex{firstBinIndex + selectedBinsRect.z - selectedBinsRect.x + 1};
+            if constexpr (debugLevel) {
+              if (firstBinIndex < 0 || firstBinIndex > tf->getIndexTable(rof1, iLayer + 1).size() ||
+                  maxBinIndex < 0 || maxBinIndex > tf->getIndexTable(rof1, iLayer + 1).size()) {
+                std::cout << iLayer << "\t" << iCluster << "\t" << zAtRmin << "\t" << zAtRmax << "\t" << sigmaZ * mTrkParams[iteration].NSigmaCut << "\t" << tf->getPhiCut(iLayer) << std::endl;
+                std::cout << currentCluster.zCoordinate << "\t" << primaryVertex.getZ() << "\t" << currentCluster.radius << std::endl;
+                std::cout << tf->getMinR(iLayer + 1) << "\t" << currentCluster.radius << "\t" << currentCluster.zCoordinate << std::endl;
+                std::cout << "Illegal access to IndexTable " << firstBinIndex << "\t" << maxBinIndex << "\t" << selectedBinsRect.z << "\t" << selectedBinsRect.x << std::endl;
+                exit(1);
               }
-              const int firstRowClusterIndex = tf->getIndexTable(rof1, iLayer + 1)[firstBinIndex];
-              const int maxRowClusterIndex = tf->getIndexTable(rof1, iLayer + 1)[maxBinIndex];
+            }
+            const int firstRowClusterIndex = tf->getIndexTable(rof1, iLayer + 1)[firstBinIndex];
+            const int maxRowClusterIndex = tf->getIndexTable(rof1, iLayer + 1)[maxBinIndex];
 
-              for (int iNextCluster{firstRowClusterIndex}; iNextCluster < maxRowClusterIndex; ++iNextCluster) {
+            for (int iNextCluster{firstRowClusterIndex}; iNextCluster < maxRowClusterIndex; ++iNextCluster) {
 
-                if (iNextCluster >= (int)layer1.size()) {
-                  break;
-                }
+              if (iNextCluster >= (int)layer1.size()) {
+                break;
+              }
 
-                const Cluster& nextCluster{layer1[iNextCluster]};
-                if (tf->isClusterUsed(iLayer + 1, nextCluster.clusterId)) {
-                  continue;
-                }
+              const Cluster& nextCluster{layer1[iNextCluster]};
+              if (tf->isClusterUsed(iLayer + 1, nextCluster.clusterId)) {
+                continue;
+              }
 
-                const float deltaPhi{gpu::GPUCommonMath::Abs(currentCluster.phi - nextCluster.phi)};
-                const float deltaZ{gpu::GPUCommonMath::Abs(tanLambda * (nextCluster.radius - currentCluster.radius) +
-                                                           currentCluster.zCoordinate - nextCluster.zCoordinate)};
+              const float deltaPhi{gpu::GPUCommonMath::Abs(currentCluster.phi - nextCluster.phi)};
+              const float deltaZ{gpu::GPUCommonMath::Abs(tanLambda * (nextCluster.radius - currentCluster.radius) +
+                                                         currentCluster.zCoordinate - nextCluster.zCoordinate)};
 
 #ifdef OPTIMISATION_OUTPUT
-                MCCompLabel label;
-                int currentId{currentCluster.clusterId};
-                int nextId{nextCluster.clusterId};
-                for (auto& lab1 : tf->getClusterLabels(iLayer, currentId)) {
-                  for (auto& lab2 : tf->getClusterLabels(iLayer + 1, nextId)) {
-                    if (lab1 == lab2 && lab1.isValid()) {
-                      label = lab1;
-                      break;
-                    }
-                  }
-                  if (label.isValid()) {
+              MCCompLabel label;
+              int currentId{currentCluster.clusterId};
+              int nextId{nextCluster.clusterId};
+              for (auto& lab1 : tf->getClusterLabels(iLayer, currentId)) {
+                for (auto& lab2 : tf->getClusterLabels(iLayer + 1, nextId)) {
+                  if (lab1 == lab2 && lab1.isValid()) {
+                    label = lab1;
                     break;
                   }
                 }
-                off << fmt::format("{}\t{:d}\t{}\t{}\t{}\t{}", iLayer, label.isValid(), (tanLambda * (nextCluster.radius - currentCluster.radius) + currentCluster.zCoordinate - nextCluster.zCoordinate) / sigmaZ, tanLambda, resolution, sigmaZ) << std::endl;
+                if (label.isValid()) {
+                  break;
+                }
+              }
+              off << fmt::format("{}\t{:d}\t{}\t{}\t{}\t{}", iLayer, label.isValid(), (tanLambda * (nextCluster.radius - currentCluster.radius) + currentCluster.zCoordinate - nextCluster.zCoordinate) / sigmaZ, tanLambda, resolution, sigmaZ) << std::endl;
 #endif
 
-                if (deltaZ / sigmaZ < mTrkParams[iteration].NSigmaCut &&
-                    (deltaPhi < tf->getPhiCut(iLayer) ||
-                     gpu::GPUCommonMath::Abs(deltaPhi - constants::math::TwoPi) < tf->getPhiCut(iLayer))) {
-                  if (iLayer > 0) {
-                    tf->getTrackletsLookupTable()[iLayer - 1][currentSortedIndex]++;
-                  }
-                  const float phi{o2::gpu::GPUCommonMath::ATan2(currentCluster.yCoordinate - nextCluster.yCoordinate,
-                                                                currentCluster.xCoordinate - nextCluster.xCoordinate)};
-                  const float tanL{(currentCluster.zCoordinate - nextCluster.zCoordinate) /
-                                   (currentCluster.radius - nextCluster.radius)};
-                  tf->getTracklets()[iLayer].emplace_back(currentSortedIndex, tf->getSortedIndex(rof1, iLayer + 1, iNextCluster), tanL, phi, rof0, rof1);
+              if (deltaZ / sigmaZ < mTrkParams[iteration].NSigmaCut &&
+                  (deltaPhi < tf->getPhiCut(iLayer) ||
+                   gpu::GPUCommonMath::Abs(deltaPhi - constants::math::TwoPi) < tf->getPhiCut(iLayer))) {
+                if (iLayer > 0) {
+                  tf->getTrackletsLookupTable()[iLayer - 1][currentSortedIndex]++;
                 }
+                const float phi{o2::gpu::GPUCommonMath::ATan2(currentCluster.yCoordinate - nextCluster.yCoordinate,
+                                                              currentCluster.xCoordinate - nextCluster.xCoordinate)};
+                const float tanL{(currentCluster.zCoordinate - nextCluster.zCoordinate) /
+                                 (currentCluster.radius - nextCluster.radius)};
+                tracklets.emplace_back(currentSortedIndex, tf->getSortedIndex(rof1, iLayer + 1, iNextCluster), tanL, phi, rof0, rof1);
               }
             }
           }
         }
       }
     }
+  };
+
+  const int nLayers{mTrkParams[iteration].TrackletsPerRoad()};
+  if (mTrkParams[iteration].nROFsPerTask > 0) {
+    /// Each (ROF slice x layer) pair is an independent task: clusters of different ROFs have different sorted indices,
+    /// so the lookup table entries touched by two tasks never overlap and only the tracklets need per-task buffers.
+    const int nROFsPerTask{mTrkParams[iteration].nROFsPerTask};
+    const int nSlices{(endROF - startROF + nROFsPerTask - 1) / nROFsPerTask};
+    const int nTasks{nSlices * nLayers};
+    std::vector<std::vector<Tracklet>> tasksTracklets(nTasks);
+#pragma omp parallel for num_threads(mNThreads) schedule(dynamic, 1)
+    for (int iTask = 0; iTask < nTasks; ++iTask) {
+      const int iLayer{iTask % nLayers};
+      const int firstROF{startROF + (iTask / nLayers) * nROFsPerTask};
+      const int lastROF{std::min(endROF, firstROF + nROFsPerTask)};
+      for (int rof0{firstROF}; rof0 < lastROF; ++rof0) {
+        computeROFLayerTracklets(rof0, iLayer, tasksTracklets[iTask]);
+      }
+    }
+    /// Merge the task outputs in slice order, independently of the scheduling
+#pragma omp parallel for num_threads(mNThreads)
+    for (int iLayer = 0; iLayer < nLayers; ++iLayer) {
+      auto& trkl{tf->getTracklets()[iLayer]};
+      size_t nTracklets{0};
+      for (int iSlice{0}; iSlice < nSlices; ++iSlice) {
+        nTracklets += tasksTracklets[iSlice * nLayers + iLayer].size();
+      }
+      trkl.reserve(nTracklets);
+      for (int iSlice{0}; iSlice < nSlices; ++iSlice) {
+        auto& taskTrkl{tasksTracklets[iSlice * nLayers + iLayer]};
+        trkl.insert(trkl.end(), taskTrkl.begin(), taskTrkl.end());
+        std::vector<Tracklet>().swap(taskTrkl);
+      }
+    }
+  } else {
+    for (int rof0{startROF}; rof0 < endROF; ++rof0) {
+#pragma omp parallel for num_threads(mNThreads)
+      for (int iLayer = 0; iLayer < nLayers; ++iLayer) {
+        computeROFLayerTracklets(rof0, iLayer, tf->getTracklets()[iLayer]);
+      }
+    }
   }
   if (!tf->checkMemory(mTrkParams[iteration].MaxMemory)) {
     return;
@@ -285,99 +325,164 @@ void TrackerTraits::computeLayerCells(const int iteration)
   }
 
   TimeFrame* tf = mTimeFrame;
-#pragma omp parallel for num_threads(mNThreads)
-  for (int iLayer = 0; iLayer < mTrkParams[iteration].CellsPerRoad(); ++iLayer) {
-
-    if (tf->getTracklets()[iLayer + 1].empty() ||
-        tf->getTracklets()[iLayer].empty()) {
-      continue;
-    }
 
+  /// Cells seeded by tracklet iTracklet of layer iLayer, appended to the given container
+  auto computeTrackletCells = [&](int iLayer, int iTracklet, std::vector<CellSeed>& cells) {
 #ifdef OPTIMISATION_OUTPUT
     float resolution{o2::gpu::CAMath::Sqrt(0.5f * (mTrkParams[iteration].SystErrorZ2[iLayer] + mTrkParams[iteration].SystErrorZ2[iLayer + 1] + mTrkParams[iteration].SystErrorZ2[iLayer + 2] + mTrkParams[iteration].SystErrorY2[iLayer] + mTrkParams[iteration].SystErrorY2[iLayer + 1] + mTrkParams[iteration].SystErrorY2[iLayer + 2])) / mTrkParams[iteration].LayerResolution[iLayer]};
     resolution = resolution > 1.e-12 ? resolution : 1.f;
 #endif
-    const int currentLayerTrackletsNum{static_cast<int>(tf->getTracklets()[iLayer].size())};
-    for (int iTracklet{0}; iTracklet < currentLayerTrackletsNum; ++iTracklet) {
-
-      const Tracklet& currentTracklet{tf->getTracklets()[iLayer][iTracklet]};
-      const int nextLayerClusterIndex{currentTracklet.secondClusterIndex};
-      const int nextLayerFirstTrackletIndex{
-        tf->getTrackletsLookupTable()[iLayer][nextLayerClusterIndex]};
-      const int nextLayerLastTrackletIndex{
-        tf->getTrackletsLookupTable()[iLayer][nextLayerClusterIndex + 1]};
+    const Tracklet& currentTracklet{tf->getTracklets()[iLayer][iTracklet]};
+    const int nextLayerClusterIndex{currentTracklet.secondClusterIndex};
+    const int nextLayerFirstTrackletIndex{
+      tf->getTrackletsLookupTable()[iLayer][nextLayerClusterIndex]};
+    const int nextLayerLastTrackletIndex{
+      tf->getTrackletsLookupTable()[iLayer][nextLayerClusterIndex + 1]};
+
+    if (nextLayerFirstTrackletIndex == nextLayerLastTrackletIndex) {
+      return;
+    }
 
-      if (nextLayerFirstTrackletIndex == nextLayerLastTrackletIndex) {
-        continue;
+    for (int iNextTracklet{nextLayerFirstTrackletIndex}; iNextTracklet < nextLayerLastTrackletIndex; ++iNextTracklet) {
+      if (tf->getTracklets()[iLayer + 1][iNextTracklet].firstClusterIndex != nextLayerClusterIndex) {
+        break;
       }
-
-      for (int iNextTracklet{nextLayerFirstTrackletIndex}; iNextTracklet < nextLayerLastTrackletIndex; ++iNextTracklet) {
-        if (tf->getTracklets()[iLayer + 1][iNextTracklet].firstClusterIndex != nextLayerClusterIndex) {
-          break;
-        }
-        const Tracklet& nextTracklet{tf->getTracklets()[iLayer + 1][iNextTracklet]};
-        const float deltaTanLambda{std::abs(currentTracklet.tanLambda - nextTracklet.tanLambda)};
+      const Tracklet& nextTracklet{tf->getTracklets()[iLayer + 1][iNextTracklet]};
+      const float deltaTanLambda{std::abs(currentTracklet.tanLambda - nextTracklet.tanLambda)};
 
 #ifdef OPTIMISATION_OUTPUT
-        bool good{tf->getTrackletsLabel(iLayer)[iTracklet] == tf->getTrackletsLabel(iLayer + 1)[iNextTracklet]};
-        float signedDelta{currentTracklet.tanLambda - nextTracklet.tanLambda};
-        off << fmt::format("{}\t{:d}\t{}\t{}\t{}\t{}", iLayer, good, signedDelta, signedDelta / (mTrkParams[iteration].CellDeltaTanLambdaSigma), tanLambda, resolution) << std::endl;
+      bool good{tf->getTrackletsLabel(iLayer)[iTracklet] == tf->getTrackletsLabel(iLayer + 1)[iNextTracklet]};
+      float signedDelta{currentTracklet.tanLambda - nextTracklet.tanLambda};
+      off << fmt::format("{}\t{:d}\t{}\t{}\t{}\t{}", iLayer, good, signedDelta, signedDelta / (mTrkParams[iteration].CellDeltaTanLambdaSigma), tanLambda, resolution) << std::endl;
 #endif
 
-        if (deltaTanLambda / mTrkParams[iteration].CellDeltaTanLambdaSigma < mTrkParams[iteration].NSigmaCut) {
+      if (deltaTanLambda / mTrkParams[iteration].CellDeltaTanLambdaSigma < mTrkParams[iteration].NSigmaCut) {
 
-          /// Track seed preparation. Clusters are numbered progressively from the innermost going outward.
-          const int clusId[3]{
-            mTimeFrame->getClusters()[iLayer][currentTracklet.firstClusterIndex].clusterId,
-            mTimeFrame->getClusters()[iLayer + 1][nextTracklet.firstClusterIndex].clusterId,
-            mTimeFrame->getClusters()[iLayer + 2][nextTracklet.secondClusterIndex].clusterId};
-          const auto& cluster1_glo = mTimeFrame->getUnsortedClusters()[iLayer].at(clusId[0]);
-          const auto& cluster2_glo = mTimeFrame->getUnsortedClusters()[iLayer + 1].at(clusId[1]);
-          const auto& cluster3_tf = mTimeFrame->getTrackingFrameInfoOnLayer(iLayer + 2).at(clusId[2]);
-          auto track{buildTrackSeed(cluster1_glo, cluster2_glo, cluster3_tf)};
+        /// Track seed preparation. Clusters are numbered progressively from the innermost going outward.
+        const int clusId[3]{
+          mTimeFrame->getClusters()[iLayer][currentTracklet.firstClusterIndex].clusterId,
+          mTimeFrame->getClusters()[iLayer + 1][nextTracklet.firstClusterIndex].clusterId,
+          mTimeFrame->getClusters()[iLayer + 2][nextTracklet.secondClusterIndex].clusterId};
+        const auto& cluster1_glo = mTimeFrame->getUnsortedClusters()[iLayer].at(clusId[0]);
+        const auto& cluster2_glo = mTimeFrame->getUnsortedClusters()[iLayer + 1].at(clusId[1]);
+        const auto& cluster3_tf = mTimeFrame->getTrackingFrameInfoOnLayer(iLayer + 2).at(clusId[2]);
+        auto track{buildTrackSeed(cluster1_glo, cluster2_glo, cluster3_tf)};
 
-          float chi2{0.f};
-          bool good{false};
-          for (int iC{2}; iC--;) {
-            const TrackingFrameInfo& trackingHit = mTimeFrame->getTrackingFrameInfoOnLayer(iLayer + iC).at(clusId[iC]);
+        float chi2{0.f};
+        bool good{false};
+        for (int iC{2}; iC--;) {
+          const TrackingFrameInfo& trackingHit = mTimeFrame->getTrackingFrameInfoOnLayer(iLayer + iC).at(clusId[iC]);
 
-            if (!track.rotate(trackingHit.alphaTrackingFrame)) {
-              break;
-            }
+          if (!track.rotate(trackingHit.alphaTrackingFrame)) {
+            break;
+          }
 
-            if (!track.propagateTo(trackingHit.xTrackingFrame, getBz())) {
-              break;
-            }
+          if (!track.propagateTo(trackingHit.xTrackingFrame, getBz())) {
+            break;
+          }
 
-            constexpr float radl = 9.36f; // Radiation length of Si [cm]
-            constexpr float rho = 2.33f;  // Density of Si [g/cm^3]
-            if (!track.correctForMaterial(mTrkParams[0].LayerxX0[iLayer + iC], mTrkParams[0].LayerxX0[iLayer] * radl * rho, true)) {
-              break;
-            }
+          constexpr float radl = 9.36f; // Radiation length of Si [cm]
+          constexpr float rho = 2.33f;  // Density of Si [g/cm^3]
+          if (!track.correctForMaterial(mTrkParams[0].LayerxX0[iLayer + iC], mTrkParams[0].LayerxX0[iLayer] * radl * rho, true)) {
+            break;
+          }
 
-            auto predChi2{track.getPredictedChi2(trackingHit.positionTrackingFrame, trackingHit.covarianceTrackingFrame)};
-            if (!track.o2::track::TrackParCov::update(trackingHit.positionTrackingFrame, trackingHit.covarianceTrackingFrame)) {
-              break;
-            }
-            if (!iC && predChi2 > mTrkParams[iteration].MaxChi2ClusterAttachment) {
-              break;
-            }
-            good = !iC;
-            chi2 += predChi2;
+          auto predChi2{track.getPredictedChi2(trackingHit.positionTrackingFrame, trackingHit.covarianceTrackingFrame)};
+          if (!track.o2::track::TrackParCov::update(trackingHit.positionTrackingFrame, trackingHit.covarianceTrackingFrame)) {
+            break;
           }
-          if (!good) {
-            continue;
+          if (!iC && predChi2 > mTrkParams[iteration].MaxChi2ClusterAttachment) {
+            break;
           }
-          if (iLayer > 0 && (int)tf->getCellsLookupTable()[iLayer - 1].size() <= iTracklet) {
-            tf->getCellsLookupTable()[iLayer - 1].resize(iTracklet + 1, tf->getCells()[iLayer].size());
+          good = !iC;
+          chi2 += predChi2;
+        }
+        if (!good) {
+          continue;
+        }
+        cells.emplace_back(iLayer, clusId[0], clusId[1], clusId[2],
+                           iTracklet, iNextTracklet, track, chi2);
+      }
+    }
+  };
+
+  const int nLayers{mTrkParams[iteration].CellsPerRoad()};
+  if (mTrkParams[iteration].nROFsPerTask > 0) {
+    /// Tracklets are sorted by their first cluster, hence by ROF: a (ROF slice x layer) task covers a contiguous range
+    /// of tracklets. Cells and their per-tracklet multiplicities are buffered per task and merged in tracklet order.
+    const int nROFsPerTask{mTrkParams[iteration].nROFsPerTask};
+    const int nSlices{(tf->getNrof() + nROFsPerTask - 1) / nROFsPerTask};
+    const int nTasks{nSlices * nLayers};
+    std::vector<std::vector<CellSeed>> tasksCells(nTasks);
+    std::vector<std::vector<int>> tasksCellsPerTracklet(nTasks);
+#pragma omp parallel for num_threads(mNThreads) schedule(dynamic, 1)
+    for (int iTask = 0; iTask < nTasks; ++iTask) {
+      const int iLayer{iTask % nLayers};
+      const auto& tracklets{tf->getTracklets()[iLayer]};
+      if (tf->getTracklets()[iLayer + 1].empty() || tracklets.empty()) {
+        continue;
+      }
+      const int firstROF{(iTask / nLayers) * nROFsPerTask};
+      auto rofComp = [](const Tracklet& trk, int rof) { return trk.rof[0] < rof; };
+      const int firstTracklet{static_cast<int>(std::lower_bound(tracklets.begin(), tracklets.end(), firstROF, rofComp) - tracklets.begin())};
+      const int lastTracklet{static_cast<int>(std::lower_bound(tracklets.begin(), tracklets.end(), firstROF + nROFsPerTask, rofComp) - tracklets.begin())};
+      auto& cells{tasksCells[iTask]};
+      auto& cellsPerTracklet{tasksCellsPerTracklet[iTask]};
+      cellsPerTracklet.resize(lastTracklet - firstTracklet, 0);
+      for (int iTracklet{firstTracklet}; iTracklet < lastTracklet; ++iTracklet) {
+        const int nCells{static_cast<int>(cells.size())};
+        computeTrackletCells(iLayer, iTracklet, cells);
+        cellsPerTracklet[iTracklet - firstTracklet] = static_cast<int>(cells.size()) - nCells;
+      }
+    }
+
+#pragma omp parallel for num_threads(mNThreads)
+    for (int iLayer = 0; iLayer < nLayers; ++iLayer) {
+      if (tf->getTracklets()[iLayer + 1].empty() ||
+          tf->getTracklets()[iLayer].empty()) {
+        continue;
+      }
+      auto& cells{tf->getCells()[iLayer]};
+      size_t nCells{0};
+      for (int iSlice{0}; iSlice < nSlices; ++iSlice) {
+        nCells += tasksCells[iSlice * nLayers + iLayer].size();
+      }
+      cells.reserve(nCells);
+      for (int iSlice{0}; iSlice < nSlices; ++iSlice) {
+        const int iTask{iSlice * nLayers + iLayer};
+        if (iLayer > 0) {
+          int offset{static_cast<int>(cells.size())};
+          for (int nTrackletCells : tasksCellsPerTracklet[iTask]) {
+            tf->getCellsLookupTable()[iLayer - 1].push_back(offset);
+            offset += nTrackletCells;
           }
-          tf->getCells()[iLayer].emplace_back(iLayer, clusId[0], clusId[1], clusId[2],
-                                              iTracklet, iNextTracklet, track, chi2);
         }
+        cells.insert(cells.end(), tasksCells[iTask].begin(), tasksCells[iTask].end());
+      }
+      if (iLayer > 0) {
+        tf->getCellsLookupTable()[iLayer - 1].push_back(cells.size());
       }
     }
-    if (iLayer > 0) {
-      tf->getCellsLookupTable()[iLayer - 1].resize(currentLayerTrackletsNum + 1, tf->getCells()[iLayer].size());
+  } else {
+#pragma omp parallel for num_threads(mNThreads)
+    for (int iLayer = 0; iLayer < nLayers; ++iLayer) {
+      if (tf->getTracklets()[iLayer + 1].empty() ||
+          tf->getTracklets()[iLayer].empty()) {
+        continue;
+      }
+
+      auto& cells{tf->getCells()[iLayer]};
+      const int currentLayerTrackletsNum{static_cast<int>(tf->getTracklets()[iLayer].size())};
+      for (int iTracklet{0}; iTracklet < currentLayerTrackletsNum; ++iTracklet) {
+        const int nCells{static_cast<int>(cells.size())};
+        computeTrackletCells(iLayer, iTracklet, cells);
+        if (iLayer > 0 && static_cast<int>(cells.size()) > nCells && (int)tf->getCellsLookupTable()[iLayer - 1].size() <= iTracklet) {
+          tf->getCellsLookupTable()[iLayer - 1].resize(iTracklet + 1, nCells);
+        }
+      }
+      if (iLayer > 0) {
+        tf->getCellsLookupTable()[iLayer - 1].resize(currentLayerTrackletsNum + 1, cells.size());
+      }
     }
   }
   if (!tf->checkMemory(mTrkParams[iteration].MaxMemory)) {
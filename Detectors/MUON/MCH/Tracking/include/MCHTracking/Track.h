@@ -36,10 +36,12 @@ class Track
   ~Track() = default;
 
   Track(const Track& track);
-  Track& operator=(const Track& track) = delete;
+  Track& operator=(const Track& track);
   Track(Track&&) = delete;
   Track& operator=(Track&&) = delete;
 
+  void reset();
+
   /// Return the number of attached clusters
   int getNClusters() const { return mParamAtClusters.size(); }
 
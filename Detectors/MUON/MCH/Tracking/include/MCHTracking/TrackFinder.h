@@ -18,8 +18,8 @@
 #define O2_MCH_TRACKFINDER_H_
 
 #include <chrono>
-#include <unordered_map>
-#include <unordered_set>
+#include <cstdint>
+#include <deque>
 #include <list>
 #include <array>
 #include <vector>
@@ -64,7 +64,55 @@ class TrackFinder
   void printTimers() const;
 
  private:
-  const std::list<Track>& findTracks(const std::unordered_map<int, std::list<const Cluster*>>& clusters);
+  /// Set of clusters of the current ROF, stored as a bitmask over their index in the ROF
+  /// The words in use are recorded to make clear(), empty() and moveTo() proportional to the number of clusters set
+  class ClusterMask
+  {
+   public:
+    /// resize the mask to hold nClusters clusters and clear it
+    void reset(int nClusters)
+    {
+      mWords.assign((nClusters + 63) / 64, 0);
+      mUsedWords.clear();
+    }
+    /// clear the mask
+    void clear()
+    {
+      for (auto iWord : mUsedWords) {
+        mWords[iWord] = 0;
+      }
+      mUsedWords.clear();
+    }
+    /// return true if no cluster is set
+    bool empty() const { return mUsedWords.empty(); }
+    /// return true if the cluster at index iCl is set
+    bool test(int iCl) const { return (mWords[iCl / 64] >> (iCl % 64)) & 1; }
+    /// set the cluster at index iCl
+    void set(int iCl)
+    {
+      auto& word = mWords[iCl / 64];
+      if (word == 0) {
+        mUsedWords.push_back(iCl / 64);
+      }
+      word |= uint64_t(1) << (iCl % 64);
+    }
+    /// add the clusters set in this mask to the destination then clear this mask
+    void moveTo(ClusterMask& destination)
+    {
+      for (auto iWord : mUsedWords) {
+        if (destination.mWords[iWord] == 0) {
+          destination.mUsedWords.push_back(iWord);
+        }
+        destination.mWords[iWord] |= mWords[iWord];
+        mWords[iWord] = 0;
+      }
+      mUsedWords.clear();
+    }
+
+   private:
+    std::vector<uint64_t> mWords{};     ///< one bit per cluster
+    std::vector<uint32_t> mUsedWords{}; ///< indices of the non-zero words
+  };
 
   void findTrackCandidates();
   void findTrackCandidatesInSt5();
@@ -74,14 +122,12 @@ class TrackFinder
 
   std::list<Track>::iterator followTrackInOverlapDE(const std::list<Track>::iterator& itTrack, int currentDE, int plane);
   std::list<Track>::iterator followTrackInChamber(std::list<Track>::iterator& itTrack,
-                                                  int chamber, int lastChamber, bool canSkip,
-                                                  std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters);
+                                                  int chamber, int lastChamber, bool canSkip, ClusterMask& excludedClusters);
   std::list<Track>::iterator followTrackInChamber(std::list<Track>::iterator& itTrack,
-                                                  int plane1, int plane2, int lastChamber,
-                                                  std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters);
+                                                  int plane1, int plane2, int lastChamber, ClusterMask& excludedClusters);
   std::list<Track>::iterator addClustersAndFollowTrack(std::list<Track>::iterator& itTrack, const TrackParam& paramAtCluster1,
                                                        const TrackParam* paramAtCluster2, int nextChamber, int lastChamber,
-                                                       std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters);
+                                                       ClusterMask& excludedClusters);
 
   void improveTracks();
 
@@ -93,6 +139,8 @@ class TrackFinder
 
   void createTrack(const Cluster& cl1, const Cluster& cl2);
   std::list<Track>::iterator addTrack(const std::list<Track>::iterator& pos, const Track& track);
+  std::list<Track>::iterator releaseTrack(const std::list<Track>::iterator& itTrack);
+  void releaseTracks();
 
   bool isAcceptable(const TrackParam& param) const;
 
@@ -104,8 +152,13 @@ class TrackFinder
   bool areUsed(const Cluster& cl1, const Cluster& cl2, const std::vector<std::array<uint32_t, 4>>& usedClusters);
   void excludeClustersFromIdenticalTracks(const std::array<uint32_t, 4>& currentClusters,
                                           const std::vector<std::array<uint32_t, 8>>& usedClusters,
-                                          std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters);
-  void moveClusters(std::unordered_map<int, std::unordered_set<uint32_t>>& source, std::unordered_map<int, std::unordered_set<uint32_t>>& destination);
+                                          ClusterMask& excludedClusters);
+
+  ClusterMask& acquireClusterMask();
+  /// clear and release the last cluster mask acquired
+  void releaseClusterMask() { mClusterMasks[--mNClusterMasksInUse].clear(); }
+  /// return the index of the cluster in the current ROF
+  int getClusterIndex(const Cluster& cluster) const { return &cluster - mFirstCluster; }
 
   bool isCompatible(const TrackParam& param, const Cluster& cluster, TrackParam& paramAtCluster);
   bool tryOneClusterFast(const TrackParam& param, const Cluster& cluster);
@@ -138,10 +191,19 @@ class TrackFinder
 
   TrackFitter mTrackFitter{}; /// track fitter
 
-  /// array of pointers to the lists of clusters per DE
-  std::array<std::vector<std::pair<const int, const std::list<const Cluster*>*>>, 32> mClusters{};
+  /// array of DEs grouped per plane, pointing to their clusters in mSortedClusters (empty if none)
+  std::array<std::vector<std::pair<const int, gsl::span<const Cluster* const>>>, 32> mClusters{};
+  std::array<int, 1100> mDEIndex{};              ///< index of the DE in mDEClusterOffsets, per DE ID
+  std::vector<int> mDEClusterOffsets{};          ///< offset of the clusters of each DE in mSortedClusters
+  std::vector<const Cluster*> mSortedClusters{}; ///< clusters of the current ROF grouped per DE
+  const Cluster* mFirstCluster = nullptr;        ///< first cluster of the current ROF
+  int mNClusters = 0;                            ///< number of clusters in the current ROF
+
+  std::deque<ClusterMask> mClusterMasks{}; ///< pool of excluded cluster masks, used as a stack during the tracking
+  std::size_t mNClusterMasksInUse = 0;     ///< number of cluster masks currently acquired
 
-  std::list<Track> mTracks{}; ///< list of reconstructed tracks
+  std::list<Track> mTracks{};     ///< list of reconstructed tracks
+  std::list<Track> mFreeTracks{}; ///< released tracks kept to be recycled by addTrack() and createTrack()
 
   std::chrono::time_point<std::chrono::steady_clock> mStartTime{}; ///< time when the tracking start
 
@@ -38,6 +38,35 @@ Track::Track(const Track& track)
   /// Copy the track, except the current parameters and chamber, which are reset
 }
 
+//__________________________________________________________________________
+Track& Track::operator=(const Track& track)
+{
+  /// Assign the track, except the current parameters and chamber, which are reset
+  /// The memory already allocated for the track parameters at clusters is reused
+  if (this == &track) {
+    return *this;
+  }
+
+  mParamAtClusters = track.mParamAtClusters;
+  mCurrentParam.reset();
+  mCurrentChamber = -1;
+  mConnected = track.mConnected;
+  mRemovable = track.mRemovable;
+
+  return *this;
+}
+
+//__________________________________________________________________________
+void Track::reset()
+{
+  /// Reset the track to the state of a default constructed one, in place
+  mParamAtClusters.clear();
+  mCurrentParam.reset();
+  mCurrentChamber = -1;
+  mConnected = false;
+  mRemovable = false;
+}
+
 //__________________________________________________________________________
 TrackParam& Track::createParamAtCluster(const Cluster& cluster)
 {
@@ -16,6 +16,7 @@
 
 #include "MCHTracking/TrackFinder.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <iostream>
@@ -70,72 +71,82 @@ void TrackFinder::init()
     mMaxMCSAngle2[iCh] = TrackExtrap::getMCSAngle2(param, SChamberThicknessInX0[iCh], 1.);
   }
 
-  // prepare the internal array of list of vector
+  // prepare the internal array of vectors of DEs
   // grouping DEs in z-planes (2 for chambers 1-4 and 4 for chambers 5-10)
   for (int iCh = 0; iCh < 4; ++iCh) {
     mClusters[2 * iCh].reserve(2);
-    mClusters[2 * iCh].emplace_back(100 * (iCh + 1) + 1, nullptr);
-    mClusters[2 * iCh].emplace_back(100 * (iCh + 1) + 3, nullptr);
+    mClusters[2 * iCh].emplace_back(100 * (iCh + 1) + 1, gsl::span<const Cluster* const>{});
+    mClusters[2 * iCh].emplace_back(100 * (iCh + 1) + 3, gsl::span<const Cluster* const>{});
     mClusters[2 * iCh + 1].reserve(2);
-    mClusters[2 * iCh + 1].emplace_back(100 * (iCh + 1), nullptr);
-    mClusters[2 * iCh + 1].emplace_back(100 * (iCh + 1) + 2, nullptr);
+    mClusters[2 * iCh + 1].emplace_back(100 * (iCh + 1), gsl::span<const Cluster* const>{});
+    mClusters[2 * iCh + 1].emplace_back(100 * (iCh + 1) + 2, gsl::span<const Cluster* const>{});
   }
   for (int iCh = 4; iCh < 6; ++iCh) {
     mClusters[8 + 4 * (iCh - 4)].reserve(5);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1), nullptr);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 2, nullptr);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 4, nullptr);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 14, nullptr);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 16, nullptr);
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1), gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 2, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 4, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 14, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 16, gsl::span<const Cluster* const>{});
     mClusters[8 + 4 * (iCh - 4) + 1].reserve(4);
-    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 1, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 3, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 15, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 17, nullptr);
+    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 1, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 3, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 15, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 17, gsl::span<const Cluster* const>{});
     mClusters[8 + 4 * (iCh - 4) + 2].reserve(4);
-    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 6, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 8, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 10, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 12, nullptr);
+    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 6, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 8, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 10, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 12, gsl::span<const Cluster* const>{});
     mClusters[8 + 4 * (iCh - 4) + 3].reserve(5);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 5, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 7, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 9, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 11, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 13, nullptr);
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 5, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 7, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 9, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 11, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 13, gsl::span<const Cluster* const>{});
   }
   for (int iCh = 6; iCh < 10; ++iCh) {
     mClusters[8 + 4 * (iCh - 4)].reserve(7);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1), nullptr);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 2, nullptr);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 4, nullptr);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 6, nullptr);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 20, nullptr);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 22, nullptr);
-    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 24, nullptr);
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1), gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 2, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 4, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 6, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 20, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 22, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4)].emplace_back(100 * (iCh + 1) + 24, gsl::span<const Cluster* const>{});
     mClusters[8 + 4 * (iCh - 4) + 1].reserve(6);
-    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 1, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 3, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 5, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 21, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 23, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 25, nullptr);
+    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 1, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 3, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 5, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 21, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 23, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 1].emplace_back(100 * (iCh + 1) + 25, gsl::span<const Cluster* const>{});
     mClusters[8 + 4 * (iCh - 4) + 2].reserve(6);
-    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 8, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 10, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 12, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 14, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 16, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 18, nullptr);
+    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 8, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 10, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 12, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 14, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 16, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 2].emplace_back(100 * (iCh + 1) + 18, gsl::span<const Cluster* const>{});
     mClusters[8 + 4 * (iCh - 4) + 3].reserve(7);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 7, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 9, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 11, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 13, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 15, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 17, nullptr);
-    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 19, nullptr);
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 7, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 9, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 11, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 13, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 15, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 17, gsl::span<const Cluster* const>{});
+    mClusters[8 + 4 * (iCh - 4) + 3].emplace_back(100 * (iCh + 1) + 19, gsl::span<const Cluster* const>{});
+  }
+
+  // index the DEs to group the clusters per DE in a contiguous array
+  mDEIndex.fill(-1);
+  int nDEs(0);
+  for (const auto& plane : mClusters) {
+    for (const auto& de : plane) {
+      mDEIndex[de.first] = nDEs++;
+    }
   }
+  mDEClusterOffsets.resize(nDEs + 1);
 }
 
 //_________________________________________________________________________________________________
@@ -149,33 +160,50 @@ void TrackFinder::initField(float l3Current, float dipoleCurrent)
 const std::list<Track>& TrackFinder::findTracks(gsl::span<const Cluster> clusters)
 {
   /// Group the clusters per DE and run the track finder algorithm
-  std::unordered_map<int, std::list<const Cluster*>> clustersPerDE{};
-  for (const auto& cluster : clusters) {
-    clustersPerDE[cluster.getDEId()].emplace_back(&cluster);
-  }
-  return findTracks(clustersPerDE);
-}
 
-//_________________________________________________________________________________________________
-const std::list<Track>& TrackFinder::findTracks(const std::unordered_map<int, std::list<const Cluster*>>& clusters)
-{
-  /// Run the track finder algorithm
-
-  mTracks.clear();
+  releaseTracks();
   mStartTime = std::chrono::steady_clock::now();
 
-  // fill the internal array of pointers to the list of clusters per DE
+  // group the clusters per DE in a contiguous array, keeping their order within each DE
+  std::fill(mDEClusterOffsets.begin(), mDEClusterOffsets.end(), 0);
+  auto deIndex = [this](const Cluster& cluster) {
+    auto deId = cluster.getDEId();
+    return (deId >= 0 && deId < static_cast<int>(mDEIndex.size())) ? mDEIndex[deId] : -1;
+  };
+  for (const auto& cluster : clusters) {
+    auto iDE = deIndex(cluster);
+    if (iDE >= 0) {
+      ++mDEClusterOffsets[iDE + 1];
+    }
+  }
+  for (std::size_t iDE = 1; iDE < mDEClusterOffsets.size(); ++iDE) {
+    mDEClusterOffsets[iDE] += mDEClusterOffsets[iDE - 1];
+  }
+  mSortedClusters.resize(mDEClusterOffsets.back());
+  for (const auto& cluster : clusters) {
+    auto iDE = deIndex(cluster);
+    if (iDE >= 0) {
+      mSortedClusters[mDEClusterOffsets[iDE]++] = &cluster;
+    }
+  }
+
+  // make the DEs point to their clusters (the offsets now point to the end of the clusters of each DE)
   for (auto& plane : mClusters) {
     for (auto& de : plane) {
-      auto itDE = clusters.find(de.first);
-      if (itDE == clusters.end()) {
-        de.second = nullptr;
-      } else {
-        de.second = &(itDE->second);
-      }
+      auto iDE = mDEIndex[de.first];
+      int first = (iDE > 0) ? mDEClusterOffsets[iDE - 1] : 0;
+      de.second = gsl::span<const Cluster* const>(mSortedClusters.data() + first, mDEClusterOffsets[iDE] - first);
     }
   }
 
+  // prepare the masks of excluded clusters
+  mFirstCluster = clusters.data();
+  mNClusters = clusters.size();
+  for (auto& mask : mClusterMasks) {
+    mask.reset(mNClusters);
+  }
+  mNClusterMasksInUse = 0;
+
   // use the chamber resolution when fitting the tracks during the tracking
   mTrackFitter.useChamberResolution();
 
@@ -199,10 +227,11 @@ const std::list<Track>& TrackFinder::findTracks(const std::unordered_map<int, st
     // track each candidate down to chamber 1 and remove it
     tStart = std::chrono::high_resolution_clock::now();
     for (auto itTrack = mTracks.begin(); itTrack != mTracks.end();) {
-      std::unordered_map<int, std::unordered_set<uint32_t>> excludedClusters{};
+      auto& excludedClusters = acquireClusterMask();
       followTrackInChamber(itTrack, 5, 0, false, excludedClusters);
+      releaseClusterMask();
       print("findTracks: removing candidate at position #", getTrackIndex(itTrack));
-      itTrack = mTracks.erase(itTrack);
+      itTrack = releaseTrack(itTrack);
     }
     tEnd = std::chrono::high_resolution_clock::now();
     mTimeFollowTracks += tEnd - tStart;
@@ -211,7 +240,7 @@ const std::list<Track>& TrackFinder::findTracks(const std::unordered_map<int, st
 
   } catch (exception const& e) {
     LOG(warning) << e.what() << " --> abort";
-    mTracks.clear();
+    releaseTracks();
     return mTracks;
   }
 
@@ -259,15 +288,17 @@ void TrackFinder::findTrackCandidates()
     }
 
     // look for compatible clusters on station 4
-    std::unordered_map<int, std::unordered_set<uint32_t>> excludedClusters{};
+    auto& excludedClusters = acquireClusterMask();
     auto itNewTrack = followTrackInChamber(itTrack, 7, 6, false, excludedClusters);
+    bool hasExcludedClusters = !excludedClusters.empty();
+    releaseClusterMask();
 
     // keep the current candidate only if no compatible cluster is found and the station is not requested
-    if (!TrackerParam::Instance().requestStation[3] && excludedClusters.empty() && itTrack->areCurrentParamValid()) {
+    if (!TrackerParam::Instance().requestStation[3] && !hasExcludedClusters && itTrack->areCurrentParamValid()) {
       ++itTrack;
     } else {
       print("findTrackCandidates: removing candidate at position #", getTrackIndex(itTrack));
-      itTrack = mTracks.erase(itTrack);
+      itTrack = releaseTrack(itTrack);
       // prepare backward tracking for the new tracks
       for (; itNewTrack != mTracks.end() && itNewTrack != itTrack; ++itNewTrack) {
         prepareBackwardTracking(itNewTrack, false);
@@ -275,13 +306,13 @@ void TrackFinder::findTrackCandidates()
     }
   }
 
-  // list the cluster combinations already used in stations 4 and 5
+  // list the cluster combinations already used in stations 4 and 5, storing their index in the ROF + 1
   std::vector<std::array<uint32_t, 8>> usedClusters(mTracks.size());
   int iTrack(0);
   for (const auto& track : mTracks) {
     for (const auto& param : track) {
       int iCl = 2 * (param.getClusterPtr()->getChamberId() - 6) + param.getClusterPtr()->getDEId() % 2;
-      usedClusters[iTrack][iCl] = param.getClusterPtr()->uid;
+      usedClusters[iTrack][iCl] = getClusterIndex(*param.getClusterPtr()) + 1;
     }
     ++iTrack;
   }
@@ -300,7 +331,7 @@ void TrackFinder::findTrackCandidates()
         prepareForwardTracking(itTrack, true);
       } catch (exception const&) {
         print("findTrackCandidates: removing candidate at position #", getTrackIndex(itTrack));
-        itTrack = mTracks.erase(itTrack);
+        itTrack = releaseTrack(itTrack);
         continue;
       }
     }
@@ -308,12 +339,12 @@ void TrackFinder::findTrackCandidates()
     // look for compatible clusters on each chamber of station 5 separately,
     // exluding those already attached to an identical candidate on station 4
     // (cases where both chambers of station 5 are fired should have been found in the first step)
-    std::unordered_map<int, std::unordered_set<uint32_t>> excludedClusters{};
+    auto& excludedClusters = acquireClusterMask();
     if (!usedClusters.empty()) {
       std::array<uint32_t, 4> currentClusters{};
       for (const auto& param : *itTrack) {
         int iCl = 2 * (param.getClusterPtr()->getChamberId() - 6) + param.getClusterPtr()->getDEId() % 2;
-        currentClusters[iCl] = param.getClusterPtr()->uid;
+        currentClusters[iCl] = getClusterIndex(*param.getClusterPtr()) + 1;
       }
       excludeClustersFromIdenticalTracks(currentClusters, usedClusters, excludedClusters);
     }
@@ -322,14 +353,16 @@ void TrackFinder::findTrackCandidates()
     if (itFirstNewTrack == mTracks.end()) {
       itFirstNewTrack = itNewTrack;
     }
+    bool hasExcludedClusters = !excludedClusters.empty();
+    releaseClusterMask();
 
     // keep the current candidate only if no compatible cluster is found and the station is not requested
-    if (!TrackerParam::Instance().requestStation[4] && excludedClusters.empty()) {
+    if (!TrackerParam::Instance().requestStation[4] && !hasExcludedClusters) {
       itFirstNewTrack = itTrack;
       ++itTrack;
     } else {
       print("findTrackCandidates: removing candidate at position #", getTrackIndex(itTrack));
-      itTrack = mTracks.erase(itTrack);
+      itTrack = releaseTrack(itTrack);
     }
 
     // refit the track(s) and prepare to continue the tracking in the backward direction
@@ -339,7 +372,7 @@ void TrackFinder::findTrackCandidates()
         ++itFirstNewTrack;
       } catch (exception const&) {
         print("findTrackCandidates: removing candidate at position #", getTrackIndex(itFirstNewTrack));
-        itFirstNewTrack = mTracks.erase(itFirstNewTrack);
+        itFirstNewTrack = releaseTrack(itFirstNewTrack);
       }
     }
   }
@@ -379,7 +412,7 @@ void TrackFinder::findTrackCandidatesInSt5()
             prepareForwardTracking(itTrack, true);
           } catch (exception const&) {
             print("findTrackCandidatesInSt5: removing candidate at position #", getTrackIndex(itTrack));
-            itTrack = mTracks.erase(itTrack);
+            itTrack = releaseTrack(itTrack);
             continue;
           }
           auto itNewTrack = followTrackInOverlapDE(itTrack, itTrack->last().getClusterPtr()->getDEId(), iPlaneCh10 + 1);
@@ -388,7 +421,7 @@ void TrackFinder::findTrackCandidatesInSt5()
 
             // remove the initial candidate if compatible cluster(s) are found
             print("findTrackCandidatesInSt5: removing candidate at position #", getTrackIndex(itTrack));
-            itTrack = mTracks.erase(itTrack);
+            itTrack = releaseTrack(itTrack);
 
             // refit the track(s) with new attached cluster(s) and prepare to continue the tracking in the backward direction
             bool stop(false);
@@ -401,7 +434,7 @@ void TrackFinder::findTrackCandidatesInSt5()
                 prepareBackwardTracking(itTrack, true);
               } catch (exception const&) {
                 print("findTrackCandidatesInSt5: removing candidate at position #", getTrackIndex(itTrack));
-                itTrack = mTracks.erase(itTrack);
+                itTrack = releaseTrack(itTrack);
               }
             }
           } else {
@@ -425,7 +458,7 @@ void TrackFinder::findTrackCandidatesInSt5()
               ++itTrack;
             } else {
               print("findTrackCandidatesInSt5: removing candidate at position #", getTrackIndex(itTrack));
-              itTrack = mTracks.erase(itTrack);
+              itTrack = releaseTrack(itTrack);
             }
           }
         }
@@ -438,7 +471,7 @@ void TrackFinder::findTrackCandidatesInSt5()
   // remove tracks out of limits now that overlaps have been checked
   for (auto itTrack = mTracks.begin(); itTrack != mTracks.end();) {
     if (itTrack->isRemovable()) {
-      itTrack = mTracks.erase(itTrack);
+      itTrack = releaseTrack(itTrack);
     } else {
       ++itTrack;
     }
@@ -484,7 +517,7 @@ void TrackFinder::findTrackCandidatesInSt4()
           // keep the initial candidate only if no compatible cluster is found
           if (itNewTrack != mTracks.end()) {
             print("findTrackCandidatesInSt4: removing candidate at position #", getTrackIndex(itTrack));
-            mTracks.erase(itTrack);
+            releaseTrack(itTrack);
             itTrack = itNewTrack;
           }
         }
@@ -496,7 +529,7 @@ void TrackFinder::findTrackCandidatesInSt4()
             prepareForwardTracking(itTrack, true);
           } catch (exception const&) {
             print("findTrackCandidatesInSt4: removing candidate at position #", getTrackIndex(itTrack));
-            itTrack = mTracks.erase(itTrack);
+            itTrack = releaseTrack(itTrack);
             continue;
           }
 
@@ -514,7 +547,7 @@ void TrackFinder::findTrackCandidatesInSt4()
                 prepareForwardTracking(itNewTrack, false);
               }
               print("findTrackCandidatesInSt4: removing candidate at position #", getTrackIndex(itTrack));
-              itTrack = mTracks.erase(itTrack);
+              itTrack = releaseTrack(itTrack);
             }
           } else {
             ++itTrack;
@@ -528,7 +561,7 @@ void TrackFinder::findTrackCandidatesInSt4()
   auto itTrack = (itLastCandidateFromSt5 == mTracks.end()) ? mTracks.begin() : ++itLastCandidateFromSt5;
   while (itTrack != mTracks.end()) {
     if (itTrack->isRemovable()) {
-      itTrack = mTracks.erase(itTrack);
+      itTrack = releaseTrack(itTrack);
     } else {
       ++itTrack;
     }
@@ -570,7 +603,7 @@ void TrackFinder::findMoreTrackCandidates()
             prepareForwardTracking(itTrack, true);
           } catch (exception const&) {
             print("findMoreTrackCandidates: removing candidate at position #", getTrackIndex(itTrack));
-            itTrack = mTracks.erase(itTrack);
+            itTrack = releaseTrack(itTrack);
             continue;
           }
           auto itNewTrack = followTrackInOverlapDE(itTrack, itTrack->last().getClusterPtr()->getDEId(), iPlaneSt5 + 1);
@@ -579,7 +612,7 @@ void TrackFinder::findMoreTrackCandidates()
 
             // remove the initial candidate if compatible cluster(s) are found
             print("findMoreTrackCandidates: removing candidate at position #", getTrackIndex(itTrack));
-            itTrack = mTracks.erase(itTrack);
+            itTrack = releaseTrack(itTrack);
 
             // refit the track(s) with new cluster(s) and prepare to continue the tracking in the backward direction
             bool stop(false);
@@ -592,7 +625,7 @@ void TrackFinder::findMoreTrackCandidates()
                 prepareBackwardTracking(itTrack, true);
               } catch (exception const&) {
                 print("findMoreTrackCandidates: removing candidate at position #", getTrackIndex(itTrack));
-                itTrack = mTracks.erase(itTrack);
+                itTrack = releaseTrack(itTrack);
               }
             }
           } else {
@@ -616,7 +649,7 @@ void TrackFinder::findMoreTrackCandidates()
               ++itTrack;
             } else {
               print("findMoreTrackCandidates: removing candidate at position #", getTrackIndex(itTrack));
-              itTrack = mTracks.erase(itTrack);
+              itTrack = releaseTrack(itTrack);
             }
           }
         }
@@ -631,7 +664,7 @@ void TrackFinder::findMoreTrackCandidates()
   auto itTrack = (itLastCandidate == mTracks.end()) ? mTracks.begin() : ++itLastCandidate;
   while (itTrack != mTracks.end()) {
     if (itTrack->isRemovable()) {
-      itTrack = mTracks.erase(itTrack);
+      itTrack = releaseTrack(itTrack);
     } else {
       if (!itTrack->hasCurrentParam()) {
         prepareBackwardTracking(itTrack, false);
@@ -682,22 +715,22 @@ std::list<Track>::iterator TrackFinder::findTrackCandidates(int plane1, int plan
   for (auto& de1 : mClusters[plane1]) {
 
     // skip DE without cluster
-    if (de1.second == nullptr) {
+    if (de1.second.empty()) {
       continue;
     }
 
-    for (const auto cluster1 : *de1.second) {
+    for (const auto cluster1 : de1.second) {
 
       double z1 = cluster1->getZ();
 
       for (auto& de2 : mClusters[plane2]) {
 
         // skip DE without cluster
-        if (de2.second == nullptr) {
+        if (de2.second.empty()) {
           continue;
         }
 
-        for (const auto cluster2 : *de2.second) {
+        for (const auto cluster2 : de2.second) {
 
           // skip combinations of clusters already part of a track if requested
           if (skipUsedPairs && areUsed(*cluster1, *cluster2, usedClusters)) {
@@ -770,7 +803,7 @@ std::list<Track>::iterator TrackFinder::followTrackInOverlapDE(const std::list<T
   for (auto& de : mClusters[plane]) {
 
     // skip DE without cluster
-    if (de.second == nullptr) {
+    if (de.second.empty()) {
       continue;
     }
 
@@ -780,7 +813,7 @@ std::list<Track>::iterator TrackFinder::followTrackInOverlapDE(const std::list<T
     }
 
     // look for cluster candidate in this DE
-    for (const auto cluster : *de.second) {
+    for (const auto cluster : de.second) {
 
       // try to add the current cluster
       if (!isCompatible(currentParam, *cluster, paramAtCluster)) {
@@ -804,8 +837,7 @@ std::list<Track>::iterator TrackFinder::followTrackInOverlapDE(const std::list<T
 
 //_________________________________________________________________________________________________
 std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::iterator& itTrack,
-                                                             int chamber, int lastChamber, bool canSkip,
-                                                             std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters)
+                                                             int chamber, int lastChamber, bool canSkip, ClusterMask& excludedClusters)
 {
   /// Follow the track candidate pointed to by "itTrack" to the given "chamber"
   /// The tracking starts from the current parameters, which must have already been set
@@ -906,8 +938,7 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
 
 //_________________________________________________________________________________________________
 std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::iterator& itTrack,
-                                                             int plane1, int plane2, int lastChamber,
-                                                             std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters)
+                                                             int plane1, int plane2, int lastChamber, ClusterMask& excludedClusters)
 {
   /// Follow the track candidate pointed to by "itTrack" to the (half)chamber formed by "plane1" and "plane2"
   /// The tracking starts from the current parameters, which must have already been set
@@ -958,23 +989,19 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
   TrackParam paramAtCluster1{};
   TrackParam currentParamAtCluster1{};
   TrackParam paramAtCluster2{};
-  std::unordered_map<int, std::unordered_set<uint32_t>> newExcludedClusters{};
+  auto& newExcludedClusters = acquireClusterMask();
   for (auto& de1 : mClusters[plane1]) {
 
     // skip DE without cluster
-    if (de1.second == nullptr) {
+    if (de1.second.empty()) {
       continue;
     }
 
-    // get the list of excluded clusters for the DE
-    auto itExcludedClusters = excludedClusters.find(de1.first);
-    bool hasExcludedClusters = (itExcludedClusters != excludedClusters.end());
-
     // look for cluster candidate in this DE
-    for (const auto cluster1 : *de1.second) {
+    for (const auto cluster1 : de1.second) {
 
       // skip excluded clusters
-      if (hasExcludedClusters && itExcludedClusters->second.count(cluster1->uid) > 0) {
+      if (excludedClusters.test(getClusterIndex(*cluster1))) {
         continue;
       }
 
@@ -984,7 +1011,7 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
       }
 
       // add it to the list of excluded clusters for this candidate
-      excludedClusters[de1.first].emplace(cluster1->uid);
+      excludedClusters.set(getClusterIndex(*cluster1));
 
       // skip tracks out of limits, but after checking for overlaps
       bool isAcceptableAtCluster1 = isAcceptable(paramAtCluster1);
@@ -999,7 +1026,7 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
       for (auto& de2 : mClusters[plane2]) {
 
         // skip DE without cluster
-        if (de2.second == nullptr) {
+        if (de2.second.empty()) {
           continue;
         }
 
@@ -1009,7 +1036,7 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
         }
 
         // look for cluster candidate in this DE
-        for (const auto cluster2 : *de2.second) {
+        for (const auto cluster2 : de2.second) {
 
           // try to add the current cluster
           if (!isCompatible(currentParamAtCluster1, *cluster2, paramAtCluster2)) {
@@ -1019,7 +1046,7 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
           cluster2Found = true;
 
           // add it to the list of excluded clusters for this candidate
-          excludedClusters[de2.first].emplace(cluster2->uid);
+          excludedClusters.set(getClusterIndex(*cluster2));
 
           // skip tracks out of limits
           if (!isAcceptableAtCluster1 || !isAcceptable(paramAtCluster2)) {
@@ -1033,7 +1060,7 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
           }
 
           // transfert the list of new excluded clusters to the full list for the initial candidate
-          moveClusters(newExcludedClusters, excludedClusters);
+          newExcludedClusters.moveTo(excludedClusters);
         }
       }
 
@@ -1046,7 +1073,7 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
         }
 
         // transfert the list of new excluded clusters to the full list for the initial candidate
-        moveClusters(newExcludedClusters, excludedClusters);
+        newExcludedClusters.moveTo(excludedClusters);
       }
     }
   }
@@ -1055,19 +1082,15 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
   for (auto& de2 : mClusters[plane2]) {
 
     // skip DE without cluster
-    if (de2.second == nullptr) {
+    if (de2.second.empty()) {
       continue;
     }
 
-    // get the list of excluded clusters for the DE
-    auto itExcludedClusters = excludedClusters.find(de2.first);
-    bool hasExcludedClusters = (itExcludedClusters != excludedClusters.end());
-
     // look for cluster candidate in this DE
-    for (const auto cluster2 : *de2.second) {
+    for (const auto cluster2 : de2.second) {
 
       // skip excluded clusters (in particular the ones already attached together with a cluster on plane1)
-      if (hasExcludedClusters && itExcludedClusters->second.count(cluster2->uid) > 0) {
+      if (excludedClusters.test(getClusterIndex(*cluster2))) {
         continue;
       }
 
@@ -1077,7 +1100,7 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
       }
 
       // add it to the list of excluded clusters for this candidate
-      excludedClusters[de2.first].emplace(cluster2->uid);
+      excludedClusters.set(getClusterIndex(*cluster2));
 
       // skip tracks out of limits
       if (!isAcceptable(paramAtCluster2)) {
@@ -1091,10 +1114,12 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
       }
 
       // transfert the list of new excluded clusters to the full list for the initial candidate
-      moveClusters(newExcludedClusters, excludedClusters);
+      newExcludedClusters.moveTo(excludedClusters);
     }
   }
 
+  releaseClusterMask();
+
   // reset the current parameters to the ones at that chamber if needed, not adding MCS effects yet
   if (itTrack->getCurrentChamber() != chamber) {
     setCurrentParam(*itTrack, paramAtChamber, chamber);
@@ -1106,7 +1131,7 @@ std::list<Track>::iterator TrackFinder::followTrackInChamber(std::list<Track>::i
 //_________________________________________________________________________________________________
 std::list<Track>::iterator TrackFinder::addClustersAndFollowTrack(std::list<Track>::iterator& itTrack, const TrackParam& paramAtCluster1,
                                                                   const TrackParam* paramAtCluster2, int nextChamber, int lastChamber,
-                                                                  std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters)
+                                                                  ClusterMask& excludedClusters)
 {
   /// If "nextChamber" >= 0: continue the tracking of "itTrack" up to "lastChamber", attach the two clusters
   /// to every new tracks found and return an iterator to the first of them (or mTracks.end() if none is found)
@@ -1239,7 +1264,7 @@ void TrackFinder::improveTracks()
     // Remove the track if it couldn't be improved
     if (removeTrack) {
       print("improveTracks: removing candidate at position #", getTrackIndex(itTrack));
-      itTrack = mTracks.erase(itTrack);
+      itTrack = releaseTrack(itTrack);
     } else {
       ++itTrack;
     }
@@ -1311,7 +1336,7 @@ void TrackFinder::removeConnectedTracks(int stMin, int stMax)
   for (auto itTrack = mTracks.begin(); itTrack != mTracks.end(); ++iTrack) {
     if (remove[iTrack]) {
       print("removeConnectedTracks: removing candidate at position #", getTrackIndex(itTrack));
-      itTrack = mTracks.erase(itTrack);
+      itTrack = releaseTrack(itTrack);
     } else {
       ++itTrack;
     }
@@ -1329,7 +1354,7 @@ void TrackFinder::refineTracks()
       ++itTrack;
     } catch (exception const&) {
       print("refineTracks: removing candidate at position #", getTrackIndex(itTrack));
-      itTrack = mTracks.erase(itTrack);
+      itTrack = releaseTrack(itTrack);
     }
   }
 }
@@ -1358,8 +1383,14 @@ void TrackFinder::createTrack(const Cluster& cl1, const Cluster& cl2)
     throw length_error(string("Too many track candidates (") + mTracks.size() + ")");
   }
 
-  // create the track and the trackParam at each cluster
-  Track& track = mTracks.emplace_back();
+  // create the track, recycling a removed one if any, and the trackParam at each cluster
+  if (mFreeTracks.empty()) {
+    mTracks.emplace_back();
+  } else {
+    mTracks.splice(mTracks.end(), mFreeTracks, mFreeTracks.begin());
+    mTracks.back().reset();
+  }
+  Track& track = mTracks.back();
   track.createParamAtCluster(cl2);
   track.createParamAtCluster(cl1);
   print("createTrack: creating candidate at position #", getTrackIndex(std::prev(mTracks.end())),
@@ -1370,7 +1401,7 @@ void TrackFinder::createTrack(const Cluster& cl1, const Cluster& cl2)
     mTrackFitter.fit(track, false);
   } catch (exception const&) {
     print("... fit failed --> removing it");
-    mTracks.erase(std::prev(mTracks.end()));
+    releaseTrack(std::prev(mTracks.end()));
   }
 }
 
@@ -1378,12 +1409,36 @@ void TrackFinder::createTrack(const Cluster& cl1, const Cluster& cl2)
 std::list<Track>::iterator TrackFinder::addTrack(const std::list<Track>::iterator& pos, const Track& track)
 {
   /// Add the given track at the requested position in the list of tracks
+  /// Recycle a removed track if any, reusing the memory of its track parameters
   /// Throw an exception if the maximum number of tracks is exceeded
   if (mTracks.size() >= TrackerParam::Instance().maxCandidates) {
     mErrorMap.add(ErrorType::Tracking_TooManyCandidates, 0, 0);
     throw length_error(string("Too many track candidates (") + mTracks.size() + ")");
   }
-  return mTracks.emplace(pos, track);
+  if (mFreeTracks.empty()) {
+    return mTracks.emplace(pos, track);
+  }
+  mTracks.splice(pos, mFreeTracks, mFreeTracks.begin());
+  auto itNewTrack = std::prev(pos);
+  *itNewTrack = track;
+  return itNewTrack;
+}
+
+//_________________________________________________________________________________________________
+std::list<Track>::iterator TrackFinder::releaseTrack(const std::list<Track>::iterator& itTrack)
+{
+  /// Remove the track from the list of tracks and keep it to be recycled
+  /// Return an iterator to the track that follows
+  auto itNextTrack = std::next(itTrack);
+  mFreeTracks.splice(mFreeTracks.end(), mTracks, itTrack);
+  return itNextTrack;
+}
+
+//_________________________________________________________________________________________________
+void TrackFinder::releaseTracks()
+{
+  /// Remove all the tracks from the list of tracks and keep them to be recycled
+  mFreeTracks.splice(mFreeTracks.end(), mTracks);
 }
 
 //_________________________________________________________________________________________________
@@ -1529,10 +1584,11 @@ bool TrackFinder::areUsed(const Cluster& cl1, const Cluster& cl2, const std::vec
 //_________________________________________________________________________________________________
 void TrackFinder::excludeClustersFromIdenticalTracks(const std::array<uint32_t, 4>& currentClusters,
                                                      const std::vector<std::array<uint32_t, 8>>& usedClusters,
-                                                     std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters)
+                                                     ClusterMask& excludedClusters)
 {
   /// Find the combinations of usedClusters using all the currentClusters on station 4
   /// and add the clusters from these combinations on station 5 in the excludedClusters list
+  /// The clusters are identified by their index in the ROF + 1, 0 meaning no cluster
 
   for (const auto& clusters : usedClusters) {
 
@@ -1547,7 +1603,7 @@ void TrackFinder::excludeClustersFromIdenticalTracks(const std::array<uint32_t,
     if (identicalTrack) {
       for (int iCl = 4; iCl < 8; ++iCl) {
         if (clusters[iCl] > 0) {
-          excludedClusters[Cluster::getDEId(clusters[iCl])].emplace(clusters[iCl]);
+          excludedClusters.set(clusters[iCl] - 1);
         }
       }
     }
@@ -1555,13 +1611,13 @@ void TrackFinder::excludeClustersFromIdenticalTracks(const std::array<uint32_t,
 }
 
 //_________________________________________________________________________________________________
-void TrackFinder::moveClusters(std::unordered_map<int, std::unordered_set<uint32_t>>& source, std::unordered_map<int, std::unordered_set<uint32_t>>& destination)
+TrackFinder::ClusterMask& TrackFinder::acquireClusterMask()
 {
-  /// Move cluster Ids listed in source into destination then clear source
-  for (auto& sourceDE : source) {
-    destination[sourceDE.first].insert(sourceDE.second.begin(), sourceDE.second.end());
+  /// Return an empty cluster mask from the pool, to be given back with releaseClusterMask() once no longer used
+  if (mNClusterMasksInUse == mClusterMasks.size()) {
+    mClusterMasks.emplace_back().reset(mNClusters);
   }
-  source.clear();
+  return mClusterMasks[mNClusterMasksInUse++];
 }
 
 //_________________________________________________________________________________________________
@@ -54,6 +54,7 @@ struct ReaderInp {
   uint32_t maxTF = 0xffffffff;
   bool partPerSP = true;
   bool cache = false;
+  bool mmap = false;
   bool autodetectTF0 = false;
   bool preferCalcTF = false;
   bool sup0xccdb = false;
@@ -209,6 +210,7 @@ class RawFileReader
     size_t readNextHBF(char* buff);
     size_t readNextTF(char* buff);
     size_t readNextSuperPage(char* buff, const PartStat* pstat = nullptr);
+    size_t mapNextSuperPage(const char*& ptr, const PartStat* pstat = nullptr);
     size_t skipNextHBF();
     size_t skipNextTF();
 
@@ -217,6 +219,8 @@ class RawFileReader
     std::string describe() const;
 
    private:
+    int getNextSuperPageEnd(size_t& sz, const PartStat* pstat) const;
+
     RawFileReader* reader = nullptr; //!
   };
 
@@ -272,6 +276,9 @@ class RawFileReader
   bool getCacheData() const { return mCacheData; }
   void setCacheData(bool v) { mCacheData = v; }
 
+  bool getUseMMap() const { return mUseMMap; }
+  void setUseMMap(bool v) { mUseMMap = v; } // must be set before init()
+
   o2::header::DataOrigin getDefaultDataOrigin() const { return mDefDataOrigin; }
   o2::header::DataDescription getDefaultDataSpecification() const { return mDefDataDescription; }
   ReadoutCardType getDefaultReadoutCardType() const { return mDefCardType; }
@@ -292,6 +299,11 @@ class RawFileReader
  private:
   int getLinkLocalID(const RDHAny& rdh, int fileID);
   bool preprocessFile(int ifl);
+  bool preprocessMappedFile(int ifl, const std::vector<size_t>& rdhOffsets);
+  bool preprocessRDH(const RDHAny& rdh, LinkSpec_t& specPrev, int& lIDPrev);
+  bool mapFiles();
+  void unmapFiles();
+  void indexMappedFiles(std::vector<std::vector<size_t>>& rdhOffsets) const;
   static LinkSpec_t createSpec(o2::header::DataOrigin orig, LinkSubSpec_t ss) { return (LinkSpec_t(orig) << 32) | ss; }
 
   static constexpr o2::header::DataOrigin DEFDataOrigin = o2::header::gDataOriginFLP;
@@ -303,6 +315,7 @@ class RawFileReader
   std::vector<std::string> mFileNames;                                  //! input file names
   std::vector<FILE*> mFiles;                                            //! input file handlers
   std::vector<std::unique_ptr<char[]>> mFileBuffers;                    //! buffers for input files
+  std::vector<std::pair<const char*, size_t>> mMappedFiles;             //! read-only mappings of input files and their sizes
   std::vector<OrigDescCard> mDataSpecs;                                 //! data origin and description for every input file + readout card type
   bool mInitDone = false;
   bool mEmpty = true;
@@ -320,6 +333,7 @@ class RawFileReader
   long int mPosInFile = 0;                                          //! current position in the file
   bool mMultiLinkFile = false;                                      //! was > than 1 link seen in the file?
   bool mCacheData = false;                                          //! cache data to block after 1st scan (may require excessive memory, use with care)
+  bool mUseMMap = false;                                            //! memory-map input files instead of reading them
   bool mStopProcessing = false;                                     //! stop processing after error
   uint32_t mCheckErrors = 0;                                        //! mask for errors to check
   FirstTFDetection mFirstTFAutodetect = FirstTFDetection::Disabled; //!
@@ -14,12 +14,14 @@
 /// @brief  Reader for (multiple) raw data files
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <memory>
 #include <sstream>
 #include <iostream>
+#include <thread>
 #include "DetectorsRaw/RawFileReader.h"
 #include "Headers/DAQID.h"
 #include "CommonConstants/Triggers.h"
@@ -30,6 +32,8 @@
 #include <Common/Configuration.h>
 #include <TStopwatch.h>
 #include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 using namespace o2::raw;
 namespace o2h = o2::header;
@@ -133,6 +137,8 @@ size_t RawFileReader::LinkData::readNextHBF(char* buff)
     ibl++;
     if (blc.dataCache) {
       memcpy(buff + sz, blc.dataCache.get(), blc.size);
+    } else if (reader->mUseMMap) {
+      memcpy(buff + sz, reader->mMappedFiles[blc.fileID].first + blc.offset, blc.size);
     } else {
       auto fl = reader->mFiles[blc.fileID];
       if (fseek(fl, blc.offset, SEEK_SET) || fread(buff + sz, 1, blc.size, fl) != blc.size) {
@@ -258,16 +264,11 @@ int RawFileReader::LinkData::getNHBFinTF() const
 }
 
 //____________________________________________
-size_t RawFileReader::LinkData::readNextSuperPage(char* buff, const RawFileReader::PartStat* pstat)
+int RawFileReader::LinkData::getNextSuperPageEnd(size_t& sz, const RawFileReader::PartStat* pstat) const
 {
-  // read data of the next complete HB, buffer of getNextHBFSize() must be allocated in advance
-  size_t sz = 0;
-  if (nextBlock2Read < 0) { // negative nextBlock2Read signals absence of data
-    return sz;
-  }
+  // find the size of the next superpage and the block following it
   int ibl = nextBlock2Read, nbl = blocks.size();
-  auto tfID = blocks[nextBlock2Read].tfID;
-  bool error = false;
+  sz = 0;
   if (pstat) { // info is provided, use it derictly
     sz = pstat->size;
     ibl += pstat->nBlocks;
@@ -284,9 +285,24 @@ size_t RawFileReader::LinkData::readNextSuperPage(char* buff, const RawFileReade
       sz += blc.size;
     }
   }
+  return ibl;
+}
+
+//____________________________________________
+size_t RawFileReader::LinkData::readNextSuperPage(char* buff, const RawFileReader::PartStat* pstat)
+{
+  // read data of the next complete HB, buffer of getNextHBFSize() must be allocated in advance
+  size_t sz = 0;
+  if (nextBlock2Read < 0) { // negative nextBlock2Read signals absence of data
+    return sz;
+  }
+  int ibl = getNextSuperPageEnd(sz, pstat);
+  bool error = false;
   if (sz) {
     if (reader->mCacheData && blocks[nextBlock2Read].dataCache) {
       memcpy(buff, blocks[nextBlock2Read].dataCache.get(), sz);
+    } else if (reader->mUseMMap) {
+      memcpy(buff, reader->mMappedFiles[blocks[nextBlock2Read].fileID].first + blocks[nextBlock2Read].offset, sz);
     } else {
       auto fl = reader->mFiles[blocks[nextBlock2Read].fileID];
       if (fseek(fl, blocks[nextBlock2Read].offset, SEEK_SET) || fread(buff, 1, sz, fl) != sz) {
@@ -303,6 +319,29 @@ size_t RawFileReader::LinkData::readNextSuperPage(char* buff, const RawFileReade
   return error ? 0 : sz; // in case of the error we ignore the data
 }
 
+//____________________________________________
+size_t RawFileReader::LinkData::mapNextSuperPage(const char*& ptr, const RawFileReader::PartStat* pstat)
+{
+  // provide the pointer on the next superpage in the memory-mapped input file w/o copying the data,
+  // it stays valid until the reader is cleared
+  size_t sz = 0;
+  ptr = nullptr;
+  if (nextBlock2Read < 0) { // negative nextBlock2Read signals absence of data
+    return sz;
+  }
+  if (!reader->mUseMMap) {
+    LOGF(error, "Superpage of the %s can be mapped only for memory-mapped input files", describe());
+    return sz;
+  }
+  int ibl = getNextSuperPageEnd(sz, pstat);
+  if (!sz) { // nothing mapped, leave the superpage to the caller falling back to readNextSuperPage
+    return sz;
+  }
+  ptr = reader->mMappedFiles[blocks[nextBlock2Read].fileID].first + blocks[nextBlock2Read].offset;
+  nextBlock2Read = ibl;
+  return sz;
+}
+
 //____________________________________________
 size_t RawFileReader::LinkData::getLargestSuperPage() const
 {
@@ -596,40 +635,12 @@ bool RawFileReader::preprocessFile(int ifl)
         break;
       }
       nRDHread++;
-      LinkSpec_t spec = createSpec(std::get<0>(mDataSpecs[mCurrentFileID]), RDHUtils::getSubSpec(rdh));
-      int lID = lIDPrev;
-      if (spec != specPrev) { // link has changed
-        specPrev = spec;
-        if (lIDPrev != -1) {
-          mMultiLinkFile = true;
-        }
-        lID = getLinkLocalID(rdh, mCurrentFileID);
-      }
-      bool newSPage = lID != lIDPrev;
-      try {
-        mLinksData[lID].preprocessCRUPage(rdh, newSPage);
-      } catch (...) {
-        LOG(error) << "Corrupted data, abandoning processing";
-        mStopProcessing = true;
-        break;
-      }
-
-      if (mLinksData[lID].nTimeFrames && (mLinksData[lID].nTimeFrames - 1 > mMaxTFToRead)) { // limit reached, discard the last read
-        mLinksData[lID].nTimeFrames--;
-        mLinksData[lID].blocks.pop_back();
-        if (mLinksData[lID].nHBFrames > 0) {
-          mLinksData[lID].nHBFrames--;
-        }
-        if (mLinksData[lID].nCRUPages > 0) {
-          mLinksData[lID].nCRUPages--;
-        }
-        lIDPrev = -1; // last block is closed
+      if (!preprocessRDH(rdh, specPrev, lIDPrev)) {
         readMore = false;
         break;
       }
       boffs += RDHUtils::getOffsetToNext(rdh);
       mPosInFile += RDHUtils::getOffsetToNext(rdh);
-      lIDPrev = lID;
       if (boffs + sizeof(RDHUtils::RDHAny) >= nr) {
         if (fseek(fl, mPosInFile, SEEK_SET)) {
           readMore = false;
@@ -644,6 +655,147 @@ bool RawFileReader::preprocessFile(int ifl)
   return nRDHread > 0;
 }
 
+//_____________________________________________________________________
+bool RawFileReader::preprocessMappedFile(int ifl, const std::vector<size_t>& rdhOffsets)
+{
+  // preprocess memory-mapped file using the RDH positions found by indexMappedFiles
+  const char* data = mMappedFiles[ifl].first;
+  mCurrentFileID = ifl;
+  LinkSpec_t specPrev = 0xffffffffffffffff;
+  int lIDPrev = -1;
+  mMultiLinkFile = false;
+  mPosInFile = 0;
+  size_t nRDHread = 0;
+  for (auto offs : rdhOffsets) {
+    const auto& rdh = *reinterpret_cast<const RDHUtils::RDHAny*>(data + offs);
+    mPosInFile = offs;
+    nRDHread++;
+    if (!preprocessRDH(rdh, specPrev, lIDPrev)) {
+      break;
+    }
+    mPosInFile += RDHUtils::getOffsetToNext(rdh);
+  }
+  LOGF(info, "File %3d : %9li bytes scanned, %6d RDH read for %4d links from %s",
+       mCurrentFileID, mPosInFile, nRDHread, int(mLinkEntries.size()), mFileNames[mCurrentFileID]);
+  return nRDHread > 0;
+}
+
+//_____________________________________________________________________
+bool RawFileReader::preprocessRDH(const RDHAny& rdh, LinkSpec_t& specPrev, int& lIDPrev)
+{
+  // account the RDH found at mPosInFile of the current file, return false if the file scanning should stop
+  LinkSpec_t spec = createSpec(std::get<0>(mDataSpecs[mCurrentFileID]), RDHUtils::getSubSpec(rdh));
+  int lID = lIDPrev;
+  if (spec != specPrev) { // link has changed
+    specPrev = spec;
+    if (lIDPrev != -1) {
+      mMultiLinkFile = true;
+    }
+    lID = getLinkLocalID(rdh, mCurrentFileID);
+  }
+  bool newSPage = lID != lIDPrev;
+  try {
+    mLinksData[lID].preprocessCRUPage(rdh, newSPage);
+  } catch (...) {
+    LOG(error) << "Corrupted data, abandoning processing";
+    mStopProcessing = true;
+    return false;
+  }
+
+  if (mLinksData[lID].nTimeFrames && (mLinksData[lID].nTimeFrames - 1 > mMaxTFToRead)) { // limit reached, discard the last read
+    mLinksData[lID].nTimeFrames--;
+    mLinksData[lID].blocks.pop_back();
+    if (mLinksData[lID].nHBFrames > 0) {
+      mLinksData[lID].nHBFrames--;
+    }
+    if (mLinksData[lID].nCRUPages > 0) {
+      mLinksData[lID].nCRUPages--;
+    }
+    lIDPrev = -1; // last block is closed
+    return false;
+  }
+  lIDPrev = lID;
+  return true;
+}
+
+//_____________________________________________________________________
+bool RawFileReader::mapFiles()
+{
+  // map all input files read-only to memory
+  mMappedFiles.clear();
+  for (int ifl = 0; ifl < int(mFiles.size()); ifl++) {
+    int fd = fileno(mFiles[ifl]);
+    struct stat st;
+    if (fstat(fd, &st)) {
+      LOG(error) << "Failed to stat input file " << mFileNames[ifl];
+      return false;
+    }
+    size_t size = st.st_size;
+    void* addr = nullptr;
+    if (size) { // empty files cannot be mapped and have nothing to provide
+      addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr == MAP_FAILED) {
+        LOG(error) << "Failed to map input file " << mFileNames[ifl];
+        return false;
+      }
+      madvise(addr, size, MADV_WILLNEED);
+    }
+    mMappedFiles.emplace_back(static_cast<const char*>(addr), size);
+  }
+  return true;
+}
+
+//_____________________________________________________________________
+void RawFileReader::unmapFiles()
+{
+  // release the mappings of the input files
+  for (const auto& [data, size] : mMappedFiles) {
+    if (data) {
+      munmap(const_cast<char*>(data), size);
+    }
+  }
+  mMappedFiles.clear();
+}
+
+//_____________________________________________________________________
+void RawFileReader::indexMappedFiles(std::vector<std::vector<size_t>>& rdhOffsets) const
+{
+  // find positions of all RDHs in the memory-mapped files, each file is scanned by its own thread
+  int nf = mMappedFiles.size();
+  rdhOffsets.clear();
+  rdhOffsets.resize(nf);
+  auto indexFile = [this, &rdhOffsets](int ifl) {
+    const auto [data, size] = mMappedFiles[ifl];
+    auto& offsets = rdhOffsets[ifl];
+    size_t pos = 0;
+    while (pos < size) {
+      if (pos + sizeof(RDHUtils::RDHAny) > size) {
+        LOGP(warning, "File {} truncated current file pos {} + RDH size {} > fileSize {}", ifl, pos, sizeof(RDHUtils::RDHAny), size);
+        break;
+      }
+      const auto& rdh = *reinterpret_cast<const RDHUtils::RDHAny*>(data + pos);
+      auto offsetToNext = RDHUtils::getOffsetToNext(rdh);
+      if ((pos + offsetToNext) > size) {
+        LOGP(warning, "File {} truncated current file pos {} + offsetToNext {} > fileSize {}", ifl, pos, offsetToNext, size);
+        break;
+      }
+      offsets.push_back(pos);
+      if (!offsetToNext) { // corrupted RDH, let the preprocessing report it
+        break;
+      }
+      pos += offsetToNext;
+    }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(nf);
+  for (int ifl = 0; ifl < nf; ifl++) {
+    threads.emplace_back(indexFile, ifl);
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+}
+
 //_____________________________________________________________________
 void RawFileReader::printStat(bool verbose) const
 {
@@ -662,6 +814,7 @@ void RawFileReader::clear()
   mLinkEntries.clear();
   mOrderedIDs.clear();
   mLinksData.clear();
+  unmapFiles();
   for (auto fl : mFiles) {
     fclose(fl);
   }
@@ -724,8 +877,22 @@ bool RawFileReader::init()
 
   int nf = mFiles.size();
   mEmpty = true;
+  std::vector<std::vector<size_t>> rdhOffsets;
+  if (mUseMMap) {
+    if (mapFiles()) {
+      indexMappedFiles(rdhOffsets);
+      if (mCacheData) {
+        LOG(info) << "Data caching is not needed for memory-mapped input files, disabling it";
+        mCacheData = false;
+      }
+    } else {
+      LOG(warning) << "Failed to map input files, falling back to reading them";
+      unmapFiles();
+      mUseMMap = false;
+    }
+  }
   for (int i = 0; i < nf; i++) {
-    if (preprocessFile(i)) {
+    if (mUseMMap ? preprocessMappedFile(i, rdhOffsets[i]) : preprocessFile(i)) {
       mEmpty = false;
     }
   }
@@ -102,6 +102,7 @@ RawReaderSpecs::RawReaderSpecs(const ReaderInp& rinp)
   mReader->setMaxTFToRead(rinp.maxTF);
   mReader->setNominalSPageSize(rinp.spSize);
   mReader->setCacheData(rinp.cache);
+  mReader->setUseMMap(rinp.mmap);
   mReader->setTFAutodetect(rinp.autodetectTF0 ? RawFileReader::FirstTFDetection::Pending : RawFileReader::FirstTFDetection::Disabled);
   mReader->setPreferCalculatedTFStart(rinp.preferCalcTF);
   LOG(info) << "Will preprocess files with buffer size of " << rinp.bufferSize << " bytes";
@@ -266,8 +267,18 @@ void RawReaderSpecs::run(o2f::ProcessingContext& ctx)
     while (hdrTmpl.splitPayloadIndex < hdrTmpl.splitPayloadParts) {
       hdrTmpl.payloadSize = mPartPerSP ? partsSP[hdrTmpl.splitPayloadIndex].size : link.getNextHBFSize();
       auto hdMessage = fmqFactory->CreateMessage(hstackSize, fair::mq::Alignment{64});
-      auto plMessage = fmqFactory->CreateMessage(hdrTmpl.payloadSize, fair::mq::Alignment{64});
-      auto bread = mPartPerSP ? link.readNextSuperPage(reinterpret_cast<char*>(plMessage->GetData()), &partsSP[hdrTmpl.splitPayloadIndex]) : link.readNextHBF(reinterpret_cast<char*>(plMessage->GetData()));
+      fair::mq::MessagePtr plMessage;
+      size_t bread = 0;
+      const char* spData = nullptr;
+      if (mPartPerSP && mReader->getUseMMap()) {
+        bread = link.mapNextSuperPage(spData, &partsSP[hdrTmpl.splitPayloadIndex]);
+      }
+      if (spData) { // the superpage is contiguous in the mapped file: the shmem transport copies it once to the segment, others send it directly
+        plMessage = fmqFactory->CreateMessage(const_cast<char*>(spData), bread, [](void*, void*) {}, nullptr); // mapping is owned by the reader
+      } else {
+        plMessage = fmqFactory->CreateMessage(hdrTmpl.payloadSize, fair::mq::Alignment{64});
+        bread = mPartPerSP ? link.readNextSuperPage(reinterpret_cast<char*>(plMessage->GetData()), &partsSP[hdrTmpl.splitPayloadIndex]) : link.readNextHBF(reinterpret_cast<char*>(plMessage->GetData()));
+      }
       if (bread != hdrTmpl.payloadSize) {
         LOG(error) << "Link " << il << " read " << bread << " bytes instead of " << hdrTmpl.payloadSize
                    << " expected in TF=" << mTFCounter << " part=" << hdrTmpl.splitPayloadIndex;
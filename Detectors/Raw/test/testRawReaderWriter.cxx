@@ -13,7 +13,9 @@
 #define BOOST_TEST_MAIN
 #define BOOST_TEST_DYN_LINK
 #include <algorithm>
+#include <cstring>
 #include <string>
+#include <vector>
 #include <iostream>
 #include <fstream>
 #include <TRandom.h>
@@ -189,9 +191,10 @@ struct TestRawReader { // simple class to read detector raw data for multiple li
 
   std::unique_ptr<RawFileReader> reader;
   std::string confName;
+  bool useMMap = false;
 
   //_________________________________________________________________
-  TestRawReader(const std::string& name = "TST", const std::string& cfg = "rawConf.cfg") : confName(cfg) {}
+  TestRawReader(const std::string& name = "TST", const std::string& cfg = "rawConf.cfg", bool mmap = false) : confName(cfg), useMMap(mmap) {}
 
   //_________________________________________________________________
   void init()
@@ -200,6 +203,7 @@ struct TestRawReader { // simple class to read detector raw data for multiple li
     uint32_t errCheck = 0xffffffff;
     errCheck ^= 0x1 << RawFileReader::ErrNoSuperPageForTF; // makes no sense for superpages not interleaved by others
     reader->setCheckErrors(errCheck);
+    reader->setUseMMap(useMMap);
     reader->init();
   }
 
@@ -329,4 +333,37 @@ BOOST_AUTO_TEST_CASE(RawReaderWriter_RORC)
   dr.run(); // read back and check
 }
 
+BOOST_AUTO_TEST_CASE(RawReaderWriter_MMap)
+{
+  TestRawWriter dw{"TST", true, "test_raw_conf_GBT.cfg"};
+  dw.init();
+  dw.run();
+  //
+  TestRawReader dr{"TST", "test_raw_conf_GBT.cfg", true}; // read back from memory-mapped files
+  dr.init();
+  BOOST_CHECK(dr.reader->getUseMMap());
+  dr.run();
+
+  // superpages provided w/o copy must be identical to those read from the files
+  TestRawReader drf{"TST", "test_raw_conf_GBT.cfg"}, drm{"TST", "test_raw_conf_GBT.cfg", true};
+  drf.init();
+  drm.init();
+  BOOST_CHECK(drf.reader->getNLinks() == drm.reader->getNLinks());
+  std::vector<char> buff;
+  for (int il = 0; il < drf.reader->getNLinks(); il++) {
+    auto& lnkf = drf.reader->getLink(il);
+    auto& lnkm = drm.reader->getLink(il);
+    const char* ptr = nullptr;
+    size_t sz = 0;
+    do {
+      buff.resize(lnkf.getLargestSuperPage());
+      sz = lnkf.readNextSuperPage(buff.data());
+      BOOST_CHECK(lnkm.mapNextSuperPage(ptr) == sz);
+      if (sz) {
+        BOOST_CHECK(ptr && memcmp(ptr, buff.data(), sz) == 0);
+      }
+    } while (sz);
+  }
+}
+
 } // namespace o2
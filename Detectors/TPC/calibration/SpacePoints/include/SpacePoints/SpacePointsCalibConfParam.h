@@ -88,6 +88,7 @@ struct SpacePointsCalibConfParam : public o2::conf::ConfigurableParamHelper<Spac
   float maxSigY = 1.1f;                ///< maximum sigma for y of the voxel
   float maxSigZ = .7f;                 ///< maximum sigma for z of the voxel
   float maxGaussStdDev = 5.f;          ///< maximum number of sigmas to be considered for gaussian kernel smoothing
+  int nThreads = 1;                    ///< number of threads used for the extraction and smoothing of the voxel residuals of a sector
 
   O2ParamDef(SpacePointsCalibConfParam, "scdcalib");
 };
@@ -159,6 +159,7 @@ class TrackResiduals
   // -------------------------------------- steering functions --------------------------------------------------
 
   /// Processes residuals for given sector.
+  /// The voxels are processed by SpacePointsCalibConfParam::nThreads threads, the results do not depend on the number of threads.
   /// \param iSec Sector to process
   void processSectorResiduals(Int_t iSec);
 
@@ -182,6 +183,7 @@ class TrackResiduals
   int validateVoxels(int iSec);
 
   /// Smooths the residuals for given sector
+  /// The voxels are smoothed by SpacePointsCalibConfParam::nThreads threads.
   /// \param iSec Sector to process
   void smooth(int iSec);
 
@@ -444,6 +446,41 @@ class TrackResiduals
   TTree* getOutputTree() { return mTreeOut.get(); }
 
  private:
+  /// Buffers for the processing of a single voxel.
+  /// They are allocated once per thread and reused for all voxels, such that the fits do not allocate memory for each voxel.
+  struct VoxelBuffers {
+    std::vector<float> dy;        ///< residuals in y
+    std::vector<float> dz;        ///< residuals in z
+    std::vector<float> tg;        ///< tan(phi) of the tracks
+    std::vector<float> ycm;       ///< residuals in y after the crude slope correction of the robust fit
+    std::vector<float> tmp;       ///< working copy for the medians and for reordering
+    std::vector<size_t> indices;  ///< indices of the sorted data
+    std::vector<size_t> indicesY; ///< indices of the sorted residuals in y
+    void reserve(size_t nPoints);
+  };
+
+  /// Same as the public processVoxelResiduals(), using the given buffers for all temporaries
+  void processVoxelResiduals(std::vector<float>& dy, std::vector<float>& dz, std::vector<float>& tg, VoxRes& resVox, VoxelBuffers& buffers);
+
+  /// Same as the public processVoxelDispersions(), using the given buffers for all temporaries
+  void processVoxelDispersions(std::vector<float>& tg, std::vector<float>& dy, VoxRes& resVox, VoxelBuffers& buffers);
+
+  /// Same as the public fitPoly1Robust(), using buffers.ycm, buffers.tmp, buffers.indices and buffers.indicesY as temporaries.
+  /// x and y may be buffers.tg and buffers.dy (as in processVoxelResiduals()), but not one of the temporaries.
+  float fitPoly1Robust(std::vector<float>& x, std::vector<float>& y, std::array<float, 2>& res, std::array<float, 3>& err, float cutLTM, VoxelBuffers& buffers) const;
+
+  /// Same as the public medFit(), using vecTmp as working buffer
+  void medFit(int nPoints, int offset, const std::vector<float>& x, const std::vector<float>& y, float& a, float& b, std::array<float, 3>& err, std::vector<float>& vecTmp) const;
+
+  /// Same as the public roFunc(), using vecTmp as working buffer
+  float roFunc(int nPoints, int offset, const std::vector<float>& x, const std::vector<float>& y, float b, float& aa, std::vector<float>& vecTmp) const;
+
+  /// Same as getMAD2Sigma(), but rearranging the input data instead of working on a copy
+  static float getMAD2SigmaInPlace(std::vector<float>& data);
+
+  /// Rearranges the data in the order given by the index vector, as o2::math_utils::Reorder, using tmp as working buffer
+  static void reorder(std::vector<float>& data, const std::vector<size_t>& index, std::vector<float>& tmp);
+
   std::bitset<SECTORSPERSIDE * SIDES> mInitResultsContainer{};
 
   // some constants
@@ -493,7 +530,6 @@ class TrackResiduals
   std::array<int, VoxDim> mStepKern{};                             ///< N bins to consider with given kernel settings
   std::array<float, VoxDim> mKernelScaleEdge{};                    ///< optional scaling factors for kernel width on the edge
   std::array<float, VoxDim> mKernelWInv{};                         ///< inverse kernel width in bins
-  std::array<double, ResDim * sMaxSmtDim> mLastSmoothingRes{};     ///< results of last smoothing operation
   // calibrated parameters
   float mEffVdriftCorr{0.f}; ///< global correction factor for vDrift based on d(delta(z))/dz fit
   float mEffT0Corr{0.f};     ///< global correction for T0 shift from offset of d(delta(z))/dz fit
@@ -504,7 +540,7 @@ class TrackResiduals
   VoxRes mVoxelResultsOut{};                                                                ///< the results from mVoxelResults are copied in here to be able to stream them
   VoxRes* mVoxelResultsOutPtr{&mVoxelResultsOut};                                           ///< pointer to set the branch address to for the output
 
-  ClassDefNV(TrackResiduals, 3);
+  ClassDefNV(TrackResiduals, 4);
 };
 
 //_____________________________________________________
@@ -39,8 +39,25 @@
 
 #include <fairlogger/Logger.h>
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace o2::tpc;
 
+namespace
+{
+/// index of the calling thread inside a parallel region, 0 outside
+int getThreadID()
+{
+#ifdef WITH_OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
+} // namespace
+
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// initialization + binning
@@ -359,6 +376,18 @@ void TrackResiduals::fillStats(int iSec)
   }
 }
 
+//______________________________________________________________________________
+void TrackResiduals::VoxelBuffers::reserve(size_t nPoints)
+{
+  dy.reserve(nPoints);
+  dz.reserve(nPoints);
+  tg.reserve(nPoints);
+  ycm.reserve(nPoints);
+  tmp.reserve(nPoints);
+  indices.reserve(nPoints);
+  indicesY.reserve(nPoints);
+}
+
 //______________________________________________________________________________
 void TrackResiduals::processSectorResiduals(int iSec)
 {
@@ -376,44 +405,49 @@ void TrackResiduals::processSectorResiduals(int iSec)
   // fill the voxel statistics into the results container
   std::vector<VoxRes>& secData = mVoxelResults[iSec];
 
-  // vectors holding the data for one voxel at a time
-  std::vector<float> dyVec;
-  std::vector<float> dzVec;
-  std::vector<float> tgVec;
-  // assuming we will always have around 1000 entries per voxel
-  dyVec.reserve(1e3);
-  dzVec.reserve(1e3);
-  tgVec.reserve(1e3);
-  size_t currVoxBin = -1;
-  unsigned int nPointsInVox = 0;
-  unsigned int nProcessed = 0;
-  while (nProcessed < binData.size()) {
-    // read all points, voxel by voxel
-    int idx = binIndices[nProcessed];
-    if (currVoxBin != binData[idx]) {
-      if (nPointsInVox) {
-        VoxRes& resVox = secData[currVoxBin];
-        processVoxelResiduals(dyVec, dzVec, tgVec, resVox);
+  // the points of the n-th voxel with data are binIndices[voxelStart[n]] ... binIndices[voxelStart[n + 1] - 1]
+  std::vector<size_t> voxelStart;
+  size_t maxPointsInVox = 0;
+  for (size_t iPoint = 0; iPoint < binData.size(); ++iPoint) {
+    if (iPoint == 0 || binData[binIndices[iPoint]] != binData[binIndices[iPoint - 1]]) {
+      if (!voxelStart.empty()) {
+        maxPointsInVox = std::max(maxPointsInVox, iPoint - voxelStart.back());
       }
-      currVoxBin = binData[idx];
-      nPointsInVox = 0;
-      dyVec.clear();
-      dzVec.clear();
-      tgVec.clear();
+      voxelStart.push_back(iPoint);
     }
-    dyVec.push_back(mLocalResidualsIn[idx].dy * param::MaxResid / 0x7fff);
-    dzVec.push_back(mLocalResidualsIn[idx].dz * param::MaxResid / 0x7fff -
-                    mEffVdriftCorr * secData[currVoxBin].stat[VoxZ] * secData[currVoxBin].stat[VoxX] -
-                    effT0corr);
-    tgVec.push_back(mLocalResidualsIn[idx].tgSlp * param::MaxTgSlp / 0x7fff);
+  }
+  if (!voxelStart.empty()) {
+    maxPointsInVox = std::max(maxPointsInVox, binData.size() - voxelStart.back());
+  }
+  voxelStart.push_back(binData.size());
+  const int nVoxWithData = voxelStart.size() - 1;
 
-    ++nPointsInVox;
-    ++nProcessed;
+  // the voxels are independent from each other, each thread uses its own buffers
+  const int nThreads = std::max(1, mParams->nThreads);
+  std::vector<VoxelBuffers> buffers(nThreads);
+  for (auto& buffer : buffers) {
+    buffer.reserve(maxPointsInVox);
   }
-  if (nPointsInVox) {
-    // process last voxel
+
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+#endif
+  for (int iVoxData = 0; iVoxData < nVoxWithData; ++iVoxData) {
+    auto& buffer = buffers[getThreadID()];
+    buffer.dy.clear();
+    buffer.dz.clear();
+    buffer.tg.clear();
+    const size_t currVoxBin = binData[binIndices[voxelStart[iVoxData]]];
     VoxRes& resVox = secData[currVoxBin];
-    processVoxelResiduals(dyVec, dzVec, tgVec, resVox);
+    for (size_t iPoint = voxelStart[iVoxData]; iPoint < voxelStart[iVoxData + 1]; ++iPoint) {
+      const auto& res = mLocalResidualsIn[binIndices[iPoint]];
+      buffer.dy.push_back(res.dy * param::MaxResid / 0x7fff);
+      buffer.dz.push_back(res.dz * param::MaxResid / 0x7fff -
+                          mEffVdriftCorr * resVox.stat[VoxZ] * resVox.stat[VoxX] -
+                          effT0corr);
+      buffer.tg.push_back(res.tgSlp * param::MaxTgSlp / 0x7fff);
+    }
+    processVoxelResiduals(buffer.dy, buffer.dz, buffer.tg, resVox, buffer);
   }
   LOG(info) << "extracted residuals for sector " << iSec;
 
@@ -427,38 +461,29 @@ void TrackResiduals::processSectorResiduals(int iSec)
   }
 
   // process dispersions
-  dyVec.clear();
-  tgVec.clear();
-  currVoxBin = -1;
-  nProcessed = 0;
-  nPointsInVox = 0;
-  while (nProcessed < binData.size()) {
-    int idx = binIndices[nProcessed];
-    if (currVoxBin != binData[idx]) {
-      if (nPointsInVox) {
-        VoxRes& resVox = secData[currVoxBin];
-        if (!getXBinIgnored(iSec, resVox.bvox[VoxX])) {
-          processVoxelDispersions(tgVec, dyVec, resVox);
-        }
-      }
-      currVoxBin = binData[idx];
-      nPointsInVox = 0;
-      dyVec.clear();
-      tgVec.clear();
-    }
-    dyVec.push_back(mLocalResidualsIn[idx].dy * param::MaxResid / 0x7fff);
-    tgVec.push_back(mLocalResidualsIn[idx].tgSlp * param::MaxTgSlp / 0x7fff);
-    ++nPointsInVox;
-    ++nProcessed;
-  }
-  if (nPointsInVox) {
-    // process last voxel
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+#endif
+  for (int iVoxData = 0; iVoxData < nVoxWithData; ++iVoxData) {
+    const size_t currVoxBin = binData[binIndices[voxelStart[iVoxData]]];
     VoxRes& resVox = secData[currVoxBin];
-    if (!getXBinIgnored(iSec, resVox.bvox[VoxX])) {
-      processVoxelDispersions(tgVec, dyVec, resVox);
+    if (getXBinIgnored(iSec, resVox.bvox[VoxX])) {
+      continue;
     }
+    auto& buffer = buffers[getThreadID()];
+    buffer.dy.clear();
+    buffer.tg.clear();
+    for (size_t iPoint = voxelStart[iVoxData]; iPoint < voxelStart[iVoxData + 1]; ++iPoint) {
+      const auto& res = mLocalResidualsIn[binIndices[iPoint]];
+      buffer.dy.push_back(res.dy * param::MaxResid / 0x7fff);
+      buffer.tg.push_back(res.tgSlp * param::MaxTgSlp / 0x7fff);
+    }
+    processVoxelDispersions(buffer.tg, buffer.dy, resVox, buffer);
   }
   // smooth dispersions
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+#endif
   for (int ix = 0; ix < mNXBins; ++ix) {
     if (getXBinIgnored(iSec, ix)) {
       continue;
@@ -477,6 +502,13 @@ void TrackResiduals::processSectorResiduals(int iSec)
 
 //______________________________________________________________________________
 void TrackResiduals::processVoxelResiduals(std::vector<float>& dy, std::vector<float>& dz, std::vector<float>& tg, VoxRes& resVox)
+{
+  VoxelBuffers buffers;
+  processVoxelResiduals(dy, dz, tg, resVox, buffers);
+}
+
+//______________________________________________________________________________
+void TrackResiduals::processVoxelResiduals(std::vector<float>& dy, std::vector<float>& dz, std::vector<float>& tg, VoxRes& resVox, VoxelBuffers& buffers)
 {
   int nPoints = dy.size();
   if (nPoints < mParams->minEntriesPerVoxel) {
@@ -487,15 +519,15 @@ void TrackResiduals::processVoxelResiduals(std::vector<float>& dy, std::vector<f
   }
   std::array<float, 7> zResults;
   resVox.flags = 0;
-  std::vector<size_t> indices(dz.size());
-  if (!o2::math_utils::LTMUnbinned(dz, indices, zResults, mParams->LTMCut)) {
+  buffers.indices.resize(dz.size());
+  if (!o2::math_utils::LTMUnbinned(dz, buffers.indices, zResults, mParams->LTMCut)) {
     LOG(debug) << "failed trimming input array for voxel " << getGlbVoxBin(resVox.bvox);
     return;
   }
   if (!mParams->isBfieldZero) {
     std::array<float, 2> res{0.f};
     std::array<float, 3> err{0.f};
-    float sigMAD = fitPoly1Robust(tg, dy, res, err, mParams->LTMCut);
+    float sigMAD = fitPoly1Robust(tg, dy, res, err, mParams->LTMCut, buffers);
     if (sigMAD < 0) {
       LOG(debug) << "failed robust linear fit, sigMAD =  " << sigMAD;
       return;
@@ -516,8 +548,8 @@ void TrackResiduals::processVoxelResiduals(std::vector<float>& dy, std::vector<f
     // for B=0 we cannot disentangle radial distortions from distortions in y,
     // so simply use average for dy as well and set distortion in X to zero
     std::array<float, 7> yResults;
-    std::vector<size_t> indicesY(dy.size());
-    if (!o2::math_utils::LTMUnbinned(dy, indicesY, yResults, mParams->LTMCut)) {
+    buffers.indicesY.resize(dy.size());
+    if (!o2::math_utils::LTMUnbinned(dy, buffers.indicesY, yResults, mParams->LTMCut)) {
       LOG(debug) << "failed trimming input array for voxel " << getGlbVoxBin(resVox.bvox);
       return;
     }
@@ -541,6 +573,12 @@ void TrackResiduals::processVoxelResiduals(std::vector<float>& dy, std::vector<f
 }
 
 void TrackResiduals::processVoxelDispersions(std::vector<float>& tg, std::vector<float>& dy, VoxRes& resVox)
+{
+  VoxelBuffers buffers;
+  processVoxelDispersions(tg, dy, resVox, buffers);
+}
+
+void TrackResiduals::processVoxelDispersions(std::vector<float>& tg, std::vector<float>& dy, VoxRes& resVox, VoxelBuffers& buffers)
 {
   size_t nPoints = tg.size();
   LOG(debug) << "processing voxel dispersions for vox " << getGlbVoxBin(resVox.bvox) << " with " << nPoints << " points";
@@ -550,7 +588,8 @@ void TrackResiduals::processVoxelDispersions(std::vector<float>& tg, std::vector
   for (size_t i = nPoints; i--;) {
     dy[i] -= resVox.DS[ResY] - resVox.DS[ResX] * tg[i];
   }
-  resVox.D[ResD] = getMAD2Sigma(dy);
+  buffers.tmp.assign(dy.begin(), dy.end());
+  resVox.D[ResD] = getMAD2SigmaInPlace(buffers.tmp);
   resVox.E[ResD] = resVox.D[ResD] / sqrt(2.f * nPoints); // a la gaussioan RMS error (very crude)
   resVox.flags |= DispDone;
 }
@@ -687,6 +726,10 @@ int TrackResiduals::validateVoxels(int iSec)
 void TrackResiduals::smooth(int iSec)
 {
   std::vector<VoxRes>& secData = mVoxelResults[iSec];
+  // the smoothing of a voxel reads the extracted distortions of its neighbours and writes only its own smoothed ones,
+  // the flags are updated in separate passes since they are read for the neighbours
+  std::vector<int> voxBins;
+  voxBins.reserve(mNVoxPerSector);
   for (int ix = 0; ix < mNXBins; ++ix) {
     if (getXBinIgnored(iSec, ix)) {
       continue;
@@ -694,17 +737,27 @@ void TrackResiduals::smooth(int iSec)
     for (int ip = 0; ip < mNY2XBins; ++ip) {
       for (int iz = 0; iz < mNZ2XBins; ++iz) {
         int voxBin = getGlbVoxBin(ix, ip, iz);
-        VoxRes& resVox = secData[voxBin];
-        resVox.flags &= ~SmoothDone;
-        bool res = getSmoothEstimate(resVox.bsec, resVox.stat[VoxX], resVox.stat[VoxF], resVox.stat[VoxZ], resVox.DS, (0x1 << VoxX | 0x1 << VoxF | 0x1 << VoxZ));
-        if (!res) {
-          mNSmoothingFailedBins[iSec]++;
-        } else {
-          resVox.flags |= SmoothDone;
-        }
+        secData[voxBin].flags &= ~SmoothDone;
+        voxBins.push_back(voxBin);
       }
     }
   }
+  const int nVox = voxBins.size();
+  std::vector<char> smoothOK(nVox);
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(std::max(1, mParams->nThreads))
+#endif
+  for (int iVox = 0; iVox < nVox; ++iVox) {
+    VoxRes& resVox = secData[voxBins[iVox]];
+    smoothOK[iVox] = getSmoothEstimate(resVox.bsec, resVox.stat[VoxX], resVox.stat[VoxF], resVox.stat[VoxZ], resVox.DS, (0x1 << VoxX | 0x1 << VoxF | 0x1 << VoxZ));
+  }
+  for (int iVox = 0; iVox < nVox; ++iVox) {
+    if (!smoothOK[iVox]) {
+      mNSmoothingFailedBins[iSec]++;
+    } else {
+      secData[voxBins[iVox]].flags |= SmoothDone;
+    }
+  }
   // substract dX contribution to dZ
   for (int ix = 0; ix < mNXBins; ++ix) {
     if (getXBinIgnored(iSec, ix)) {
@@ -758,6 +811,7 @@ bool TrackResiduals::getSmoothEstimate(int iSec, float x, float p, float z, std:
   // cache
   // \todo maybe a 1-D cache would be more efficient?
   std::array<std::array<double, sMaxSmtDim*(sMaxSmtDim + 1) / 2>, ResDim> cmat;
+  std::array<double, ResDim * sMaxSmtDim> rhs; // local, since the voxels of a sector may be smoothed concurrently
   int maxNeighb = 10 * 10 * 10;
   std::vector<VoxRes*> currVox;
   currVox.reserve(maxNeighb);
@@ -772,7 +826,7 @@ bool TrackResiduals::getSmoothEstimate(int iSec, float x, float p, float z, std:
   std::array<int, VoxDim> trial{0};
 
   while (true) {
-    std::fill(mLastSmoothingRes.begin(), mLastSmoothingRes.end(), 0);
+    std::fill(rhs.begin(), rhs.end(), 0);
     memset(&cmat[0][0], 0, sizeof(cmat));
 
     int nbOK = 0; // accounted neighbours
@@ -958,7 +1012,7 @@ bool TrackResiduals::getSmoothEstimate(int iSec, float x, float p, float z, std:
           wi /= (voxNb->E[iDim] * voxNb->E[iDim]);
         }
         std::array<double, sMaxSmtDim*(sMaxSmtDim + 1) / 2>& cmatD = cmat[iDim];
-        double* rhsD = &mLastSmoothingRes[iDim * sMaxSmtDim];
+        double* rhsD = &rhs[iDim * sMaxSmtDim];
         unsigned short iMat = 0;
         unsigned short iRhs = 0;
         // linear part
@@ -1024,7 +1078,7 @@ bool TrackResiduals::getSmoothEstimate(int iSec, float x, float p, float z, std:
       }
       matrix.Zero(); // reset matrix
       std::array<double, sMaxSmtDim*(sMaxSmtDim + 1) / 2>& cmatD = cmat[iDim];
-      double* rhsD = &mLastSmoothingRes[iDim * sMaxSmtDim];
+      double* rhsD = &rhs[iDim * sMaxSmtDim];
       short iMat = -1;
       short row = -1;
 
@@ -1114,6 +1168,12 @@ double TrackResiduals::getKernelWeight(std::array<double, 3> u2vec) const
 ///////////////////////////////////////////////////////////////////////////////
 
 float TrackResiduals::fitPoly1Robust(std::vector<float>& x, std::vector<float>& y, std::array<float, 2>& res, std::array<float, 3>& err, float cutLTM) const
+{
+  VoxelBuffers buffers;
+  return fitPoly1Robust(x, y, res, err, cutLTM, buffers);
+}
+
+float TrackResiduals::fitPoly1Robust(std::vector<float>& x, std::vector<float>& y, std::array<float, 2>& res, std::array<float, 3>& err, float cutLTM, VoxelBuffers& buffers) const
 {
   // robust pol1 fit, modifies input arrays order
   if (x.size() != y.size()) {
@@ -1125,33 +1185,37 @@ float TrackResiduals::fitPoly1Robust(std::vector<float>& x, std::vector<float>&
     return -1;
   }
   std::array<float, 7> yResults;
-  std::vector<size_t> indY(nPoints);
+  auto& indY = buffers.indicesY;
+  indY.resize(nPoints);
   if (!o2::math_utils::LTMUnbinned(y, indY, yResults, cutLTM)) {
     return -1;
   }
   // rearrange used events in increasing order
-  o2::math_utils::Reorder(y, indY);
-  o2::math_utils::Reorder(x, indY);
+  reorder(y, indY, buffers.tmp);
+  reorder(x, indY, buffers.tmp);
   //
   // 1st fit to get crude slope
   int nPointsUsed = std::lrint(yResults[0]);
   int vecOffset = std::lrint(yResults[5]);
   // use only entries selected by LTM for the fit
   float a, b;
-  medFit(nPointsUsed, vecOffset, x, y, a, b, err);
+  medFit(nPointsUsed, vecOffset, x, y, a, b, err, buffers.tmp);
   //
-  std::vector<float> ycm(nPoints);
+  auto& ycm = buffers.ycm;
+  ycm.resize(nPoints);
   for (size_t i = nPoints; i-- > 0;) {
     ycm[i] = y[i] - (a + b * x[i]);
   }
-  std::vector<size_t> indices(nPoints);
+  auto& indices = buffers.indices;
+  indices.resize(nPoints);
   o2::math_utils::SortData(ycm, indices);
-  o2::math_utils::Reorder(ycm, indices);
-  o2::math_utils::Reorder(y, indices);
-  o2::math_utils::Reorder(x, indices);
+  reorder(ycm, indices, buffers.tmp);
+  reorder(y, indices, buffers.tmp);
+  reorder(x, indices, buffers.tmp);
   //
   // robust estimate of sigma after crude slope correction
-  float sigMAD = getMAD2Sigma({ycm.begin() + vecOffset, ycm.begin() + vecOffset + nPointsUsed});
+  buffers.tmp.assign(ycm.begin() + vecOffset, ycm.begin() + vecOffset + nPointsUsed);
+  float sigMAD = getMAD2SigmaInPlace(buffers.tmp);
   // find LTM estimate matching to sigMAD, keaping at least given fraction
   if (!o2::math_utils::LTMUnbinnedSig(ycm, indY, yResults, mParams->minFracLTM, sigMAD, true)) {
     return -1;
@@ -1159,7 +1223,7 @@ float TrackResiduals::fitPoly1Robust(std::vector<float>& x, std::vector<float>&
   // final fit
   nPointsUsed = std::lrint(yResults[0]);
   vecOffset = std::lrint(yResults[5]);
-  medFit(nPointsUsed, vecOffset, x, y, a, b, err);
+  medFit(nPointsUsed, vecOffset, x, y, a, b, err, buffers.tmp);
   res[0] = a;
   res[1] = b;
   return sigMAD;
@@ -1167,6 +1231,12 @@ float TrackResiduals::fitPoly1Robust(std::vector<float>& x, std::vector<float>&
 
 //___________________________________________________________________
 void TrackResiduals::medFit(int nPoints, int offset, const std::vector<float>& x, const std::vector<float>& y, float& a, float& b, std::array<float, 3>& err) const
+{
+  std::vector<float> vecTmp;
+  medFit(nPoints, offset, x, y, a, b, err, vecTmp);
+}
+
+void TrackResiduals::medFit(int nPoints, int offset, const std::vector<float>& x, const std::vector<float>& y, float& a, float& b, std::array<float, 3>& err, std::vector<float>& vecTmp) const
 {
   // fitting a straight line y(x|a, b) = a + b * x
   // to given x and y data minimizing the absolute deviation
@@ -1198,10 +1268,10 @@ void TrackResiduals::medFit(int nPoints, int offset, const std::vector<float>& x
   }
   float sigb = std::sqrt(chi2 * delI); // expected sigma for b
   float b1 = bb;
-  float f1 = roFunc(nPoints, offset, x, y, b1, aa);
+  float f1 = roFunc(nPoints, offset, x, y, b1, aa, vecTmp);
   if (sigb > 0) {
     float b2 = bb + std::copysign(3.f * sigb, f1);
-    float f2 = roFunc(nPoints, offset, x, y, b2, aa);
+    float f2 = roFunc(nPoints, offset, x, y, b2, aa, vecTmp);
     if (fabs(f1 - f2) < sFloatEps) {
       a = aa;
       b = bb;
@@ -1212,7 +1282,7 @@ void TrackResiduals::medFit(int nPoints, int offset, const std::vector<float>& x
       b1 = b2;
       f1 = f2;
       b2 = bb;
-      f2 = roFunc(nPoints, offset, x, y, b2, aa);
+      f2 = roFunc(nPoints, offset, x, y, b2, aa, vecTmp);
     }
     sigb = .01f * sigb;
     while (fabs(b2 - b1) > sigb) {
@@ -1220,7 +1290,7 @@ void TrackResiduals::medFit(int nPoints, int offset, const std::vector<float>& x
       if (bb == b1 || bb == b2) {
         break;
       }
-      float f = roFunc(nPoints, offset, x, y, bb, aa);
+      float f = roFunc(nPoints, offset, x, y, bb, aa, vecTmp);
       if (f * f1 >= .0f) {
         f1 = f;
         b1 = bb;
@@ -1235,10 +1305,16 @@ void TrackResiduals::medFit(int nPoints, int offset, const std::vector<float>& x
 }
 
 float TrackResiduals::roFunc(int nPoints, int offset, const std::vector<float>& x, const std::vector<float>& y, float b, float& aa) const
+{
+  std::vector<float> vecTmp;
+  return roFunc(nPoints, offset, x, y, b, aa, vecTmp);
+}
+
+float TrackResiduals::roFunc(int nPoints, int offset, const std::vector<float>& x, const std::vector<float>& y, float b, float& aa, std::vector<float>& vecTmp) const
 {
   // calculate sum(x_i * sgn(y_i - a - b * x_i)) for given b
   // see numberical recipies paragraph 15.7.3
-  std::vector<float> vecTmp(nPoints);
+  vecTmp.resize(nPoints);
   float sum = 0.f;
   for (int j = nPoints; j-- > 0;) {
     vecTmp[j] = y[j + offset] - b * x[j + offset];
@@ -1347,10 +1423,16 @@ float TrackResiduals::selectKthMin(const int k, std::vector<float>& data) const
 //___________________________________________________________________
 float TrackResiduals::getMAD2Sigma(std::vector<float> data) const
 {
-  // Sigma calculated from median absolute deviations
-  // see: https://en.wikipedia.org/wiki/Median_absolute_deviation
   // the data is passed by value (copied!), such that the original vector
   // is not rearranged
+  return getMAD2SigmaInPlace(data);
+}
+
+//___________________________________________________________________
+float TrackResiduals::getMAD2SigmaInPlace(std::vector<float>& data)
+{
+  // Sigma calculated from median absolute deviations
+  // see: https://en.wikipedia.org/wiki/Median_absolute_deviation
 
   int nPoints = data.size();
   if (nPoints < 2) {
@@ -1389,6 +1471,20 @@ float TrackResiduals::getMAD2Sigma(std::vector<float> data) const
   return k * medianOfAbsDeviations;
 }
 
+//___________________________________________________________________
+void TrackResiduals::reorder(std::vector<float>& data, const std::vector<size_t>& index, std::vector<float>& tmp)
+{
+  // rearange data in order given by index
+  if (data.size() != index.size()) {
+    LOG(error) << "Reordering not possible if number of elements in index container different from the data container";
+    return;
+  }
+  tmp.assign(data.begin(), data.end());
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = tmp[index[i]];
+  }
+}
+
 void TrackResiduals::fitCircle(int nCl, std::array<float, param::NPadRows>& x, std::array<float, param::NPadRows>& y, float& xc, float& yc, float& r, std::array<float, param::NPadRows>& residHelixY)
 {
   // this fast algebraic circle fit is described here:
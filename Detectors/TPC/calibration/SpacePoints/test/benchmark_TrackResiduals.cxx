@@ -0,0 +1,76 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchmark_TrackResiduals.cxx
+/// \brief Time to extract and smooth the voxel residuals of one sector from a synthetic residual sample
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "CommonUtils/ConfigurableParam.h"
+#include "SpacePoints/TrackResiduals.h"
+
+using namespace o2::tpc;
+
+/// Residuals of one sector: smooth distortions plus gaussian noise, on average nPerVoxel residuals per voxel
+std::vector<TrackResiduals::LocalResid> generateResiduals(const TrackResiduals& residuals, double nPerVoxel)
+{
+  std::mt19937 generator(0);
+  std::normal_distribution<float> noiseDist(0.f, 0.3f);
+  std::uniform_real_distribution<float> tgDist(-0.3f, 0.3f);
+  std::poisson_distribution<int> nDist(nPerVoxel);
+  std::vector<TrackResiduals::LocalResid> data;
+  for (int ix = 0; ix < residuals.getNXBins(); ++ix) {
+    for (int ip = 0; ip < residuals.getNY2XBins(); ++ip) {
+      for (int iz = 0; iz < residuals.getNZ2XBins(); ++iz) {
+        const float dyVox = 0.5f * std::sin(0.1f * ix + 0.3f * ip);
+        const float dzVox = 0.2f * std::cos(0.05f * ix + iz);
+        const float dxVox = 0.3f * std::sin(0.02f * ix * iz);
+        const std::array<unsigned char, TrackResiduals::VoxDim> bvox{static_cast<unsigned char>(iz), static_cast<unsigned char>(ip), static_cast<unsigned char>(ix)};
+        for (int i = nDist(generator); i--;) {
+          const float tg = tgDist(generator);
+          const float dy = dyVox - dxVox * tg + noiseDist(generator);
+          const float dz = dzVox + noiseDist(generator);
+          data.emplace_back(static_cast<short>(dy / param::MaxResid * 0x7fff), static_cast<short>(dz / param::MaxResid * 0x7fff), static_cast<short>(tg / param::MaxTgSlp * 0x7fff), bvox);
+        }
+      }
+    }
+  }
+  // the residuals arrive unordered
+  std::shuffle(data.begin(), data.end(), generator);
+  return data;
+}
+
+static void BM_ProcessSectorResiduals(benchmark::State& state)
+{
+  o2::conf::ConfigurableParam::updateFromString("scdcalib.nThreads=" + std::to_string(state.range(0)));
+  TrackResiduals residuals;
+  residuals.init();
+  const auto data = generateResiduals(residuals, state.range(1));
+  for (auto _ : state) {
+    state.PauseTiming();
+    residuals.clear();
+    residuals.getLocalResVec() = data;
+    state.ResumeTiming();
+    residuals.processSectorResiduals(0);
+  }
+  state.counters["residuals"] = benchmark::Counter(static_cast<double>(data.size() * state.iterations()), benchmark::Counter::kIsRate);
+}
+
+// number of threads, mean number of residuals per voxel
+BENCHMARK(BM_ProcessSectorResiduals)->ArgsProduct({{1, 4, 8}, {100, 1000}})->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -18,6 +18,12 @@
 #define BOOST_TEST_MAIN
 #define BOOST_TEST_DYN_LINK
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include "CommonUtils/ConfigurableParam.h"
 #include "SpacePoints/TrackResiduals.h"
 
 namespace o2::tpc
@@ -58,4 +64,70 @@ BOOST_AUTO_TEST_CASE(TrackResidualsBinning_test)
   }
 }
 
+// extract and smooth the voxel residuals of one sector with the given number of threads
+std::vector<TrackResiduals::VoxRes> processSector(int nThreads)
+{
+  o2::conf::ConfigurableParam::updateFromString("scdcalib.nThreads=" + std::to_string(nThreads));
+  TrackResiduals resid;
+  resid.init();
+
+  // mean position of each voxel at its center
+  std::vector<TrackResiduals::VoxStats> stats(resid.getNVoxelsPerSector());
+  // smooth distortions plus gaussian noise, on average 50 residuals per voxel, in random order
+  std::mt19937 generator(0);
+  std::normal_distribution<float> noiseDist(0.f, 0.3f);
+  std::uniform_real_distribution<float> tgDist(-0.3f, 0.3f);
+  std::poisson_distribution<int> nDist(50);
+  auto& data = resid.getLocalResVec();
+  for (int ix = 0; ix < resid.getNXBins(); ++ix) {
+    for (int ip = 0; ip < resid.getNY2XBins(); ++ip) {
+      for (int iz = 0; iz < resid.getNZ2XBins(); ++iz) {
+        const float dyVox = 0.5f * std::sin(0.1f * ix + 0.3f * ip);
+        const float dzVox = 0.2f * std::cos(0.05f * ix + iz);
+        const float dxVox = 0.3f * std::sin(0.02f * ix * iz);
+        const std::array<unsigned char, TrackResiduals::VoxDim> bvox{static_cast<unsigned char>(iz), static_cast<unsigned char>(ip), static_cast<unsigned char>(ix)};
+        auto& stat = stats[resid.getGlbVoxBin(ix, ip, iz)];
+        resid.getVoxelCoordinates(0, ix, ip, iz, stat.meanPos[TrackResiduals::VoxX], stat.meanPos[TrackResiduals::VoxF], stat.meanPos[TrackResiduals::VoxZ]);
+        for (int i = nDist(generator); i--;) {
+          const float tg = tgDist(generator);
+          const float dy = dyVox - dxVox * tg + noiseDist(generator);
+          const float dz = dzVox + noiseDist(generator);
+          data.emplace_back(static_cast<short>(dy / param::MaxResid * 0x7fff), static_cast<short>(dz / param::MaxResid * 0x7fff), static_cast<short>(tg / param::MaxTgSlp * 0x7fff), bvox);
+          stat.nEntries += 1.f;
+        }
+      }
+    }
+  }
+  std::shuffle(data.begin(), data.end(), generator);
+  resid.setStats(stats, 0);
+  resid.processSectorResiduals(0);
+  return resid.getVoxelResults()[0];
+}
+
+// the voxels are processed independently, the results must not depend on the number of threads
+BOOST_AUTO_TEST_CASE(TrackResidualsThreads_test)
+{
+  const auto resSerial = processSector(1);
+  const auto resParallel = processSector(4);
+  o2::conf::ConfigurableParam::updateFromString("scdcalib.nThreads=1");
+  BOOST_REQUIRE_EQUAL(resSerial.size(), resParallel.size());
+  int nDone = 0;
+  for (size_t iVox = 0; iVox < resSerial.size(); ++iVox) {
+    const auto& ref = resSerial[iVox];
+    const auto& res = resParallel[iVox];
+    BOOST_CHECK_EQUAL(static_cast<int>(ref.flags), static_cast<int>(res.flags));
+    for (int iRes = 0; iRes < TrackResiduals::ResDim; ++iRes) {
+      BOOST_CHECK_EQUAL(ref.D[iRes], res.D[iRes]);
+      BOOST_CHECK_EQUAL(ref.E[iRes], res.E[iRes]);
+      BOOST_CHECK_EQUAL(ref.DS[iRes], res.DS[iRes]);
+    }
+    BOOST_CHECK_EQUAL(ref.EXYCorr, res.EXYCorr);
+    BOOST_CHECK_EQUAL(ref.dYSigMAD, res.dYSigMAD);
+    BOOST_CHECK_EQUAL(ref.dZSigLTM, res.dZSigLTM);
+    nDone += (ref.flags & TrackResiduals::DistDone) ? 1 : 0;
+  }
+  // make sure the comparison is not trivial
+  BOOST_CHECK_GT(nDone, 0);
+}
+
 } // namespace o2::tpc
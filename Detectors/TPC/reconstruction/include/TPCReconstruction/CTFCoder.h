@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <memory>
 #include <string>
 #include <cassert>
 #include <tuple>
@@ -161,6 +162,9 @@ class CTFCoder : public o2::ctf::CTFCoderBase
   bool getCombineColumns() const { return mCombineColumns; }
   void setCombineColumns(bool v) { mCombineColumns = v; }
 
+  int getNThreads() const { return mNThreads; }
+  void setNThreads(int n) { mNThreads = n; }
+
  private:
   void checkDataDictionaryConsistency(const CTFHeader& h);
 
@@ -171,6 +175,7 @@ class CTFCoder : public o2::ctf::CTFCoderBase
   void buildCoder(ctf::CTFCoderBase::OpType coderType, const CTF::container_t& ctf, CTF::Slots slot);
 
   bool mCombineColumns = false; // combine correlated columns
+  int mNThreads = 1;             // number of threads for the entropy coding of the blocks
 };
 
 template <typename source_T>
@@ -230,20 +235,33 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const CompressedClusters& ccl, co
   ec->setANSHeader(mANSVersion);
 
   o2::ctf::CTFIOSize iosize;
-  auto encodeTPC = [&buff, &optField, &coders = mCoders, mfc = this->getMemMarginFactor(), &iosize](auto begin, auto end, CTF::Slots slot, size_t probabilityBits, std::vector<bool>* reject = nullptr) {
+  std::unique_ptr<CTF::ParallelEncoder> parEncoder;
+  std::vector<std::shared_ptr<void>> filteredColumns; // filtered copies of the columns must survive until the parallel encoding
+  if (mNThreads > 1) {
+    parEncoder = std::make_unique<CTF::ParallelEncoder>(*ec, mNThreads);
+  }
+  auto encodeTPC = [&buff, &optField, &coders = mCoders, mfc = this->getMemMarginFactor(), &iosize, &parEncoder, &filteredColumns](auto begin, auto end, CTF::Slots slot, size_t probabilityBits, std::vector<bool>* reject = nullptr) {
     // at every encoding the buffer might be autoexpanded, so we don't work with fixed pointer ec
     const auto slotVal = static_cast<int>(slot);
+    auto encodeRange = [&](auto b, auto e) {
+      if (parEncoder) {
+        parEncoder->add(b, e, slotVal, probabilityBits, optField[slotVal], coders[slotVal], mfc);
+      } else {
+        iosize += CTF::get(buff.data())->encode(b, e, slotVal, probabilityBits, optField[slotVal], &buff, coders[slotVal], mfc);
+      }
+    };
     if (reject && begin != end) {
-      std::vector<std::decay_t<decltype(*begin)>> tmp;
-      tmp.reserve(std::distance(begin, end));
+      auto tmp = std::make_shared<std::vector<std::decay_t<decltype(*begin)>>>();
+      tmp->reserve(std::distance(begin, end));
       for (auto i = begin; i != end; i++) {
         if (!(*reject)[std::distance(begin, i)]) {
-          tmp.emplace_back(*i);
+          tmp->emplace_back(*i);
         }
       }
-      iosize += CTF::get(buff.data())->encode(tmp.begin(), tmp.end(), slotVal, probabilityBits, optField[slotVal], &buff, coders[slotVal], mfc);
+      encodeRange(tmp->begin(), tmp->end());
+      filteredColumns.push_back(tmp);
     } else {
-      iosize += CTF::get(buff.data())->encode(begin, end, slotVal, probabilityBits, optField[slotVal], &buff, coders[slotVal], mfc);
+      encodeRange(begin, end);
     }
   };
 
@@ -314,6 +332,9 @@ o2::ctf::CTFIOSize CTFCoder::encode(VEC& buff, const CompressedClusters& ccl, co
   encodeTPC(trigComp.deltaBC.begin(), trigComp.deltaBC.end(), CTF::BLCTrigBCInc, 0);
   encodeTPC(trigComp.triggerType.begin(), trigComp.triggerType.end(), CTF::BLCTrigType, 0);
 
+  if (parEncoder) {
+    iosize += parEncoder->process(buff);
+  }
   CTF::get(buff.data())->print(getPrefix(), mVerbosity);
   finaliseCTFOutput<CTF>(buff);
   iosize.rawIn = iosize.ctfIn;
@@ -345,9 +366,17 @@ o2::ctf::CTFIOSize CTFCoder::decode(const CTF::base& ec, VEC& buffVec, TRIGVEC&
 
   // decode encoded data directly to destination buff
   o2::ctf::CTFIOSize iosize;
-  auto decodeTPC = [&ec, &coders = mCoders, &iosize](auto begin, CTF::Slots slot) {
+  std::unique_ptr<CTF::ParallelDecoder> parDecoder;
+  if (mNThreads > 1) {
+    parDecoder = std::make_unique<CTF::ParallelDecoder>(ec, mNThreads);
+  }
+  auto decodeTPC = [&ec, &coders = mCoders, &iosize, &parDecoder](auto begin, CTF::Slots slot) {
     const auto slotVal = static_cast<int>(slot);
-    iosize += ec.decode(begin, slotVal, coders[slotVal]);
+    if (parDecoder) {
+      parDecoder->add(begin, slotVal, coders[slotVal]);
+    } else {
+      iosize += ec.decode(begin, slotVal, coders[slotVal]);
+    }
   };
 
   if (mCombineColumns) {
@@ -408,6 +437,9 @@ o2::ctf::CTFIOSize CTFCoder::decode(const CTF::base& ec, VEC& buffVec, TRIGVEC&
   decodeTPC(trigInfo.deltaOrbit.data(), CTF::BLCTrigOrbitInc);
   decodeTPC(trigInfo.deltaBC.data(), CTF::BLCTrigBCInc);
   decodeTPC(trigInfo.triggerType.data(), CTF::BLCTrigType);
+  if (parDecoder) {
+    iosize += parDecoder->process();
+  }
   // convert trigger info to output format
   uint32_t prevOrbit = header.firstOrbitTrig;
   uint16_t prevBC = 0;
@@ -17,6 +17,8 @@
 #define ALICEO2_TPC_DigitContainer_H_
 
 #include <deque>
+#include <memory>
+#include <vector>
 #include <algorithm>
 #include "TPCBase/CRU.h"
 #include "DataFormatsTPC/Defs.h"
@@ -73,7 +75,10 @@ class DigitContainer
   /// \param eventTime time stamp of the event
   /// \param isContinuous Switch for continuous readout
   /// \param finalFlush Flag whether the whole container is dumped
-  void fillOutputContainer(std::vector<Digit>& output, dataformats::MCTruthContainer<MCCompLabel>& mcTruth, std::vector<CommonMode>& commonModeOutput, const Sector& sector, TimeBin eventTimeBin = 0, bool isContinuous = true, bool finalFlush = false);
+  /// \param padParams Ion tail fraction, ion tail slope and common mode k-values per pad, nullptr if not used
+  /// \param deadMap Dead channel map, nullptr if not used
+  void fillOutputContainer(std::vector<Digit>& output, dataformats::MCTruthContainer<MCCompLabel>& mcTruth, std::vector<CommonMode>& commonModeOutput, const Sector& sector, TimeBin eventTimeBin = 0, bool isContinuous = true, bool finalFlush = false,
+                           const CalPad* padParams[3] = nullptr, const CalDet<bool>* deadMap = nullptr);
 
   /// Get the size of the container for one event
   size_t size() const { return mTimeBins.size(); }
@@ -84,10 +89,18 @@ class DigitContainer
   TimeBin mTmaxTriggered = 0;                                 ///< Maximum time bin in case of triggered mode (hard cut at average drift speed with additional margin)
   TimeBin mOffset;                                            ///< Size of the container for one event
   std::deque<DigitTime*> mTimeBins;                           ///< Time bin Container for the ADC value
+  std::vector<std::unique_ptr<DigitTime>> mTimeBinPool;       ///< Flushed time bin containers, cleared and kept for reuse within a time frame
   std::unique_ptr<DigitTime::PrevDigitInfoArray> mPrevDigArr; ///< Keep track of ToT and ion tail cumul from last time bin
-  o2::utils::DebugStreamer mStreamer;                         ///< Debug streamer
 
   void reportSettings();
+
+  /// Get a cleared time bin container, recycled from the pool if available
+  DigitTime* getTimeBin();
+
+  /// Clear a flushed time bin container and return it to the pool.
+  /// The pool holds at most the containers needed for one event (mOffset time bins), the others are deleted.
+  /// The pool is released with the final flush of the time frame
+  void recycleTimeBin(DigitTime* time);
 };
 
 inline DigitContainer::DigitContainer()
@@ -134,12 +147,35 @@ inline void DigitContainer::addDigit(const MCCompLabel& label, const CRU& cru, T
   }
 
   if (mTimeBins[mEffectiveTimeBin] == nullptr) {
-    mTimeBins[mEffectiveTimeBin] = new DigitTime();
+    mTimeBins[mEffectiveTimeBin] = getTimeBin();
   }
 
   mTimeBins[mEffectiveTimeBin]->addDigit(label, cru, globalPad, signal);
 }
 
+inline DigitTime* DigitContainer::getTimeBin()
+{
+  if (mTimeBinPool.empty()) {
+    return new DigitTime();
+  }
+  auto time = mTimeBinPool.back().release();
+  mTimeBinPool.pop_back();
+  return time;
+}
+
+inline void DigitContainer::recycleTimeBin(DigitTime* time)
+{
+  if (!time) {
+    return;
+  }
+  if (mTimeBinPool.size() >= static_cast<size_t>(mOffset)) {
+    delete time;
+    return;
+  }
+  time->clear();
+  mTimeBinPool.emplace_back(time);
+}
+
 } // namespace o2::tpc
 
 #endif // ALICEO2_TPC_DigitContainer_H_
@@ -215,7 +215,7 @@ inline void DigitGlobalPad::fillOutputContainer(std::vector<Digit>& output,
   const Mapper& mapper = Mapper::instance();
   SAMPAProcessing& sampaProcessing = SAMPAProcessing::instance();
   const PadPos pad = mapper.padPos(globalPad);
-  static std::vector<std::pair<MCCompLabel, int>> labelCollector; // static workspace container for sorting
+  static thread_local std::vector<std::pair<MCCompLabel, int>> labelCollector; // per-thread workspace container for sorting
 
   /// The charge accumulated on that pad is converted into ADC counts, saturation of the SAMPA is applied and a Digit
   /// is created in written out
@@ -16,6 +16,8 @@
 #ifndef ALICEO2_TPC_DigitTime_H_
 #define ALICEO2_TPC_DigitTime_H_
 
+#include <algorithm>
+#include <vector>
 #include "TPCBase/Mapper.h"
 #include "TPCBase/CalDet.h"
 #include "TPCSimulation/DigitGlobalPad.h"
@@ -49,6 +51,13 @@ class DigitTime
   /// Resets the container
   void reset();
 
+  /// Clears the container such that it can be reused for another time bin
+  /// Only the pads registered as occupied are reset, unless all pads were touched by the last flush
+  void clear();
+
+  /// Get the number of pads with a signal deposited via addDigit
+  size_t getNOccupiedPads() const { return mOccupiedPads.size(); }
+
   /// Get common mode for a given GEM stack
   /// \param gemstack GEM stack of the digit
   /// \return Common mode value in that time bin for a given GEM ROC
@@ -75,6 +84,8 @@ class DigitTime
   /// \param timeBin Time bin
   /// \param commonMode Common mode value of that specific ROC
   /// \param prevTime Previous time bin to calculate CM and ToT
+  /// If neither the signal of the previous time bin (ion tail, saturation) nor noise on empty pads is needed,
+  /// only the occupied pads are visited
   template <DigitzationMode MODE>
   void fillOutputContainer(std::vector<Digit>& output, dataformats::MCTruthContainer<MCCompLabel>& mcTruth,
                            std::vector<CommonMode>& commonModeOutput, const Sector& sector, TimeBin timeBin,
@@ -85,15 +96,17 @@ class DigitTime
   std::array<float, GEMSTACKSPERSECTOR> mCommonMode;                 ///< Common mode container - 4 GEM ROCs per sector
   std::array<DigitGlobalPad, Mapper::getPadsInSector()> mGlobalPads; ///< Pad Container for the ADC value
   int mDigitCounter = 0;                                             ///< counts the number of digits in this timebin
+  std::vector<GlobalPadNumber> mOccupiedPads;                        ///< pads with a signal deposited, in order of occurrence
+  bool mAllPadsTouched = false;                                      ///< all pads were processed by the last flush
 
   o2::dataformats::LabelContainer<std::pair<MCCompLabel, int>, false> mLabels;
-  // std::deque<int> mOccupiedPads; // iterable container of occupied pads
 };
 
 inline DigitTime::DigitTime() : mCommonMode(), mGlobalPads()
 {
   mCommonMode.fill(0.f);
   mLabels.reserve(Mapper::getPadsInSector() / 3);
+  mOccupiedPads.reserve(Mapper::getPadsInSector() / 3);
 }
 
 inline void DigitTime::addDigit(const MCCompLabel& label, const CRU& cru, GlobalPadNumber globalPad, float signal)
@@ -102,7 +115,7 @@ inline void DigitTime::addDigit(const MCCompLabel& label, const CRU& cru, Global
   if (paddigit.getID() == -1) {
     // this means we have a new digit
     paddigit.setID(mDigitCounter++);
-    // could also register this pad in a vector of digits
+    mOccupiedPads.emplace_back(globalPad);
   }
 
   // previous digit for CM and ToT calculation
@@ -118,6 +131,26 @@ inline void DigitTime::reset()
   mCommonMode.fill(0.f);
 }
 
+inline void DigitTime::clear()
+{
+  if (mAllPadsTouched) {
+    for (auto& pad : mGlobalPads) {
+      pad.reset();
+      pad.setID(-1);
+    }
+  } else {
+    for (const auto iPad : mOccupiedPads) {
+      mGlobalPads[iPad].reset();
+      mGlobalPads[iPad].setID(-1);
+    }
+  }
+  mOccupiedPads.clear();
+  mAllPadsTouched = false;
+  mDigitCounter = 0;
+  mLabels.clear();
+  mCommonMode.fill(0.f);
+}
+
 inline float DigitTime::getCommonMode(const GEMstack& gemstack) const
 {
   /// simple case when there is no external capacitance on the ROC
@@ -135,6 +168,35 @@ inline void DigitTime::fillOutputContainer(std::vector<Digit>& output, dataforma
   const auto& mapper = Mapper::instance();
   const auto& eleParam = ParameterElectronics::Instance();
 
+  if (!prevTime && !eleParam.doNoiseEmptyPads) {
+    // Pads without deposited signal neither contribute to the common mode nor produce a digit.
+    // The occupied pads are visited in ascending order, as in the dense loop below, for identical results.
+    std::sort(mOccupiedPads.begin(), mOccupiedPads.end());
+    for (const auto iPad : mOccupiedPads) {
+      const auto& digit = mGlobalPads[iPad];
+      const CRU cru = mapper.getCRU(sector, iPad);
+      const float cmKValue = (padParams[2]) ? padParams[2]->getValue(sector.getSector(), iPad) : 1.f;
+      mCommonMode[cru.gemStack()] += digit.getChargePad() * eleParam.commonModeCoupling * cmKValue;
+    }
+
+    for (size_t i = 0; i < mCommonMode.size(); ++i) {
+      const float cm = getCommonMode(GEMstack(i));
+      if (cm > 0.) {
+        commonModeOutput.push_back({cm, timeBin, static_cast<unsigned char>(i)});
+      }
+    }
+
+    for (const auto iPad : mOccupiedPads) {
+      auto& digit = mGlobalPads[iPad];
+      if (digit.getChargePad() > 0.f) {
+        const CRU cru = mapper.getCRU(sector, iPad);
+        digit.fillOutputContainer<MODE>(output, mcTruth, cru, timeBin, iPad, mLabels, getCommonMode(cru), PrevDigitInfo(), debugStream, deadMap);
+      }
+    }
+    return;
+  }
+  mAllPadsTouched = true;
+
   // at this point we only have the pure signals from tracks
   // loop over all pads to calculated ion tail, common mode and ToT for saturated signals
   for (size_t iPad = 0; iPad < mGlobalPads.size(); ++iPad) {
@@ -20,7 +20,9 @@
 #include "TPCSimulation/Point.h"
 #include "TPCBase/Mapper.h"
 
+#include <array>
 #include <cmath>
+#include <memory>
 
 class TTree;
 class TH3;
@@ -64,7 +66,7 @@ class Digitizer
   Digitizer(const Digitizer&) = delete;
   Digitizer& operator=(const Digitizer&) = delete;
 
-  /// Initializer
+  /// Initializer, also loads the calibration objects used when flushing the digits
   void init();
 
   /// Process a single hit group
@@ -124,6 +126,12 @@ class Digitizer
   /// \param spaceCharge unique pointer to spaceCharge object
   void setSCDistortionsDerivative(SC* spaceCharge);
 
+  /// Take over the readout, drift, distortion and calibration settings of another, initialized, digitizer, e.g. when
+  /// several digitizers process different sectors concurrently. The space-charge maps and calibration objects are
+  /// shared, not copied, since they are only read during the processing
+  /// \param other Digitizer to take the settings from
+  void shareSettings(const Digitizer& other);
+
   /// Enable the use of space-charge distortions by providing global distortions and global corrections stored in a ROOT file
   /// The storage of the values should be done by the methods provided in the SpaceCharge class
   /// \param file containing distortions
@@ -142,20 +150,22 @@ class Digitizer
   void recalculateDistortions();
 
  private:
-  DigitContainer mDigitContainer;      ///< Container for the Digits
-  std::unique_ptr<SC> mSpaceCharge;    ///< Handler of full distortions (static + IR dependant)
-  std::unique_ptr<SC> mSpaceChargeDer; ///< Handler of reference static distortions
-  Sector mSector = -1;                 ///< ID of the currently processed sector
-  double mEventTime = 0.f;             ///< Time of the currently processed event
-  double mOutputDigitTimeOffset = 0;   ///< Time of the first IR sampled in the digitizer
-  float mVDrift = 0;                   ///< VDrift for current timestamp
-  float mTDriftOffset = 0;             ///< drift time additive offset in \mus
-  bool mIsContinuous;                  ///< Switch for continuous readout
-  bool mUseSCDistortions = false;      ///< Flag to switch on the use of space-charge distortions
-  int mDistortionScaleType = 0;        ///< type=0: no scaling of distortions, type=1 distortions without any scaling, type=2 distortions scaling with lumi
-  float mLumiScaleFactor = 0;          ///< value used to scale the derivative map
-  bool mUseScaledDistortions = false;  ///< whether the distortions are already scaled
-  ClassDefNV(Digitizer, 3);
+  DigitContainer mDigitContainer;            ///< Container for the Digits
+  std::shared_ptr<SC> mSpaceCharge;          //!< Handler of full distortions (static + IR dependant), can be shared between digitizers
+  std::shared_ptr<SC> mSpaceChargeDer;       //!< Handler of reference static distortions, can be shared between digitizers
+  Sector mSector = -1;                       ///< ID of the currently processed sector
+  double mEventTime = 0.f;                   ///< Time of the currently processed event
+  double mOutputDigitTimeOffset = 0;         ///< Time of the first IR sampled in the digitizer
+  float mVDrift = 0;                         ///< VDrift for current timestamp
+  float mTDriftOffset = 0;                   ///< drift time additive offset in \mus
+  bool mIsContinuous;                        ///< Switch for continuous readout
+  bool mUseSCDistortions = false;            ///< Flag to switch on the use of space-charge distortions
+  int mDistortionScaleType = 0;              ///< type=0: no scaling of distortions, type=1 distortions without any scaling, type=2 distortions scaling with lumi
+  float mLumiScaleFactor = 0;                ///< value used to scale the derivative map
+  bool mUseScaledDistortions = false;        ///< whether the distortions are already scaled
+  std::array<const CalPad*, 3> mPadParams{}; //!< ion tail fraction, ion tail slope and common mode k-values per pad, loaded in init()
+  const CalDet<bool>* mDeadMap = nullptr;    //!< dead channel map, loaded in init()
+  ClassDefNV(Digitizer, 4);
 };
 } // namespace tpc
 } // namespace o2
@@ -40,11 +40,16 @@ namespace tpc
 class SAMPAProcessing
 {
  public:
-  static SAMPAProcessing& instance()
-  {
-    static SAMPAProcessing sampaProcessing;
-    return sampaProcessing;
-  }
+  static SAMPAProcessing& instance();
+
+  /// Give the calling thread a private copy of the global instance, with its own position in the random rings,
+  /// such that several threads can digitize concurrently. Subsequent calls to instance() from that thread
+  /// return the copy
+  /// \param stream Index of the random number stream, used to offset the random rings of the copy
+  static void createThreadInstance(int stream);
+
+  /// Release the private copy of the calling thread, instance() returns the global instance again
+  static void releaseThreadInstance();
   /// Destructor
   ~SAMPAProcessing() = default;
 
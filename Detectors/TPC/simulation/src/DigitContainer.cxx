@@ -14,24 +14,26 @@
 /// \author Andi Mathis, TU München, andreas.mathis@ph.tum.de
 
 #include "TPCSimulation/DigitContainer.h"
+#include <atomic>
 #include <memory>
 #include <fairlogger/Logger.h>
 #include "TPCBase/Mapper.h"
 #include "TPCBase/CDBInterface.h"
 #include "TPCBase/ParameterElectronics.h"
-#include "TPCBase/IonTailSettings.h"
 #include "SimConfig/DigiParams.h"
 
 using namespace o2::tpc;
 
 void DigitContainer::fillOutputContainer(std::vector<Digit>& output,
-                                         dataformats::MCTruthContainer<MCCompLabel>& mcTruth, std::vector<CommonMode>& commonModeOutput, const Sector& sector, TimeBin eventTimeBin, bool isContinuous, bool finalFlush)
+                                         dataformats::MCTruthContainer<MCCompLabel>& mcTruth, std::vector<CommonMode>& commonModeOutput, const Sector& sector, TimeBin eventTimeBin, bool isContinuous, bool finalFlush,
+                                         const CalPad* padParams[3], const CalDet<bool>* deadMap)
 {
+  // the debug streamer keeps one output file per thread, such that containers can be flushed concurrently
   using Streamer = o2::utils::DebugStreamer;
   Streamer* debugStream = nullptr;
   if (Streamer::checkStream(o2::utils::StreamFlags::streamDigitFolding) || Streamer::checkStream(o2::utils::StreamFlags::streamDigits)) {
-    mStreamer.setStreamer("debug_digits", "UPDATE");
-    debugStream = &mStreamer;
+    debugStream = Streamer::instance();
+    debugStream->setStreamer("debug_digits", "UPDATE");
   }
 
   const auto& eleParam = ParameterElectronics::Instance();
@@ -45,19 +47,10 @@ void DigitContainer::fillOutputContainer(std::vector<Digit>& output,
 
   auto& cdb = CDBInterface::instance();
 
-  // ion tail per pad parameters
-  const CalPad* padParams[3] = {nullptr, nullptr, nullptr};
-
-  if (eleParam.doIonTailPerPad) {
-    const auto& itSettings = IonTailSettings::Instance();
-    if (itSettings.padITCorrFile.size()) {
-      cdb.setFEEParamsFromFile(itSettings.padITCorrFile);
-    }
-    padParams[0] = &cdb.getITFraction();
-    padParams[1] = &cdb.getITExpLambda();
-  }
-  if (eleParam.doCommonModePerPad) {
-    padParams[2] = &cdb.getCMkValues();
+  // ion tail and common mode per pad parameters, loaded by the Digitizer
+  const CalPad* noPadParams[3] = {nullptr, nullptr, nullptr};
+  if (!padParams) {
+    padParams = noPadParams;
   }
 
   const bool needsPrevDigArray = eleParam.doIonTail || eleParam.doIonTailPerPad || eleParam.doSaturationTail;
@@ -68,19 +61,12 @@ void DigitContainer::fillOutputContainer(std::vector<Digit>& output,
     mPrevDigArr = std::make_unique<DigitTime::PrevDigitInfoArray>();
   }
 
-  // dead channel map
-  const CalDet<bool>* deadMap = {nullptr};
-  if (eleParam.applyDeadMap) {
-    deadMap = &cdb.getDeadChannelMap();
-  }
-
-  static bool reportedSettings = false;
-  if (!reportedSettings) {
+  static std::atomic<bool> reportedSettings{false}; // containers of several sectors may be flushed concurrently
+  if (!reportedSettings.exchange(true)) {
     reportSettings();
     if (deadMap) {
       LOGP(info, "Using dead map with {} masked pads", deadMap->getSum<int>());
     }
-    reportedSettings = true;
   }
 
   for (auto& time : mTimeBins) {
@@ -96,7 +82,7 @@ void DigitContainer::fillOutputContainer(std::vector<Digit>& output,
 
     // fill also time bins without signal to get noise, ion tail and saturated signals
     if (needsEmptyTimeBins && !time) {
-      time = new DigitTime;
+      time = getTimeBin();
     }
 
     if (maxTimeBinForTimeFrame != -1 && timeBin >= maxTimeBinForTimeFrame) {
@@ -151,11 +137,20 @@ void DigitContainer::fillOutputContainer(std::vector<Digit>& output,
   if (nProcessedTimeBins > 0) {
     mFirstTimeBin += nProcessedTimeBins;
     while (nProcessedTimeBins--) {
-      auto popped = mTimeBins.front();
+      recycleTimeBin(mTimeBins.front());
       mTimeBins.pop_front();
-      delete popped;
     }
   }
+
+  if (finalFlush) {
+    // the recycled containers only serve the flushes within a time frame, a high occupancy time frame
+    // must not pin its peak memory in every sector for the rest of the run
+    mTimeBinPool.clear();
+  }
+
+  if (debugStream && finalFlush) {
+    debugStream->flush(Streamer::getCPUID());
+  }
 }
 
 void DigitContainer::reportSettings()
@@ -20,6 +20,7 @@
 #include "TPCBase/ParameterGEM.h"
 #include "TPCBase/ParameterElectronics.h"
 #include "TPCBase/ParameterGas.h"
+#include "TPCBase/IonTailSettings.h"
 #include "TPCSimulation/ElectronTransport.h"
 #include "TPCSimulation/GEMAmplification.h"
 #include "TPCSimulation/Point.h"
@@ -47,6 +48,40 @@ void Digitizer::init()
   electronTransport.updateParameters(mVDrift);
   auto& sampaProcessing = SAMPAProcessing::instance();
   sampaProcessing.updateParameters(mVDrift);
+
+  // load the calibration objects needed when flushing the digits, such that the containers of several sectors
+  // can be flushed concurrently and only read them
+  const auto& eleParam = ParameterElectronics::Instance();
+  auto& cdb = CDBInterface::instance();
+  cdb.getFEEConfig();
+  mPadParams.fill(nullptr);
+  if (eleParam.doIonTailPerPad) {
+    const auto& itSettings = IonTailSettings::Instance();
+    if (itSettings.padITCorrFile.size()) {
+      cdb.setFEEParamsFromFile(itSettings.padITCorrFile);
+    }
+    mPadParams[0] = &cdb.getITFraction();
+    mPadParams[1] = &cdb.getITExpLambda();
+  }
+  if (eleParam.doCommonModePerPad) {
+    mPadParams[2] = &cdb.getCMkValues();
+  }
+  mDeadMap = eleParam.applyDeadMap ? &cdb.getDeadChannelMap() : nullptr;
+}
+
+void Digitizer::shareSettings(const Digitizer& other)
+{
+  mIsContinuous = other.mIsContinuous;
+  mVDrift = other.mVDrift;
+  mTDriftOffset = other.mTDriftOffset;
+  mSpaceCharge = other.mSpaceCharge;
+  mSpaceChargeDer = other.mSpaceChargeDer;
+  mUseSCDistortions = other.mUseSCDistortions;
+  mDistortionScaleType = other.mDistortionScaleType;
+  mLumiScaleFactor = other.mLumiScaleFactor;
+  mUseScaledDistortions = other.mUseScaledDistortions;
+  mPadParams = other.mPadParams;
+  mDeadMap = other.mDeadMap;
 }
 
 void Digitizer::process(const std::vector<o2::tpc::HitGroup>& hits,
@@ -63,7 +98,7 @@ void Digitizer::process(const std::vector<o2::tpc::HitGroup>& hits,
 
   const int nShapedPoints = eleParam.NShapedPoints;
   const auto amplificationMode = gemParam.AmplMode;
-  static std::vector<float> signalArray;
+  static thread_local std::vector<float> signalArray; // per-thread workspace, sectors may be digitized concurrently
   signalArray.resize(nShapedPoints);
 
   /// Reserve space in the digit container for the current event
@@ -165,7 +200,7 @@ void Digitizer::flush(std::vector<o2::tpc::Digit>& digits,
                       bool finalFlush)
 {
   SAMPAProcessing& sampaProcessing = SAMPAProcessing::instance();
-  mDigitContainer.fillOutputContainer(digits, labels, commonModeOutput, mSector, sampaProcessing.getTimeBinFromTime(mEventTime - mOutputDigitTimeOffset), mIsContinuous, finalFlush);
+  mDigitContainer.fillOutputContainer(digits, labels, commonModeOutput, mSector, sampaProcessing.getTimeBinFromTime(mEventTime - mOutputDigitTimeOffset), mIsContinuous, finalFlush, mPadParams.data(), mDeadMap);
   // flushing debug output to file
   if (((finalFlush && mIsContinuous) || (!mIsContinuous)) && mSpaceCharge) {
     o2::utils::DebugStreamer::instance()->flush();
@@ -17,10 +17,36 @@
 #include "TPCBase/CDBInterface.h"
 
 #include <cmath>
+#include <memory>
 
 using namespace o2::tpc;
 using namespace o2::math_utils;
 
+namespace
+{
+/// private copy of the electron transport used by the calling thread, see ElectronTransport::createThreadInstance
+thread_local std::unique_ptr<ElectronTransport> threadElectronTransport;
+} // namespace
+
+ElectronTransport& ElectronTransport::instance()
+{
+  static ElectronTransport electronTransport;
+  return threadElectronTransport ? *threadElectronTransport : electronTransport;
+}
+
+void ElectronTransport::createThreadInstance(int stream)
+{
+  threadElectronTransport.reset();
+  threadElectronTransport.reset(new ElectronTransport(instance()));
+  threadElectronTransport->mRandomGaus.setStream(stream);
+  threadElectronTransport->mRandomFlat.setStream(stream);
+}
+
+void ElectronTransport::releaseThreadInstance()
+{
+  threadElectronTransport.reset();
+}
+
 ElectronTransport::ElectronTransport() : mRandomGaus(), mRandomFlat(RandomRing<>::RandomType::Flat)
 {
   updateParameters();
@@ -21,11 +21,41 @@
 #include <fstream>
 #include "Framework/Logger.h"
 #include <filesystem>
+#include <memory>
 
 using namespace o2::tpc;
 using namespace o2::math_utils;
 using boost::format;
 
+namespace
+{
+/// private copy of the GEM amplification used by the calling thread, see GEMAmplification::createThreadInstance
+thread_local std::unique_ptr<GEMAmplification> threadGEMAmplification;
+} // namespace
+
+GEMAmplification& GEMAmplification::instance()
+{
+  static GEMAmplification gemAmplification;
+  return threadGEMAmplification ? *threadGEMAmplification : gemAmplification;
+}
+
+void GEMAmplification::createThreadInstance(int stream)
+{
+  threadGEMAmplification.reset();
+  threadGEMAmplification.reset(new GEMAmplification(instance()));
+  threadGEMAmplification->mRandomGaus.setStream(stream);
+  threadGEMAmplification->mRandomFlat.setStream(stream);
+  for (auto& gain : threadGEMAmplification->mGain) {
+    gain.setStream(stream);
+  }
+  threadGEMAmplification->mGainFullStack.setStream(stream);
+}
+
+void GEMAmplification::releaseThreadInstance()
+{
+  threadGEMAmplification.reset();
+}
+
 GEMAmplification::GEMAmplification()
   : mRandomGaus(),
     mRandomFlat(RandomRing<>::RandomType::Flat),
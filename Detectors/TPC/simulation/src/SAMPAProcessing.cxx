@@ -18,12 +18,37 @@
 
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <string>
 #include "Framework/Logger.h"
 
 using namespace o2::tpc;
 
+namespace
+{
+/// private copy of the SAMPA processing used by the calling thread, see SAMPAProcessing::createThreadInstance
+thread_local std::unique_ptr<SAMPAProcessing> threadSAMPAProcessing;
+} // namespace
+
+SAMPAProcessing& SAMPAProcessing::instance()
+{
+  static SAMPAProcessing sampaProcessing;
+  return threadSAMPAProcessing ? *threadSAMPAProcessing : sampaProcessing;
+}
+
+void SAMPAProcessing::createThreadInstance(int stream)
+{
+  threadSAMPAProcessing.reset();
+  threadSAMPAProcessing.reset(new SAMPAProcessing(instance()));
+  threadSAMPAProcessing->mRandomNoiseRing.setStream(stream);
+}
+
+void SAMPAProcessing::releaseThreadInstance()
+{
+  threadSAMPAProcessing.reset();
+}
+
 SAMPAProcessing::SAMPAProcessing() : mRandomNoiseRing()
 {
   updateParameters();
@@ -167,5 +167,56 @@ BOOST_AUTO_TEST_CASE(DigitContainer_test2)
     BOOST_CHECK_CLOSE(commonMode[i].getCommonMode(), chargeSum[i] / nPads, 1E-6);
   }
 }
+
+/// \brief Test of the DigitContainer
+/// Time bins flushed in a first step are recycled for the digits added afterwards, we check that no charge or MC label
+/// of the first flush leaks into the digits of the second one
+BOOST_AUTO_TEST_CASE(DigitContainer_test3)
+{
+  auto& cdb = CDBInterface::instance();
+  cdb.setUseDefaults();
+  o2::conf::ConfigurableParam::updateFromString(fmt::format("TPCEleParam.DigiMode={}", (int)o2::tpc::DigitzationMode::PropagateADC)); // propagate the ADC values, otherwise the computation get complicated
+  const Mapper& mapper = Mapper::instance();
+  DigitContainer digitContainer;
+  digitContainer.reset();
+  dataformats::MCTruthContainer<MCCompLabel> mMCTruthArray;
+
+  const CRU cru(0);
+  const GlobalPadNumber globalPad1 = mapper.getPadNumberInROC(PadROCPos(cru.roc(), PadPos(12, 1)));
+  const GlobalPadNumber globalPad2 = mapper.getPadNumberInROC(PadROCPos(cru.roc(), PadPos(5, 15)));
+
+  std::vector<Digit> mDigitsArray;
+  std::vector<o2::tpc::CommonMode> commonMode;
+
+  // first batch, flushed up to time bin 100
+  for (int i = 0; i < 10; ++i) {
+    digitContainer.addDigit(MCCompLabel(1, 2, 0, false), cru, i, globalPad1, 100);
+  }
+  digitContainer.fillOutputContainer(mDigitsArray, mMCTruthArray, commonMode, 0, 100, true, false);
+  BOOST_CHECK(mDigitsArray.size() == 10);
+
+  // second batch, filled into recycled time bins
+  mDigitsArray.clear();
+  commonMode.clear();
+  mMCTruthArray.clear();
+  for (int i = 100; i < 110; ++i) {
+    digitContainer.addDigit(MCCompLabel(3, 4, 0, false), cru, i, globalPad2, 50);
+  }
+  digitContainer.fillOutputContainer(mDigitsArray, mMCTruthArray, commonMode, 0, 0, true, true);
+  BOOST_CHECK(mDigitsArray.size() == 10);
+
+  int digits = 0;
+  for (const auto& digit : mDigitsArray) {
+    BOOST_CHECK(digit.getTimeStamp() == 100 + digits);
+    BOOST_CHECK(digit.getRow() == 5);
+    BOOST_CHECK(digit.getPad() == 15);
+    BOOST_CHECK_CLOSE(digit.getChargeFloat(), mDigitsArray[0].getChargeFloat(), 1E-6);
+    const auto& mcArray = mMCTruthArray.getLabels(digits);
+    BOOST_CHECK(mcArray.size() == 1);
+    BOOST_CHECK(mcArray[0].getTrackID() == 3);
+    BOOST_CHECK(mcArray[0].getEventID() == 4);
+    ++digits;
+  }
+}
 } // namespace tpc
 } // namespace o2
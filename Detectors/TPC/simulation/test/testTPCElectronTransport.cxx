@@ -25,6 +25,8 @@
 #include "TH1D.h"
 #include "TF1.h"
 
+#include <thread>
+
 namespace o2
 {
 namespace tpc
@@ -143,5 +145,27 @@ BOOST_AUTO_TEST_CASE(ElectronAttatchment_test_1)
   BOOST_CHECK_CLOSE(lostElectrons / nEvents,
                     gasParam.AttCoeff * gasParam.OxygenCont * driftTime, 0.5);
 }
+
+/// \brief Test of the per-thread instances of the electron transport
+/// A thread with a private instance has to see a different object than the global one
+/// and return to the global instance once the private one is released
+BOOST_AUTO_TEST_CASE(ElectronTransport_threadInstance_test)
+{
+  ElectronTransport* globalInstance = &ElectronTransport::instance();
+  ElectronTransport* threadInstance = nullptr;
+  ElectronTransport* releasedInstance = nullptr;
+
+  std::thread worker([&]() {
+    ElectronTransport::createThreadInstance(1);
+    threadInstance = &ElectronTransport::instance();
+    ElectronTransport::releaseThreadInstance();
+    releasedInstance = &ElectronTransport::instance();
+  });
+  worker.join();
+
+  BOOST_CHECK(threadInstance != globalInstance);
+  BOOST_CHECK(releasedInstance == globalInstance);
+  BOOST_CHECK(&ElectronTransport::instance() == globalInstance);
+}
 } // namespace tpc
 } // namespace o2
@@ -25,6 +25,7 @@
 #include "TPCSpaceCharge/RegularGrid3D.h"
 #include "CommonConstants/MathConstants.h"
 #include "TPCSpaceCharge/SpaceChargeParameter.h"
+#include <memory>
 #include <vector>
 
 namespace o2
@@ -96,6 +97,22 @@ class PoissonSolver
   static void setNThreads(int nThreads) { sNThreads = nThreads; }
 
  private:
+  /// Properties of one level of the multi grid used in poissonMultiGrid3D: number of vertices and coefficients of the
+  /// relaxation and residue stencils. The restriction and interpolation between two levels is defined by their number of vertices.
+  struct MGLevel {
+    int nR{};                                 ///< number of vertices in r direction
+    int nZ{};                                 ///< number of vertices in z direction
+    int nPhi{};                               ///< number of vertices in phi direction
+    DataT h2{};                               ///< square of the grid spacing in r direction
+    DataT ih2{};                              ///< inverse of h2
+    DataT tempRatioZ{};                       ///< ratio between the square of the grid spacing in r and in z direction
+    std::vector<DataT> coefficient1{};        ///< (1 + h_{r}/2r_{i}) for each vertex in r direction
+    std::vector<DataT> coefficient2{};        ///< (1 - h_{r}/2r_{i}) for each vertex in r direction
+    std::vector<DataT> coefficient3{};        ///< (1/r_{i}^2) scaled by the ratio in phi direction for each vertex in r direction
+    std::vector<DataT> coefficient4{};        ///< normalisation of the relaxation for each vertex in r direction
+    std::vector<DataT> inverseCoefficient4{}; ///< inverse of coefficient4
+  };
+
   const RegularGrid& mGrid3D{};                                      ///< grid properties
   const ParamSpaceCharge mParamGrid{mGrid3D.getParamSC()};           ///< parameters of the grid on which the calculations are performed
   inline static DataT sConvergenceError{1e-6};                       ///< Error tolerated
@@ -105,6 +122,12 @@ class PoissonSolver
   /// \returns inverse grid size in phi (either 1/2Pi or NSECTORSPERSIDE/2Pi)
   static DataT getGridSizePhiInv();
 
+  /// \returns the levels of the multi grid for the grid of this solver.
+  /// They are computed once per grid and are shared by all solvers using the same grid, e.g. when solving for many space-charge scenarios.
+  /// \param nLoop number of levels
+  /// \param nnPhi minimum number of vertices in phi direction
+  std::shared_ptr<const std::vector<MGLevel>> getMGLevels(const int nLoop, const int nnPhi) const;
+
   /// Relative error calculation: comparison with exact solution
   ///
   /// \param matricesCurrentV current potential (numerical solution)
@@ -222,6 +245,8 @@ class PoissonSolver
 
   /// Relaxation operation for multiGrid
   ///   relaxation used 7 stencil in cylindrical coordinate
+  ///   The red-black Gauss-Seidel relaxation is vectorised along r, the contiguous direction of Vector3D,
+  ///   and the phi slices are relaxed in parallel when the colouring is consistent across the phi boundary.
   ///
   /// Using the following equations
   /// \f$ U_{i,j,k} = (1 + \frac{1}{r_{i}h_{r}}) U_{i+1,j,k}  + (1 - \frac{1}{r_{i}h_{r}}) U_{i+1,j,k}  \f$
@@ -370,18 +395,12 @@ class PoissonSolver
   /// \param gridTo coarsest level of grid
   /// \param nPre number of smoothing before coarsening
   /// \param nPost number of smoothing after coarsening
-  /// \param ratioZ ratio between square of grid r and grid z (OPTION,  recalculate)
+  /// \param levels properties and relaxation coefficients of the levels of the multi grid
   /// \param tvArrayV vector of V potential in different grids
   /// \param tvCharge vector of charge distribution in different grids
   /// \param tvResidue vector of residue calculation in different grids
-  /// \param coefficient1 coefficient for relaxation (r direction)
-  /// \param coefficient2 coefficient for relaxation (r direction)
-  /// \param coefficient3 coefficient for relaxation (ratio r/z)
-  /// \param coefficient4 coefficient for relaxation (ratio for grid_r)
-  /// \param inverseCoefficient4 coefficient for relaxation (inverse coefficient4)
-  void vCycle3D(const int symmetry, const int gridFrom, const int gridTo, const int nPre, const int nPost, const DataT ratioZ, std::vector<Vector>& tvArrayV, std::vector<Vector>& tvCharge,
-                std::vector<Vector>& tvResidue, std::vector<DataT>& coefficient1, std::vector<DataT>& coefficient2, std::vector<DataT>& coefficient3,
-                std::vector<DataT>& coefficient4, std::vector<DataT>& inverseCoefficient4) const;
+  void vCycle3D(const int symmetry, const int gridFrom, const int gridTo, const int nPre, const int nPost, const std::vector<MGLevel>& levels, std::vector<Vector>& tvArrayV, std::vector<Vector>& tvCharge,
+                std::vector<Vector>& tvResidue) const;
 
   /// V-Cycle 2D
   ///
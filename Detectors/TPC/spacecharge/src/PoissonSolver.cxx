@@ -22,6 +22,9 @@
 #include "TPCSpaceCharge/PoissonSolverHelpers.h"
 #include "Framework/Logger.h"
 #include <numeric>
+#include <map>
+#include <mutex>
+#include <tuple>
 #include <fmt/core.h>
 #include "TPCSpaceCharge/Vector3D.h"
 #include "TPCSpaceCharge/DataContainer3D.h"
@@ -348,10 +351,6 @@ void PoissonSolver<DataT>::poissonMultiGrid3D2D(DataContainer& matricesV, const
 template <typename DataT>
 void PoissonSolver<DataT>::poissonMultiGrid3D(DataContainer& matricesV, const DataContainer& matricesCharge, const int symmetry)
 {
-  const DataT gridSpacingR = getSpacingR();
-  const DataT gridSpacingZ = getSpacingZ();
-  const DataT ratioZ = gridSpacingR * gridSpacingR / (gridSpacingZ * gridSpacingZ); // ratio_{Z} = gridSize_{r} / gridSize_{z}
-
   LOGP(detail, "{}", fmt::format("PoissonMultiGrid3D: in Poisson Solver 3D multi grid full coarsening  mParamGrid.NRVertices={}, cols={}, mParamGrid.NPhiVertices={}", mParamGrid.NRVertices, mParamGrid.NZVertices, mParamGrid.NPhiVertices));
 
   // Check that the number of mParamGrid.NRVertices and mParamGrid.NZVertices is suitable for a binary expansion
@@ -393,13 +392,9 @@ void PoissonSolver<DataT>::poissonMultiGrid3D(DataContainer& matricesV, const Da
   LOGP(detail, "{}", fmt::format("PoissonMultiGrid3D: nGridRow={}, nGridCol={}, nGridPhi={}", nGridRow, nGridCol, nGridPhi));
   const int nLoop = std::max({nGridRow, nGridCol, nGridPhi}); // Calculate the number of nLoop for the binary expansion
 
-  // Vector for storing multi grid array
-  unsigned int iOne = 1; // index i in gridSize r (original)
-  unsigned int jOne = 1; // index j in gridSize z (original)
-  unsigned int kOne = 1; // index k in gridSize phi
-  int tnRRow = mParamGrid.NRVertices;
-  int tnZColumn = mParamGrid.NZVertices;
-  int tPhiSlice = mParamGrid.NPhiVertices;
+  // number of vertices and relaxation coefficients of all levels, shared by all solves on the same grid
+  const auto levelsPtr = getMGLevels(nLoop, nnPhi);
+  const auto& levels = *levelsPtr;
 
   // 1) Memory allocation for multi grid
   std::vector<Vector> tvArrayV(nLoop);     // potential <--> error
@@ -408,29 +403,18 @@ void PoissonSolver<DataT>::poissonMultiGrid3D(DataContainer& matricesV, const Da
   std::vector<Vector> tvPrevArrayV(nLoop); // error calculation
   std::vector<Vector> tvResidue(nLoop);    // residue calculation
 
-  std::vector<DataT> coefficient1(mParamGrid.NRVertices);        // coefficient1(mParamGrid.NRVertices) for storing (1 + h_{r}/2r_{i}) from central differences in r direction
-  std::vector<DataT> coefficient2(mParamGrid.NRVertices);        // coefficient2(mParamGrid.NRVertices) for storing (1 + h_{r}/2r_{i}) from central differences in r direction
-  std::vector<DataT> coefficient3(mParamGrid.NRVertices);        // coefficient3(mParamGrid.NRVertices) for storing (1/r_{i}^2) from central differences in phi direction
-  std::vector<DataT> coefficient4(mParamGrid.NRVertices);        // coefficient4(mParamGrid.NRVertices) for storing  1/2
-  std::vector<DataT> inverseCoefficient4(mParamGrid.NRVertices); // inverse of coefficient4(mParamGrid.NRVertices)
-
-  for (int count = 1; count <= nLoop; ++count) {
-    // tnRRow,tnZColumn in new grid
-    tnRRow = iOne == 1 ? mParamGrid.NRVertices : mParamGrid.NRVertices / iOne + 1;
-    tnZColumn = jOne == 1 ? mParamGrid.NZVertices : mParamGrid.NZVertices / jOne + 1;
-    tPhiSlice = kOne == 1 ? mParamGrid.NPhiVertices : mParamGrid.NPhiVertices / kOne;
-    tPhiSlice = tPhiSlice < nnPhi ? nnPhi : tPhiSlice;
+  for (int index = 0; index < nLoop; ++index) {
+    const auto& level = levels[index];
 
     // allocate memory for residue
-    const int index = count - 1;
-    tvResidue[index].resize(tnRRow, tnZColumn, tPhiSlice);
-    tvPrevArrayV[index].resize(tnRRow, tnZColumn, tPhiSlice);
-    tvChargeFMG[index].resize(tnRRow, tnZColumn, tPhiSlice);
-    tvArrayV[index].resize(tnRRow, tnZColumn, tPhiSlice);
-    tvCharge[index].resize(tnRRow, tnZColumn, tPhiSlice);
+    tvResidue[index].resize(level.nR, level.nZ, level.nPhi);
+    tvPrevArrayV[index].resize(level.nR, level.nZ, level.nPhi);
+    tvChargeFMG[index].resize(level.nR, level.nZ, level.nPhi);
+    tvArrayV[index].resize(level.nR, level.nZ, level.nPhi);
+    tvCharge[index].resize(level.nR, level.nZ, level.nPhi);
 
     // memory for the finest grid is from parameters
-    if (count == 1) {
+    if (index == 0) {
       for (int iphi = 0; iphi < mParamGrid.NPhiVertices; ++iphi) {
         for (int ir = 0; ir < mParamGrid.NRVertices; ++ir) {
           for (int iz = 0; iz < mParamGrid.NZVertices; ++iz) {
@@ -441,82 +425,29 @@ void PoissonSolver<DataT>::poissonMultiGrid3D(DataContainer& matricesV, const Da
       }
       tvCharge[index] = tvChargeFMG[index];
     }
-    iOne *= 2; // doubling
-    jOne *= 2; // doubling
-    kOne *= 2;
   }
 
   // Case full multi grid (FMG)
   if (MGParameters::cycleType == CycleType::FCycle) {
-    // Restrict the charge to coarser grid
-    iOne = 2;
-    jOne = 2;
-    kOne = 2;
-    int otPhiSlice = mParamGrid.NPhiVertices;
-
     // 1) Restrict Charge and Boundary to coarser grid
     for (int count = 2; count <= nLoop; ++count) {
-      // tnRRow,tnZColumn in new grid
-      tnRRow = iOne == 1 ? mParamGrid.NRVertices : mParamGrid.NRVertices / iOne + 1;
-      tnZColumn = jOne == 1 ? mParamGrid.NZVertices : mParamGrid.NZVertices / jOne + 1;
-      tPhiSlice = kOne == 1 ? mParamGrid.NPhiVertices : mParamGrid.NPhiVertices / kOne;
-      tPhiSlice = tPhiSlice < nnPhi ? nnPhi : tPhiSlice;
-
-      LOGP(detail, "{}", fmt::format("PoissonMultiGrid3D: Restrict3D, tnRRow={}, tnZColumn={}, newPhiSlice={}, oldPhiSlice={}", tnRRow, tnZColumn, tPhiSlice, otPhiSlice));
-      restrict3D(tvChargeFMG[count - 1], tvChargeFMG[count - 2], tnRRow, tnZColumn, tPhiSlice, otPhiSlice);
+      const auto& coarse = levels[count - 1];
+      const auto& fine = levels[count - 2];
+      LOGP(detail, "{}", fmt::format("PoissonMultiGrid3D: Restrict3D, tnRRow={}, tnZColumn={}, newPhiSlice={}, oldPhiSlice={}", coarse.nR, coarse.nZ, coarse.nPhi, fine.nPhi));
+      restrict3D(tvChargeFMG[count - 1], tvChargeFMG[count - 2], coarse.nR, coarse.nZ, coarse.nPhi, fine.nPhi);
       // copy boundary values of V
-      restrictBoundary3D(tvArrayV[count - 1], tvArrayV[count - 2], tnRRow, tnZColumn, tPhiSlice, otPhiSlice);
-      otPhiSlice = tPhiSlice;
-
-      iOne *= 2; // doubling
-      jOne *= 2; // doubling
-      kOne *= 2;
+      restrictBoundary3D(tvArrayV[count - 1], tvArrayV[count - 2], coarse.nR, coarse.nZ, coarse.nPhi, fine.nPhi);
     }
 
-    // Relax on the coarsest grid
-    // FMG
     // 2) Relax on the coarsest grid
-    // move to the coarsest + 1
-    iOne /= 2;
-    jOne /= 2;
-    kOne /= 2;
-    tnRRow = iOne == 1 ? mParamGrid.NRVertices : mParamGrid.NRVertices / iOne + 1;
-    tnZColumn = jOne == 1 ? mParamGrid.NZVertices : mParamGrid.NZVertices / jOne + 1;
-    tPhiSlice = kOne == 1 ? mParamGrid.NPhiVertices : mParamGrid.NPhiVertices / kOne;
-    tPhiSlice = tPhiSlice < nnPhi ? nnPhi : tPhiSlice;
-    otPhiSlice = tPhiSlice;
-
-    const DataT h = gridSpacingR * iOne;
-    const DataT h2 = h * h;
-    const DataT gridSizePhiInv = tPhiSlice * getGridSizePhiInv();    // h_{phi}
-    const DataT tempRatioPhi = h2 * gridSizePhiInv * gridSizePhiInv; // ratio_{phi} = gridSize_{r} / gridSize_{phi}
-    const DataT tempRatioZ = ratioZ * iOne * iOne / (jOne * jOne);
-
-    calcCoefficients(1, tnRRow - 1, h, tempRatioZ, tempRatioPhi, coefficient1, coefficient2, coefficient3, coefficient4);
-
-    // 3) Relax on the coarsest grid
-    relax3D(tvArrayV[nLoop - 1], tvChargeFMG[nLoop - 1], tnRRow, tnZColumn, tPhiSlice, symmetry, h2, tempRatioZ, coefficient1, coefficient2, coefficient3, coefficient4);
+    const auto& coarsest = levels[nLoop - 1];
+    relax3D(tvArrayV[nLoop - 1], tvChargeFMG[nLoop - 1], coarsest.nR, coarsest.nZ, coarsest.nPhi, symmetry, coarsest.h2, coarsest.tempRatioZ, coarsest.coefficient1, coarsest.coefficient2, coarsest.coefficient3, coarsest.coefficient4);
 
-    // 4) V Cycle from coarsest to finest
+    // 3) V Cycle from coarsest to finest
     for (int count = nLoop - 2; count >= 0; --count) {
-      // move to finer grid
-      std::fill(std::begin(coefficient1), std::end(coefficient1), 0);
-      std::fill(std::begin(coefficient2), std::end(coefficient2), 0);
-      std::fill(std::begin(coefficient3), std::end(coefficient3), 0);
-      std::fill(std::begin(coefficient4), std::end(coefficient4), 0);
-      std::fill(std::begin(inverseCoefficient4), std::end(inverseCoefficient4), 0);
-
-      iOne /= 2;
-      jOne /= 2;
-      kOne /= 2;
-
-      tnRRow = iOne == 1 ? mParamGrid.NRVertices : mParamGrid.NRVertices / iOne + 1;
-      tnZColumn = jOne == 1 ? mParamGrid.NZVertices : mParamGrid.NZVertices / jOne + 1;
-      tPhiSlice = kOne == 1 ? mParamGrid.NPhiVertices : mParamGrid.NPhiVertices / kOne;
-      tPhiSlice = tPhiSlice < nnPhi ? nnPhi : tPhiSlice;
-
-      // 4) a) interpolate from 2h --> h grid
-      interp3D(tvArrayV[count], tvArrayV[count + 1], tnRRow, tnZColumn, tPhiSlice, otPhiSlice);
+      // 3) a) interpolate from 2h --> h grid
+      const auto& level = levels[count];
+      interp3D(tvArrayV[count], tvArrayV[count + 1], level.nR, level.nZ, level.nPhi, levels[count + 1].nPhi);
 
       // Copy the relax charge to the tvCharge
       if (count > 0) {
@@ -529,7 +460,7 @@ void PoissonSolver<DataT>::poissonMultiGrid3D(DataContainer& matricesV, const Da
         // copy to store previous potential
         tvPrevArrayV[count] = tvArrayV[count];
 
-        vCycle3D(symmetry, count + 1, nLoop, MGParameters::nPre, MGParameters::nPost, ratioZ, tvArrayV, tvCharge, tvResidue, coefficient1, coefficient2, coefficient3, coefficient4, inverseCoefficient4);
+        vCycle3D(symmetry, count + 1, nLoop, MGParameters::nPre, MGParameters::nPost, levels, tvArrayV, tvCharge, tvResidue);
 
         // converge error
         const DataT convergenceError = getConvergenceError(tvArrayV[count], tvPrevArrayV[count]);
@@ -550,8 +481,6 @@ void PoissonSolver<DataT>::poissonMultiGrid3D(DataContainer& matricesV, const Da
           LOGP(warning, "Cycle {} did not convergence! Current convergence error is larger than expected convergence error: {} > {}", mgCycle, convergenceError, sConvergenceError);
         }
       }
-      // keep old slice information
-      otPhiSlice = tPhiSlice;
     }
   } else if (MGParameters::cycleType == CycleType::VCycle) {
     // V-cycle
@@ -563,7 +492,7 @@ void PoissonSolver<DataT>::poissonMultiGrid3D(DataContainer& matricesV, const Da
       tvPrevArrayV[0] = tvArrayV[0];
 
       // Do V Cycle from the coarsest to finest grid
-      vCycle3D(symmetry, gridFrom, gridTo, MGParameters::nPre, MGParameters::nPost, ratioZ, tvArrayV, tvCharge, tvResidue, coefficient1, coefficient2, coefficient3, coefficient4, inverseCoefficient4);
+      vCycle3D(symmetry, gridFrom, gridTo, MGParameters::nPre, MGParameters::nPost, levels, tvArrayV, tvCharge, tvResidue);
 
       // convergence error
       const DataT convergenceError = getConvergenceError(tvArrayV[0], tvPrevArrayV[0]);
@@ -829,103 +758,44 @@ void PoissonSolver<DataT>::vCycle3D2D(const int symmetry, const int gridFrom, co
 }
 
 template <typename DataT>
-void PoissonSolver<DataT>::vCycle3D(const int symmetry, const int gridFrom, const int gridTo, const int nPre, const int nPost, const DataT ratioZ, std::vector<Vector>& tvArrayV,
-                                    std::vector<Vector>& tvCharge, std::vector<Vector>& tvResidue, std::vector<DataT>& coefficient1, std::vector<DataT>& coefficient2, std::vector<DataT>& coefficient3,
-                                    std::vector<DataT>& coefficient4, std::vector<DataT>& inverseCoefficient4) const
+void PoissonSolver<DataT>::vCycle3D(const int symmetry, const int gridFrom, const int gridTo, const int nPre, const int nPost, const std::vector<MGLevel>& levels, std::vector<Vector>& tvArrayV,
+                                    std::vector<Vector>& tvCharge, std::vector<Vector>& tvResidue) const
 {
-  const DataT gridSpacingR = getSpacingR();
-
-  unsigned int iOne = 1 << (gridFrom - 1);
-  unsigned int jOne = 1 << (gridFrom - 1);
-  unsigned int kOne = 1 << (gridFrom - 1);
-
-  int nnPhi = mParamGrid.NPhiVertices;
-  while (nnPhi % 2 == 0) {
-    nnPhi /= 2;
-  }
-
-  int tnRRow = iOne == 1 ? mParamGrid.NRVertices : mParamGrid.NRVertices / iOne + 1;
-  int tnZColumn = jOne == 1 ? mParamGrid.NZVertices : mParamGrid.NZVertices / jOne + 1;
-  int tPhiSlice = kOne == 1 ? mParamGrid.NPhiVertices : mParamGrid.NPhiVertices / kOne;
-  tPhiSlice = tPhiSlice < nnPhi ? nnPhi : tPhiSlice;
-
   for (int count = gridFrom; count <= gridTo - 1; ++count) {
     const int index = count - 1;
-    const int otPhiSlice = tPhiSlice;
-    const DataT h = gridSpacingR * iOne;
-    const DataT h2 = h * h;
-    const DataT ih2 = 1 / h2;
-    const DataT tempGridSizePhiInv = tPhiSlice * getGridSizePhiInv();        // phi now is multiGrid
-    const DataT tempRatioPhi = h2 * tempGridSizePhiInv * tempGridSizePhiInv; // ratio_{phi} = gridSize_{r} / gridSize_{phi}
-    const DataT tempRatioZ = ratioZ * iOne * iOne / (jOne * jOne);
-
-    calcCoefficients(1, tnRRow - 1, h, tempRatioZ, tempRatioPhi, coefficient1, coefficient2, coefficient3, coefficient4);
-
-    for (int i = 1; i < tnRRow - 1; ++i) {
-      inverseCoefficient4[i] = 1 / coefficient4[i];
-    }
+    const auto& level = levels[index];
+    const auto& coarse = levels[count];
 
     // 1) Pre-Smoothing: Gauss-Seidel Relaxation or Jacobi
     for (int jPre = 1; jPre <= nPre; ++jPre) {
-      relax3D(tvArrayV[index], tvCharge[index], tnRRow, tnZColumn, tPhiSlice, symmetry, h2, tempRatioZ, coefficient1, coefficient2, coefficient3, coefficient4);
+      relax3D(tvArrayV[index], tvCharge[index], level.nR, level.nZ, level.nPhi, symmetry, level.h2, level.tempRatioZ, level.coefficient1, level.coefficient2, level.coefficient3, level.coefficient4);
     } // end pre smoothing
 
     // 2) Residue calculation
-    residue3D(tvResidue[index], tvArrayV[index], tvCharge[index], tnRRow, tnZColumn, tPhiSlice, symmetry, ih2, tempRatioZ, coefficient1, coefficient2, coefficient3, inverseCoefficient4);
-
-    iOne *= 2;
-    jOne *= 2;
-    kOne *= 2;
-    tnRRow = iOne == 1 ? mParamGrid.NRVertices : mParamGrid.NRVertices / iOne + 1;
-    tnZColumn = jOne == 1 ? mParamGrid.NZVertices : mParamGrid.NZVertices / jOne + 1;
-    tPhiSlice = mParamGrid.NPhiVertices / kOne;
-    tPhiSlice = tPhiSlice < nnPhi ? nnPhi : tPhiSlice;
+    residue3D(tvResidue[index], tvArrayV[index], tvCharge[index], level.nR, level.nZ, level.nPhi, symmetry, level.ih2, level.tempRatioZ, level.coefficient1, level.coefficient2, level.coefficient3, level.inverseCoefficient4);
 
     // 3) Restriction
-    restrict3D(tvCharge[count], tvResidue[index], tnRRow, tnZColumn, tPhiSlice, otPhiSlice);
+    restrict3D(tvCharge[count], tvResidue[index], coarse.nR, coarse.nZ, coarse.nPhi, level.nPhi);
 
     // 4) Zeroing coarser V
     std::fill(tvArrayV[count].begin(), tvArrayV[count].end(), 0);
   }
 
-  // coarsest grid
-  const DataT hTmp = gridSpacingR * iOne;
-  const DataT h2Tmp = hTmp * hTmp;
-  const DataT tempGridSizePhiInvTmp = tPhiSlice * getGridSizePhiInv();                 // phi now is multiGrid
-  const DataT tempRatioPhiTmp = h2Tmp * tempGridSizePhiInvTmp * tempGridSizePhiInvTmp; // ratio_{phi} = gridSize_{r} / gridSize_{phi}
-  const DataT tempRatioZTmp = ratioZ * iOne * iOne / (jOne * jOne);
-
-  calcCoefficients(1, tnRRow - 1, hTmp, tempRatioZTmp, tempRatioPhiTmp, coefficient1, coefficient2, coefficient3, coefficient4);
-
   // 3) Relax on the coarsest grid
-  relax3D(tvArrayV[gridTo - 1], tvCharge[gridTo - 1], tnRRow, tnZColumn, tPhiSlice, symmetry, h2Tmp, tempRatioZTmp, coefficient1, coefficient2, coefficient3, coefficient4);
+  const auto& coarsest = levels[gridTo - 1];
+  relax3D(tvArrayV[gridTo - 1], tvCharge[gridTo - 1], coarsest.nR, coarsest.nZ, coarsest.nPhi, symmetry, coarsest.h2, coarsest.tempRatioZ, coarsest.coefficient1, coarsest.coefficient2, coarsest.coefficient3, coarsest.coefficient4);
+
   // back to fine
   for (int count = gridTo - 1; count >= gridFrom; --count) {
     const int index = count - 1;
-    const int otPhiSlice = tPhiSlice;
-    iOne /= 2;
-    jOne /= 2;
-    kOne /= 2;
-
-    tnRRow = iOne == 1 ? mParamGrid.NRVertices : mParamGrid.NRVertices / iOne + 1;
-    tnZColumn = jOne == 1 ? mParamGrid.NZVertices : mParamGrid.NZVertices / jOne + 1;
-    tPhiSlice = kOne == 1 ? mParamGrid.NPhiVertices : mParamGrid.NPhiVertices / kOne;
-    tPhiSlice = tPhiSlice < nnPhi ? nnPhi : tPhiSlice;
-
-    const DataT h = gridSpacingR * iOne;
-    const DataT h2 = h * h;
-    const DataT tempGridSizePhiInv = tPhiSlice * getGridSizePhiInv();
-    const DataT tempRatioPhi = h2 * tempGridSizePhiInv * tempGridSizePhiInv; // ratio_{phi} = gridSize_{r} / gridSize_{phi}
-    const DataT tempRatioZ = ratioZ * iOne * iOne / (jOne * jOne);
+    const auto& level = levels[index];
 
     // 4) Interpolation/Prolongation
-    addInterp3D(tvArrayV[index], tvArrayV[count], tnRRow, tnZColumn, tPhiSlice, otPhiSlice);
-
-    calcCoefficients(1, tnRRow - 1, h, tempRatioZ, tempRatioPhi, coefficient1, coefficient2, coefficient3, coefficient4);
+    addInterp3D(tvArrayV[index], tvArrayV[count], level.nR, level.nZ, level.nPhi, levels[count].nPhi);
 
     // 5) Post-Smoothing: Gauss-Seidel Relaxation
     for (int jPost = 1; jPost <= nPost; ++jPost) {
-      relax3D(tvArrayV[index], tvCharge[index], tnRRow, tnZColumn, tPhiSlice, symmetry, h2, tempRatioZ, coefficient1, coefficient2, coefficient3, coefficient4);
+      relax3D(tvArrayV[index], tvCharge[index], level.nR, level.nZ, level.nPhi, symmetry, level.h2, level.tempRatioZ, level.coefficient1, level.coefficient2, level.coefficient3, level.coefficient4);
     }
   }
 }
@@ -992,10 +862,18 @@ void PoissonSolver<DataT>::residue3D(Vector& residue, const Vector& matricesCurr
     }
 
     for (int j = 1; j < tnZColumn - 1; ++j) {
+      DataT* rowResidue = &residue(0, j, m);
+      const DataT* row = &matricesCurrentV(0, j, m);
+      const DataT* rowZMinus = &matricesCurrentV(0, j - 1, m);
+      const DataT* rowZPlus = &matricesCurrentV(0, j + 1, m);
+      const DataT* rowPhiPlus = &matricesCurrentV(0, j, mp1);
+      const DataT* rowPhiMinus = &matricesCurrentV(0, j, mm1);
+      const DataT* rowCharge = &matricesCurrentCharge(0, j, m);
+#pragma omp simd
       for (int i = 1; i < tnRRow - 1; ++i) {
-        residue(i, j, m) = ih2 * (coefficient2[i] * matricesCurrentV(i - 1, j, m) + tempRatioZ * (matricesCurrentV(i, j - 1, m) + matricesCurrentV(i, j + 1, m)) + coefficient1[i] * matricesCurrentV(i + 1, j, m) +
-                                  coefficient3[i] * (signPlus * matricesCurrentV(i, j, mp1) + signMinus * matricesCurrentV(i, j, mm1)) - inverseCoefficient4[i] * matricesCurrentV(i, j, m)) +
-                           matricesCurrentCharge(i, j, m);
+        rowResidue[i] = ih2 * (coefficient2[i] * row[i - 1] + tempRatioZ * (rowZMinus[i] + rowZPlus[i]) + coefficient1[i] * row[i + 1] +
+                               coefficient3[i] * (signPlus * rowPhiPlus[i] + signMinus * rowPhiMinus[i]) - inverseCoefficient4[i] * row[i]) +
+                        rowCharge[i];
       } // end cols
     }   // end mParamGrid.NRVertices
   }
@@ -1006,6 +884,7 @@ void PoissonSolver<DataT>::interp3D(Vector& matricesCurrentV, const Vector& matr
 {
   // Do restrict 2 D for each slice
   if (newPhiSlice == 2 * oldPhiSlice) {
+#pragma omp parallel for num_threads(sNThreads) // each iteration writes the slices m and m + 1 only
     for (int m = 0; m < newPhiSlice; m += 2) {
       // assuming no symmetry
       int mm = m / 2;
@@ -1114,6 +993,7 @@ void PoissonSolver<DataT>::addInterp3D(Vector& matricesCurrentV, const Vector& m
 {
   // Do restrict 2 D for each slice
   if (newPhiSlice == 2 * oldPhiSlice) {
+#pragma omp parallel for num_threads(sNThreads) // each iteration writes the slices m and m + 1 only
     for (int m = 0; m < newPhiSlice; m += 2) {
       // assuming no symmetry
       int mm = m / 2;
@@ -1222,9 +1102,13 @@ void PoissonSolver<DataT>::relax3D(Vector& matricesCurrentV, const Vector& matri
 {
   // Gauss-Seidel (Read Black}
   if (MGParameters::relaxType == RelaxType::GaussSeidel) {
+    // The points updated in one pass have the same parity of i + j + m, so that all their neighbours in r, z and phi belong to the other colour.
+    // The slices can therefore be relaxed concurrently, unless the periodic phi boundary connects two slices of the same colour (odd number of slices).
+    const bool parallelPhi = (symmetry != 0) || (iPhi % 2 == 0);
     // for each slice
     for (int iPass = 1; iPass <= 2; ++iPass) {
       const int msw = (iPass % 2) ? 1 : 2;
+#pragma omp parallel for num_threads(sNThreads) if (parallelPhi)
       for (int m = 0; m < iPhi; ++m) {
         const int jsw = ((msw + m) % 2) ? 1 : 2;
         int mp1 = m + 1;
@@ -1260,8 +1144,17 @@ void PoissonSolver<DataT>::relax3D(Vector& matricesCurrentV, const Vector& matri
         }
         int isw = jsw;
         for (int j = 1; j < tnZColumn - 1; ++j, isw = 3 - isw) {
+          // r is the contiguous direction: only the points of the current colour are visited (stride 2) and stored, their neighbours in r
+          // belong to the other colour, hence the lanes do not depend on each other and the slices m +- 1 read by other threads are not written.
+          DataT* row = &matricesCurrentV(0, j, m);
+          const DataT* rowZMinus = &matricesCurrentV(0, j - 1, m);
+          const DataT* rowZPlus = &matricesCurrentV(0, j + 1, m);
+          const DataT* rowPhiPlus = &matricesCurrentV(0, j, mp1);
+          const DataT* rowPhiMinus = &matricesCurrentV(0, j, mm1);
+          const DataT* rowCharge = &matricesCurrentCharge(0, j, m);
+#pragma omp simd
           for (int i = isw; i < tnRRow - 1; i += 2) {
-            (matricesCurrentV)(i, j, m) = (coefficient2[i] * (matricesCurrentV)(i - 1, j, m) + tempRatioZ * ((matricesCurrentV)(i, j - 1, m) + (matricesCurrentV)(i, j + 1, m)) + coefficient1[i] * (matricesCurrentV)(i + 1, j, m) + coefficient3[i] * (signPlus * (matricesCurrentV)(i, j, mp1) + signMinus * (matricesCurrentV)(i, j, mm1)) + (h2 * (matricesCurrentCharge)(i, j, m))) * coefficient4[i];
+            row[i] = (coefficient2[i] * row[i - 1] + tempRatioZ * (rowZMinus[i] + rowZPlus[i]) + coefficient1[i] * row[i + 1] + coefficient3[i] * (signPlus * rowPhiPlus[i] + signMinus * rowPhiMinus[i]) + (h2 * rowCharge[i])) * coefficient4[i];
           } // end cols
         }   // end mParamGrid.NRVertices
       }     // end phi
@@ -1389,8 +1282,9 @@ template <typename DataT>
 void PoissonSolver<DataT>::restrict3D(Vector& matricesCurrentCharge, const Vector& residue, const int tnRRow, const int tnZColumn, const int newPhiSlice, const int oldPhiSlice) const
 {
   if (2 * newPhiSlice == oldPhiSlice) {
-    int mm = 0;
-    for (int m = 0; m < newPhiSlice; m++, mm += 2) {
+#pragma omp parallel for num_threads(sNThreads)
+    for (int m = 0; m < newPhiSlice; m++) {
+      const int mm = 2 * m;
       // assuming no symmetry
       int mp1 = mm + 1;
       int mm1 = mm - 1;
@@ -1402,8 +1296,9 @@ void PoissonSolver<DataT>::restrict3D(Vector& matricesCurrentCharge, const Vecto
         mm1 = mm - 1 + (oldPhiSlice);
       }
 
-      for (int i = 1, ii = 2; i < tnRRow - 1; ++i, ii += 2) {
-        for (int j = 1, jj = 2; j < tnZColumn - 1; ++j, jj += 2) {
+      // loop over r innermost to read the fine grid along its contiguous direction
+      for (int j = 1, jj = 2; j < tnZColumn - 1; ++j, jj += 2) {
+        for (int i = 1, ii = 2; i < tnRRow - 1; ++i, ii += 2) {
 
           // at the same plane
           const int iip1 = ii + 1;
@@ -1420,8 +1315,8 @@ void PoissonSolver<DataT>::restrict3D(Vector& matricesCurrentCharge, const Vecto
                            (residue(iim1, jjm1, mm1) + residue(iim1, jjp1, mm1) + residue(iim1, jjm1, mp1) + residue(iim1, jjp1, mp1));
 
           matricesCurrentCharge(i, j, m) = residue(ii, jj, mm) / 8 + s1 / 16 + s2 / 32 + s3 / 64;
-        } // end cols
-      }   // end mParamGrid.NRVertices
+        } // end mParamGrid.NRVertices
+      }   // end cols
 
       // for boundary
       for (int j = 0, jj = 0; j < tnZColumn; ++j, jj += 2) {
@@ -1437,6 +1332,7 @@ void PoissonSolver<DataT>::restrict3D(Vector& matricesCurrentCharge, const Vecto
     } // end phis
 
   } else {
+#pragma omp parallel for num_threads(sNThreads)
     for (int m = 0; m < newPhiSlice; ++m) {
       restrict2D(matricesCurrentCharge, residue, tnRRow, tnZColumn, m);
     }
@@ -1446,8 +1342,8 @@ void PoissonSolver<DataT>::restrict3D(Vector& matricesCurrentCharge, const Vecto
 template <typename DataT>
 void PoissonSolver<DataT>::restrict2D(Vector& matricesCurrentCharge, const Vector& residue, const int tnRRow, const int tnZColumn, const int iphi) const
 {
-  for (int i = 1, ii = 2; i < tnRRow - 1; ++i, ii += 2) {
-    for (int j = 1, jj = 2; j < tnZColumn - 1; ++j, jj += 2) {
+  for (int j = 1, jj = 2; j < tnZColumn - 1; ++j, jj += 2) {
+    for (int i = 1, ii = 2; i < tnRRow - 1; ++i, ii += 2) {
       const int iip1 = ii + 1;
       const int iim1 = ii - 1;
       const int jjp1 = jj + 1;
@@ -1494,6 +1390,56 @@ DataT PoissonSolver<DataT>::getConvergenceError(const Vector& matricesCurrentV,
   return *std::max_element(std::begin(errorArr), std::end(errorArr));
 }
 
+template <typename DataT>
+std::shared_ptr<const std::vector<typename PoissonSolver<DataT>::MGLevel>> PoissonSolver<DataT>::getMGLevels(const int nLoop, const int nnPhi) const
+{
+  // the levels depend only on the grid: cache them for all solvers and threads working on the same grid
+  using Key = std::tuple<unsigned int, unsigned int, unsigned int, DataT, DataT, bool>;
+  static std::mutex cacheMutex;
+  static std::map<Key, std::shared_ptr<const std::vector<MGLevel>>> cache;
+
+  const DataT gridSpacingR = getSpacingR();
+  const DataT gridSpacingZ = getSpacingZ();
+  const Key key{mParamGrid.NRVertices, mParamGrid.NZVertices, mParamGrid.NPhiVertices, gridSpacingR, gridSpacingZ, MGParameters::normalizeGridToOneSector};
+
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  if (const auto it = cache.find(key); it != cache.end() && static_cast<int>(it->second->size()) == nLoop) {
+    return it->second;
+  }
+
+  const DataT ratioZ = gridSpacingR * gridSpacingR / (gridSpacingZ * gridSpacingZ); // ratio_{Z} = gridSize_{r} / gridSize_{z}
+  auto levels = std::make_shared<std::vector<MGLevel>>(nLoop);
+  for (int index = 0; index < nLoop; ++index) {
+    const unsigned int iOne = 1 << index; // index i in gridSize r
+    const unsigned int jOne = 1 << index; // index j in gridSize z
+    const unsigned int kOne = 1 << index; // index k in gridSize phi
+    auto& level = (*levels)[index];
+    level.nR = iOne == 1 ? mParamGrid.NRVertices : mParamGrid.NRVertices / iOne + 1;
+    level.nZ = jOne == 1 ? mParamGrid.NZVertices : mParamGrid.NZVertices / jOne + 1;
+    level.nPhi = kOne == 1 ? mParamGrid.NPhiVertices : mParamGrid.NPhiVertices / kOne;
+    level.nPhi = level.nPhi < nnPhi ? nnPhi : level.nPhi;
+
+    const DataT h = gridSpacingR * iOne;
+    level.h2 = h * h;
+    level.ih2 = 1 / level.h2;
+    const DataT gridSizePhiInv = level.nPhi * getGridSizePhiInv();         // h_{phi}
+    const DataT tempRatioPhi = level.h2 * gridSizePhiInv * gridSizePhiInv; // ratio_{phi} = gridSize_{r} / gridSize_{phi}
+    level.tempRatioZ = ratioZ * iOne * iOne / (jOne * jOne);
+
+    level.coefficient1.resize(level.nR);
+    level.coefficient2.resize(level.nR);
+    level.coefficient3.resize(level.nR);
+    level.coefficient4.resize(level.nR);
+    level.inverseCoefficient4.resize(level.nR);
+    calcCoefficients(1, level.nR - 1, h, level.tempRatioZ, tempRatioPhi, level.coefficient1, level.coefficient2, level.coefficient3, level.coefficient4);
+    for (int i = 1; i < level.nR - 1; ++i) {
+      level.inverseCoefficient4[i] = 1 / level.coefficient4[i];
+    }
+  }
+  cache[key] = levels;
+  return levels;
+}
+
 template <typename DataT>
 void PoissonSolver<DataT>::calcCoefficients(unsigned int from, unsigned int to, const DataT h, const DataT tempRatioZ, const DataT tempRatioPhi, std::vector<DataT>& coefficient1, std::vector<DataT>& coefficient2, std::vector<DataT>& coefficient3, std::vector<DataT>& coefficient4) const
 {
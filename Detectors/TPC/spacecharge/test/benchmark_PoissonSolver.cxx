@@ -0,0 +1,72 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file benchmark_PoissonSolver.cxx
+/// \brief Time to solve Poisson's equation with the 3D multi grid solver on the default grid of the space-charge calculations
+
+#include <benchmark/benchmark.h>
+
+#include "TPCSpaceCharge/PoissonSolver.h"
+#include "TPCSpaceCharge/SpaceChargeHelpers.h"
+#include "TPCSpaceCharge/PoissonSolverHelpers.h"
+#include "TPCSpaceCharge/DataContainer3D.h"
+
+using namespace o2::tpc;
+
+using DataT = double;
+static constexpr unsigned short NR = 129;   // grid in r
+static constexpr unsigned short NZ = 129;   // grid in z
+static constexpr unsigned short NPHI = 180; // grid in phi
+
+/// charge density and boundary potential of the analytical test case
+struct PoissonProblem {
+  using GridProp = GridProperties<DataT>;
+  const ParamSpaceCharge params{NR, NZ, NPHI};
+  const RegularGrid3D<DataT> grid3D{GridProp::ZMIN, GridProp::RMIN, GridProp::PHIMIN, GridProp::getGridSpacingZ(NZ), GridProp::getGridSpacingR(NR), GridProp::getGridSpacingPhi(NPHI), params};
+  DataContainer3D<DataT> charge{NZ, NR, NPHI};
+  DataContainer3D<DataT> boundary{NZ, NR, NPHI};
+
+  PoissonProblem()
+  {
+    const AnalyticalFields<DataT> formulas;
+    for (size_t iPhi = 0; iPhi < NPHI; ++iPhi) {
+      const DataT phi = grid3D.getPhiVertex(iPhi);
+      for (size_t iR = 0; iR < NR; ++iR) {
+        const DataT radius = grid3D.getRVertex(iR);
+        for (size_t iZ = 0; iZ < NZ; ++iZ) {
+          const DataT z = grid3D.getZVertex(iZ);
+          charge(iZ, iR, iPhi) = formulas.evalDensity(z, radius, phi);
+          if (iR == 0 || iR == NR - 1 || iZ == 0 || iZ == NZ - 1) {
+            boundary(iZ, iR, iPhi) = formulas.evalPotential(z, radius, phi);
+          }
+        }
+      }
+    }
+  }
+};
+
+/// repeated solves on the same grid: the multi grid levels are set up by the first solve only
+static void BM_PoissonSolver3D(benchmark::State& state)
+{
+  const PoissonProblem problem;
+  PoissonSolver<DataT>::setNThreads(state.range(0));
+  PoissonSolver<DataT> poissonSolver(problem.grid3D);
+  for (auto _ : state) {
+    auto potential = problem.boundary;
+    poissonSolver.poissonSolver3D(potential, problem.charge, 0);
+    benchmark::DoNotOptimize(potential(NZ / 2, NR / 2, NPHI / 2));
+  }
+}
+
+// number of threads
+BENCHMARK(BM_PoissonSolver3D)->Arg(1)->Arg(4)->Arg(8)->Unit(benchmark::kSecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -68,6 +68,7 @@ void EntropyEncoderSpec::init(o2::framework::InitContext& ic)
 {
   mCTFCoder.init<CTF>(ic);
   mCTFCoder.setCombineColumns(!ic.options().get<bool>("no-ctf-columns-combining"));
+  mCTFCoder.setNThreads(ic.options().get<int>("ctf-nthreads"));
 
   mFastTransform = std::move(TPCFastTransformHelperO2::instance()->create(0));
 
@@ -333,6 +334,7 @@ DataProcessorSpec getEntropyEncoderSpec(bool inputFromFile, bool selIR)
             {"irframe-clusters-maxz", VariantType::Float, 25.f, {"Max z for non assigned clusters (combined with maxeta)"}},
             {"mem-factor", VariantType::Float, 1.f, {"Memory allocation margin factor"}},
             {"nThreads-tpc-encoder", VariantType::UInt32, 1u, {"number of threads to use for decoding"}},
+            {"ctf-nthreads", VariantType::Int, 1, {"number of threads for the entropy encoding of the CTF blocks"}},
             {"ans-version", VariantType::String, {"version of ans entropy coder implementation to use"}}}};
 }
 
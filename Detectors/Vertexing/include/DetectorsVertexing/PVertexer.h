@@ -88,6 +88,8 @@ class PVertexer
   void setValidateWithIR(bool v) { mValidateWithIR = v; }
   bool getValidateWithIR() const { return mValidateWithIR; }
   void setTrackSources(GTrackID::mask_t s);
+  void setNThreads(int n);
+  int getNThreads() const { return mNThreads; }
 
   auto& getTracksPool() const { return mTracksPool; }
   auto& getTimeZClusters() const { return mTimeZClusters; }
@@ -139,6 +141,18 @@ class PVertexer
  private:
   static constexpr int DBS_UNDEF = -2, DBS_NOISE = -1, DBS_INCHECK = -10;
 
+  struct ClusterVertices { // vertices found in a single TZ-cluster, with track indices local to the cluster output
+    std::vector<PVertex> vertices;
+    std::vector<V2TRef> v2tRefs;
+    std::vector<uint32_t> trackIDs;
+    void clear()
+    {
+      vertices.clear();
+      v2tRefs.clear();
+      trackIDs.clear();
+    }
+  };
+
   SeedHistoTZ buildHistoTZ(const VertexingInput& input);
   int runVertexing(gsl::span<o2d::GlobalTrackID> gids, const gsl::span<InteractionCandidate> intCand,
                    std::vector<PVertex>& vertices, std::vector<o2d::VtxTrackIndex>& vertexTrackIDs, std::vector<V2TRef>& v2tRefs,
@@ -165,6 +179,8 @@ class PVertexer
   void createTracksPool(const TR& tracks, gsl::span<const o2d::GlobalTrackID> gids);
 
   int findVertices(const VertexingInput& input, std::vector<PVertex>& vertices, std::vector<uint32_t>& trackIDs, std::vector<V2TRef>& v2tRefs);
+  template <typename F>
+  void processClusters(int nClusters, F&& process, std::vector<PVertex>& vertices, std::vector<uint32_t>& trackIDs, std::vector<V2TRef>& v2tRefs);
   void reAttach(std::vector<PVertex>& vertices, std::vector<int>& timeSort, std::vector<uint32_t>& trackIDs, std::vector<V2TRef>& v2tRefs);
 
   std::pair<int, int> getBestIR(const PVertex& vtx, const gsl::span<InteractionCandidate> intCand, int& currEntry) const;
@@ -223,6 +239,8 @@ class PVertexer
   int mLongestClusterMult = 0;
   bool mPoolDumpProduced = false;
   bool mITSOnly = false;
+  int mNThreads = 1;
+  std::vector<ClusterVertices> mClustersVertices; // per-cluster output of the multithreaded processing
   TStopwatch mTimeDBScan;
   TStopwatch mTimeVertexing;
   TStopwatch mTimeDebris;
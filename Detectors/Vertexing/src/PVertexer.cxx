@@ -22,6 +22,10 @@
 #include "CommonUtils/StringUtils.h"
 #include <TH2F.h>
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace o2::vertexing;
 using DetID = o2::detectors::DetID;
 constexpr float PVertexer::kAlmost0F;
@@ -63,17 +67,31 @@ int PVertexer::runVertexing(const gsl::span<o2d::GlobalTrackID> gids, const gsl:
   std::vector<float> validationTimes;
   std::vector<o2::MCEventLabel> lblVtxLoc;
   mTimeVertexing.Start();
-  int cntTZ = 0;
-  for (auto tc : mTimeZClusters) {
-    size_t nnold = verticesLoc.size();
-    VertexingInput inp;
-    inp.idRange = gsl::span<int>(tc.trackIDs);
-    inp.scaleSigma2 = mPVParams->iniScale2;
-    inp.timeEst = tc.timeEst;
+  if (mNThreads > 1) {
+    // TZ-clusters have no tracks in common, so they can be processed concurrently
+    processClusters(
+      mTimeZClusters.size(), [this](int icl, ClusterVertices& res) {
+        auto& tc = mTimeZClusters[icl];
+        VertexingInput inp;
+        inp.idRange = gsl::span<int>(tc.trackIDs);
+        inp.scaleSigma2 = mPVParams->iniScale2;
+        inp.timeEst = tc.timeEst;
+        findVertices(inp, res.vertices, res.trackIDs, res.v2tRefs);
+      },
+      verticesLoc, trackIDs, v2tRefsLoc);
+  } else {
+    int cntTZ = 0;
+    for (auto tc : mTimeZClusters) {
+      size_t nnold = verticesLoc.size();
+      VertexingInput inp;
+      inp.idRange = gsl::span<int>(tc.trackIDs);
+      inp.scaleSigma2 = mPVParams->iniScale2;
+      inp.timeEst = tc.timeEst;
 #ifdef _PV_DEBUG_TREE_
-    doDBScanDump(inp, lblTracks);
+      doDBScanDump(inp, lblTracks);
 #endif
-    findVertices(inp, verticesLoc, trackIDs, v2tRefsLoc);
+      findVertices(inp, verticesLoc, trackIDs, v2tRefsLoc);
+    }
   }
   mTimeVertexing.Stop();
   // sort in time
@@ -223,19 +241,27 @@ int PVertexer::findVertices(const VertexingInput& input, std::vector<PVertex>& v
     auto clTime = tCurr - tStart;
     if (clTime > mPVParams->maxTimeMSPerCluster) {
       LOGP(warn, "Time per TZ-cluster ({}ms) of {} tracks exceeded limit after {} trials, abandon", clTime, mult, nTrials);
+#ifdef WITH_OPENMP
+#pragma omp critical(pvertexer_dump)
+#endif
       if (!mPoolDumpProduced) {
         dumpPool();
       }
       break;
     }
   }
-  mTotTrials += nTrials;
-  if (size_t(nTrials) > mMaxTrialPerCluster) {
-    mMaxTrialPerCluster = nTrials;
-  }
-  if (tCurr - tStart > mLongestClusterTimeMS) {
-    mLongestClusterTimeMS = tCurr - tStart;
-    mLongestClusterMult = mult;
+#ifdef WITH_OPENMP
+#pragma omp critical(pvertexer_stat)
+#endif
+  {
+    mTotTrials += nTrials;
+    if (size_t(nTrials) > mMaxTrialPerCluster) {
+      mMaxTrialPerCluster = nTrials;
+    }
+    if (tCurr - tStart > mLongestClusterTimeMS) {
+      mLongestClusterTimeMS = tCurr - tStart;
+      mLongestClusterMult = mult;
+    }
   }
   return nfound;
 }
@@ -528,11 +554,11 @@ void PVertexer::reAttach(std::vector<PVertex>& vertices, std::vector<int>& timeS
   v2tRefs.clear();
   trackIDs.clear();
   std::vector<PVertex> verticesUpd;
-  for (int ivt = 0; ivt < nvtOrig; ivt++) {
+  auto refitReattached = [this, &vertices](int ivt, std::vector<PVertex>& vtxOut, std::vector<uint32_t>& trIDsOut, std::vector<V2TRef>& refsOut) {
     auto& clusZT = mTimeZClusters[ivt];
     auto& vtx = vertices[ivt];
     if (clusZT.trackIDs.size() < mPVParams->minTracksPerVtx) {
-      continue;
+      return;
     }
     VertexingInput inp;
     inp.idRange = gsl::span<int>(clusZT.trackIDs);
@@ -540,9 +566,18 @@ void PVertexer::reAttach(std::vector<PVertex>& vertices, std::vector<int>& timeS
     inp.timeEst = vtx.getTimeStamp();
     if (!findVertex(inp, vtx)) {
       vtx.setNContributors(0);
-      continue;
+      return;
+    }
+    finalizeVertex(inp, vtx, vtxOut, refsOut, trIDsOut);
+  };
+  if (mNThreads > 1) { // every track is attached to at most 1 vertex, so the refits are independent
+    processClusters(
+      nvtOrig, [&refitReattached](int ivt, ClusterVertices& res) { refitReattached(ivt, res.vertices, res.trackIDs, res.v2tRefs); },
+      verticesUpd, trackIDs, v2tRefs);
+  } else {
+    for (int ivt = 0; ivt < nvtOrig; ivt++) {
+      refitReattached(ivt, verticesUpd, trackIDs, v2tRefs);
     }
-    finalizeVertex(inp, vtx, verticesUpd, v2tRefs, trackIDs);
   }
   // reorder in time since the time-stamp of vertices might have been changed
   vertices.swap(verticesUpd);
@@ -1379,6 +1414,53 @@ int PVertexer::processFromExternalPool(const std::vector<TrackVF>& pool, std::ve
   return runVertexing(gids, intCand, vertices, vertexTrackIDs, v2tRefs, lblTracks, lblVtx);
 }
 
+//______________________________________________
+void PVertexer::setNThreads(int n)
+{
+#if defined(WITH_OPENMP) && !defined(_PV_DEBUG_TREE_)
+  mNThreads = n > 0 ? n : 1;
+#else
+  mNThreads = 1;
+#endif
+}
+
+//______________________________________________
+template <typename F>
+void PVertexer::processClusters(int nClusters, F&& process, std::vector<PVertex>& vertices, std::vector<uint32_t>& trackIDs, std::vector<V2TRef>& v2tRefs)
+{
+  // Run process(icl, result) for each of nClusters clusters with disjoint tracks sets, filling per-cluster results,
+  // then append the results to the output vectors in the cluster order, so that the output does not depend on the
+  // number of threads and is the same as of the sequential processing.
+  if (int(mClustersVertices.size()) < nClusters) {
+    mClustersVertices.resize(nClusters);
+  }
+  for (int icl = 0; icl < nClusters; icl++) {
+    mClustersVertices[icl].clear();
+  }
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int icl = 0; icl < nClusters; icl++) {
+    process(icl, mClustersVertices[icl]);
+  }
+
+  for (int icl = 0; icl < nClusters; icl++) {
+    auto& res = mClustersVertices[icl];
+    int vtxOffs = vertices.size(), trcOffs = trackIDs.size();
+    for (const auto& ref : res.v2tRefs) {
+      v2tRefs.emplace_back(ref.getFirstEntry() + trcOffs, ref.getEntries());
+    }
+    for (auto id : res.trackIDs) {
+      auto& trc = mTracksPool[id];
+      if (trc.vtxID >= 0) {
+        trc.vtxID += vtxOffs; // local vertex index -> global one
+      }
+      trackIDs.push_back(id);
+    }
+    vertices.insert(vertices.end(), res.vertices.begin(), res.vertices.end());
+  }
+}
+
 //______________________________________________
 void PVertexer::setTrackSources(GTrackID::mask_t s)
 {
@@ -12,9 +12,13 @@
 #include <map>
 #include <list>
 #include <fstream>
+#include <future>
+#include <chrono>
+#include <vector>
 #include <getopt.h>
 
 #include "TSystem.h"
+#include "TROOT.h"
 #include "TFile.h"
 #include "TTree.h"
 #include "TList.h"
@@ -38,6 +42,7 @@ int main(int argc, char* argv[])
   bool skipNonExistingFiles = false;
   bool skipParentFilesList = false;
   int verbosity = 2;
+  int nThreads = 1;
   int exitCode = 0; // 0: success, >0: failure
 
   int option_index = 0;
@@ -49,6 +54,7 @@ int main(int argc, char* argv[])
     {"skip-parent-files-list", no_argument, nullptr, 4},
     {"verbosity", required_argument, nullptr, 5},
     {"help", no_argument, nullptr, 6},
+    {"threads", required_argument, nullptr, 7},
     {nullptr, 0, nullptr, 0}};
 
   while (true) {
@@ -67,6 +73,8 @@ int main(int argc, char* argv[])
       skipParentFilesList = true;
     } else if (c == 5) {
       verbosity = atoi(optarg);
+    } else if (c == 7) {
+      nThreads = atoi(optarg);
     } else if (c == 6) {
       printf("AO2D merging tool. Options: \n");
       printf("  --input <inputfile.txt>      Contains path to files to be merged. Default: %s\n", inputCollection.c_str());
@@ -75,6 +83,7 @@ int main(int argc, char* argv[])
       printf("  --skip-non-existing-files    Flag to allow skipping of non-existing files in the input list.\n");
       printf("  --skip-parent-files-list     Flag to allow skipping the merging of the parent files list.\n");
       printf("  --verbosity <flag>           Verbosity of output (default: %d).\n", verbosity);
+      printf("  --threads <n>                Threads for opening the next input file ahead and for (de)compressing branches in parallel (default: %d).\n", nThreads);
       return -1;
     } else {
       return -2;
@@ -88,6 +97,11 @@ int main(int argc, char* argv[])
   if (skipNonExistingFiles) {
     printf("  WARNING: Skipping non-existing files.\n");
   }
+  if (nThreads > 1) {
+    printf("  Threads: %d\n", nThreads);
+    // baskets of the different branches are unzipped in GetEntry() and zipped in Fill() in parallel
+    ROOT::EnableImplicitMT(nThreads);
+  }
 
   std::map<std::string, TTree*> trees;
   std::map<std::string, uint64_t> sizeCompressed;
@@ -102,12 +116,9 @@ int main(int argc, char* argv[])
   std::ifstream in;
   in.open(inputCollection);
   TString line;
+  std::vector<TString> inputFileNames;
   bool connectedToAliEn = false;
-  TMap* metaData = nullptr;
-  TMap* parentFiles = nullptr;
-  int totalMergedDFs = 0;
-  int mergedDFs = 0;
-  while (in.good() && exitCode == 0) {
+  while (in.good()) {
     in >> line;
 
     if (line.Length() == 0) {
@@ -119,10 +130,29 @@ int main(int argc, char* argv[])
       TGrid::Connect("alien:");
       connectedToAliEn = true; // Only try once
     }
+    inputFileNames.push_back(line);
+  }
 
+  // the next input file is opened while the current one is merged, hiding the latency of remote files
+  auto launchPolicy = (nThreads > 1) ? std::launch::async : std::launch::deferred;
+  auto openInputFile = [](TString fileName) { return TFile::Open(fileName); };
+  std::future<TFile*> nextInputFile;
+  if (!inputFileNames.empty()) {
+    nextInputFile = std::async(launchPolicy, openInputFile, inputFileNames.front());
+  }
+
+  TMap* metaData = nullptr;
+  TMap* parentFiles = nullptr;
+  int totalMergedDFs = 0;
+  int mergedDFs = 0;
+  for (size_t iFile = 0; iFile < inputFileNames.size() && exitCode == 0; ++iFile) {
+    line = inputFileNames[iFile];
     printf("Processing input file: %s\n", line.Data());
 
-    auto inputFile = TFile::Open(line);
+    auto inputFile = nextInputFile.get();
+    if (iFile + 1 < inputFileNames.size()) {
+      nextInputFile = std::async(launchPolicy, openInputFile, inputFileNames[iFile + 1]);
+    }
     if (!inputFile) {
       printf("Error: Could not open input file %s.\n", line.Data());
       if (skipNonExistingFiles) {
@@ -254,18 +284,38 @@ int main(int argc, char* argv[])
         }
 
         auto outputTree = trees[treeName];
+        // all index columns are connected to one contiguous buffer, so that they are shifted in a single pass per entry
+        int nIndices = 0;
+        TObjArray* branches = inputTree->GetListOfBranches();
+        for (int i = 0; i < branches->GetEntriesFast(); ++i) {
+          TBranch* br = (TBranch*)branches->UncheckedAt(i);
+          TString branchName(br->GetName());
+          TLeaf* leafCount = ((TLeaf*)br->GetListOfLeaves()->First())->GetLeafCount();
+          if (leafCount != nullptr) {
+            if (branchName.BeginsWith("fIndexArray")) {
+              nIndices += leafCount->GetMaximum();
+            }
+          } else if (branchName.BeginsWith("fIndexSlice")) {
+            nIndices += 2;
+          } else if (branchName.BeginsWith("fIndex") && !branchName.EndsWith("_size")) {
+            nIndices += 1;
+          }
+        }
+        std::vector<int> indexValues(nIndices);
+        std::vector<int> indexOffsets(nIndices);
+        std::vector<TString> indexBranchNames;
+        int nextIndex = 0;
+
         // register index and connect VLA columns
-        std::vector<std::pair<int*, int>> indexList;
         std::vector<char*> vlaPointers;
-        std::vector<int*> indexPointers;
-        TObjArray* branches = inputTree->GetListOfBranches();
         for (int i = 0; i < branches->GetEntriesFast(); ++i) {
           TBranch* br = (TBranch*)branches->UncheckedAt(i);
           TString branchName(br->GetName());
 
           // detect VLA
           if (((TLeaf*)br->GetListOfLeaves()->First())->GetLeafCount() != nullptr) {
-            int maximum = ((TLeaf*)br->GetListOfLeaves()->First())->GetLeafCount()->GetMaximum();
+            TLeaf* leafCount = ((TLeaf*)br->GetListOfLeaves()->First())->GetLeafCount();
+            int maximum = leafCount->GetMaximum();
 
             // get type
             static TClass* cls;
@@ -273,61 +323,60 @@ int main(int argc, char* argv[])
             br->GetExpectedType(cls, type);
             auto typeSize = TDataType::GetDataType(type)->Size();
 
-            char* buffer = new char[maximum * typeSize];
-            memset(buffer, 0, maximum * typeSize);
-            vlaPointers.push_back(buffer);
+            char* buffer = nullptr;
+            if (branchName.BeginsWith("fIndexArray")) {
+              // index arrays are int arrays by construction of the data model
+              buffer = reinterpret_cast<char*>(indexValues.data() + nextIndex);
+              std::fill_n(indexOffsets.begin() + nextIndex, maximum, offsets[getTableName(branchName, treeName)]);
+              nextIndex += maximum;
+              indexBranchNames.emplace_back(br->GetName());
+              indexBranchNames.emplace_back(leafCount->GetBranch()->GetName());
+            } else {
+              buffer = new char[maximum * typeSize];
+              memset(buffer, 0, maximum * typeSize);
+              vlaPointers.push_back(buffer);
+            }
             if (verbosity > 2) {
               printf("      Allocated VLA buffer of length %d with %d bytes each for branch name %s\n", maximum, typeSize, br->GetName());
             }
             inputTree->SetBranchAddress(br->GetName(), buffer);
             outputTree->SetBranchAddress(br->GetName(), buffer);
-
-            if (branchName.BeginsWith("fIndexArray")) {
-              for (int i = 0; i < maximum; i++) {
-                indexList.push_back({reinterpret_cast<int*>(buffer + i * typeSize), offsets[getTableName(branchName, treeName)]});
-              }
-            }
           } else if (branchName.BeginsWith("fIndexSlice")) {
-            int* buffer = new int[2];
-            memset(buffer, 0, 2 * sizeof(buffer[0]));
-            vlaPointers.push_back(reinterpret_cast<char*>(buffer));
+            int* buffer = indexValues.data() + nextIndex;
+            std::fill_n(indexOffsets.begin() + nextIndex, 2, offsets[getTableName(branchName, treeName)]);
+            nextIndex += 2;
+            indexBranchNames.emplace_back(br->GetName());
 
             inputTree->SetBranchAddress(br->GetName(), buffer);
             outputTree->SetBranchAddress(br->GetName(), buffer);
-
-            indexList.push_back({buffer, offsets[getTableName(branchName, treeName)]});
-            indexList.push_back({buffer + 1, offsets[getTableName(branchName, treeName)]});
           } else if (branchName.BeginsWith("fIndex") && !branchName.EndsWith("_size")) {
-            int* buffer = new int;
-            *buffer = 0;
-            indexPointers.push_back(buffer);
+            int* buffer = indexValues.data() + nextIndex;
+            indexOffsets[nextIndex] = offsets[getTableName(branchName, treeName)];
+            nextIndex += 1;
+            indexBranchNames.emplace_back(br->GetName());
 
             inputTree->SetBranchAddress(br->GetName(), buffer);
             outputTree->SetBranchAddress(br->GetName(), buffer);
-
-            indexList.push_back({buffer, offsets[getTableName(branchName, treeName)]});
           }
         }
 
-        if (indexList.size() > 0) {
+        if (nIndices > 0) {
           auto entries = inputTree->GetEntries();
           int minIndexOffset = unassignedIndexOffset[treeName];
           auto newMinIndexOffset = minIndexOffset;
-          for (int i = 0; i < entries; i++) {
-            for (auto& index : indexList) {
-              *(index.first) = 0; // Any positive number will do, in any case it will not be filled in the output. Otherwise the previous entry is used and manipulated in the following.
+          if (alreadyCopied) {
+            // the entries were copied with the tree, only the index columns are needed to find the unassigned indices
+            inputTree->SetBranchStatus("*", false);
+            for (const auto& branchName : indexBranchNames) {
+              inputTree->SetBranchStatus(branchName, true);
             }
+          }
+          for (int i = 0; i < entries; i++) {
+            // Any positive number will do, in any case it will not be filled in the output. Otherwise the previous entry is used and manipulated in the following.
+            std::fill(indexValues.begin(), indexValues.end(), 0);
             inputTree->GetEntry(i);
             // shift index columns by offset
-            for (const auto& idx : indexList) {
-              // if negative, the index is unassigned. In this case, the different unassigned blocks have to get unique negative IDs
-              if (*(idx.first) < 0) {
-                *(idx.first) += minIndexOffset;
-                newMinIndexOffset = std::min(newMinIndexOffset, *(idx.first));
-              } else {
-                *(idx.first) += idx.second;
-              }
-            }
+            newMinIndexOffset = shiftIndices(indexValues.data(), indexOffsets.data(), nIndices, minIndexOffset, newMinIndexOffset);
             if (!alreadyCopied) {
               int nbytes = outputTree->Fill();
               if (nbytes > 0) {
@@ -345,9 +394,6 @@ int main(int argc, char* argv[])
 
         delete inputTree;
 
-        for (auto& buffer : indexPointers) {
-          delete buffer;
-        }
         for (auto& buffer : vlaPointers) {
           delete[] buffer;
         }
@@ -412,6 +458,13 @@ int main(int argc, char* argv[])
     inputFile->Close();
   }
 
+  // when the merge stops early, the read ahead may still be opening the next input file
+  if (nextInputFile.valid() && nextInputFile.wait_for(std::chrono::seconds(0)) != std::future_status::deferred) {
+    if (auto pendingFile = nextInputFile.get()) {
+      pendingFile->Close();
+    }
+  }
+
   if (parentFiles) {
     outputFile->cd();
     parentFiles->Write("parentFiles", TObject::kSingleKey);
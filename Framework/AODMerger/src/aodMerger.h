@@ -10,6 +10,8 @@
 // or submit itself to any jurisdiction.
 
 #include <TString.h>
+#include <algorithm>
+#include <limits>
 
 const char* removeVersionSuffix(const char* treeName)
 {
@@ -49,3 +51,16 @@ const char* getTableName(const char* branchName, const char* treeName)
   // printf("%s --> %s\n", branchName, tableName.Data());
   return tableName;
 }
+
+int shiftIndices(int* indices, const int* offsets, int n, int unassignedOffset, int minUnassigned)
+{
+  // shift index columns by the offset of the table they point to and return the new minimum of the unassigned indices
+  // if negative, the index is unassigned. In this case, the different unassigned blocks have to get unique negative IDs
+  // written with bit masks instead of branches such that the loop over the contiguous index buffer is vectorised
+  for (int i = 0; i < n; ++i) {
+    const int mask = indices[i] >> 31; // all bits set for unassigned indices
+    indices[i] += (unassignedOffset & mask) | (offsets[i] & ~mask);
+    minUnassigned = std::min(minUnassigned, (indices[i] & mask) | (std::numeric_limits<int>::max() & ~mask));
+  }
+  return minUnassigned;
+}
@@ -0,0 +1,72 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test AOD Merger ShiftIndices
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+
+#include <boost/test/unit_test.hpp>
+#include <random>
+#include <vector>
+
+#include "../src/aodMerger.h"
+
+// reference: the per-index loop of the merger before the index buffers were made contiguous
+int shiftIndicesReference(std::vector<int>& indices, const std::vector<int>& offsets, int unassignedOffset, int minUnassigned)
+{
+  for (size_t i = 0; i < indices.size(); ++i) {
+    if (indices[i] < 0) {
+      indices[i] += unassignedOffset;
+      minUnassigned = std::min(minUnassigned, indices[i]);
+    } else {
+      indices[i] += offsets[i];
+    }
+  }
+  return minUnassigned;
+}
+
+BOOST_AUTO_TEST_CASE(ShiftIndicesSimple)
+{
+  std::vector<int> indices{0, 5, -1, 12, -3, -1};
+  const std::vector<int> offsets{10, 10, 10, 100, 100, 7};
+  auto minUnassigned = shiftIndices(indices.data(), offsets.data(), indices.size(), -4, -4);
+  const std::vector<int> expected{10, 15, -5, 112, -7, -5};
+  BOOST_CHECK_EQUAL_COLLECTIONS(indices.begin(), indices.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(minUnassigned, -7);
+
+  // without unassigned indices the minimum is unchanged
+  std::vector<int> assigned{0, 1, 2};
+  BOOST_CHECK_EQUAL(shiftIndices(assigned.data(), offsets.data(), assigned.size(), -4, -4), -4);
+  BOOST_CHECK_EQUAL(assigned[2], 12);
+
+  // nothing to do for an empty buffer
+  BOOST_CHECK_EQUAL(shiftIndices(nullptr, nullptr, 0, 0, -2), -2);
+}
+
+BOOST_AUTO_TEST_CASE(ShiftIndicesRandom)
+{
+  std::mt19937 generator(1234);
+  std::uniform_int_distribution<int> indexDist(-50, 10000);
+  std::uniform_int_distribution<int> offsetDist(0, 1000000);
+  // odd size to cover the remainder of the vectorised loop
+  constexpr int n = 1001;
+  std::vector<int> indices(n), offsets(n);
+  for (int i = 0; i < n; ++i) {
+    indices[i] = indexDist(generator);
+    offsets[i] = offsetDist(generator);
+  }
+  auto expected = indices;
+  const int unassignedOffset = -123;
+  auto expectedMin = shiftIndicesReference(expected, offsets, unassignedOffset, unassignedOffset);
+  auto minUnassigned = shiftIndices(indices.data(), offsets.data(), n, unassignedOffset, unassignedOffset);
+  BOOST_CHECK_EQUAL_COLLECTIONS(indices.begin(), indices.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(minUnassigned, expectedMin);
+}
@@ -34,6 +34,7 @@
 #include <TFile.h>
 #include <TTreeCache.h>
 #include <TSystem.h>
+#include <TROOT.h>
 
 #include <arrow/ipc/reader.h>
 #include <arrow/ipc/writer.h>
@@ -159,6 +160,13 @@ AlgorithmSpec AODJAlienReaderHelpers::rootFileReaderCallback()
       }
     }
 
+    // columns of a tree are read concurrently by TreeToTable when implicit MT is enabled.
+    // Note that ROOT implicit MT is a process wide setting: the thread pool is shared with
+    // any other ROOT code running in the reader process.
+    if (options.isSet("aod-reader-threads") && options.get<int>("aod-reader-threads") > 1) {
+      ROOT::EnableImplicitMT(options.get<int>("aod-reader-threads"));
+    }
+
     // get the run time watchdog
     auto* watchdog = new RuntimeWatchdog(options.get<int64_t>("time-limit"));
 
@@ -17,7 +17,9 @@
 #include "Framework/RuntimeError.h"
 #include <arrow/table.h>
 
+#include <algorithm>
 #include <iterator>
+#include <numeric>
 #include <tuple>
 #include <utility>
 
@@ -72,8 +74,56 @@ inline bool diffCategory(BinningIndex const& a, BinningIndex const& b)
   return a.bin >= b.bin;
 }
 
+/// Sort the rows by bin into groupedIndices, keeping the rows of a bin in the given order.
+/// A counting sort is used when the bin range is comparable to the number of rows, a stable sort otherwise.
+inline void sortByBin(std::vector<int> const& rowBins, std::vector<uint64_t> const& rowIndices, std::vector<BinningIndex>& groupedIndices)
+{
+  groupedIndices.clear();
+  if (rowIndices.empty()) {
+    return;
+  }
+  groupedIndices.resize(rowIndices.size(), BinningIndex{0, 0});
+  auto [minIt, maxIt] = std::minmax_element(rowBins.begin(), rowBins.end());
+  int64_t minBin = *minIt;
+  uint64_t range = int64_t(*maxIt) - minBin + 1;
+  if (range <= 2 * rowIndices.size() + 1024) {
+    std::vector<uint64_t> offsets(range + 1, 0);
+    for (auto bin : rowBins) {
+      offsets[bin - minBin + 1]++;
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    for (size_t i = 0; i < rowIndices.size(); i++) {
+      groupedIndices[offsets[rowBins[i] - minBin]++] = BinningIndex{rowBins[i], rowIndices[i]};
+    }
+  } else {
+    for (size_t i = 0; i < rowIndices.size(); i++) {
+      groupedIndices[i] = BinningIndex{rowBins[i], rowIndices[i]};
+    }
+    std::stable_sort(groupedIndices.begin(), groupedIndices.end(), sameCategory);
+  }
+}
+
+/// Remove the categories with less than minCatSize entries from the sorted groupedIndices, in a single pass
+inline void removeSmallCategories(std::vector<BinningIndex>& groupedIndices, uint64_t minCatSize)
+{
+  if (minCatSize <= 1) {
+    return;
+  }
+  auto kept = groupedIndices.begin();
+  auto catBegin = groupedIndices.begin();
+  while (catBegin != groupedIndices.end()) {
+    auto catEnd = std::upper_bound(catBegin, groupedIndices.end(), *catBegin, sameCategory);
+    if (uint64_t(std::distance(catBegin, catEnd)) >= minCatSize) {
+      kept = (kept == catBegin) ? catEnd : std::move(catBegin, catEnd, kept);
+    }
+    catBegin = catEnd;
+  }
+  groupedIndices.erase(kept, groupedIndices.end());
+}
+
+// Bins of the table rows, in increasing row order, skipping the rows in the outsider bin
 template <template <typename... Cs> typename BP, typename T, typename... Cs>
-std::vector<BinningIndex> groupTable(const T& table, const BP<Cs...>& binningPolicy, int minCatSize, int outsider)
+void getRowBins(const T& table, const BP<Cs...>& binningPolicy, int outsider, std::vector<int>& rowBins, std::vector<uint64_t>& rowIndices)
 {
   arrow::Table* arrowTable = table.asArrowTable().get();
   auto rowIterator = table.begin();
@@ -81,11 +131,10 @@ std::vector<BinningIndex> groupTable(const T& table, const BP<Cs...>& binningPol
   uint64_t ind = 0;
   uint64_t selInd = 0;
   gsl::span<int64_t const> selectedRows;
-  std::vector<BinningIndex> groupedIndices;
 
   // Separate check to account for Filtered size different from arrow table
   if (table.size() == 0) {
-    return groupedIndices;
+    return;
   }
 
   if constexpr (soa::is_soa_filtered_v<T>) {
@@ -102,6 +151,9 @@ std::vector<BinningIndex> groupTable(const T& table, const BP<Cs...>& binningPol
     }
   }
 
+  rowBins.reserve(table.size());
+  rowIndices.reserve(table.size());
+
   for (uint64_t ci = 0; ci < chunksCount; ++ci) {
     auto chunks = o2::soa::row_helpers::getChunks(arrowTable, persistentColumns, ci);
     auto chunkLength = std::get<0>(chunks)->length();
@@ -128,7 +180,8 @@ std::vector<BinningIndex> groupTable(const T& table, const BP<Cs...>& binningPol
       auto values = binningPolicy.getBinningValues(rowIterator, arrowTable, ci, ai, ind);
       auto val = binningPolicy.getBin(values);
       if (val != outsider) {
-        groupedIndices.emplace_back(val, ind);
+        rowBins.push_back(val);
+        rowIndices.push_back(ind);
       }
       ind++;
 
@@ -148,53 +201,154 @@ std::vector<BinningIndex> groupTable(const T& table, const BP<Cs...>& binningPol
     }
   }
 
-  // Do a stable sort so that same categories entries are
-  // grouped together.
-  std::stable_sort(groupedIndices.begin(), groupedIndices.end());
+}
+
+template <template <typename... Cs> typename BP, typename T, typename... Cs>
+std::vector<BinningIndex> groupTable(const T& table, const BP<Cs...>& binningPolicy, int minCatSize, int outsider)
+{
+  std::vector<int> rowBins;
+  std::vector<uint64_t> rowIndices;
+  std::vector<BinningIndex> groupedIndices;
+  getRowBins(table, binningPolicy, outsider, rowBins, rowIndices);
+
+  // Rows are visited in increasing order, so that the stable sort groups same categories
+  // together keeping the rows sorted within a category.
+  sortByBin(rowBins, rowIndices, groupedIndices);
 
   // Remove categories of too small size
-  if (minCatSize > 1) {
-    auto catBegin = groupedIndices.begin();
-    while (catBegin != groupedIndices.end()) {
-      auto catEnd = std::upper_bound(catBegin, groupedIndices.end(), *catBegin, sameCategory);
-      if (std::distance(catBegin, catEnd) < minCatSize) {
-        catEnd = groupedIndices.erase(catBegin, catEnd);
+  removeSmallCategories(groupedIndices, minCatSize);
+
+  return groupedIndices;
+}
+
+/// Rows of a table partitioned by bin, in compressed sparse row form: the rows of bins[i] are
+/// rows[offsets[i]] ... rows[offsets[i + 1] - 1]. Bins are in increasing order and the rows of a bin keep the table order.
+/// Bins are mixed independently of each other, so that the ranges of bins given by splitBins() can be processed
+/// concurrently, e.g. one range per worker thread.
+struct BinnedIndex {
+  std::vector<int> bins;
+  std::vector<uint64_t> offsets{0};
+  std::vector<uint64_t> rows;
+
+  size_t nBins() const { return bins.size(); }
+  size_t size() const { return rows.size(); }
+  bool empty() const { return rows.empty(); }
+  uint64_t binSize(size_t i) const { return offsets[i + 1] - offsets[i]; }
+  gsl::span<uint64_t const> binRows(size_t i) const { return {rows.data() + offsets[i], binSize(i)}; }
+
+  /// Build the partition from the rows sorted by bin
+  void build(std::vector<BinningIndex> const& groupedIndices)
+  {
+    bins.clear();
+    offsets.assign(1, 0);
+    rows.resize(groupedIndices.size());
+    for (size_t i = 0; i < groupedIndices.size(); i++) {
+      if (bins.empty() || bins.back() != groupedIndices[i].bin) {
+        if (!bins.empty()) {
+          offsets.push_back(i);
+        }
+        bins.push_back(groupedIndices[i].bin);
       }
-      catBegin = catEnd;
+      rows[i] = groupedIndices[i].index;
+    }
+    if (!bins.empty()) {
+      offsets.push_back(rows.size());
     }
   }
 
-  return groupedIndices;
+  /// Split the bins into at most nBlocks ranges [first, last) of consecutive bins with a similar number of
+  /// combinations for the given sliding window size
+  std::vector<std::pair<size_t, size_t>> splitBins(size_t nBlocks, uint64_t windowSize) const
+  {
+    std::vector<std::pair<size_t, size_t>> blocks;
+    if (bins.empty() || nBlocks == 0) {
+      return blocks;
+    }
+    auto cost = [this, windowSize](size_t i) { return binSize(i) * std::min(binSize(i), windowSize); };
+    uint64_t total = 0;
+    for (size_t i = 0; i < bins.size(); i++) {
+      total += cost(i);
+    }
+    uint64_t perBlock = std::max<uint64_t>(1, (total + nBlocks - 1) / nBlocks);
+    uint64_t acc = 0;
+    size_t first = 0;
+    for (size_t i = 0; i < bins.size(); i++) {
+      acc += cost(i);
+      if (acc >= perBlock || i == bins.size() - 1) {
+        blocks.emplace_back(first, i + 1);
+        first = i + 1;
+        acc = 0;
+      }
+    }
+    return blocks;
+  }
+};
+
+// Partition the table rows by bin, dropping the outsider bin and the bins with less than minCatSize rows
+template <template <typename... Cs> typename BP, typename T, typename... Cs>
+BinnedIndex binTable(const T& table, const BP<Cs...>& binningPolicy, int minCatSize, int outsider)
+{
+  BinnedIndex binnedIndex;
+  binnedIndex.build(groupTable(table, binningPolicy, minCatSize, outsider));
+  return binnedIndex;
+}
+
+// Identity of the rows seen through a table, so that the same rows are grouped only once
+struct TableRowsId {
+  arrow::Table const* table = nullptr;
+  int64_t const* selection = nullptr;
+  uint64_t offset = 0;
+  uint64_t size = 0;
+
+  bool operator==(TableRowsId const& rhs) const { return std::tie(table, selection, offset, size) == std::tie(rhs.table, rhs.selection, rhs.offset, rhs.size); }
+};
+
+template <typename T>
+TableRowsId getTableRowsId(const T& table)
+{
+  TableRowsId id{table.asArrowTable().get(), nullptr, uint64_t(table.offset()), uint64_t(table.size())};
+  if constexpr (soa::is_soa_filtered_v<T>) {
+    id.selection = table.getSelectedRows().data();
+  }
+  return id;
 }
 
 // Synchronize categories so as groupedIndices contain elements only of categories common to all tables
 template <std::size_t K>
 void syncCategories(std::array<std::vector<BinningIndex>, K>& groupedIndices)
 {
-  std::vector<BinningIndex> firstCategories;
-  std::vector<BinningIndex> commonCategories;
-  std::unique_copy(groupedIndices[0].begin(), groupedIndices[0].end(), std::back_inserter(firstCategories), diffCategory);
-
-  for (auto& cat : firstCategories) {
-    bool isCommon = true;
-    for (int i = 1; i < K; i++) {
-      if (!std::binary_search(groupedIndices[i].begin(), groupedIndices[i].end(), cat, sameCategory)) {
-        isCommon = false;
-        break;
-      }
+  // Intersect the sorted category lists of all tables
+  std::vector<int> commonCategories;
+  for (auto& idx : groupedIndices[0]) {
+    if (commonCategories.empty() || commonCategories.back() != idx.bin) {
+      commonCategories.push_back(idx.bin);
     }
-    if (isCommon) {
-      commonCategories.push_back(cat);
+  }
+  for (int i = 1; i < K; i++) {
+    size_t nCommon = 0;
+    auto it = groupedIndices[i].begin();
+    for (auto cat : commonCategories) {
+      it = std::lower_bound(it, groupedIndices[i].end(), BinningIndex{cat, 0}, sameCategory);
+      if (it != groupedIndices[i].end() && it->bin == cat) {
+        commonCategories[nCommon++] = cat;
+      }
     }
+    commonCategories.resize(nCommon);
   }
 
+  // Compact each table in a single pass
   for (int i = 0; i < K; i++) {
-    auto nonCatBegin = groupedIndices[i].begin();
-    for (auto& cat : commonCategories) {
-      auto nonCatEnd = std::lower_bound(nonCatBegin, groupedIndices[i].end(), cat, sameCategory);
-      nonCatEnd = groupedIndices[i].erase(nonCatBegin, nonCatEnd);
-      nonCatBegin = std::upper_bound(nonCatEnd, groupedIndices[i].end(), cat, sameCategory);
+    auto cat = commonCategories.begin();
+    size_t nKept = 0;
+    for (auto& idx : groupedIndices[i]) {
+      while (cat != commonCategories.end() && *cat < idx.bin) {
+        ++cat;
+      }
+      if (cat != commonCategories.end() && *cat == idx.bin) {
+        groupedIndices[i][nKept++] = idx;
+      }
     }
+    groupedIndices[i].erase(groupedIndices[i].begin() + nKept, groupedIndices[i].end());
   }
 }
 
@@ -452,7 +606,7 @@ struct CombinationsBlockIndexPolicyBase : public CombinationsIndexPolicyBase<Ts.
     }
 
     int tableIndex = 0;
-    ((this->mGroupedIndices[tableIndex++] = groupTable(tables, this->mBP, 1, this->mOutsider)), ...);
+    (groupTableOnce(tableIndex++, tables), ...);
 
     // Synchronize categories across tables
     syncCategories(this->mGroupedIndices);
@@ -481,7 +635,7 @@ struct CombinationsBlockIndexPolicyBase : public CombinationsIndexPolicyBase<Ts.
 
     int tableIndex = 0;
     std::apply([&, this](auto&&... x) mutable {
-      ((this->mGroupedIndices[tableIndex++] = groupTable(x, this->mBP, 1, this->mOutsider)), ...);
+      (groupTableOnce(tableIndex++, x), ...);
     },
                *this->mTables);
 
@@ -500,6 +654,20 @@ struct CombinationsBlockIndexPolicyBase : public CombinationsIndexPolicyBase<Ts.
     });
   }
 
+  // Group the table, or copy the grouping of a previous table seeing the same rows (e.g. mixing a table with itself)
+  template <typename TT>
+  void groupTableOnce(int tableIndex, const TT& table)
+  {
+    mTableRowsIds[tableIndex] = getTableRowsId(table);
+    for (int i = 0; i < tableIndex; i++) {
+      if (mTableRowsIds[i] == mTableRowsIds[tableIndex]) {
+        this->mGroupedIndices[tableIndex] = this->mGroupedIndices[i];
+        return;
+      }
+    }
+    this->mGroupedIndices[tableIndex] = groupTable(table, this->mBP, 1, this->mOutsider);
+  }
+
   int currentWindowNeighbours()
   {
     // NOTE: The same number of currentWindowNeighbours is returned for all kinds of block combinations.
@@ -522,6 +690,7 @@ struct CombinationsBlockIndexPolicyBase : public CombinationsIndexPolicyBase<Ts.
   }
 
   std::array<std::vector<BinningIndex>, sizeof...(Ts)> mGroupedIndices;
+  std::array<TableRowsId, sizeof...(Ts)> mTableRowsIds;
   IndicesType mCurrentIndices;
   IndicesType mBeginIndices;
   uint64_t mSlidingWindowSize;
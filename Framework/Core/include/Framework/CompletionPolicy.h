@@ -97,6 +97,11 @@ struct CompletionPolicy {
   /// not needed if the policy always happens to consume / discard
   /// data.
   bool balanceChannels = true;
+  /// Set to true if the policy is guaranteed to Wait as long as any
+  /// non Lifetime::Sporadic input of a record is missing. This allows
+  /// the DataRelayer to skip invoking callbackFull on incomplete records
+  /// by simply checking its per slot completion bitmask.
+  bool waitsForAllInputs = false;
 
   CompletionOrder order = CompletionOrder::Any;
 
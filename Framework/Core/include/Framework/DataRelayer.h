@@ -22,7 +22,9 @@
 #include "Framework/TimesliceSlot.h"
 #include "Framework/ServiceRegistryRef.h"
 
+#include <atomic>
 #include <cstddef>
+#include <memory>
 #include <mutex>
 #include <vector>
 #include <functional>
@@ -187,6 +189,14 @@ class DataRelayer
   /// e.g. as consequnce of an OOB event.
   void rescan() { mTimesliceIndex.rescan(); };
 
+  /// @return true if all the non Lifetime::Sporadic inputs of @a slot have been relayed.
+  /// This does not take the relayer lock, it only reads the completion bitmask of the slot,
+  /// so it can be polled from other threads while data is being relayed.
+  /// Notice that the bitmask is reallocated by setPipelineLength.
+  [[nodiscard]] bool isSlotComplete(TimesliceSlot slot) const;
+  /// @return the number of inputs of @a slot which have been relayed, lock free as above.
+  [[nodiscard]] size_t getNumberOfInputsInSlot(TimesliceSlot slot) const;
+
   [[nodiscard]] size_t getCacheSize() const { return mCache.size(); }
   [[nodiscard]] size_t getNumberOfTimeslices() const { return mTimesliceIndex.size(); }
   [[nodiscard]] size_t getNumberOfUniqueInputs() const { return mDistinctRoutesIndex.size(); }
@@ -213,6 +223,20 @@ class DataRelayer
   std::vector<PruneOp> mPruneOps;
   size_t mMaxLanes;
 
+  /// Set / reset the bit of @a input in the completion bitmask of @a slot
+  void markInputPresent(TimesliceSlot slot, size_t input);
+  void resetCompletionMask(TimesliceSlot slot);
+  /// (Re)create the completion bitmask from the content of the cache
+  void rebuildCompletionMask();
+
+  /// One bit per input for each slot, set when the corresponding cache
+  /// entry gets filled and cleared when the slot is pruned or consumed.
+  /// Each slot uses mCompletionMaskWords consecutive words.
+  std::unique_ptr<std::atomic<uint64_t>[]> mCompletionMask;
+  size_t mCompletionMaskWords = 0;
+  /// Bits of the inputs which need to be present for a slot to be complete
+  std::vector<uint64_t> mRequiredInputsMask;
+
   O2_LOCKABLE_NAMED(std::recursive_mutex, mMutex, "data relayer mutex");
 };
 
@@ -27,7 +27,10 @@
 #include <TDataType.h>
 #include <TArrayL.h>
 
+#include <atomic>
 #include <deque>
+#include <mutex>
+#include <unordered_map>
 
 class TList;
 
@@ -69,6 +72,85 @@ struct HistFiller {
   static int getBaseElementSize(T* ptr);
 };
 
+//**************************************************************************************************
+/**
+ * Buffer collecting the fills of one histogram from several threads at the same time.
+ * Bin contents of TH1, TH2 and TH3 are accumulated in flat arrays of atomics, those of THn and THnSparse in a
+ * sharded hash map of the filled bins. The buffered fills are merged into the histogram by flush(), which must not run
+ * concurrently with fill(). Histograms which cannot be buffered (profiles, StepTHn, extendable axes) are filled
+ * directly, one thread at a time.
+ * The flat buffer is not free: it holds two doubles (sum of weights and of squared weights) per cell, on top of the
+ * bins of the histogram itself, i.e. twice the memory of a TH1D without Sumw2.
+ */
+//**************************************************************************************************
+class ConcurrentHistFiller
+{
+ public:
+  explicit ConcurrentHistFiller(HistPtr hist);
+
+  // fill the buffer with values (if weight was requested it must be the last argument)
+  template <typename... Ts>
+  void fill(Ts... positionAndWeight)
+    requires(FillValue<Ts> && ...);
+
+  // merge the buffered fills into the histogram and reset the buffer
+  void flush();
+
+ private:
+  enum class Mode { Flat,
+                    Sparse,
+                    Serial };
+
+  static constexpr int NSTRIPES{16};
+  static constexpr int NSHARDS{16};
+  static constexpr int NSTATS{11}; // number of statistics kept by TH3, see TH1::GetStats()
+
+  // statistics of the fills of the threads hashed to this stripe, aligned to avoid false sharing
+  struct alignas(64) StatsStripe {
+    std::array<std::atomic<double>, NSTATS> stats{};
+    std::atomic<uint64_t> entries{};
+  };
+
+  struct SparseBin {
+    double sumw{};
+    double sumw2{};
+    uint64_t entries{};
+  };
+
+  struct alignas(64) SparseShard {
+    std::mutex mutex;
+    std::unordered_map<Long64_t, SparseBin> bins;
+    std::vector<double> stats; // sum of w, w^2, then w*x and w*x^2 per dimension, see THnBase::Fill()
+  };
+
+  void fillFlat(const double* x, double w);
+  void fillSparse(const double* x, double w);
+  void flushFlat();
+  void flushSparse();
+  const char* getName() const;
+  static size_t getStripe();
+
+  HistPtr mHist;
+  TH1* mTH1{};
+  THnBase* mTHn{};
+  Mode mMode{Mode::Serial};
+  int mNDim{};
+  std::vector<TAxis*> mAxes{};
+
+  // flat buffer
+  Long64_t mNCells{};
+  std::unique_ptr<std::atomic<double>[]> mSumw{};
+  std::unique_ptr<std::atomic<double>[]> mSumw2{};
+  std::array<StatsStripe, NSTRIPES> mStats{};
+  std::atomic<bool> mWeighted{};
+  bool mStatOverflows{};
+
+  // sparse buffer, bins are keyed by their linear index including under- and overflow
+  std::array<SparseShard, NSHARDS> mShards{};
+
+  std::mutex mSerialMutex;
+};
+
 //**************************************************************************************************
 /**
  * HistogramRegistry for storing and filling histograms of any type.
@@ -130,6 +212,14 @@ class HistogramRegistry
   /// deletes all the histograms from the registry
   void clean();
 
+  /// Allows to fill the registry from several threads at the same time. The fills are collected in buffers
+  /// (see ConcurrentHistFiller) and only show up in the histograms after flushConcurrentFills(), which is done
+  /// automatically when the histograms are written out.
+  void setConcurrentFill(bool enable = true);
+
+  /// merges the buffered concurrent fills into the histograms, must not be called while other threads are filling
+  void flushConcurrentFills();
+
   // fill hist with values
   template <typename... Ts>
   void fill(const HistName& histName, Ts... positionAndWeight)
@@ -194,6 +284,9 @@ class HistogramRegistry
   static constexpr uint32_t MAX_REGISTRY_SIZE{REGISTRY_BITMASK + 1};
   std::array<uint32_t, MAX_REGISTRY_SIZE> mRegistryKey{};
   std::array<HistPtr, MAX_REGISTRY_SIZE> mRegistryValue{};
+
+  bool mConcurrentFill{};
+  std::array<std::shared_ptr<ConcurrentHistFiller>, MAX_REGISTRY_SIZE> mConcurrentFillers{};
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -253,6 +346,37 @@ void HistFiller::fillHistAny(std::shared_ptr<R> hist, const T& table, const o2::
   }
 }
 
+//--------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------
+// Implementation of ConcurrentHistFiller template functions.
+//--------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------
+
+template <typename... Ts>
+void ConcurrentHistFiller::fill(Ts... positionAndWeight)
+  requires(FillValue<Ts> && ...)
+{
+  if (mMode == Mode::Serial) {
+    std::lock_guard<std::mutex> guard(mSerialMutex);
+    std::visit([positionAndWeight...](auto&& hist) { HistFiller::fillHistAny(hist, positionAndWeight...); }, mHist);
+    return;
+  }
+
+  constexpr int nArgs = sizeof...(Ts);
+  const double values[] = {static_cast<double>(positionAndWeight)...};
+  double weight{1.};
+  if (nArgs == mNDim + 1) {
+    weight = values[nArgs - 1];
+  } else if (nArgs != mNDim) {
+    LOGF(fatal, "The number of arguments in fill function called for histogram %s is incompatible with histogram dimensions.", getName());
+  }
+  if (mMode == Mode::Flat) {
+    fillFlat(values, weight);
+  } else {
+    fillSparse(values, weight);
+  }
+}
+
 template <typename T>
 double HistFiller::getSize(std::shared_ptr<T> hist, double fillFraction)
 {
@@ -396,6 +520,9 @@ HistPtr HistogramRegistry::insertClone(const HistName& histName, const std::shar
       registerName(histName.str);
       mRegistryKey[imask(histName.idx + i)] = histName.hash;
       mRegistryValue[imask(histName.idx + i)] = std::shared_ptr<T>(static_cast<T*>(originalHist->Clone(histName.str)));
+      if (mConcurrentFill) {
+        mConcurrentFillers[imask(histName.idx + i)] = std::make_shared<ConcurrentHistFiller>(mRegistryValue[imask(histName.idx + i)]);
+      }
       lookup += i;
       return mRegistryValue[imask(histName.idx + i)];
     }
@@ -422,7 +549,12 @@ template <typename... Ts>
 void HistogramRegistry::fill(const HistName& histName, Ts... positionAndWeight)
   requires(FillValue<Ts> && ...)
 {
-  std::visit([positionAndWeight...](auto&& hist) { HistFiller::fillHistAny(hist, positionAndWeight...); }, mRegistryValue[getHistIndex(histName)]);
+  const uint32_t idx = getHistIndex(histName);
+  if (mConcurrentFill) {
+    mConcurrentFillers[idx]->fill(positionAndWeight...);
+    return;
+  }
+  std::visit([positionAndWeight...](auto&& hist) { HistFiller::fillHistAny(hist, positionAndWeight...); }, mRegistryValue[idx]);
 }
 
 extern template void HistogramRegistry::fill(const HistName& histName, double);
@@ -432,7 +564,16 @@ extern template void HistogramRegistry::fill(const HistName& histName, int);
 template <typename... Cs, typename T>
 void HistogramRegistry::fill(const HistName& histName, const T& table, const o2::framework::expressions::Filter& filter)
 {
-  std::visit([&table, &filter](auto&& hist) { HistFiller::fillHistAny<Cs...>(hist, table, filter); }, mRegistryValue[getHistIndex(histName)]);
+  const uint32_t idx = getHistIndex(histName);
+  if (mConcurrentFill) {
+    auto s = o2::framework::expressions::createSelection(table.asArrowTable(), filter);
+    auto filtered = o2::soa::Filtered<T>{{table.asArrowTable()}, s};
+    for (auto& t : filtered) {
+      mConcurrentFillers[idx]->fill((*(static_cast<Cs>(t).getIterator()))...);
+    }
+    return;
+  }
+  std::visit([&table, &filter](auto&& hist) { HistFiller::fillHistAny<Cs...>(hist, table, filter); }, mRegistryValue[idx]);
 }
 
 } // namespace o2::framework
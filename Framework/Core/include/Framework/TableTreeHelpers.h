@@ -43,6 +43,11 @@ namespace o2::framework
 //    t2t.addAllColumns();
 //  . auto ta = t2t.process();
 //
+// When ROOT implicit multi-threading is enabled (ROOT::EnableImplicitMT) and
+// the tree comes from a file opened for reading, the columns are split in
+// groups which are read concurrently, every group through its own TFile
+// handle, so that the baskets are also decompressed in parallel.
+//
 // .............................................................................
 struct ROOTTypeInfo {
   EDataType type;
@@ -62,6 +67,8 @@ class BranchToColumn
   TBranch* branch();
 
   std::pair<std::shared_ptr<arrow::ChunkedArray>, std::shared_ptr<arrow::Field>> read(TBuffer* buffer);
+  /// read the branch of the same name from tree, e.g. the tree read through another handle of the same file
+  std::pair<std::shared_ptr<arrow::ChunkedArray>, std::shared_ptr<arrow::Field>> read(TBuffer* buffer, TTree* tree);
 
  private:
   TBranch* mBranch = nullptr;
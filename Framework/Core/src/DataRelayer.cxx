@@ -46,6 +46,7 @@
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 #include <gsl/span>
+#include <bit>
 #include <numeric>
 #include <string>
 
@@ -94,6 +95,13 @@ DataRelayer::DataRelayer(const CompletionPolicy& policy,
     queries += std::string_view(buffer, strlen(buffer));
     queries += ";";
   }
+  // Sporadic inputs are not needed to complete a record
+  mRequiredInputsMask.assign((numInputTypes + 63) / 64, 0);
+  for (size_t ii = 0; ii < mInputs.size(); ++ii) {
+    if (mInputs[ii].lifetime != Lifetime::Sporadic) {
+      mRequiredInputsMask[ii / 64] |= uint64_t{1} << (ii % 64);
+    }
+  }
   auto stateId = (short)ProcessingStateId::DATA_QUERIES;
   states.registerState({.name = "data_queries", .stateId = stateId, .sendInitialValue = true, .defaultEnabled = true});
   states.updateState(DataProcessingStates::CommandSpec{.id = stateId, .size = (int)queries.size(), .data = queries.data()});
@@ -220,6 +228,7 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
       PartRef newRef;
       expirator.handler(services, newRef, variables);
       part.reset(std::move(newRef));
+      markInputPresent(slot, expirator.routeIndex.value);
       activity.expiredSlots++;
 
       mTimesliceIndex.markAsDirty(slot, true);
@@ -400,6 +409,7 @@ void DataRelayer::pruneCache(TimesliceSlot slot, OnDropCallback onDrop)
   };
 
   pruneCache(slot);
+  resetCompletionMask(slot);
 }
 
 DataRelayer::RelayChoice
@@ -450,7 +460,8 @@ DataRelayer::RelayChoice
   };
 
   // Actually save the header / payload in the slot
-  auto saveInSlot = [&cachedStateMetrics = mCachedStateMetrics,
+  auto saveInSlot = [this,
+                     &cachedStateMetrics = mCachedStateMetrics,
                      &messages,
                      &nMessages,
                      &nPayloads,
@@ -473,6 +484,7 @@ DataRelayer::RelayChoice
       target.add([&messages, &mi](size_t i) -> fair::mq::MessagePtr& { return messages[mi + i]; }, nPayloads + 1);
       mi += nPayloads;
     }
+    this->markInputPresent(slot, input);
   };
 
   auto updateStatistics = [ref = mContext](TimesliceIndex::ActionTaken action) {
@@ -709,6 +721,13 @@ void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& comp
     if (!mCompletionPolicy.callbackFull) {
       throw runtime_error_f("Completion police %s has no callback set", mCompletionPolicy.name.c_str());
     }
+    // If the policy would anyway wait for the missing inputs, we do not
+    // need to build the record, the bitmask of the slot is enough.
+    if (mCompletionPolicy.waitsForAllInputs && !isSlotComplete(slot)) {
+      countWait++;
+      mTimesliceIndex.markAsDirty(slot, false);
+      continue;
+    }
     auto partial = getPartialRecord(li);
     // TODO: get the data ref from message model
     auto getter = [&partial](size_t idx, size_t part) {
@@ -843,6 +862,7 @@ std::vector<o2::framework::MessageSet> DataRelayer::consumeAllInputsForTimeslice
     moveHeaderPayloadToOutput(slot, ai);
   }
   invalidateCacheFor(slot);
+  resetCompletionMask(slot);
 
   return messages;
 }
@@ -899,7 +919,57 @@ void DataRelayer::clear()
   }
   for (size_t s = 0; s < mTimesliceIndex.size(); ++s) {
     mTimesliceIndex.markAsInvalid(TimesliceSlot{s});
+    resetCompletionMask(TimesliceSlot{s});
+  }
+}
+
+void DataRelayer::markInputPresent(TimesliceSlot slot, size_t input)
+{
+  auto& word = mCompletionMask[slot.index * mCompletionMaskWords + input / 64];
+  word.fetch_or(uint64_t{1} << (input % 64), std::memory_order_release);
+}
+
+void DataRelayer::resetCompletionMask(TimesliceSlot slot)
+{
+  for (size_t wi = 0; wi < mCompletionMaskWords; ++wi) {
+    mCompletionMask[slot.index * mCompletionMaskWords + wi].store(0, std::memory_order_release);
+  }
+}
+
+void DataRelayer::rebuildCompletionMask()
+{
+  auto numInputTypes = mDistinctRoutesIndex.size();
+  auto numSlots = mTimesliceIndex.size();
+  mCompletionMaskWords = (numInputTypes + 63) / 64;
+  mCompletionMask = std::make_unique<std::atomic<uint64_t>[]>(mCompletionMaskWords * numSlots);
+  mRequiredInputsMask.resize(mCompletionMaskWords, 0);
+  for (size_t si = 0; si < numSlots; ++si) {
+    for (size_t ai = 0; ai < numInputTypes; ++ai) {
+      if (mCache[si * numInputTypes + ai].size() > 0) {
+        markInputPresent(TimesliceSlot{si}, ai);
+      }
+    }
+  }
+}
+
+bool DataRelayer::isSlotComplete(TimesliceSlot slot) const
+{
+  for (size_t wi = 0; wi < mCompletionMaskWords; ++wi) {
+    auto present = mCompletionMask[slot.index * mCompletionMaskWords + wi].load(std::memory_order_acquire);
+    if ((present & mRequiredInputsMask[wi]) != mRequiredInputsMask[wi]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t DataRelayer::getNumberOfInputsInSlot(TimesliceSlot slot) const
+{
+  size_t count = 0;
+  for (size_t wi = 0; wi < mCompletionMaskWords; ++wi) {
+    count += std::popcount(mCompletionMask[slot.index * mCompletionMaskWords + wi].load(std::memory_order_acquire));
   }
+  return count;
 }
 
 size_t
@@ -933,6 +1003,7 @@ void DataRelayer::publishMetrics()
   auto& states = mContext.get<DataProcessingStates>();
 
   mCachedStateMetrics.resize(mCache.size());
+  rebuildCompletionMask();
 
   // There is maximum 16 variables available. We keep them row-wise so that
   // that we can take mod 16 of the index to understand which variable we
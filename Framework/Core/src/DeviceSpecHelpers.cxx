@@ -1755,7 +1755,8 @@ boost::program_options::options_description DeviceSpecHelpers::getForwardedDevic
     ("infologger-severity", bpo::value<std::string>(), "minimun FairLogger severity which goes to info logger")                                                      //
     ("dpl-tracing-flags", bpo::value<std::string>(), "pipe separated list of events to trace")                                                                       //
     ("signposts", bpo::value<std::string>()->default_value(defaultSignposts),                                                                                        //
-     "comma separated list of signposts to enable (any of `completion`, `data_processor_context`, `stream_context`, `device`, `monitoring_service`)")                //
+     "comma separated list of signposts to enable (any of `completion`, `data_processor_context`, `stream_context`, `device`, `monitoring_service`, "                //
+     "optionally suffixed by `:binary`)")                                                                                                                            //
     ("child-driver", bpo::value<std::string>(), "external driver to start childs with (e.g. valgrind)");                                                             //
 
   return forwardedDeviceOptions;
@@ -10,7 +10,10 @@
 // or submit itself to any jurisdiction.
 
 #include "Framework/HistogramRegistry.h"
+#include <algorithm>
+#include <limits>
 #include <regex>
+#include <thread>
 #include <TList.h>
 #include <TClass.h>
 
@@ -73,6 +76,9 @@ HistPtr HistogramRegistry::insert(const HistogramSpec& histSpec)
       registerName(histSpec.name);
       mRegistryKey[imask(idx + i)] = histSpec.hash;
       mRegistryValue[imask(idx + i)] = HistFactory::createHistVariant(histSpec);
+      if (mConcurrentFill) {
+        mConcurrentFillers[imask(idx + i)] = std::make_shared<ConcurrentHistFiller>(mRegistryValue[imask(idx + i)]);
+      }
       lookup += i;
       return mRegistryValue[imask(idx + i)];
     }
@@ -192,6 +198,33 @@ void HistogramRegistry::clean()
   for (auto& value : mRegistryValue) {
     std::visit([](auto&& hist) { hist.reset(); }, value);
   }
+  mConcurrentFillers.fill(nullptr);
+}
+
+void HistogramRegistry::setConcurrentFill(bool enable)
+{
+  if (!enable) {
+    flushConcurrentFills();
+    mConcurrentFillers.fill(nullptr);
+  } else {
+    for (auto j = 0u; j < MAX_REGISTRY_SIZE; ++j) {
+      TObject* rawPtr = nullptr;
+      std::visit([&](const auto& sharedPtr) { rawPtr = sharedPtr.get(); }, mRegistryValue[j]);
+      if (rawPtr && !mConcurrentFillers[j]) {
+        mConcurrentFillers[j] = std::make_shared<ConcurrentHistFiller>(mRegistryValue[j]);
+      }
+    }
+  }
+  mConcurrentFill = enable;
+}
+
+void HistogramRegistry::flushConcurrentFills()
+{
+  for (auto& filler : mConcurrentFillers) {
+    if (filler) {
+      filler->flush();
+    }
+  }
 }
 
 // print some useful meta-info about the stored histograms
@@ -285,6 +318,8 @@ void HistogramRegistry::print(bool showAxisDetails)
 // create output structure will be propagated to file-sink
 TList* HistogramRegistry::getListOfHistograms()
 {
+  flushConcurrentFills();
+
   TList* list = new TList();
   list->SetName(mName.data());
 
@@ -409,4 +444,221 @@ void HistogramRegistry::registerName(const std::string& name)
   mRegisteredNames.push_back(name);
 }
 
+//--------------------------------------------------------------------------------------------------
+// ConcurrentHistFiller
+//--------------------------------------------------------------------------------------------------
+
+ConcurrentHistFiller::ConcurrentHistFiller(HistPtr hist)
+  : mHist(std::move(hist))
+{
+  std::visit([this](auto&& hist) {
+    using T = typename std::decay_t<decltype(hist)>::element_type;
+    if constexpr (std::is_same_v<T, TH1> || std::is_same_v<T, TH2> || std::is_same_v<T, TH3>) {
+      mTH1 = hist.get();
+      mNDim = mTH1->GetDimension();
+      TAxis* axes[] = {mTH1->GetXaxis(), mTH1->GetYaxis(), mTH1->GetZaxis()};
+      mAxes.assign(axes, axes + mNDim);
+      // histograms which change their binning while being filled cannot be buffered
+      bool canExtend = mTH1->GetBufferSize() > 0;
+      for (auto axis : mAxes) {
+        canExtend |= static_cast<bool>(axis->CanExtend());
+      }
+      if (!canExtend) {
+        mMode = Mode::Flat;
+        mNCells = mTH1->GetNcells();
+        mSumw = std::make_unique<std::atomic<double>[]>(mNCells);
+        mSumw2 = std::make_unique<std::atomic<double>[]>(mNCells);
+        mStatOverflows = mTH1->GetStatOverflowsBehaviour();
+      }
+    } else if constexpr (std::is_base_of_v<THnBase, T>) {
+      mTHn = hist.get();
+      mNDim = mTHn->GetNdimensions();
+      double nBinsTotal = 1.;
+      for (int d = 0; d < mNDim; ++d) {
+        mAxes.push_back(mTHn->GetAxis(d));
+        nBinsTotal *= mAxes.back()->GetNbins() + 2;
+      }
+      // the linear bin index used as key must not overflow
+      if (nBinsTotal < static_cast<double>(std::numeric_limits<Long64_t>::max())) {
+        mMode = Mode::Sparse;
+        for (auto& shard : mShards) {
+          shard.stats.assign(2 + 2 * mNDim, 0.);
+        }
+      }
+    }
+  },
+             mHist);
+}
+
+const char* ConcurrentHistFiller::getName() const
+{
+  return mTH1 ? mTH1->GetName() : mTHn->GetName();
+}
+
+size_t ConcurrentHistFiller::getStripe()
+{
+  static thread_local const size_t stripe = std::hash<std::thread::id>{}(std::this_thread::get_id()) % NSTRIPES;
+  return stripe;
+}
+
+void ConcurrentHistFiller::fillFlat(const double* x, double w)
+{
+  // same global bin numbering as TH1::GetBin()
+  Long64_t cell = 0;
+  Long64_t stride = 1;
+  bool inRange = true;
+  for (int d = 0; d < mNDim; ++d) {
+    const int bin = mAxes[d]->FindFixBin(x[d]);
+    inRange &= bin > 0 && bin <= mAxes[d]->GetNbins();
+    cell += bin * stride;
+    stride *= mAxes[d]->GetNbins() + 2;
+  }
+  mSumw[cell].fetch_add(w, std::memory_order_relaxed);
+  mSumw2[cell].fetch_add(w * w, std::memory_order_relaxed);
+  if (w != 1. && !mWeighted.load(std::memory_order_relaxed)) {
+    mWeighted.store(true, std::memory_order_relaxed);
+  }
+
+  auto& stripe = mStats[getStripe()];
+  stripe.entries.fetch_add(1, std::memory_order_relaxed);
+  // like TH1::Fill() under- and overflows only count as entries
+  if (!inRange && !mStatOverflows) {
+    return;
+  }
+  auto add = [&stripe](int i, double value) { stripe.stats[i].fetch_add(value, std::memory_order_relaxed); };
+  add(0, w);
+  add(1, w * w);
+  add(2, w * x[0]);
+  add(3, w * x[0] * x[0]);
+  if (mNDim > 1) {
+    add(4, w * x[1]);
+    add(5, w * x[1] * x[1]);
+    add(6, w * x[0] * x[1]);
+  }
+  if (mNDim > 2) {
+    add(7, w * x[2]);
+    add(8, w * x[2] * x[2]);
+    add(9, w * x[0] * x[2]);
+    add(10, w * x[1] * x[2]);
+  }
+}
+
+void ConcurrentHistFiller::fillSparse(const double* x, double w)
+{
+  Long64_t key = 0;
+  Long64_t stride = 1;
+  for (int d = 0; d < mNDim; ++d) {
+    key += mAxes[d]->FindFixBin(x[d]) * stride;
+    stride *= mAxes[d]->GetNbins() + 2;
+  }
+  auto& shard = mShards[std::hash<Long64_t>{}(key) % NSHARDS];
+  std::lock_guard<std::mutex> guard(shard.mutex);
+  auto& bin = shard.bins[key];
+  bin.sumw += w;
+  bin.sumw2 += w * w;
+  ++bin.entries;
+  shard.stats[0] += w;
+  shard.stats[1] += w * w;
+  for (int d = 0; d < mNDim; ++d) {
+    shard.stats[2 + 2 * d] += w * x[d];
+    shard.stats[3 + 2 * d] += w * x[d] * x[d];
+  }
+}
+
+void ConcurrentHistFiller::flush()
+{
+  if (mMode == Mode::Flat) {
+    flushFlat();
+  } else if (mMode == Mode::Sparse) {
+    flushSparse();
+  }
+}
+
+void ConcurrentHistFiller::flushFlat()
+{
+  uint64_t entries = 0;
+  for (auto& stripe : mStats) {
+    entries += stripe.entries.exchange(0, std::memory_order_relaxed);
+  }
+  if (!entries) {
+    return;
+  }
+
+  // TH1::Fill() switches on the sum of squares of weights when it sees the first weight different from one
+  if (mWeighted.exchange(false, std::memory_order_relaxed) && !mTH1->GetSumw2N() && !mTH1->TestBit(TH1::kIsNotW)) {
+    mTH1->Sumw2();
+  }
+  // statistics must be retrieved before the bin contents are changed, since they may be recomputed from them
+  double stats[NSTATS]{};
+  mTH1->GetStats(stats);
+  for (auto& stripe : mStats) {
+    for (int i = 0; i < NSTATS; ++i) {
+      stats[i] += stripe.stats[i].exchange(0., std::memory_order_relaxed);
+    }
+  }
+  const bool sumw2 = mTH1->GetSumw2N();
+  for (Long64_t cell = 0; cell < mNCells; ++cell) {
+    const double sumw = mSumw[cell].exchange(0., std::memory_order_relaxed);
+    const double sumw2Cell = mSumw2[cell].exchange(0., std::memory_order_relaxed);
+    if (sumw != 0.) {
+      mTH1->AddBinContent(cell, sumw);
+    }
+    if (sumw2) {
+      mTH1->GetSumw2()->fArray[cell] += sumw2Cell;
+    }
+  }
+  const double nEntries = mTH1->GetEntries() + entries;
+  mTH1->PutStats(stats);
+  mTH1->SetEntries(nEntries);
+}
+
+namespace
+{
+// THnBase has no setters for the sums used by the axis statistics, they are reached through pointers to the
+// protected members, which a derived class is allowed to form
+struct THnStats : THnBase {
+  static constexpr auto Sumw = &THnStats::fTsumw;
+  static constexpr auto Sumw2 = &THnStats::fTsumw2;
+  static constexpr auto Sumwx = &THnStats::fTsumwx;
+  static constexpr auto Sumwx2 = &THnStats::fTsumwx2;
+};
+} // namespace
+
+void ConcurrentHistFiller::flushSparse()
+{
+  const bool errors = mTHn->GetCalculateErrors();
+  uint64_t entries = 0;
+  std::vector<Int_t> coord(mNDim);
+  for (auto& shard : mShards) {
+    // like THnBase::Fill() the sums are only kept when the errors are calculated
+    if (errors) {
+      mTHn->*THnStats::Sumw += shard.stats[0];
+      mTHn->*THnStats::Sumw2 += shard.stats[1];
+      for (int d = 0; d < mNDim; ++d) {
+        (mTHn->*THnStats::Sumwx)[d] += shard.stats[2 + 2 * d];
+        (mTHn->*THnStats::Sumwx2)[d] += shard.stats[3 + 2 * d];
+      }
+    }
+    std::fill(shard.stats.begin(), shard.stats.end(), 0.);
+    for (auto& [key, bin] : shard.bins) {
+      auto index = key;
+      for (int d = 0; d < mNDim; ++d) {
+        const int nBins = mAxes[d]->GetNbins() + 2;
+        coord[d] = index % nBins;
+        index /= nBins;
+      }
+      const Long64_t globalBin = mTHn->GetBin(coord.data(), true);
+      mTHn->AddBinContent(globalBin, bin.sumw);
+      if (errors) {
+        mTHn->AddBinError2(globalBin, bin.sumw2);
+      }
+      entries += bin.entries;
+    }
+    shard.bins.clear();
+  }
+  if (entries) {
+    mTHn->SetEntries(mTHn->GetEntries() + entries);
+  }
+}
+
 } // namespace o2::framework
@@ -15,7 +15,11 @@
 #include "arrow/type_traits.h"
 #include <arrow/util/key_value_metadata.h>
 #include <TBufferFile.h>
+#include <TFile.h>
+#include <TROOT.h>
+#include <ROOT/TThreadExecutor.hxx>
 
+#include <memory>
 #include <utility>
 namespace TableTreeHelpers
 {
@@ -176,6 +180,18 @@ void swapCopy(unsigned char* dest, char* source, int size, int typeSize) noexcep
   }
 }
 
+std::pair<std::shared_ptr<arrow::ChunkedArray>, std::shared_ptr<arrow::Field>> BranchToColumn::read(TBuffer* buffer, TTree* tree)
+{
+  auto* branch = tree->GetBranch(mBranch->GetName());
+  if (branch == nullptr) {
+    throw runtime_error_f("Branch %s not found in tree %s", mBranch->GetName(), tree->GetName());
+  }
+  std::swap(mBranch, branch);
+  auto result = read(buffer);
+  std::swap(mBranch, branch);
+  return result;
+}
+
 std::pair<std::shared_ptr<arrow::ChunkedArray>, std::shared_ptr<arrow::Field>> BranchToColumn::read(TBuffer* buffer)
 {
   auto totalEntries = mBranch->GetEntries();
@@ -548,16 +564,45 @@ void TreeToTable::setLabel(const char* label)
   mTableLabel = label;
 }
 
-void TreeToTable::fill(TTree*)
+void TreeToTable::fill(TTree* tree)
 {
   std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
   std::vector<std::shared_ptr<arrow::Field>> fields;
-  static TBufferFile buffer{TBuffer::EMode::kWrite, 4 * 1024 * 1024};
-  for (auto& reader : mBranchReaders) {
-    buffer.Reset();
-    auto arrayAndField = reader->read(&buffer);
-    columns.push_back(arrayAndField.first);
-    fields.push_back(arrayAndField.second);
+  auto* file = tree->GetCurrentFile();
+  auto nTasks = std::min<size_t>(ROOT::IsImplicitMTEnabled() ? ROOT::GetThreadPoolSize() : 1, mBranchReaders.size());
+  if (nTasks > 1 && file != nullptr && !file->IsWritable()) {
+    // a TFile is not thread safe: every group of columns is read through its own handle of the file,
+    // the first group uses the tree we were given
+    std::string treePath = tree->GetDirectory()->GetPath();
+    treePath = treePath.substr(treePath.find(":/") + 2);
+    treePath += treePath.empty() ? tree->GetName() : std::string{"/"} + tree->GetName();
+    columns.resize(mBranchReaders.size());
+    fields.resize(mBranchReaders.size());
+    auto readGroup = [&](unsigned int task) {
+      TBufferFile buffer{TBuffer::EMode::kWrite, 4 * 1024 * 1024};
+      std::unique_ptr<TFile> taskFile;
+      auto* taskTree = tree;
+      if (task > 0) {
+        taskFile.reset(TFile::Open(file->GetName(), "READ"));
+        taskTree = taskFile ? taskFile->Get<TTree>(treePath.c_str()) : nullptr;
+        if (taskTree == nullptr) {
+          throw runtime_error_f("Cannot read tree %s from file %s", treePath.c_str(), file->GetName());
+        }
+      }
+      for (auto ci = task; ci < mBranchReaders.size(); ci += nTasks) {
+        buffer.Reset();
+        std::tie(columns[ci], fields[ci]) = task > 0 ? mBranchReaders[ci]->read(&buffer, taskTree) : mBranchReaders[ci]->read(&buffer);
+      }
+    };
+    ROOT::TThreadExecutor{}.Foreach(readGroup, (unsigned int)nTasks);
+  } else {
+    static TBufferFile buffer{TBuffer::EMode::kWrite, 4 * 1024 * 1024};
+    for (auto& reader : mBranchReaders) {
+      buffer.Reset();
+      auto arrayAndField = reader->read(&buffer);
+      columns.push_back(arrayAndField.first);
+      fields.push_back(arrayAndField.second);
+    }
   }
 
   auto schema = std::make_shared<arrow::Schema>(fields, std::make_shared<arrow::KeyValueMetadata>(std::vector{std::string{"label"}}, std::vector{mTableLabel}));
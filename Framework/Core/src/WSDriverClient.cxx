@@ -20,6 +20,7 @@
 #include <uv.h>
 #include <string_view>
 #include <charconv>
+#include <unistd.h>
 
 O2_DECLARE_DYNAMIC_LOG(device);
 O2_DECLARE_DYNAMIC_LOG(completion);
@@ -159,6 +160,25 @@ void on_connect(uv_connect_t* connection, int status)
     state.tracingFlags = tracingFlags;
   });
 
+  // Dump the signposts recorded by the logs in binary mode as a Chrome / Perfetto trace.
+  client->observe("/signpost-dump", [ref = context->ref](std::string_view cmd) {
+    auto& spec = ref.get<DeviceSpec const>();
+    static constexpr int prefixSize = std::string_view{"/signpost-dump "}.size();
+    std::string filename;
+    if (prefixSize < cmd.size()) {
+      cmd.remove_prefix(prefixSize);
+      filename = std::string(cmd);
+    } else {
+      filename = fmt::format("dpl-signposts-{}-{}.json", spec.id, getpid());
+    }
+    auto events = _o2_signpost_dump_chrome_trace(filename.c_str());
+    if (events < 0) {
+      LOGP(error, "Unable to write signposts to {}", filename);
+      return;
+    }
+    LOGP(info, "Dumped {} signposts to {}", events, filename);
+  });
+
   client->observe("/log-streams", [ref = context->ref](std::string_view cmd) {
     auto& state = ref.get<DeviceState>();
     static constexpr int prefixSize = std::string_view{"/log-streams "}.size();
@@ -2029,6 +2029,7 @@ int runStateMachine(DataProcessorSpecs const& workflow,
             "--aod-writer-keep",
             "--aod-parent-access-level",
             "--aod-parent-base-path-replacement",
+            "--aod-reader-threads",
             "--driver-client-backend",
             "--fairmq-ipc-prefix",
             "--readers",
@@ -2743,7 +2744,12 @@ void enableSignposts(std::string const& signpostsToEnable)
     std::string prefix = "ch.cern.aliceo2.";
     auto* last = strchr(selectedName, ':');
     int maxDepth = 1;
-    if (last) {
+    // <stream>:binary records the signposts in the in memory ring buffers,
+    // to be dumped as a Chrome / Perfetto trace, rather than printing them.
+    bool binary = false;
+    if (last && strcmp(last + 1, "binary") == 0) {
+      binary = true;
+    } else if (last) {
       char* err;
       maxDepth = strtol(last + 1, &err, 10);
       if (*(last + 1) == '\0' || *err != '\0') {
@@ -2753,7 +2759,8 @@ void enableSignposts(std::string const& signpostsToEnable)
 
     auto fullName = prefix + std::string{selectedName, last ? last - selectedName : strlen(selectedName)};
     if (strncmp(name, fullName.data(), fullName.size()) == 0) {
-      LOGP(info, "Enabling signposts for stream \"{}\" with depth {}.", fullName, maxDepth);
+      LOGP(info, "Enabling {}signposts for stream \"{}\" with depth {}.", binary ? "binary " : "", fullName, maxDepth);
+      _o2_log_set_binary(log, binary);
       _o2_log_set_stacktrace(log, maxDepth);
       return false;
     } else {
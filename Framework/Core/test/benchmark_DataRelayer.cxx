@@ -18,6 +18,7 @@
 #include <Monitoring/Monitoring.h>
 #include <fairmq/TransportFactory.h>
 #include <cstring>
+#include <string>
 #include <vector>
 
 using Monitoring = o2::monitoring::Monitoring;
@@ -238,6 +239,69 @@ static void BM_RelayMultipleRoutes(benchmark::State& state)
 
 BENCHMARK(BM_RelayMultipleRoutes);
 
+/// In this case we have a record with many routes, all of which are required.
+/// The readiness of the slot is checked after each incoming message, like
+/// the DataProcessingDevice does.
+static void BM_RelayManyRoutes(benchmark::State& state)
+{
+  Monitoring metrics;
+  const size_t nRoutes = state.range(0);
+
+  std::vector<InputRoute> inputs;
+  for (size_t ri = 0; ri < nRoutes; ++ri) {
+    InputSpec spec{"input" + std::to_string(ri), "TST", "DATA", static_cast<o2::header::DataHeader::SubSpecificationType>(ri)};
+    inputs.emplace_back(InputRoute{spec, ri, "Fake" + std::to_string(ri), 0});
+  }
+
+  std::vector<ForwardRoute> forwards;
+  std::vector<InputChannelInfo> infos{1};
+  TimesliceIndex index{1, infos};
+
+  auto policy = CompletionPolicyHelpers::consumeWhenAll();
+  ServiceRegistry registry;
+  DataRelayer relayer(policy, inputs, index, {registry});
+  relayer.setPipelineLength(4);
+
+  auto transport = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+  size_t timeslice = 0;
+
+  // One header / payload pair per route
+  std::vector<fair::mq::MessagePtr> inflightMessages;
+  inflightMessages.reserve(2 * nRoutes);
+  for (size_t ri = 0; ri < nRoutes; ++ri) {
+    DataHeader dh;
+    dh.dataDescription = "DATA";
+    dh.dataOrigin = "TST";
+    dh.subSpecification = ri;
+    DataProcessingHeader dph{timeslice, 1};
+    Stack stack{dh, dph};
+    inflightMessages.emplace_back(transport->CreateMessage(stack.size()));
+    memcpy(inflightMessages.back()->GetData(), stack.data(), stack.size());
+    inflightMessages.emplace_back(transport->CreateMessage(1000));
+  }
+
+  std::vector<RecordAction> ready;
+  for (auto _ : state) {
+    for (size_t ri = 0; ri < nRoutes; ++ri) {
+      DataRelayer::InputInfo fakeInfo{0, 2, DataRelayer::InputType::Data, {ChannelIndex::INVALID}};
+      relayer.relay(inflightMessages[2 * ri]->GetData(), &inflightMessages[2 * ri], fakeInfo, 2);
+      ready.clear();
+      relayer.getReadyToProcess(ready);
+      assert(ready.size() == (ri == nRoutes - 1 ? 1 : 0));
+    }
+    assert(ready[0].op == CompletionPolicy::CompletionOp::Consume);
+    auto result = relayer.consumeAllInputsForTimeslice(ready[0].slot);
+    assert(result.size() == nRoutes);
+    for (size_t ri = 0; ri < nRoutes; ++ri) {
+      inflightMessages[2 * ri] = std::move(result[ri].messages[0]);
+      inflightMessages[2 * ri + 1] = std::move(result[ri].messages[1]);
+    }
+  }
+  state.counters["Routes"] = nRoutes;
+}
+
+BENCHMARK(BM_RelayManyRoutes)->Arg(16)->Arg(128)->Arg(256);
+
 /// In this case we have a record with two entries
 static void BM_RelaySplitParts(benchmark::State& state)
 {
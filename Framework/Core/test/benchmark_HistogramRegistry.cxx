@@ -17,6 +17,9 @@
 #include <benchmark/benchmark.h>
 #include <boost/format.hpp>
 
+#include <mutex>
+#include <thread>
+
 using namespace o2::framework;
 using namespace arrow;
 using namespace o2::soa;
@@ -62,7 +65,51 @@ static void BM_StandardNameLookup(benchmark::State& state)
     }
   }
 }
+
+/// Number of fills per thread
+const int nFills = 100000;
+
+/// Fill the histograms of a single registry from several threads, either serialised by a lock (range(1) == 0)
+/// or through the concurrent fill buffers of the registry (range(1) == 1), including the final merge
+static void BM_ConcurrentFill(benchmark::State& state)
+{
+  const int nThreads = state.range(0);
+  const bool concurrent = state.range(1);
+  for (auto _ : state) {
+    state.PauseTiming();
+    HistogramRegistry registry{"registry", {{"x", "x", {HistType::kTH1F, {{100, 0, 1}}}},
+                                            {"xy", "xy", {HistType::kTH2F, {{100, 0, 1}, {100, 0, 1}}}},
+                                            {"xyz", "xyz", {HistType::kTHnSparseF, {{20, 0, 1}, {20, 0, 1}, {20, 0, 1}}}}}};
+    registry.setConcurrentFill(concurrent);
+    std::mutex mutex;
+    state.ResumeTiming();
+
+    std::vector<std::thread> threads;
+    for (auto t = 0; t < nThreads; ++t) {
+      threads.emplace_back([&registry, &mutex, concurrent, t]() {
+        for (auto i = 0; i < nFills; ++i) {
+          double x = ((i * 7 + t) % 1000) / 1000.;
+          double y = ((i * 13 + t) % 1000) / 1000.;
+          std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+          if (!concurrent) {
+            lock.lock();
+          }
+          registry.fill(HIST("x"), x);
+          registry.fill(HIST("xy"), x, y);
+          registry.fill(HIST("xyz"), x, y, x * y);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    registry.flushConcurrentFills();
+  }
+  state.counters["fills"] = benchmark::Counter(3. * nFills * nThreads * state.iterations(), benchmark::Counter::kIsRate);
+}
+
 BENCHMARK(BM_HashedNameLookup)->Arg(4)->Arg(8)->Arg(16)->Arg(64)->Arg(128)->Arg(256)->Arg(512);
 BENCHMARK(BM_StandardNameLookup)->Arg(4)->Arg(8)->Arg(16)->Arg(64)->Arg(128)->Arg(256)->Arg(512);
+BENCHMARK(BM_ConcurrentFill)->ArgsProduct({{1, 2, 4, 8}, {0, 1}})->Unit(benchmark::kMillisecond)->UseRealTime();
 
 BENCHMARK_MAIN();
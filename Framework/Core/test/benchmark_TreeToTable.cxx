@@ -13,10 +13,13 @@
 #include "Framework/TableTreeHelpers.h"
 #include "Framework/Logger.h"
 #include <benchmark/benchmark.h>
+#include <array>
 #include <random>
 #include <vector>
 
 #include <TFile.h>
+#include <TROOT.h>
+#include <TTree.h>
 
 using namespace o2::framework;
 using namespace arrow;
@@ -91,6 +94,49 @@ static void BM_TreeToTable(benchmark::State& state)
   state.SetBytesProcessed(state.iterations() * state.range(0) * 24);
 }
 
+// wide tree as in heavy AO2D tables, arguments are the number of rows and of threads
+static void BM_TreeToTableThreads(benchmark::State& state)
+{
+  constexpr int ncols = 64;
+  std::default_random_engine e1(1234567891);
+  std::normal_distribution<float> rf(5., 2.);
+
+  {
+    TFile fout("tree2table_wide.root", "RECREATE");
+    TTree t("wide", "wide tree");
+    std::array<float, ncols> values;
+    for (auto ci = 0; ci < ncols; ++ci) {
+      t.Branch(Form("c%d", ci), &values[ci], Form("c%d/F", ci));
+    }
+    for (auto i = 0; i < state.range(0); ++i) {
+      for (auto& v : values) {
+        v = rf(e1);
+      }
+      t.Fill();
+    }
+    t.Write();
+  }
+
+  if (state.range(1) > 1) {
+    ROOT::EnableImplicitMT(state.range(1));
+  }
+  for (auto _ : state) {
+    TFile f("tree2table_wide.root", "READ");
+    auto tr = (TTree*)f.Get("wide");
+    TreeToTable tr2ta;
+    tr2ta.addAllColumns(tr);
+    tr2ta.fill(tr);
+    benchmark::DoNotOptimize(tr2ta.finalize());
+  }
+  if (state.range(1) > 1) {
+    ROOT::DisableImplicitMT();
+  }
+
+  state.counters["columns"] = benchmark::Counter(static_cast<double>(state.iterations() * ncols), benchmark::Counter::kIsRate);
+  state.SetBytesProcessed(state.iterations() * state.range(0) * ncols * sizeof(float));
+}
+
 BENCHMARK(BM_TreeToTable)->Range(8, 8 << maxrange);
+BENCHMARK(BM_TreeToTableThreads)->ArgsProduct({{1 << 18}, {1, 2, 4, 8}})->Unit(benchmark::kMillisecond)->UseRealTime();
 
 BENCHMARK_MAIN();
@@ -14,6 +14,8 @@
 #include "Framework/AnalysisDataModel.h"
 #include "Framework/ExpressionHelpers.h"
 #include <catch_amalgamated.hpp>
+#include <numeric>
+#include <thread>
 
 using namespace o2::framework;
 using namespace o2::soa;
@@ -1400,3 +1402,101 @@ TEST_CASE("BlockCombinationsCounters")
     previousEvent = c0.index();
   }
 }
+
+TEST_CASE("GroupTable")
+{
+  TableBuilder builderA;
+  auto rowWriterA = builderA.persist<int32_t, int32_t, float>({"x", "y", "floatZ"});
+  rowWriterA(0, 0, 25, -6.0f);
+  rowWriterA(0, 1, 18, 0.0f);
+  rowWriterA(0, 2, 48, 8.0f);
+  rowWriterA(0, 3, 103, 2.0f);
+  rowWriterA(0, 4, 28, -6.0f);
+  rowWriterA(0, 5, 102, 2.0f);
+  rowWriterA(0, 6, 12, 0.0f);
+  rowWriterA(0, 7, 24, -7.0f);
+  rowWriterA(0, 8, 41, 8.0f);
+  rowWriterA(0, 9, 49, 8.0f);
+  auto tableA = builderA.finalize();
+
+  using TestA = o2::soa::Table<o2::framework::OriginEnc{"AOD"}, o2::soa::Index<>, test::X, test::Y, test::FloatZ>;
+  TestA testA{tableA};
+
+  // Grouped data, in increasing bin order:
+  // [0, 4, 7], [1, 6], [3, 5], [2, 8, 9]
+  std::vector<double> yBins{VARIABLE_WIDTH, 0, 5, 10, 20, 30, 40, 50, 101};
+  std::vector<double> zBins{VARIABLE_WIDTH, -7.0, -5.0, -3.0, -1.0, 1.0, 3.0, 5.0, 7.0};
+  ColumnBinningPolicy<test::Y, test::FloatZ> pairBinning{{yBins, zBins}, false};
+
+  auto grouped = groupTable(testA, pairBinning, 1, -1);
+  std::vector<uint64_t> expectedRows{0, 4, 7, 1, 6, 3, 5, 2, 8, 9};
+  REQUIRE(grouped.size() == expectedRows.size());
+  for (size_t i = 0; i < grouped.size(); i++) {
+    REQUIRE(grouped[i].index == expectedRows[i]);
+    if (i > 0) {
+      REQUIRE(grouped[i - 1].bin <= grouped[i].bin);
+    }
+  }
+  REQUIRE(grouped[2].bin != grouped[3].bin);
+  REQUIRE(grouped[4].bin != grouped[5].bin);
+  REQUIRE(grouped[6].bin != grouped[7].bin);
+
+  // Categories smaller than the minimal size are dropped
+  auto groupedMin3 = groupTable(testA, pairBinning, 3, -1);
+  REQUIRE(groupedMin3.size() == 6);
+  REQUIRE(groupedMin3[0].index == 0);
+  REQUIRE(groupedMin3[3].index == 2);
+
+  // Same partition in compressed sparse row form
+  auto binned = binTable(testA, pairBinning, 1, -1);
+  std::vector<std::vector<uint64_t>> expectedBinRows{{0, 4, 7}, {1, 6}, {3, 5}, {2, 8, 9}};
+  REQUIRE(binned.nBins() == expectedBinRows.size());
+  REQUIRE(binned.size() == 10);
+  for (size_t i = 0; i < binned.nBins(); i++) {
+    auto rows = binned.binRows(i);
+    REQUIRE(std::vector<uint64_t>(rows.begin(), rows.end()) == expectedBinRows[i]);
+  }
+  REQUIRE(binTable(testA, pairBinning, 3, -1).nBins() == 2);
+
+  // Blocks of consecutive bins covering all bins, processed concurrently
+  for (size_t nBlocks = 1; nBlocks < 6; nBlocks++) {
+    auto blocks = binned.splitBins(nBlocks, 2);
+    REQUIRE(blocks.size() <= nBlocks);
+    REQUIRE(blocks.front().first == 0);
+    REQUIRE(blocks.back().second == binned.nBins());
+    std::vector<uint64_t> pairsPerBlock(blocks.size(), 0);
+    std::vector<std::thread> workers;
+    for (size_t b = 0; b < blocks.size(); b++) {
+      workers.emplace_back([&binned, &blocks, &pairsPerBlock, b]() {
+        for (auto i = blocks[b].first; i < blocks[b].second; i++) {
+          pairsPerBlock[b] += binned.binSize(i) * (binned.binSize(i) - 1) / 2;
+        }
+      });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    REQUIRE(std::accumulate(pairsPerBlock.begin(), pairsPerBlock.end(), uint64_t{0}) == 3 + 1 + 1 + 3);
+  }
+
+  // Bins too far apart for a counting sort are sorted the same way
+  std::vector<BinningIndex> sparse;
+  sortByBin({1000000, -5, 1000000, 7, -5}, {0, 1, 2, 3, 4}, sparse);
+  std::vector<std::pair<int, uint64_t>> expectedSparse{{-5, 1}, {-5, 4}, {7, 3}, {1000000, 0}, {1000000, 2}};
+  REQUIRE(sparse.size() == expectedSparse.size());
+  for (size_t i = 0; i < sparse.size(); i++) {
+    REQUIRE(sparse[i].bin == expectedSparse[i].first);
+    REQUIRE(sparse[i].index == expectedSparse[i].second);
+  }
+
+  // Only the categories common to all tables are kept
+  std::array<std::vector<BinningIndex>, 2> groupedIndices{
+    std::vector<BinningIndex>{{1, 0}, {1, 2}, {2, 1}, {4, 3}},
+    std::vector<BinningIndex>{{1, 5}, {3, 4}, {4, 6}, {5, 7}}};
+  syncCategories(groupedIndices);
+  REQUIRE(groupedIndices[0].size() == 3);
+  REQUIRE(groupedIndices[0][2].index == 3);
+  REQUIRE(groupedIndices[1].size() == 2);
+  REQUIRE(groupedIndices[1][0].index == 5);
+  REQUIRE(groupedIndices[1][1].index == 6);
+}
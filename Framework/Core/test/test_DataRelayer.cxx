@@ -414,6 +414,73 @@ TEST_CASE("DataRelayer")
     REQUIRE(result2.size() == 1);
   }
 
+  // A sporadic input does not need to be present for a slot to be complete.
+  SECTION("TestCompletionMask")
+  {
+    InputSpec spec1{"clusters", "TPC", "CLUSTERS"};
+    InputSpec spec2{"clusters_its", "ITS", "CLUSTERS"};
+    InputSpec spec3{"calib", "TPC", "CALIB", 0, Lifetime::Sporadic};
+
+    std::vector<InputRoute> inputs = {
+      InputRoute{spec1, 0, "Fake1", 0},
+      InputRoute{spec2, 1, "Fake2", 0},
+      InputRoute{spec3, 2, "Fake3", 0}};
+
+    std::vector<InputChannelInfo> infos{1};
+    TimesliceIndex index{1, infos};
+    ref.registerService(ServiceRegistryHelpers::handleForService<TimesliceIndex>(&index));
+
+    auto policy = CompletionPolicyHelpers::consumeWhenAll();
+    REQUIRE(policy.waitsForAllInputs);
+    DataRelayer relayer(policy, inputs, index, {registry});
+    relayer.setPipelineLength(2);
+
+    auto transport = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+    auto channelAlloc = o2::pmr::getTransportAllocator(transport.get());
+
+    auto createMessage = [&transport, &channelAlloc, &relayer](DataHeader& dh, size_t time) {
+      std::array<fair::mq::MessagePtr, 2> messages;
+      messages[0] = o2::pmr::getMessage(Stack{channelAlloc, dh, DataProcessingHeader{time, 1}});
+      messages[1] = transport->CreateMessage(1000);
+      DataRelayer::InputInfo fakeInfo{0, messages.size(), DataRelayer::InputType::Data, {ChannelIndex::INVALID}};
+      relayer.relay(messages[0]->GetData(), messages.data(), fakeInfo, messages.size());
+    };
+
+    DataHeader dh1;
+    dh1.dataDescription = "CLUSTERS";
+    dh1.dataOrigin = "TPC";
+    dh1.subSpecification = 0;
+    dh1.splitPayloadIndex = 0;
+    dh1.splitPayloadParts = 1;
+
+    DataHeader dh2;
+    dh2.dataDescription = "CLUSTERS";
+    dh2.dataOrigin = "ITS";
+    dh2.subSpecification = 0;
+    dh2.splitPayloadIndex = 0;
+    dh2.splitPayloadParts = 1;
+
+    // The sporadic input is not required to complete the slot
+    createMessage(dh1, 0);
+    std::vector<RecordAction> ready;
+    relayer.getReadyToProcess(ready);
+    REQUIRE(ready.size() == 0);
+    REQUIRE(relayer.getNumberOfInputsInSlot({0}) == 1);
+    REQUIRE(relayer.isSlotComplete({0}) == false);
+    createMessage(dh2, 0);
+    REQUIRE(relayer.getNumberOfInputsInSlot({0}) == 2);
+    REQUIRE(relayer.isSlotComplete({0}));
+    auto result = relayer.consumeAllInputsForTimeslice({0});
+    REQUIRE(result.size() == 3);
+    REQUIRE(relayer.getNumberOfInputsInSlot({0}) == 0);
+    REQUIRE(relayer.isSlotComplete({0}) == false);
+
+    createMessage(dh2, 1);
+    REQUIRE(relayer.getNumberOfInputsInSlot({1}) == 1);
+    relayer.clear();
+    REQUIRE(relayer.getNumberOfInputsInSlot({1}) == 0);
+  }
+
   // This the any policy. Even when there are two inputs, given the any policy
   // it will run immediately.
   SECTION("TestPolicies")
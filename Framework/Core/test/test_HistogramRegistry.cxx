@@ -11,6 +11,7 @@
 
 #include "Framework/HistogramRegistry.h"
 #include <catch_amalgamated.hpp>
+#include <thread>
 
 using namespace o2;
 using namespace o2::framework;
@@ -125,3 +126,79 @@ TEST_CASE("HistogramRegistryStepTHn")
 
   registry.print();
 }
+
+TEST_CASE("HistogramRegistryConcurrentFill")
+{
+  std::vector<HistogramSpec> specs{
+    {"x", "x", {HistType::kTH1F, {{100, -1.0f, 1.0f}}}},
+    {"xy", "xy", {HistType::kTH2D, {{50, -1.0f, 1.0f}, {50, -1.0f, 1.0f}}}},
+    {"xyz", "xyz", {HistType::kTHnSparseF, {{20, -1.0f, 1.0f}, {20, -1.0f, 1.0f}, {20, -1.0f, 1.0f}}}, true},
+    {"prof", "prof", {HistType::kTProfile, {{20, -1.0f, 1.0f}}}}};
+  HistogramRegistry serial{"serial", specs};
+  HistogramRegistry concurrent{"concurrent", specs};
+  concurrent.setConcurrentFill();
+
+  auto fillAll = [](HistogramRegistry& registry, int offset, int n) {
+    for (int i = offset; i < offset + n; ++i) {
+      // values also cover under- and overflows
+      double x = (i % 113) / 50. - 1.1;
+      double y = (i % 71) / 30. - 1.2;
+      double z = (i % 37) / 18. - 1.;
+      registry.fill(HIST("x"), x);
+      registry.fill(HIST("xy"), x, y, 0.5);
+      registry.fill(HIST("xyz"), x, y, z);
+      registry.fill(HIST("prof"), x, y);
+    }
+  };
+  const int nThreads = 4;
+  const int nFills = 10000;
+  fillAll(serial, 0, nThreads * nFills);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < nThreads; ++t) {
+    threads.emplace_back(fillAll, std::ref(concurrent), t * nFills, nFills);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // buffered fills only show up after the flush
+  REQUIRE(concurrent.get<TH1>(HIST("x"))->GetEntries() == 0);
+  concurrent.flushConcurrentFills();
+
+  auto x = concurrent.get<TH1>(HIST("x"));
+  auto xRef = serial.get<TH1>(HIST("x"));
+  REQUIRE(x->GetEntries() == xRef->GetEntries());
+  REQUIRE(x->GetMean() == Catch::Approx(xRef->GetMean()));
+  REQUIRE(x->GetStdDev() == Catch::Approx(xRef->GetStdDev()));
+  for (int bin = 0; bin < x->GetNcells(); ++bin) {
+    REQUIRE(x->GetBinContent(bin) == xRef->GetBinContent(bin));
+  }
+
+  auto xy = concurrent.get<TH2>(HIST("xy"));
+  auto xyRef = serial.get<TH2>(HIST("xy"));
+  REQUIRE(xy->GetSumw2N() == xyRef->GetSumw2N());
+  REQUIRE(xy->GetCovariance() == Catch::Approx(xyRef->GetCovariance()));
+  for (int bin = 0; bin < xy->GetNcells(); ++bin) {
+    REQUIRE(xy->GetBinContent(bin) == xyRef->GetBinContent(bin));
+    REQUIRE(xy->GetBinError(bin) == Catch::Approx(xyRef->GetBinError(bin)));
+  }
+
+  auto xyz = concurrent.get<THnSparse>(HIST("xyz"));
+  auto xyzRef = serial.get<THnSparse>(HIST("xyz"));
+  REQUIRE(xyz->GetEntries() == xyzRef->GetEntries());
+  REQUIRE(xyz->GetNbins() == xyzRef->GetNbins());
+  // sums used for the axis statistics
+  REQUIRE(xyz->GetSumw() == Catch::Approx(xyzRef->GetSumw()));
+  REQUIRE(xyz->GetSumw2() == Catch::Approx(xyzRef->GetSumw2()));
+  for (int d = 0; d < 3; ++d) {
+    REQUIRE(xyz->GetSumwx(d) == Catch::Approx(xyzRef->GetSumwx(d)));
+    REQUIRE(xyz->GetSumwx2(d) == Catch::Approx(xyzRef->GetSumwx2(d)));
+  }
+  for (Long64_t bin = 0; bin < xyzRef->GetNbins(); ++bin) {
+    Int_t coord[3];
+    double content = xyzRef->GetBinContent(bin, coord);
+    REQUIRE(xyz->GetBinContent(coord) == content);
+  }
+
+  REQUIRE(concurrent.get<TProfile>(HIST("prof"))->GetMean(2) == Catch::Approx(serial.get<TProfile>(HIST("prof"))->GetMean(2)));
+}
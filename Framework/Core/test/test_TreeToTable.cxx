@@ -18,6 +18,7 @@
 
 #include <TTree.h>
 #include <TRandom.h>
+#include <TROOT.h>
 #include <arrow/table.h>
 #include <array>
 
@@ -236,3 +237,48 @@ TEST_CASE("VariableLists")
     ++i;
   }
 }
+
+TEST_CASE("TreeToTableConversionMT")
+{
+  constexpr int ncols = 16;
+  constexpr int ndp = 1000;
+  TFile f1("tree2table_mt.root", "RECREATE");
+  TTree t1("t1", "a tree with many columns");
+  std::array<Float_t, ncols> values;
+  std::array<Int_t, 3> vec;
+  for (auto ci = 0; ci < ncols; ++ci) {
+    t1.Branch(Form("c%d", ci), &values[ci], Form("c%d/F", ci));
+  }
+  t1.Branch("vec", vec.data(), "vec[3]/I");
+  for (int i = 0; i < ndp; i++) {
+    for (auto ci = 0; ci < ncols; ++ci) {
+      values[ci] = i * 0.5f + ci;
+    }
+    vec = {i, i + 1, i + 2};
+    t1.Fill();
+  }
+  t1.Write();
+  f1.Close();
+
+  TFile f2("tree2table_mt.root", "READ");
+  auto* t2 = f2.Get<TTree>("t1");
+  TreeToTable serial;
+  serial.addAllColumns(t2);
+  serial.fill(t2);
+  auto expected = serial.finalize();
+
+  // groups of columns are read concurrently through separate file handles when ROOT implicit MT is enabled
+  TFile f3("tree2table_mt.root", "READ");
+  auto* t3 = f3.Get<TTree>("t1");
+  ROOT::EnableImplicitMT(4);
+  TreeToTable parallel;
+  parallel.addAllColumns(t3);
+  parallel.fill(t3);
+  auto table = parallel.finalize();
+  ROOT::DisableImplicitMT();
+
+  REQUIRE(table->Validate().ok() == true);
+  REQUIRE(table->num_columns() == ncols + 1);
+  REQUIRE(table->schema()->Equals(*expected->schema()));
+  REQUIRE(table->Equals(*expected));
+}
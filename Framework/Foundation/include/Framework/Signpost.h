@@ -197,6 +197,62 @@ struct _o2_log_t {
 
   // Default stacktrace level for the log, when enabled.
   int defaultStacktrace = 1;
+
+  // If true, the signposts are not formatted and printed, but they are
+  // recorded in the per-thread ring buffers (see _o2_signpost_ring_t),
+  // to be dumped later on with _o2_signpost_dump_chrome_trace.
+  bool binary = false;
+
+  // The name of the log, as registered in the list of logs.
+  char const* name = nullptr;
+};
+
+enum struct _o2_signpost_record_type_t : uint8_t {
+  BEGIN,
+  END,
+  EVENT
+};
+
+// A fixed size entry of the binary signpost backend. The arguments of the
+// format string are not expanded, we only keep (a prefix of) the format string
+// itself so that recording a signpost is a handful of stores.
+struct _o2_signpost_record_t {
+  // Nanoseconds from the steady clock epoch
+  uint64_t timestamp = 0;
+  int64_t id = 0;
+  _o2_log_t* log = nullptr;
+  // The thread which emitted the signpost
+  int64_t tid = 0;
+  _o2_signpost_record_type_t type = _o2_signpost_record_type_t::EVENT;
+  uint8_t indentation = 0;
+  char name[30] = {};
+  char format[64] = {};
+};
+
+// A slot of the ring buffer. The record is stored as atomic words, guarded by a
+// sequence number (a seqlock): it is odd while the record is being written, and
+// 2 * (n + 1) once the n-th record of the ring is complete. A reader keeps a copy
+// only if it saw the same complete sequence number before and after copying.
+struct _o2_signpost_slot_t {
+  static constexpr size_t W = sizeof(_o2_signpost_record_t) / sizeof(uint64_t);
+  static_assert(sizeof(_o2_signpost_record_t) % sizeof(uint64_t) == 0);
+  std::atomic<uint64_t> seq = 0;
+  std::array<std::atomic<uint64_t>, W> words = {};
+};
+
+// A single producer ring buffer of signposts. Each thread gets one on first use,
+// and they are chained in a list so that they can be walked by the dumper. When a
+// thread exits its ring is released, and taken over by the next thread which needs
+// one, so only as many rings as threads recording at the same time are allocated.
+// The records of the thread which exited can still be dumped until they are overwritten.
+struct _o2_signpost_ring_t {
+  static constexpr size_t N = 8192;
+  // Number of records ever written. The last N ones are available.
+  std::atomic<uint64_t> head = 0;
+  // Whether a living thread writes to this ring
+  std::atomic<bool> owned = true;
+  _o2_signpost_ring_t* next = nullptr;
+  std::array<_o2_signpost_slot_t, N> slots;
 };
 
 bool _o2_lock_free_stack_push(_o2_lock_free_stack& stack, const int& value, bool spin = false);
@@ -206,6 +262,13 @@ void _o2_signpost_event_emit(_o2_log_t* log, _o2_signpost_id_t id, char const* n
 void _o2_signpost_interval_begin(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, ...);
 void _o2_signpost_interval_end(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, ...);
 void _o2_log_set_stacktrace(_o2_log_t* log, int stacktrace);
+void _o2_log_set_binary(_o2_log_t* log, bool binary);
+// Head of the list of per thread ring buffers used by the binary backend
+std::atomic<_o2_signpost_ring_t*>& _o2_get_signpost_rings();
+// Dump the content of all the rings to @a filename, in the Chrome trace event JSON format,
+// which can be opened by Perfetto (https://ui.perfetto.dev) or chrome://tracing.
+// Returns the number of events written, -1 in case the file could not be opened.
+int64_t _o2_signpost_dump_chrome_trace(char const* filename);
 
 // This generates a unique id for a signpost. Do not use this directly, use O2_SIGNPOST_ID_GENERATE instead.
 // Notice that this is only valid on a given computer.
@@ -234,7 +297,12 @@ inline _o2_signpost_id_t _o2_signpost_id_make_with_pointer(_o2_log_t* log, void
 #include <cstdarg>
 #include <cstdio>
 #include <cstring>
+#include <chrono>
 #include <execinfo.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
 #include "Framework/RuntimeError.h"
 #include "Framework/BacktraceHelpers.h"
 void _o2_signpost_interval_end_v(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, va_list args);
@@ -334,6 +402,7 @@ void* _o2_log_create(char const* name, int defaultStacktrace)
   }
 #endif
   newHandle->name = strdup(name);
+  log->name = newHandle->name;
   newHandle->next = o2_get_logs_tail().load();
   // Until I manage to replace the log I have in next, keep trying.
   // Notice this does not protect against two threads trying to insert
@@ -347,6 +416,107 @@ void* _o2_log_create(char const* name, int defaultStacktrace)
   return log;
 }
 
+std::atomic<_o2_signpost_ring_t*>& _o2_get_signpost_rings()
+{
+  static std::atomic<_o2_signpost_ring_t*> first = nullptr;
+  return first;
+}
+
+// The ring of the current thread, released when the thread exits.
+struct _o2_signpost_thread_ring_t {
+  _o2_signpost_ring_t* ring = nullptr;
+  int64_t tid = 0;
+
+  ~_o2_signpost_thread_ring_t()
+  {
+    if (ring) {
+      ring->owned.store(false, std::memory_order_release);
+    }
+  }
+};
+
+static _o2_signpost_thread_ring_t& _o2_signpost_get_thread_ring()
+{
+  static thread_local _o2_signpost_thread_ring_t current;
+  if (current.ring) {
+    return current;
+  }
+#ifdef __linux__
+  current.tid = syscall(SYS_gettid);
+#else
+  static std::atomic<int64_t> nextTid = 1;
+  current.tid = nextTid++;
+#endif
+  // Take over the ring of a thread which exited, if any.
+  for (auto* ring = _o2_get_signpost_rings().load(std::memory_order_acquire); ring; ring = ring->next) {
+    bool owned = false;
+    if (ring->owned.compare_exchange_strong(owned, true, std::memory_order_acquire, std::memory_order_relaxed)) {
+      current.ring = ring;
+      return current;
+    }
+  }
+  current.ring = new _o2_signpost_ring_t();
+  current.ring->next = _o2_get_signpost_rings().load();
+  while (!_o2_get_signpost_rings().compare_exchange_weak(current.ring->next, current.ring,
+                                                         std::memory_order_release,
+                                                         std::memory_order_relaxed)) {
+  }
+  return current;
+}
+
+// Append a signpost to the ring of the current thread. Only the owning thread
+// writes to a ring, the sequence number of the slot tells a concurrent reader
+// whether the record it copied is complete.
+static void _o2_signpost_record(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* format,
+                                _o2_signpost_record_type_t type, int indentation)
+{
+  auto& current = _o2_signpost_get_thread_ring();
+  auto* ring = current.ring;
+  _o2_signpost_record_t record;
+  record.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  record.id = id.value;
+  record.log = log;
+  record.tid = current.tid;
+  record.type = type;
+  record.indentation = indentation < 0 ? 0 : indentation;
+  strncpy(record.name, name ? name : "", sizeof(record.name) - 1);
+  strncpy(record.format, format ? format : "", sizeof(record.format) - 1);
+  uint64_t words[_o2_signpost_slot_t::W];
+  memcpy(words, &record, sizeof(record));
+
+  uint64_t head = ring->head.load(std::memory_order_relaxed);
+  auto& slot = ring->slots[head % _o2_signpost_ring_t::N];
+  slot.seq.store(2 * head + 1, std::memory_order_relaxed);
+  // The odd sequence number must be visible before any of the new words.
+  std::atomic_thread_fence(std::memory_order_release);
+  for (size_t i = 0; i < _o2_signpost_slot_t::W; ++i) {
+    slot.words[i].store(words[i], std::memory_order_relaxed);
+  }
+  slot.seq.store(2 * head + 2, std::memory_order_release);
+  ring->head.store(head + 1, std::memory_order_release);
+}
+
+// Copy the n-th record of the ring. Returns false if it is not (or no longer) available.
+static bool _o2_signpost_read_record(_o2_signpost_ring_t const* ring, uint64_t n, _o2_signpost_record_t& record)
+{
+  auto const& slot = ring->slots[n % _o2_signpost_ring_t::N];
+  uint64_t seq = slot.seq.load(std::memory_order_acquire);
+  if (seq != 2 * n + 2) {
+    return false;
+  }
+  uint64_t words[_o2_signpost_slot_t::W];
+  for (size_t i = 0; i < _o2_signpost_slot_t::W; ++i) {
+    words[i] = slot.words[i].load(std::memory_order_relaxed);
+  }
+  // The words must be read before checking again the sequence number.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (slot.seq.load(std::memory_order_relaxed) != seq) {
+    return false;
+  }
+  memcpy(&record, words, sizeof(record));
+  return true;
+}
+
 // This will look at the slot in the log associated to the ID.
 // If the slot is empty, it will return the id and increment the indentation level.
 void _o2_signpost_event_emit(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, ...)
@@ -374,6 +544,12 @@ void _o2_signpost_event_emit(_o2_log_t* log, _o2_signpost_id_t id, char const* n
     }
   }
 
+  if (log->binary) {
+    va_end(args);
+    _o2_signpost_record(log, id, name, format, _o2_signpost_record_type_t::EVENT, leading / 2);
+    return;
+  }
+
   char prebuffer[4096];
   int s = snprintf(prebuffer, 4096, "id%.16" PRIx64 ":%-16s*>%*c", id.value, name, leading, ' ');
   vsnprintf(prebuffer + s, 4096 - s, format, args);
@@ -401,6 +577,11 @@ void _o2_signpost_interval_begin(_o2_log_t* log, _o2_signpost_id_t id, char cons
   auto* activity = &log->activities[signpost_index];
   activity->indentation = log->current_indentation++;
   activity->name = name;
+  if (log->binary) {
+    va_end(args);
+    _o2_signpost_record(log, id, name, format, _o2_signpost_record_type_t::BEGIN, activity->indentation);
+    return;
+  }
   int leading = activity->indentation * 2;
   char prebuffer[4096];
   int s = snprintf(prebuffer, 4096, "id%.16" PRIx64 ":%-16sS>%*c", id.value, name, leading, ' ');
@@ -430,11 +611,15 @@ void _o2_signpost_interval_end_v(_o2_log_t* log, _o2_signpost_id_t id, char cons
   }
   // i is the slot index
   _o2_activity_t* activity = &log->activities[i];
-  int leading = activity->indentation * 2;
-  char prebuffer[4096];
-  int s = snprintf(prebuffer, 4096, "id%.16" PRIx64 ":%-16sE>%*c", id.value, name, leading, ' ');
-  vsnprintf(prebuffer + s, 4096 - s, format, args);
-  O2_LOG_MACRO("%s", prebuffer);
+  if (log->binary) {
+    _o2_signpost_record(log, id, name, format, _o2_signpost_record_type_t::END, activity->indentation);
+  } else {
+    int leading = activity->indentation * 2;
+    char prebuffer[4096];
+    int s = snprintf(prebuffer, 4096, "id%.16" PRIx64 ":%-16sE>%*c", id.value, name, leading, ' ');
+    vsnprintf(prebuffer + s, 4096 - s, format, args);
+    O2_LOG_MACRO("%s", prebuffer);
+  }
   // Clear the slot
   activity->indentation = -1;
   activity->name = nullptr;
@@ -459,12 +644,81 @@ void _o2_log_set_stacktrace(_o2_log_t* log, int stacktrace)
 {
   log->stacktrace = stacktrace;
 }
+
+void _o2_log_set_binary(_o2_log_t* log, bool binary)
+{
+  log->binary = binary;
+}
+
+// Write a string as a JSON string literal, escaping what needs to be escaped.
+static void _o2_signpost_write_json_string(FILE* f, char const* s)
+{
+  fputc('"', f);
+  for (; *s; ++s) {
+    auto c = (unsigned char)*s;
+    if (c == '"' || c == '\\') {
+      fputc('\\', f);
+      fputc(c, f);
+    } else if (c < 0x20) {
+      fprintf(f, "\\u%04x", c);
+    } else {
+      fputc(c, f);
+    }
+  }
+  fputc('"', f);
+}
+
+int64_t _o2_signpost_dump_chrome_trace(char const* filename)
+{
+  FILE* f = fopen(filename, "w");
+  if (f == nullptr) {
+    return -1;
+  }
+  int pid = getpid();
+  int64_t count = 0;
+  _o2_signpost_record_t record;
+  fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+  for (auto* ring = _o2_get_signpost_rings().load(std::memory_order_acquire); ring; ring = ring->next) {
+    // The owning thread keeps writing while we read, records which are
+    // overwritten in the meanwhile are skipped.
+    uint64_t head = ring->head.load(std::memory_order_acquire);
+    uint64_t first = head > _o2_signpost_ring_t::N ? head - _o2_signpost_ring_t::N : 0;
+    for (uint64_t i = first; i < head; ++i) {
+      if (!_o2_signpost_read_record(ring, i, record)) {
+        continue;
+      }
+      char const* phase = record.type == _o2_signpost_record_type_t::BEGIN ? "b" : (record.type == _o2_signpost_record_type_t::END ? "e" : "n");
+      fprintf(f, "%s\n{\"ph\":\"%s\",\"id\":\"0x%" PRIx64 "\",\"ts\":%.3f,\"pid\":%d,\"tid\":%" PRId64 ",\"cat\":",
+              count ? "," : "", phase, (uint64_t)record.id, record.timestamp / 1000., pid, record.tid);
+      _o2_signpost_write_json_string(f, record.log && record.log->name ? record.log->name : "");
+      fprintf(f, ",\"name\":");
+      _o2_signpost_write_json_string(f, record.name);
+      fprintf(f, ",\"args\":{\"format\":");
+      _o2_signpost_write_json_string(f, record.format);
+      fprintf(f, ",\"depth\":%d}}", record.indentation);
+      ++count;
+    }
+  }
+  fprintf(f, "\n]}\n");
+  fclose(f);
+  return count;
+}
 // A C function which can be used to enable the signposts
 extern "C" {
 void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
 {
   log->stacktrace = stacktrace;
 }
+
+void o2_debug_log_set_binary(_o2_log_t* log, bool binary)
+{
+  log->binary = binary;
+}
+
+int64_t o2_debug_signpost_dump_chrome_trace(char const* filename)
+{
+  return _o2_signpost_dump_chrome_trace(filename);
+}
 }
 #endif // O2_SIGNPOST_IMPLEMENTATION
 
@@ -478,6 +732,11 @@ void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
 // When we enable the log, we set the stacktrace to the default value.
 #define O2_LOG_ENABLE(log) _o2_log_set_stacktrace(private_o2_log_##log, private_o2_log_##log->defaultStacktrace)
 #define O2_LOG_DISABLE(log) _o2_log_set_stacktrace(private_o2_log_##log, 0)
+// Enable the log, recording its signposts in the binary ring buffers rather than printing them.
+#define O2_LOG_ENABLE_BINARY(log) __extension__({     \
+  _o2_log_set_binary(private_o2_log_##log, true); \
+  O2_LOG_ENABLE(log);                             \
+})
 // For the moment we simply use LOG DEBUG. We should have proper activities so that we can
 // turn on and off the printing.
 #define O2_LOG_DEBUG(log, ...) __extension__({                        \
@@ -550,6 +809,7 @@ void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
 #define O2_DECLARE_LOG(x, category)
 #define O2_LOG_ENABLE(log)
 #define O2_LOG_DISABLE(log)
+#define O2_LOG_ENABLE_BINARY(log)
 #define O2_LOG_DEBUG(log, ...)
 #define O2_SIGNPOST_ID_FROM_POINTER(name, log, pointer)
 #define O2_SIGNPOST_ID_GENERATE(name, log)
@@ -49,4 +49,17 @@ int main(int argc, char** argv)
   O2_SIGNPOST_START(test_SignpostDynamic, id, "Test category", "This is dynamic signpost which you will see, because we turned them on");
   O2_SIGNPOST_END(test_SignpostDynamic, id, "Test category", "This is dynamic signpost which you will see, because we turned them on");
 #endif
+
+  // In binary mode the signposts are only recorded, and then dumped in the Chrome trace format.
+  O2_LOG_ENABLE_BINARY(test_SignpostDynamic);
+  O2_SIGNPOST_ID_GENERATE(id5, test_SignpostDynamic);
+  O2_SIGNPOST_START(test_SignpostDynamic, id5, "Test category", "A binary signpost with a \"quoted\" argument %d", 1);
+  O2_SIGNPOST_EVENT_EMIT(test_SignpostDynamic, id5, "Test category", "An event in a binary interval");
+  O2_SIGNPOST_END(test_SignpostDynamic, id5, "Test category", "End of the binary interval");
+#ifndef __APPLE__
+  if (_o2_signpost_dump_chrome_trace("test_Signpost.json") != 3) {
+    std::cerr << "Unexpected number of events in the binary signposts dump" << std::endl;
+    return 1;
+  }
+#endif
 }
@@ -404,6 +404,10 @@ void displayDeviceInspector(DeviceSpec const& spec,
       std::string cmd = fmt::format("/log-streams {}", control.logStreams);
       control.controller->write(cmd.c_str(), cmd.size());
     }
+    if (ImGui::Button("Dump binary signposts") && control.controller) {
+      std::string cmd = "/signpost-dump";
+      control.controller->write(cmd.c_str(), cmd.size());
+    }
   }
 
   bool flagsChanged = false;
@@ -36,6 +36,9 @@
 #include "TPCBase/CDBInterface.h"
 #include "DataFormatsTPC/Digit.h"
 #include "TPCSimulation/Digitizer.h"
+#include "TPCSimulation/ElectronTransport.h"
+#include "TPCSimulation/GEMAmplification.h"
+#include "TPCSimulation/SAMPAProcessing.h"
 #include "TPCSimulation/Detector.h"
 #include "TPCSpaceCharge/SpaceCharge.h"
 #include "DetectorsBase/BaseDPLDigitizer.h"
@@ -44,6 +47,9 @@
 #include "CommonDataFormat/RangeReference.h"
 #include "SimConfig/DigiParams.h"
 #include <filesystem>
+#include <atomic>
+#include <thread>
+#include "TROOT.h"
 #include "Framework/CCDBParamSpec.h"
 
 using namespace o2::framework;
@@ -124,6 +130,11 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
     const int nthreadsDist = ic.options().get<int>("n-threads-distortions");
     SC::setNThreads(nthreadsDist);
     mUseCalibrationsFromCCDB = ic.options().get<bool>("TPCuseCCDB");
+    mNThreadsSectors = ic.options().get<int>("n-threads-sectors");
+    if (mNThreadsSectors > 1) {
+      // each worker reads the hits through its own chains
+      ROOT::EnableThreadSafety();
+    }
     mMeanLumiDistortions = ic.options().get<float>("meanLumiDistortions");
     mMeanLumiDistortionsDerivative = ic.options().get<float>("meanLumiDistortionsDerivative");
 
@@ -248,25 +259,237 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
       cdb.setGainMapFromFile("GainMap.root");
     }
 
+    std::vector<framework::DataRef> inputrefs;
     for (auto it = pc.inputs().begin(), end = pc.inputs().end(); it != end; ++it) {
       for (auto const& inputref : it) {
         if (inputref.spec->lifetime == o2::framework::Lifetime::Condition) { // process does not need conditions
           continue;
         }
-        process(pc, inputref);
-        if (mInternalWriter) {
-          mInternalROOTFlushTTree->SetEntries(mFlushCounter);
-          mInternalROOTFlushFile->Write("", TObject::kOverwrite);
-          mInternalROOTFlushFile->Close();
-          // delete mInternalROOTFlushTTree; --> automatically done by ->Close()
-          delete mInternalROOTFlushFile;
-          mInternalROOTFlushFile = nullptr;
+        inputrefs.push_back(inputref);
+      }
+    }
+
+    // several sectors of this device can be digitized concurrently; the internal writer updates one file per flush
+    // and is therefore always served sequentially
+    if (mNThreadsSectors > 1 && inputrefs.size() > 1 && !mInternalWriter) {
+      processParallel(pc, inputrefs);
+      return;
+    }
+
+    for (auto const& inputref : inputrefs) {
+      process(pc, inputref);
+      if (mInternalWriter) {
+        mInternalROOTFlushTTree->SetEntries(mFlushCounter);
+        mInternalROOTFlushFile->Write("", TObject::kOverwrite);
+        mInternalROOTFlushFile->Close();
+        // delete mInternalROOTFlushTTree; --> automatically done by ->Close()
+        delete mInternalROOTFlushFile;
+        mInternalROOTFlushFile = nullptr;
+      }
+      // TODO: make generic reset method?
+      mFlushCounter = 0;
+      mDigitCounter = 0;
+    }
+  }
+
+  /// loop over all collisions of the context and digitize the hits of one sector
+  /// \param flush callback flushing the digitizer after each collision part and, in continuous mode, at the end of
+  ///              the time frame; it returns the number of flushed digits
+  template <typename FlushFunction>
+  void digitizeCollisions(o2::tpc::Digitizer& digitizer, o2::steer::DigitizationContext const& context, std::vector<TChain*> const& simChains, int sector,
+                          FlushFunction&& flush, std::vector<DigiGroupRef>& eventAccum)
+  {
+    auto& irecords = context.getEventRecords();
+    auto& eventParts = context.getEventParts();
+    const bool isContinuous = digitizer.isContinuousReadout();
+
+    if (isContinuous) {
+      auto& hbfu = o2::raw::HBFUtils::Instance();
+      double time = hbfu.getFirstIRofTF(o2::InteractionRecord(0, hbfu.orbitFirstSampled)).bc2ns() / 1000.;
+      digitizer.setOutputDigitTimeOffset(time);
+      digitizer.setStartTime(irecords[0].getTimeNS() / 1000.f);
+    }
+
+    size_t digitCounter = 0;
+    // loop over all composite collisions given from context
+    // (aka loop over all the interaction records)
+    for (int collID = 0; collID < irecords.size(); ++collID) {
+      const double eventTime = irecords[collID].getTimeNS() / 1000.f;
+      LOG(info) << "TPC: Event time " << eventTime << " us";
+      digitizer.setEventTime(eventTime);
+      if (!isContinuous) {
+        digitizer.setStartTime(eventTime);
+      }
+      size_t startSize = digitCounter;
+
+      // for each collision, loop over the constituents event and source IDs
+      // (background signal merging is basically taking place here)
+      for (auto& part : eventParts[collID]) {
+        const int eventID = part.entryID;
+        const int sourceID = part.sourceID;
+
+        // get the hits for this event and this source
+        std::vector<o2::tpc::HitGroup> hitsLeft;
+        std::vector<o2::tpc::HitGroup> hitsRight;
+        context.retrieveHits(simChains, getBranchNameLeft(sector).c_str(), part.sourceID, part.entryID, &hitsLeft);
+        context.retrieveHits(simChains, getBranchNameRight(sector).c_str(), part.sourceID, part.entryID, &hitsRight);
+        LOG(debug) << "TPC: Found " << hitsLeft.size() << " hit groups left and " << hitsRight.size() << " hit groups right in collision " << collID << " eventID " << part.entryID;
+
+        digitizer.process(hitsLeft, eventID, sourceID);
+        digitizer.process(hitsRight, eventID, sourceID);
+
+        const size_t nFlushed = flush(false);
+        digitCounter += nFlushed;
+
+        if (!isContinuous) {
+          eventAccum.emplace_back(startSize, nFlushed);
         }
-        // TODO: make generic reset method?
-        mFlushCounter = 0;
-        mDigitCounter = 0;
       }
     }
+
+    // final flushing step; getting everything not yet written out
+    if (isContinuous) {
+      LOG(info) << "TPC: Final flush";
+      digitCounter += flush(true);
+      eventAccum.emplace_back(0, digitCounter); // all digits are grouped to 1 super-event pseudo-triggered mode
+    }
+  }
+
+  // we publish the GRP data once if the output channel is there
+  void publishROMode(framework::ProcessingContext& pc, o2::header::DataHeader const* dh)
+  {
+    if (mWriteGRP && pc.outputs().isAllowed({"TPC", "ROMode", 0})) {
+      auto roMode = mDigitizer.isContinuousReadout() ? o2::parameters::GRPObject::CONTINUOUS : o2::parameters::GRPObject::PRESENT;
+      LOG(info) << "TPC: Sending ROMode= " << (mDigitizer.isContinuousReadout() ? "Continuous" : "Triggered")
+                << " to GRPUpdater from channel " << dh->subSpecification;
+      pc.outputs().snapshot(Output{"TPC", "ROMode", 0}, roMode);
+    }
+    mWriteGRP = false;
+  }
+
+  // process the sectors of several inputs concurrently, each worker thread using its own digitizer, hit chains and
+  // random number streams; the outputs are published in the order of the inputs once all sectors are done
+  void processParallel(framework::ProcessingContext& pc, std::vector<framework::DataRef> const& inputrefs)
+  {
+    struct SectorTask {
+      std::unique_ptr<o2::steer::DigitizationContext const, InputRecord::Deleter<o2::steer::DigitizationContext const>> context;
+      o2::header::DataHeader const* dh = nullptr;
+      int sector = -1;
+      uint64_t activeSectors = 0;
+      std::vector<o2::tpc::Digit> digits;
+      o2::dataformats::MCTruthContainer<o2::MCCompLabel> labels;
+      std::vector<o2::tpc::CommonMode> commonMode;
+      std::vector<DigiGroupRef> events;
+    };
+    std::vector<SectorTask> tasks;
+    tasks.reserve(inputrefs.size());
+
+    for (auto const& inputref : inputrefs) {
+      auto context = pc.inputs().get<o2::steer::DigitizationContext*>(inputref);
+      LOG(info) << "TPC: Processing " << context->getEventRecords().size() << " collisions";
+      if (context->getEventRecords().size() == 0) {
+        continue;
+      }
+      auto const* dh = DataRefUtils::getHeader<o2::header::DataHeader*>(inputref);
+      publishROMode(pc, dh);
+
+      auto const* sectorHeader = DataRefUtils::getHeader<TPCSectorHeader*>(inputref);
+      if (sectorHeader == nullptr) {
+        LOG(error) << "TPC: Sector header missing, skipping processing";
+        continue;
+      }
+      const int sector = sectorHeader->sector();
+      if (sector < 0) {
+        throw std::runtime_error("Legacy control information is not expected any more");
+      }
+      if (sector >= TPCSectorHeader::NSectors) {
+        throw std::runtime_error("Digitizer can only work on single sectors");
+      }
+      mListOfSectors.push_back(sector);
+      auto& task = tasks.emplace_back();
+      task.context = std::move(context);
+      task.dh = dh;
+      task.sector = sector;
+      task.activeSectors = sectorHeader->activeSectors;
+    }
+    if (tasks.empty()) {
+      return;
+    }
+
+    TStopwatch timer;
+    timer.Start();
+
+    // parameters, calibrations and random rings are set up once, the workers only read them
+    mDigitizer.init();
+
+    std::atomic<size_t> nextTask{0};
+    auto worker = [this, &tasks, &nextTask](int threadID) {
+      o2::tpc::ElectronTransport::createThreadInstance(threadID + 1);
+      o2::tpc::GEMAmplification::createThreadInstance(threadID + 1);
+      o2::tpc::SAMPAProcessing::createThreadInstance(threadID + 1);
+      std::vector<TChain*> simChains;
+      o2::tpc::Digitizer digitizer;
+      digitizer.shareSettings(mDigitizer);
+
+      for (size_t iTask = nextTask++; iTask < tasks.size(); iTask = nextTask++) {
+        auto& task = tasks[iTask];
+        LOG(info) << "TPC: Processing sector " << task.sector << " in thread " << threadID;
+        task.context->initSimChains(o2::detectors::DetID::TPC, simChains);
+        // no init(): the parameters and calibrations were set up by mDigitizer and are taken over by shareSettings
+        digitizer.setSector(task.sector);
+
+        std::vector<o2::tpc::Digit> digits;
+        o2::dataformats::MCTruthContainer<o2::MCCompLabel> labels;
+        std::vector<o2::tpc::CommonMode> commonMode;
+        auto flushDigitsAndLabels = [this, &digitizer, &task, &digits, &labels, &commonMode](bool finalFlush) {
+          digits.clear();
+          labels.clear();
+          commonMode.clear();
+          digitizer.flush(digits, labels, commonMode, finalFlush);
+          std::copy(digits.begin(), digits.end(), std::back_inserter(task.digits));
+          if (mWithMCTruth) {
+            task.labels.mergeAtBack(labels);
+          }
+          std::copy(commonMode.begin(), commonMode.end(), std::back_inserter(task.commonMode));
+          return digits.size();
+        };
+        digitizeCollisions(digitizer, *task.context, simChains, task.sector, flushDigitsAndLabels, task.events);
+      }
+
+      for (auto chain : simChains) {
+        delete chain;
+      }
+      o2::tpc::ElectronTransport::releaseThreadInstance();
+      o2::tpc::GEMAmplification::releaseThreadInstance();
+      o2::tpc::SAMPAProcessing::releaseThreadInstance();
+    };
+
+    const int nThreads = std::min<int>(mNThreadsSectors, tasks.size());
+    std::vector<std::thread> threads;
+    for (int i = 0; i < nThreads; ++i) {
+      threads.emplace_back(worker, i);
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    // send out to next stage in the order of the inputs
+    for (auto& task : tasks) {
+      o2::tpc::TPCSectorHeader header{task.sector};
+      header.activeSectors = task.activeSectors;
+      const auto subSpec = static_cast<SubSpecificationType>(task.dh->subSpecification);
+      LOG(info) << "TPC: Sector " << task.sector << " produced " << task.digits.size() << " digits, " << task.labels.getNElements() << " labels and " << task.commonMode.size() << " common mode entries";
+      pc.outputs().snapshot(Output{"TPC", "DIGITS", subSpec, header}, task.digits);
+      pc.outputs().snapshot(Output{"TPC", "DIGTRIGGERS", subSpec, header}, task.events);
+      pc.outputs().snapshot(Output{"TPC", "COMMONMODE", subSpec, header}, task.commonMode);
+      if (mWithMCTruth) {
+        auto& sharedlabels = pc.outputs().make<o2::dataformats::ConstMCTruthContainer<o2::MCCompLabel>>(Output{"TPC", "DIGITSMCTR", subSpec, header});
+        task.labels.flatten_to(sharedlabels);
+      }
+    }
+
+    timer.Stop();
+    LOG(info) << "TPC: Digitization of " << tasks.size() << " sectors with " << nThreads << " threads took " << timer.CpuTime() << "s CPU, " << timer.RealTime() << "s real";
   }
 
   // process one sector
@@ -282,15 +505,7 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
     }
     auto const* dh = DataRefUtils::getHeader<o2::header::DataHeader*>(inputref);
 
-    bool isContinuous = mDigitizer.isContinuousReadout();
-    // we publish the GRP data once if the output channel is there
-    if (mWriteGRP && pc.outputs().isAllowed({"TPC", "ROMode", 0})) {
-      auto roMode = isContinuous ? o2::parameters::GRPObject::CONTINUOUS : o2::parameters::GRPObject::PRESENT;
-      LOG(info) << "TPC: Sending ROMode= " << (mDigitizer.isContinuousReadout() ? "Continuous" : "Triggered")
-                << " to GRPUpdater from channel " << dh->subSpecification;
-      pc.outputs().snapshot(Output{"TPC", "ROMode", 0}, roMode);
-    }
-    mWriteGRP = false;
+    publishROMode(pc, dh);
 
     // extract which sector to treat
     auto const* sectorHeader = DataRefUtils::getHeader<TPCSectorHeader*>(inputref);
@@ -371,9 +586,7 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
     mDigitizer.setSector(sector);
     mDigitizer.init();
 
-    auto& eventParts = context->getEventParts();
-
-    auto flushDigitsAndLabels = [this, digitsAccum, &labelAccum, &commonModeAccum](bool finalFlush = false) {
+    auto flushDigitsAndLabels = [this, digitsAccum, &labelAccum, &commonModeAccum](bool finalFlush) {
       mFlushCounter++;
       // flush previous buffer
       mDigits.clear();
@@ -394,59 +607,13 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
         std::copy(mCommonMode.begin(), mCommonMode.end(), std::back_inserter(commonModeAccum));
       }
       mDigitCounter += mDigits.size();
+      return mDigits.size();
     };
 
-    if (isContinuous) {
-      auto& hbfu = o2::raw::HBFUtils::Instance();
-      double time = hbfu.getFirstIRofTF(o2::InteractionRecord(0, hbfu.orbitFirstSampled)).bc2ns() / 1000.;
-      mDigitizer.setOutputDigitTimeOffset(time);
-      mDigitizer.setStartTime(irecords[0].getTimeNS() / 1000.f);
-    }
-
     TStopwatch timer;
     timer.Start();
 
-    // loop over all composite collisions given from context
-    // (aka loop over all the interaction records)
-    for (int collID = 0; collID < irecords.size(); ++collID) {
-      const double eventTime = irecords[collID].getTimeNS() / 1000.f;
-      LOG(info) << "TPC: Event time " << eventTime << " us";
-      mDigitizer.setEventTime(eventTime);
-      if (!isContinuous) {
-        mDigitizer.setStartTime(eventTime);
-      }
-      size_t startSize = mDigitCounter; // digitsAccum->size();
-
-      // for each collision, loop over the constituents event and source IDs
-      // (background signal merging is basically taking place here)
-      for (auto& part : eventParts[collID]) {
-        const int eventID = part.entryID;
-        const int sourceID = part.sourceID;
-
-        // get the hits for this event and this source
-        std::vector<o2::tpc::HitGroup> hitsLeft;
-        std::vector<o2::tpc::HitGroup> hitsRight;
-        context->retrieveHits(mSimChains, getBranchNameLeft(sector).c_str(), part.sourceID, part.entryID, &hitsLeft);
-        context->retrieveHits(mSimChains, getBranchNameRight(sector).c_str(), part.sourceID, part.entryID, &hitsRight);
-        LOG(debug) << "TPC: Found " << hitsLeft.size() << " hit groups left and " << hitsRight.size() << " hit groups right in collision " << collID << " eventID " << part.entryID;
-
-        mDigitizer.process(hitsLeft, eventID, sourceID);
-        mDigitizer.process(hitsRight, eventID, sourceID);
-
-        flushDigitsAndLabels();
-
-        if (!isContinuous) {
-          eventAccum.emplace_back(startSize, mDigits.size());
-        }
-      }
-    }
-
-    // final flushing step; getting everything not yet written out
-    if (isContinuous) {
-      LOG(info) << "TPC: Final flush";
-      flushDigitsAndLabels(true);
-      eventAccum.emplace_back(0, mDigitCounter); // all digits are grouped to 1 super-event pseudo-triggered mode
-    }
+    digitizeCollisions(mDigitizer, *context, mSimChains, sector, flushDigitsAndLabels, eventAccum);
 
     if (!mInternalWriter) {
       // send out to next stage
@@ -478,6 +645,7 @@ class TPCDPLDigitizerTask : public BaseDPLDigitizer
   bool mWithMCTruth = true;
   bool mInternalWriter = false;
   bool mUseCalibrationsFromCCDB = false;
+  int mNThreadsSectors = 1; // number of threads digitizing the sectors of this device concurrently
   int mDistortionType = 0;
   float mMeanLumiDistortions = -1;
   float mMeanLumiDistortionsDerivative = -1;
@@ -522,6 +690,7 @@ o2::framework::DataProcessorSpec getTPCDigitizerSpec(int channel, bool writeGRP,
       {"meanLumiDistortionsDerivative", VariantType::Float, -1.f, {"override lumi of derivative distortion object if >=0"}},
       {"do-not-recalculate-distortions", VariantType::Bool, false, {"Do not recalculate the distortions"}},
       {"n-threads-distortions", VariantType::Int, 4, {"Number of threads used for the calculation of the distortions"}},
+      {"n-threads-sectors", VariantType::Int, 1, {"Number of threads used to digitize the sectors of one device concurrently"}},
     }};
 }
 
@@ -0,0 +1,96 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef ALICEO2_MERGERS_FLATHISTOGRAM_H
+#define ALICEO2_MERGERS_FLATHISTOGRAM_H
+
+/// \file FlatHistogram.h
+/// \brief Mergeable message format of FlatHisto1D and FlatHisto2D
+///
+/// A flat histogram is sent as a raw (not ROOT-serialized) message, which consists of a FlatHistogram::Header,
+/// the name of the histogram and the container of a FlatHisto1D or FlatHisto2D. Mergers add the bin arrays
+/// of such messages without deserializing them and convert the result to a ROOT histogram only to publish it.
+/// A producer sends a histogram with:
+///   pc.outputs().snapshot(Output{"Origin", "Desc", 0}, FlatHistogram::toMessage(histo, "histoName"));
+
+#include "CommonDataFormat/FlatHisto1D.h"
+#include "CommonDataFormat/FlatHisto2D.h"
+
+#include <gsl/span>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+class TH1;
+
+namespace o2::mergers
+{
+
+class FlatHistogram
+{
+ public:
+  struct Header {
+    static constexpr uint32_t MagicWord = 0x48464d4f; // "OMFH"
+    uint32_t magicWord = MagicWord;
+    uint16_t dimension = 0;     // 1 for FlatHisto1D, 2 for FlatHisto2D
+    uint16_t elementSize = 0;   // sizeof(float) or sizeof(double)
+    uint32_t nameSize = 0;      // size of the name, including the padding to 8 bytes
+    uint32_t containerSize = 0; // number of elements in the container of FlatHisto1D/2D, including the service slots
+  };
+
+  /// \brief Creates the message of a histogram
+  template <typename T>
+  static std::vector<char> toMessage(const dataformats::FlatHisto1D<T>& histo, std::string_view name)
+  {
+    return toMessage(histo.getView(), 1, name);
+  }
+  template <typename T>
+  static std::vector<char> toMessage(const dataformats::FlatHisto2D<T>& histo, std::string_view name)
+  {
+    return toMessage(histo.getView(), 2, name);
+  }
+
+  /// \brief Checks if a message contains a flat histogram
+  static bool isFlatHistogram(gsl::span<const char> message);
+
+  /// \brief Reads a flat histogram from a message
+  /// \param copy If false, the object only views the message and must not outlive it. Such an object cannot be a merging target.
+  FlatHistogram(gsl::span<const char> message, bool copy);
+
+  /// \brief Adds the bins of other to the bins of this histogram. Throws if the binnings are not the same.
+  void merge(const FlatHistogram& other);
+
+  /// \brief Converts the histogram to TH1F or TH2F
+  std::unique_ptr<TH1> toTH1() const;
+
+  const Header& getHeader() const { return *reinterpret_cast<const Header*>(mMessage.data()); }
+  std::string_view getName() const;
+  gsl::span<const char> getMessage() const { return mMessage; }
+
+ private:
+  template <typename T>
+  static std::vector<char> toMessage(gsl::span<const T> container, uint16_t dimension, std::string_view name);
+
+  template <typename T>
+  gsl::span<const T> getContainer() const;
+
+  template <typename T>
+  void addBins(const FlatHistogram& other);
+
+  std::vector<char> mStorage{};     // copy of the message, if owned
+  gsl::span<const char> mMessage{}; // message, either mStorage or external
+};
+
+using FlatHistogramPtr = std::shared_ptr<FlatHistogram>;
+
+} // namespace o2::mergers
+
+#endif // ALICEO2_MERGERS_FLATHISTOGRAM_H
@@ -24,6 +24,7 @@
 #include "Framework/Task.h"
 
 #include <memory>
+#include <vector>
 
 class TObject;
 
@@ -58,7 +59,8 @@ class IntegratingMerger : public framework::Task
   void finishCycle(framework::DataAllocator& outputs);
   void publishIntegral(framework::DataAllocator& allocator);
   void publishMovingWindow(framework::DataAllocator& allocator);
-  static void merge(ObjectStore& mMergedDelta, ObjectStore&& other);
+  void reducePendingDeltas();
+  static void merge(ObjectStore& mMergedDelta, ObjectStore&& other, int nThreads = 1);
   void clear();
 
  private:
@@ -67,6 +69,8 @@ class IntegratingMerger : public framework::Task
   ObjectStore mMergedObjectLastCycle = std::monostate{};
   // data points since the last state reset
   ObjectStore mMergedObjectIntegral = std::monostate{};
+  // deltas waiting for the parallel reduction, used only with ParallelReduction::Yes
+  std::vector<VectorOfTObjectPtrs> mPendingDeltas;
   MergerConfig mConfig;
   std::unique_ptr<monitoring::Monitoring> mCollector;
   int mCyclesSinceReset = 0;
@@ -32,6 +32,17 @@ void merge(TObject* const target, TObject* const other);
 /// If such item exists it is merged into the target object. If not than the item is pushed to the end
 /// of targets vector.
 void merge(VectorOfTObjectPtrs& targets, const VectorOfTObjectPtrs& others);
+/// \brief A function which merges two vectors of TObjects with nThreads threads
+///
+/// Same as above, but the objects are matched by name first and then the objects of different names
+/// are merged concurrently. ROOT::EnableThreadSafety() has to be called beforehand.
+void merge(VectorOfTObjectPtrs& targets, const VectorOfTObjectPtrs& others, int nThreads);
+/// \brief A function which merges vectors of TObjects with a pairwise tree reduction
+///
+/// The result ends up in deltas[0], the other vectors are emptied on the way. On each level of the tree
+/// the pairs are merged concurrently, as long as there are at least as many pairs as threads.
+/// Otherwise, the objects within each pair are merged concurrently.
+void reduce(std::vector<VectorOfTObjectPtrs>& deltas, int nThreads);
 
 void deleteTCollections(TObject* obj);
 
@@ -51,6 +51,13 @@ enum class PublishMovingWindow {
   No
 };
 
+enum class FlatHistogramPublication {
+  // Flat histograms are converted to ROOT histograms when published.
+  AsROOT,
+  // Flat histograms are published in their flat format, used towards the next layer of Mergers.
+  AsFlat
+};
+
 enum class PublicationDecision {
   EachNSeconds, // Merged object is published each N seconds. This can evolve over time, thus we expect pairs specifying N:duration1, M:duration2...
 };
@@ -66,6 +73,14 @@ enum class ParallelismType {
   RoundRobin   // Mergers receive their input messages in round robin order. Useful when there is one InputSpec with a wildcard.
 };
 
+enum class ParallelReduction {
+  // Each incoming object is merged on the processing thread as it arrives.
+  No,
+  // Objects of VectorOfTObjectPtrs received within a cycle are merged with a pairwise tree reduction,
+  // objects of different names are merged concurrently. The parameter is the number of threads.
+  Yes
+};
+
 template <typename V, typename P = double>
 struct ConfigEntry {
   V value;
@@ -93,9 +108,11 @@ struct MergerConfig {
   ConfigEntry<PublicationDecision, PublicationDecisionParameter> publicationDecision = {PublicationDecision::EachNSeconds, {10}};
   ConfigEntry<TopologySize, std::variant<int, std::vector<size_t>>> topologySize = {TopologySize::NumberOfLayers, 1};
   ConfigEntry<PublishMovingWindow> publishMovingWindow = {PublishMovingWindow::No};
+  ConfigEntry<FlatHistogramPublication> flatHistogramPublication = {FlatHistogramPublication::AsROOT};
   std::string monitoringUrl = "infologger:///debug?qc";
   std::string detectorName = "TST";
   ConfigEntry<ParallelismType> parallelismType = {ParallelismType::SplitInputs};
+  ConfigEntry<ParallelReduction, int> parallelReduction = {ParallelReduction::No, 1};
   std::vector<o2::framework::DataProcessorLabel> labels;
 };
 
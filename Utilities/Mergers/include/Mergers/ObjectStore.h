@@ -19,8 +19,10 @@
 
 #include <variant>
 #include <memory>
+#include <optional>
 #include <vector>
 #include <Headers/DataHeader.h>
+#include "Mergers/FlatHistogram.h"
 
 class TObject;
 
@@ -42,7 +44,7 @@ using TObjectPtr = std::shared_ptr<TObject>;
 using VectorOfRawTObjects = std::vector<TObject*>;
 using VectorOfTObjectPtrs = std::vector<TObjectPtr>;
 using MergeInterfacePtr = std::shared_ptr<MergeInterface>;
-using ObjectStore = std::variant<std::monostate, TObjectPtr, VectorOfTObjectPtrs, MergeInterfacePtr>;
+using ObjectStore = std::variant<std::monostate, TObjectPtr, VectorOfTObjectPtrs, MergeInterfacePtr, FlatHistogramPtr>;
 
 namespace object_store_helpers
 {
@@ -50,14 +52,18 @@ namespace object_store_helpers
 /// \brief Takes a DataRef, deserializes it (if type is supported) and puts into an ObjectStore
 ObjectStore extractObjectFrom(const framework::DataRef& ref);
 
+/// \brief Returns a view on the flat histogram in the DataRef, if it contains one. It must not outlive the message.
+std::optional<FlatHistogram> viewFlatHistogram(const framework::DataRef& ref);
+
 /// \brief Helper function that converts vector of smart pointers to the vector of raw pointers that is serializable.
 ///        Make sure that original vector lives longer than the observer vector to avoid undefined behavior.
 VectorOfRawTObjects toRawObserverPointers(const VectorOfTObjectPtrs&);
 
 /// \brief Used in FullHistorMerger's and IntegratingMerger's publish function. Checks mergedObject for every state that is NOT monostate
 ///        and creates snapshot of underlying object to the framework
+///        Flat histograms are converted to ROOT histograms unless keepFlatHistograms is set (e.g. towards the next layer of Mergers)
 /// \return Boolean whether the object was succesfully snapshotted or not
-bool snapshot(framework::DataAllocator& allocator, const header::DataHeader::SubSpecificationType subSpec, const ObjectStore& mergedObject);
+bool snapshot(framework::DataAllocator& allocator, const header::DataHeader::SubSpecificationType subSpec, const ObjectStore& mergedObject, bool keepFlatHistograms = false);
 
 } // namespace object_store_helpers
 
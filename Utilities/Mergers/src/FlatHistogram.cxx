@@ -0,0 +1,164 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file FlatHistogram.cxx
+/// \brief Implementation of the mergeable message format of FlatHisto1D and FlatHisto2D
+
+#include "Mergers/FlatHistogram.h"
+
+#include <TH1F.h>
+#include <TH2F.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace o2::mergers
+{
+
+namespace
+{
+constexpr size_t alignTo8(size_t size)
+{
+  return (size + 7) & ~size_t(7);
+}
+} // namespace
+
+template <typename T>
+std::vector<char> FlatHistogram::toMessage(gsl::span<const T> container, uint16_t dimension, std::string_view name)
+{
+  if (container.empty()) {
+    throw std::runtime_error("Cannot create the message of an uninitialized flat histogram");
+  }
+  Header header;
+  header.dimension = dimension;
+  header.elementSize = sizeof(T);
+  header.nameSize = alignTo8(name.size() + 1);
+  header.containerSize = container.size();
+
+  std::vector<char> message(sizeof(Header) + header.nameSize + container.size_bytes(), 0);
+  memcpy(message.data(), &header, sizeof(Header));
+  memcpy(message.data() + sizeof(Header), name.data(), name.size());
+  memcpy(message.data() + sizeof(Header) + header.nameSize, container.data(), container.size_bytes());
+  return message;
+}
+
+bool FlatHistogram::isFlatHistogram(gsl::span<const char> message)
+{
+  if (message.size() < sizeof(Header)) {
+    return false;
+  }
+  Header header;
+  memcpy(&header, message.data(), sizeof(Header));
+  return header.magicWord == Header::MagicWord && (header.dimension == 1 || header.dimension == 2) &&
+         (header.elementSize == sizeof(float) || header.elementSize == sizeof(double)) &&
+         message.size() == sizeof(Header) + header.nameSize + size_t(header.containerSize) * header.elementSize;
+}
+
+FlatHistogram::FlatHistogram(gsl::span<const char> message, bool copy)
+{
+  if (!isFlatHistogram(message)) {
+    throw std::runtime_error("The message does not contain a flat histogram");
+  }
+  if (copy) {
+    mStorage.assign(message.begin(), message.end());
+    mMessage = mStorage;
+  } else {
+    mMessage = message;
+  }
+}
+
+std::string_view FlatHistogram::getName() const
+{
+  return {mMessage.data() + sizeof(Header)};
+}
+
+template <typename T>
+gsl::span<const T> FlatHistogram::getContainer() const
+{
+  const auto& header = getHeader();
+  return {reinterpret_cast<const T*>(mMessage.data() + sizeof(Header) + header.nameSize), header.containerSize};
+}
+
+template <typename T>
+void FlatHistogram::addBins(const FlatHistogram& other)
+{
+  constexpr size_t serviceSlots = dataformats::FlatHisto1D<T>::NServiceSlots;
+  static_assert(serviceSlots <= dataformats::FlatHisto2D<T>::NServiceSlots);
+  const size_t firstBin = getHeader().dimension == 1 ? serviceSlots : dataformats::FlatHisto2D<T>::NServiceSlots;
+  auto container = getContainer<T>();
+  auto otherContainer = other.getContainer<T>();
+  if (!std::equal(container.begin(), container.begin() + firstBin, otherContainer.begin())) {
+    throw std::runtime_error("Cannot merge flat histograms '" + std::string(getName()) + "' with different binning");
+  }
+
+  // the target is always our own copy, thus it does not overlap with the other histogram
+  T* __restrict__ bins = const_cast<T*>(container.data()) + firstBin;
+  const T* __restrict__ otherBins = otherContainer.data() + firstBin;
+  const size_t nBins = container.size() - firstBin;
+#pragma omp simd
+  for (size_t i = 0; i < nBins; i++) {
+    bins[i] += otherBins[i];
+  }
+}
+
+void FlatHistogram::merge(const FlatHistogram& other)
+{
+  if (mStorage.empty()) {
+    throw std::runtime_error("The flat histogram '" + std::string(getName()) + "' only views a message and cannot be a merging target");
+  }
+  const auto& header = getHeader();
+  const auto& otherHeader = other.getHeader();
+  if (header.dimension != otherHeader.dimension || header.elementSize != otherHeader.elementSize || header.containerSize != otherHeader.containerSize) {
+    throw std::runtime_error("Cannot merge flat histograms '" + std::string(getName()) + "' and '" + std::string(other.getName()) + "' of different types or sizes");
+  }
+  if (header.elementSize == sizeof(float)) {
+    addBins<float>(other);
+  } else {
+    addBins<double>(other);
+  }
+}
+
+namespace
+{
+template <typename T>
+std::unique_ptr<TH1> createTH1(gsl::span<const T> container, int dimension, const std::string& name)
+{
+  std::unique_ptr<TH1> histo;
+  T sum{};
+  if (dimension == 1) {
+    dataformats::FlatHisto1D<T> view(container);
+    histo = view.createTH1F(name);
+    sum = view.getSum();
+  } else {
+    dataformats::FlatHisto2D<T> view(container);
+    histo = view.createTH2F(name);
+    sum = view.getSum();
+  }
+  // the flat histograms have no statistics, SetBinContent counted the filled bins as entries
+  histo->SetEntries(sum);
+  return histo;
+}
+} // namespace
+
+std::unique_ptr<TH1> FlatHistogram::toTH1() const
+{
+  const std::string name{getName()};
+  if (getHeader().elementSize == sizeof(float)) {
+    return createTH1(getContainer<float>(), getHeader().dimension, name);
+  }
+  return createTH1(getContainer<double>(), getHeader().dimension, name);
+}
+
+template std::vector<char> FlatHistogram::toMessage(gsl::span<const float>, uint16_t, std::string_view);
+template std::vector<char> FlatHistogram::toMessage(gsl::span<const double>, uint16_t, std::string_view);
+
+} // namespace o2::mergers
@@ -25,6 +25,7 @@
 #include "Framework/Logger.h"
 #include <Monitoring/MonitoringFactory.h>
 #include <InfoLogger/InfoLogger.hxx>
+#include <TROOT.h>
 
 using namespace o2::header;
 using namespace o2::framework;
@@ -55,6 +56,10 @@ void FullHistoryMerger::init(framework::InitContext& ictx)
   // clear the state before starting the run, especially important for START->STOP->START sequence
   ictx.services().get<CallbackService>().set<CallbackService::Id::Start>([this]() { clear(); });
 
+  if (mConfig.parallelReduction.value == ParallelReduction::Yes && mConfig.parallelReduction.param > 1) {
+    ROOT::EnableThreadSafety();
+  }
+
   // set detector field in infologger
   try {
     auto& ilContext = ictx.services().get<AliceO2::InfoLogger::InfoLoggerContext>();
@@ -175,11 +180,21 @@ void FullHistoryMerger::mergeCache()
 
   } else if (std::holds_alternative<VectorOfTObjectPtrs>(mMergedObject)) {
     auto target = std::get<VectorOfTObjectPtrs>(mMergedObject);
+    // the cached objects are merged again in the next cycles, thus we can parallelize only within each of them
+    const int nThreads = mConfig.parallelReduction.value == ParallelReduction::Yes ? mConfig.parallelReduction.param : 1;
     for (auto& [_, entry] : mCache) {
       auto other = std::get<VectorOfTObjectPtrs>(entry);
-      algorithm::merge(target, other);
+      algorithm::merge(target, other, nThreads);
       mObjectsMerged += target.size();
     }
+
+  } else if (std::holds_alternative<FlatHistogramPtr>(mMergedObject)) {
+    auto target = std::get<FlatHistogramPtr>(mMergedObject);
+    for (auto& [name, entry] : mCache) {
+      (void)name;
+      target->merge(*std::get<FlatHistogramPtr>(entry));
+      mObjectsMerged++;
+    }
   }
 }
 
@@ -187,7 +202,7 @@ void FullHistoryMerger::publish(framework::DataAllocator& allocator)
 {
   if (std::holds_alternative<std::monostate>(mMergedObject)) {
     LOG(info) << "No objects received since start or reset, nothing to publish";
-  } else if (object_store_helpers::snapshot(allocator, mSubSpec, mMergedObject)) {
+  } else if (object_store_helpers::snapshot(allocator, mSubSpec, mMergedObject, mConfig.flatHistogramPublication.value == FlatHistogramPublication::AsFlat)) {
     LOG(info) << "Published the merged object containing " << mCache.size() + 1 << " incomplete objects. "
               << mUpdatesReceived << " updates were received during the last cycle.";
   } else {
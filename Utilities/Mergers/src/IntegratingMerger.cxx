@@ -23,6 +23,8 @@
 
 #include <Monitoring/MonitoringFactory.h>
 
+#include <TROOT.h>
+
 #include "Framework/InputRecordWalker.h"
 #include "Framework/Logger.h"
 
@@ -31,6 +33,9 @@ using namespace o2::framework;
 namespace o2::mergers
 {
 
+// Upper limit of deltas kept for the parallel reduction per thread, it bounds the memory used by pending deltas.
+constexpr size_t MaxPendingDeltasPerThread = 4;
+
 IntegratingMerger::IntegratingMerger(const MergerConfig& config, const header::DataHeader::SubSpecificationType& subSpec)
   : mConfig(config),
     mSubSpec(subSpec)
@@ -46,6 +51,10 @@ void IntegratingMerger::init(framework::InitContext& ictx)
   // clear the state before starting the run, especially important for START->STOP->START sequence
   ictx.services().get<CallbackService>().set<CallbackService::Id::Start>([this]() { clear(); });
 
+  if (mConfig.parallelReduction.value == ParallelReduction::Yes && mConfig.parallelReduction.param > 1) {
+    ROOT::EnableThreadSafety();
+  }
+
   // set detector field in infologger
   try {
     auto& ilContext = ictx.services().get<AliceO2::InfoLogger::InfoLoggerContext>();
@@ -62,8 +71,21 @@ void IntegratingMerger::run(framework::ProcessingContext& ctx)
 
   for (const DataRef& ref : InputRecordWalker(ctx.inputs())) {
     if (ref.header != timerHeader) {
-      auto other = object_store_helpers::extractObjectFrom(ref);
-      merge(mMergedObjectLastCycle, std::move(other));
+      auto* flatTarget = std::get_if<FlatHistogramPtr>(&mMergedObjectLastCycle);
+      if (auto flatHistogram = flatTarget ? object_store_helpers::viewFlatHistogram(ref) : std::nullopt) {
+        // the bins are added straight from the received message
+        (*flatTarget)->merge(*flatHistogram);
+      } else {
+        auto other = object_store_helpers::extractObjectFrom(ref);
+        if (mConfig.parallelReduction.value == ParallelReduction::Yes && std::holds_alternative<VectorOfTObjectPtrs>(other)) {
+          mPendingDeltas.push_back(std::move(std::get<VectorOfTObjectPtrs>(other)));
+          if (mPendingDeltas.size() >= MaxPendingDeltasPerThread * mConfig.parallelReduction.param) {
+            reducePendingDeltas();
+          }
+        } else {
+          merge(mMergedObjectLastCycle, std::move(other));
+        }
+      }
       mDeltasMerged++;
     }
   }
@@ -76,13 +98,15 @@ void IntegratingMerger::run(framework::ProcessingContext& ctx)
 void IntegratingMerger::finishCycle(DataAllocator& outputs)
 {
   mCyclesSinceReset++;
+  reducePendingDeltas();
 
   if (mConfig.publishMovingWindow.value == PublishMovingWindow::Yes) {
     publishMovingWindow(outputs);
   }
 
   if (!std::holds_alternative<std::monostate>(mMergedObjectLastCycle)) {
-    merge(mMergedObjectIntegral, std::move(mMergedObjectLastCycle));
+    const int nThreads = mConfig.parallelReduction.value == ParallelReduction::Yes ? mConfig.parallelReduction.param : 1;
+    merge(mMergedObjectIntegral, std::move(mMergedObjectLastCycle), nThreads);
   }
   mMergedObjectLastCycle = std::monostate{};
   mTotalDeltasMerged += mDeltasMerged;
@@ -100,7 +124,18 @@ void IntegratingMerger::finishCycle(DataAllocator& outputs)
   mDeltasMerged = 0;
 }
 
-void IntegratingMerger::merge(ObjectStore& target, ObjectStore&& other)
+void IntegratingMerger::reducePendingDeltas()
+{
+  if (mPendingDeltas.empty()) {
+    return;
+  }
+  const int nThreads = mConfig.parallelReduction.param;
+  algorithm::reduce(mPendingDeltas, nThreads);
+  merge(mMergedObjectLastCycle, std::move(mPendingDeltas[0]), nThreads);
+  mPendingDeltas.clear();
+}
+
+void IntegratingMerger::merge(ObjectStore& target, ObjectStore&& other, int nThreads)
 {
   if (std::holds_alternative<std::monostate>(target)) {
     LOG(debug) << "Received the first input object in the run or after the last delta reset";
@@ -117,9 +152,12 @@ void IntegratingMerger::merge(ObjectStore& target, ObjectStore&& other)
     std::get<MergeInterfacePtr>(target)->merge(otherAsMergeInterface.get());
   } else if (std::holds_alternative<VectorOfTObjectPtrs>(target)) {
     // We expect that if the first object was Vector of TObjects, then all should.
-    auto targetAsVector = std::get<VectorOfTObjectPtrs>(target);
-    const auto otherAsVector = std::get<VectorOfTObjectPtrs>(other);
-    algorithm::merge(targetAsVector, otherAsVector);
+    auto& targetAsVector = std::get<VectorOfTObjectPtrs>(target);
+    const auto& otherAsVector = std::get<VectorOfTObjectPtrs>(other);
+    algorithm::merge(targetAsVector, otherAsVector, nThreads);
+  } else if (std::holds_alternative<FlatHistogramPtr>(target)) {
+    // We expect that if the first object was a flat histogram, then all should.
+    std::get<FlatHistogramPtr>(target)->merge(*std::get<FlatHistogramPtr>(other));
   } else {
     LOG(error) << "The target variant has an unrecognized value";
   }
@@ -135,6 +173,7 @@ void IntegratingMerger::clear()
 {
   mMergedObjectLastCycle = std::monostate{};
   mMergedObjectIntegral = std::monostate{};
+  mPendingDeltas.clear();
   mCyclesSinceReset = 0;
   mTotalDeltasMerged = 0;
   mDeltasMerged = 0;
@@ -144,7 +183,7 @@ void IntegratingMerger::publishIntegral(framework::DataAllocator& allocator)
 {
   if (std::holds_alternative<std::monostate>(mMergedObjectIntegral)) {
     LOG(info) << "No objects received since start or reset, nothing to publish";
-  } else if (object_store_helpers::snapshot(allocator, mSubSpec, mMergedObjectIntegral)) {
+  } else if (object_store_helpers::snapshot(allocator, mSubSpec, mMergedObjectIntegral, mConfig.flatHistogramPublication.value == FlatHistogramPublication::AsFlat)) {
     LOG(info) << "Published the merged object with " << mTotalDeltasMerged << " deltas in total,"
               << " including " << mDeltasMerged << " in the last cycle.";
   } else {
@@ -172,6 +211,11 @@ void IntegratingMerger::publishMovingWindow(framework::DataAllocator& allocator)
     const auto& mergedVector = std::get<VectorOfTObjectPtrs>(mMergedObjectLastCycle);
     const auto vectorToSnapshot = object_store_helpers::toRawObserverPointers(mergedVector);
     allocator.snapshot(framework::OutputRef{MergerBuilder::mergerIntegralOutputBinding(), mSubSpec}, vectorToSnapshot);
+  } else if (std::holds_alternative<FlatHistogramPtr>(mMergedObjectLastCycle)) {
+    // moving windows are published only by the last layer, thus as ROOT objects
+    allocator.snapshot(framework::OutputRef{MergerBuilder::mergerIntegralOutputBinding(), mSubSpec},
+                       *std::get<FlatHistogramPtr>(mMergedObjectLastCycle)->toTH1());
+    LOG(info) << "Published a moving window with " << mDeltasMerged << " deltas.";
   } else {
     LOG(error) << "mMergedObjectIntegral' variant has an unrecognized value.";
   }
@@ -30,6 +30,10 @@
 #include <TObjArray.h>
 #include <TTree.h>
 
+#include <exception>
+#include <string_view>
+#include <unordered_map>
+
 namespace o2::mergers::algorithm
 {
 
@@ -143,6 +147,88 @@ void merge(VectorOfTObjectPtrs& targets, const VectorOfTObjectPtrs& others)
   }
 }
 
+namespace
+{
+// Runs f(0) ... f(n-1) with nThreads threads, the first exception thrown by f is rethrown afterwards.
+template <typename F>
+void parallelFor(int n, int nThreads, F&& f)
+{
+  std::exception_ptr exception = nullptr;
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+#endif
+  for (int i = 0; i < n; i++) {
+    try {
+      f(i);
+    } catch (...) {
+#ifdef WITH_OPENMP
+#pragma omp critical
+#endif
+      if (!exception) {
+        exception = std::current_exception();
+      }
+    }
+  }
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+}
+} // namespace
+
+void merge(VectorOfTObjectPtrs& targets, const VectorOfTObjectPtrs& others, int nThreads)
+{
+  if (nThreads <= 1) {
+    merge(targets, others);
+    return;
+  }
+
+  // The objects are matched serially, so that each target is merged by one thread only.
+  // Same as in the serial version, an object is merged into the first target with the same name.
+  std::unordered_map<std::string_view, size_t> targetIndices;
+  targetIndices.reserve(targets.size() + others.size());
+  for (size_t i = 0; i < targets.size(); i++) {
+    targetIndices.emplace(targets[i]->GetName(), i);
+  }
+  std::vector<std::vector<TObject*>> othersPerTarget(targets.size());
+  for (const auto& other : others) {
+    if (auto targetIndex = targetIndices.find(other->GetName()); targetIndex != targetIndices.end()) {
+      othersPerTarget[targetIndex->second].push_back(other.get());
+    } else {
+      targets.push_back(std::shared_ptr<TObject>(other->Clone(), deleteTCollections));
+      targetIndices.emplace(targets.back()->GetName(), targets.size() - 1);
+      othersPerTarget.emplace_back();
+    }
+  }
+
+  parallelFor(static_cast<int>(othersPerTarget.size()), nThreads, [&](int i) {
+    for (auto* other : othersPerTarget[i]) {
+      merge(targets[i].get(), other);
+    }
+  });
+}
+
+void reduce(std::vector<VectorOfTObjectPtrs>& deltas, int nThreads)
+{
+  const size_t nDeltas = deltas.size();
+  for (size_t stride = 1; stride < nDeltas; stride *= 2) {
+    // pairs (0, stride), (2 * stride, 3 * stride), ...
+    const int nPairs = static_cast<int>((nDeltas - stride + 2 * stride - 1) / (2 * stride));
+    auto mergePair = [&](int pair, int nThreadsPerPair) {
+      auto& target = deltas[2 * stride * pair];
+      auto& other = deltas[2 * stride * pair + stride];
+      merge(target, other, nThreadsPerPair);
+      other.clear();
+    };
+    if (nPairs >= nThreads) {
+      parallelFor(nPairs, nThreads, [&](int pair) { mergePair(pair, 1); });
+    } else {
+      for (int pair = 0; pair < nPairs; pair++) {
+        mergePair(pair, nThreads);
+      }
+    }
+  }
+}
+
 void deleteRecursive(TCollection* Coll)
 {
   // I can iterate a collection
@@ -105,6 +105,10 @@ std::string MergerInfrastructureBuilder::validateConfig()
     error += preamble + "PublishMovingWindow::Yes is not supported with InputObjectsTimespan::FullHistory\n";
   }
 
+  if (mConfig.parallelReduction.value == ParallelReduction::Yes && mConfig.parallelReduction.param < 1) {
+    error += preamble + "ParallelReduction::Yes requires at least 1 thread\n";
+  }
+
   for (const auto& input : mInputs) {
     if (DataSpecUtils::match(input, mOutputSpecIntegral)) {
       error += preamble + "output '" + DataSpecUtils::label(mOutputSpecIntegral) + "' matches input '" + DataSpecUtils::label(input) + "'. That will cause a circular dependency!";
@@ -149,6 +153,8 @@ framework::WorkflowSpec MergerInfrastructureBuilder::generateInfrastructure()
       layerConfig.mergedObjectTimespan = {MergedObjectTimespan::NCycles, 1};
       // we also expect moving windows to be published only by the last layer
       layerConfig.publishMovingWindow = {PublishMovingWindow::No};
+      // flat histograms are converted to ROOT objects only by the last layer
+      layerConfig.flatHistogramPublication = {FlatHistogramPublication::AsFlat};
     }
     mergerBuilder.setConfig(layerConfig);
 
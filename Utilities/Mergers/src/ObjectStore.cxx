@@ -19,6 +19,7 @@
 #include "Mergers/MergeInterface.h"
 #include "Mergers/MergerAlgorithm.h"
 #include "Mergers/MergerBuilder.h"
+#include <TH1.h>
 #include <TObject.h>
 #include <string_view>
 
@@ -84,6 +85,10 @@ ObjectStore extractObjectFrom(const framework::DataRef& ref)
 
   using namespace std::string_view_literals;
   using DataHeader = o2::header::DataHeader;
+  if (auto flatHistogram = viewFlatHistogram(ref)) {
+    // the only copy of the bins, there is nothing to deserialize
+    return std::make_shared<FlatHistogram>(flatHistogram->getMessage(), true);
+  }
   if (framework::DataRefUtils::getHeader<const DataHeader*>(ref)->payloadSerializationMethod != o2::header::gSerializationMethodROOT) {
     throw std::runtime_error(concat(errorPrefix, "It is not ROOT-serialized"sv));
   }
@@ -119,6 +124,19 @@ ObjectStore extractObjectFrom(const framework::DataRef& ref)
   }
 }
 
+std::optional<FlatHistogram> viewFlatHistogram(const framework::DataRef& ref)
+{
+  using DataHeader = o2::header::DataHeader;
+  if (framework::DataRefUtils::getHeader<const DataHeader*>(ref)->payloadSerializationMethod != o2::header::gSerializationMethodNone) {
+    return std::nullopt;
+  }
+  gsl::span<const char> message(ref.payload, o2::framework::DataRefUtils::getPayloadSize(ref));
+  if (!FlatHistogram::isFlatHistogram(message)) {
+    return std::nullopt;
+  }
+  return FlatHistogram(message, false);
+}
+
 VectorOfRawTObjects toRawObserverPointers(const VectorOfTObjectPtrs& vector)
 {
   // NOTE: MT - it might be worth it to create custom stack allocators for this case
@@ -130,7 +148,7 @@ VectorOfRawTObjects toRawObserverPointers(const VectorOfTObjectPtrs& vector)
 
 template <typename TypeToSnapshot>
 struct Snapshoter {
-  static bool snapshot(framework::DataAllocator& allocator, const header::DataHeader::SubSpecificationType subSpec, const ObjectStore& object)
+  static bool snapshot(framework::DataAllocator& allocator, const header::DataHeader::SubSpecificationType subSpec, const ObjectStore& object, bool)
   {
     if (!std::holds_alternative<TypeToSnapshot>(object)) {
       return false;
@@ -144,7 +162,7 @@ struct Snapshoter {
 
 template <>
 struct Snapshoter<VectorOfTObjectPtrs> {
-  static bool snapshot(framework::DataAllocator& allocator, const header::DataHeader::SubSpecificationType subSpec, const ObjectStore& object)
+  static bool snapshot(framework::DataAllocator& allocator, const header::DataHeader::SubSpecificationType subSpec, const ObjectStore& object, bool)
   {
     if (!std::holds_alternative<VectorOfTObjectPtrs>(object)) {
       return false;
@@ -160,11 +178,32 @@ struct Snapshoter<VectorOfTObjectPtrs> {
   }
 };
 
-bool snapshot(framework::DataAllocator& allocator, const header::DataHeader::SubSpecificationType subSpec, const ObjectStore& mergedObject)
+template <>
+struct Snapshoter<FlatHistogramPtr> {
+  static bool snapshot(framework::DataAllocator& allocator, const header::DataHeader::SubSpecificationType subSpec, const ObjectStore& object, bool keepFlatHistograms)
+  {
+    if (!std::holds_alternative<FlatHistogramPtr>(object)) {
+      return false;
+    }
+
+    const auto& flatHistogram = std::get<FlatHistogramPtr>(object);
+    if (keepFlatHistograms) {
+      allocator.snapshot(framework::OutputRef{MergerBuilder::mergerIntegralOutputBinding(), subSpec}, flatHistogram->getMessage());
+    } else {
+      // this is the only place where a flat histogram becomes a ROOT object
+      allocator.snapshot(framework::OutputRef{MergerBuilder::mergerIntegralOutputBinding(), subSpec}, *flatHistogram->toTH1());
+    }
+
+    return true;
+  }
+};
+
+bool snapshot(framework::DataAllocator& allocator, const header::DataHeader::SubSpecificationType subSpec, const ObjectStore& mergedObject, bool keepFlatHistograms)
 {
-  return Snapshoter<MergeInterfacePtr>::snapshot(allocator, subSpec, mergedObject) ||
-         Snapshoter<TObjectPtr>::snapshot(allocator, subSpec, mergedObject) ||
-         Snapshoter<VectorOfTObjectPtrs>::snapshot(allocator, subSpec, mergedObject);
+  return Snapshoter<MergeInterfacePtr>::snapshot(allocator, subSpec, mergedObject, keepFlatHistograms) ||
+         Snapshoter<TObjectPtr>::snapshot(allocator, subSpec, mergedObject, keepFlatHistograms) ||
+         Snapshoter<VectorOfTObjectPtrs>::snapshot(allocator, subSpec, mergedObject, keepFlatHistograms) ||
+         Snapshoter<FlatHistogramPtr>::snapshot(allocator, subSpec, mergedObject, keepFlatHistograms);
 }
 
 } // namespace object_store_helpers
@@ -39,6 +39,7 @@
 #include <TF1.h>
 #include <TGraph.h>
 #include <TProfile.h>
+#include <TROOT.h>
 
 // using namespace o2::framework;
 using namespace o2::mergers;
@@ -482,4 +483,60 @@ BOOST_AUTO_TEST_CASE(OtherLonger, *boost::unit_test::tolerance(0.001))
   BOOST_TEST(to_span(other1_2) == to_array({0., 0., 0., 0., 0., 0., 2., 0., 0., 0., 0., 0.}), boost::test_tools::per_element());
 }
 
+BOOST_AUTO_TEST_CASE(ParallelMerge, *boost::unit_test::tolerance(0.001))
+{
+  ROOT::EnableThreadSafety();
+  const size_t nHistos = 20;
+  VectorOfTObjectPtrs target;
+  VectorOfTObjectPtrs other;
+  for (size_t i = 0; i < nHistos; i++) {
+    auto name = "histo " + std::to_string(i);
+    // the other vector contains also objects which are not yet in the target
+    if (i < nHistos / 2) {
+      auto histo = std::make_shared<TH1F>(name.c_str(), name.c_str(), bins, min, max);
+      histo->Fill(5);
+      target.push_back(histo);
+    }
+    auto histo = std::make_shared<TH1F>(name.c_str(), name.c_str(), bins, min, max);
+    histo->Fill(5);
+    histo->Fill(5);
+    other.push_back(histo);
+  }
+
+  BOOST_CHECK_NO_THROW(algorithm::merge(target, other, 4));
+
+  BOOST_REQUIRE(target.size() == nHistos);
+  for (size_t i = 0; i < nHistos; i++) {
+    BOOST_TEST(std::string_view{target[i]->GetName()} == "histo " + std::to_string(i));
+    BOOST_TEST(dynamic_cast<TH1F*>(target[i].get())->GetBinContent(6) == (i < nHistos / 2 ? 3. : 2.));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TreeReduction, *boost::unit_test::tolerance(0.001))
+{
+  ROOT::EnableThreadSafety();
+  for (int nThreads : {1, 2, 4}) {
+    // an odd number of deltas leaves an unpaired delta on some levels of the tree
+    const size_t nDeltas = 7;
+    std::vector<VectorOfTObjectPtrs> deltas(nDeltas);
+    for (size_t i = 0; i < nDeltas; i++) {
+      deltas[i].push_back(std::make_shared<TH1F>("histo 1", "histo 1", bins, min, max));
+      dynamic_cast<TH1F*>(deltas[i][0].get())->Fill(5);
+      if (i % 2) {
+        deltas[i].push_back(std::make_shared<TH1F>("histo 2", "histo 2", bins, min, max));
+        dynamic_cast<TH1F*>(deltas[i][1].get())->Fill(5);
+      }
+    }
+
+    BOOST_CHECK_NO_THROW(algorithm::reduce(deltas, nThreads));
+
+    BOOST_REQUIRE(deltas[0].size() == 2);
+    BOOST_TEST(dynamic_cast<TH1F*>(deltas[0][0].get())->GetBinContent(6) == 7.);
+    BOOST_TEST(dynamic_cast<TH1F*>(deltas[0][1].get())->GetBinContent(6) == 3.);
+    for (size_t i = 1; i < nDeltas; i++) {
+      BOOST_TEST(deltas[i].empty());
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
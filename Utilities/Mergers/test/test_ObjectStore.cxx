@@ -18,6 +18,7 @@
 #include "Mergers/ObjectStore.h"
 #include "Mergers/CustomMergeableObject.h"
 #include "Mergers/CustomMergeableTObject.h"
+#include "Mergers/FlatHistogram.h"
 #include "Headers/DataHeader.h"
 #include "Framework/DataRef.h"
 
@@ -139,4 +140,44 @@ BOOST_AUTO_TEST_CASE(VectorOfHistos1D)
   BOOST_CHECK(gsl::span(histo->GetArray(), histo->GetSize()) == gsl::span(extractedHisto->GetArray(), extractedHisto->GetSize()));
 }
 
+BOOST_AUTO_TEST_CASE(FlatHistogram1D)
+{
+  o2::dataformats::FlatHisto1D<float> histo(100, 0, 100);
+  histo.fill(5);
+  histo.fill(50, 2);
+  auto message = FlatHistogram::toMessage(histo, "flat histo 1d");
+
+  DataRef ref;
+  ref.payload = message.data();
+  auto dh = new o2::header::DataHeader{};
+  dh->payloadSerializationMethod = o2::header::gSerializationMethodNone;
+  dh->payloadSize = message.size();
+  ref.header = reinterpret_cast<char const*>(dh->data());
+
+  auto objStore = object_store_helpers::extractObjectFrom(ref);
+  BOOST_REQUIRE(std::holds_alternative<FlatHistogramPtr>(objStore));
+  auto flatHisto = std::get<FlatHistogramPtr>(objStore);
+  BOOST_CHECK_EQUAL(flatHisto->getName(), "flat histo 1d");
+
+  // merging straight from the message
+  auto view = object_store_helpers::viewFlatHistogram(ref);
+  BOOST_REQUIRE(view.has_value());
+  flatHisto->merge(*view);
+  BOOST_CHECK_THROW(view->merge(*flatHisto), std::runtime_error);
+
+  auto th1 = flatHisto->toTH1();
+  BOOST_REQUIRE(th1 != nullptr);
+  BOOST_CHECK_EQUAL(th1->GetName(), "flat histo 1d");
+  BOOST_CHECK_EQUAL(th1->GetNbinsX(), 100);
+  BOOST_CHECK_EQUAL(th1->GetBinContent(th1->FindBin(5)), 2);
+  BOOST_CHECK_EQUAL(th1->GetBinContent(th1->FindBin(50)), 4);
+  BOOST_CHECK_EQUAL(th1->GetEntries(), 6);
+
+  o2::dataformats::FlatHisto1D<float> otherBinning(10, 0, 100);
+  FlatHistogram other(FlatHistogram::toMessage(otherBinning, "other"), true);
+  BOOST_CHECK_THROW(flatHisto->merge(other), std::runtime_error);
+
+  delete dh;
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,174 @@
+// Copyright 2019-2023 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   bench_ransBlocksScaling.cxx
+/// @brief  throughput of the per-block parallel encoding/decoding of EncodedBlocks vs number of threads
+
+#include <vector>
+#include <cstring>
+#include <random>
+#include <algorithm>
+#include <iterator>
+
+#include <benchmark/benchmark.h>
+
+#include "DetectorsCommonDataFormats/EncodedBlocks.h"
+#include "DetectorsCommonDataFormats/CTFDictHeader.h"
+
+using namespace o2::ctf;
+
+// TPC-like CTF: a mix of 8, 16 and 32 bit columns of different length and entropy
+inline constexpr int NBlocks = 24;
+inline constexpr size_t NClusters = 1ull << 20;
+using CTFType = EncodedBlocks<CTFDictHeader, NBlocks, uint32_t>;
+
+class BlocksSource
+{
+ public:
+  BlocksSource()
+  {
+    std::mt19937 mt(0); // same seed we want always the same distrubution of random numbers;
+    for (int i = 0; i < NBlocks; i++) {
+      const size_t nSamples = NClusters >> (i % 4); // 1/1, 1/2, 1/4, 1/8 of the clusters
+      std::binomial_distribution<uint32_t> dist(1u << (4 + i % 12), 0.5);
+      switch (i % 3) {
+        case 0:
+          fill(mColumns8.emplace_back(), nSamples, dist, mt);
+          break;
+        case 1:
+          fill(mColumns16.emplace_back(), nSamples, dist, mt);
+          break;
+        default:
+          fill(mColumns32.emplace_back(), nSamples, dist, mt);
+          break;
+      }
+    }
+  }
+
+  /// call f(column, slot) for every column, in slot order
+  template <typename F>
+  void forEach(F&& f) const
+  {
+    for (int i = 0; i < NBlocks; i++) {
+      switch (i % 3) {
+        case 0:
+          f(mColumns8[i / 3], i);
+          break;
+        case 1:
+          f(mColumns16[i / 3], i);
+          break;
+        default:
+          f(mColumns32[i / 3], i);
+          break;
+      }
+    }
+  }
+
+  size_t getSize() const
+  {
+    size_t sz = 0;
+    forEach([&sz](const auto& col, int) { sz += col.size() * sizeof(typename std::decay_t<decltype(col)>::value_type); });
+    return sz;
+  }
+
+ private:
+  template <typename T, typename D>
+  static void fill(std::vector<T>& col, size_t n, D& dist, std::mt19937& mt)
+  {
+    col.resize(n);
+    std::generate(col.begin(), col.end(), [&dist, &mt]() { return static_cast<T>(dist(mt)); });
+  }
+
+  std::vector<std::vector<uint8_t>> mColumns8;
+  std::vector<std::vector<uint16_t>> mColumns16;
+  std::vector<std::vector<uint32_t>> mColumns32;
+};
+
+const BlocksSource source{};
+
+std::vector<BufferType> encodeBlocks(int nThreads)
+{
+  std::vector<BufferType> buffer;
+  auto* ec = CTFType::create(buffer);
+  ec->setANSHeader(ANSVersion1);
+  CTFType::ParallelEncoder encoder(*ec, nThreads);
+  source.forEach([&encoder](const auto& col, int slot) { encoder.add(col, slot, 0, Metadata::OptStore::EENCODE_OR_PACK); });
+  encoder.process(buffer);
+  return buffer;
+}
+
+void ransBlocksEncodeBenchmark(benchmark::State& st)
+{
+  const int nThreads = st.range(0);
+  size_t compressedSize = 0;
+  for (auto _ : st) {
+    auto buffer = encodeBlocks(nThreads);
+    compressedSize = CTFType::get(buffer.data())->getRegistry().offsFreeStart;
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  st.SetBytesProcessed(static_cast<int64_t>(source.getSize()) * static_cast<int64_t>(st.iterations()));
+  st.counters["Threads"] = nThreads;
+  st.counters["SourceSize"] = source.getSize();
+  st.counters["CompressedSize"] = compressedSize;
+};
+
+void ransBlocksDecodeBenchmark(benchmark::State& st)
+{
+  const int nThreads = st.range(0);
+  const auto buffer = encodeBlocks(1);
+  const auto ec = CTFType::getImage(buffer.data());
+
+  std::vector<std::vector<uint8_t>> dest8;
+  std::vector<std::vector<uint16_t>> dest16;
+  std::vector<std::vector<uint32_t>> dest32;
+  dest8.resize(NBlocks);
+  dest16.resize(NBlocks);
+  dest32.resize(NBlocks);
+
+  for (auto _ : st) {
+    CTFType::ParallelDecoder decoder(ec, nThreads);
+    source.forEach([&](const auto& col, int slot) {
+      using source_type = typename std::decay_t<decltype(col)>::value_type;
+      if constexpr (std::is_same_v<source_type, uint8_t>) {
+        decoder.add(dest8[slot], slot);
+      } else if constexpr (std::is_same_v<source_type, uint16_t>) {
+        decoder.add(dest16[slot], slot);
+      } else {
+        decoder.add(dest32[slot], slot);
+      }
+    });
+    decoder.process();
+  }
+
+  bool ok = true;
+  source.forEach([&](const auto& col, int slot) {
+    using source_type = typename std::decay_t<decltype(col)>::value_type;
+    if constexpr (std::is_same_v<source_type, uint8_t>) {
+      ok &= dest8[slot] == col;
+    } else if constexpr (std::is_same_v<source_type, uint16_t>) {
+      ok &= dest16[slot] == col;
+    } else {
+      ok &= dest32[slot] == col;
+    }
+  });
+  if (!ok) {
+    st.SkipWithError("Missmatch between encoded and decoded Message");
+  }
+
+  st.SetBytesProcessed(static_cast<int64_t>(source.getSize()) * static_cast<int64_t>(st.iterations()));
+  st.counters["Threads"] = nThreads;
+  st.counters["SourceSize"] = source.getSize();
+};
+
+BENCHMARK(ransBlocksEncodeBenchmark)->RangeMultiplier(2)->Range(1, 32)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(ransBlocksDecodeBenchmark)->RangeMultiplier(2)->Range(1, 32)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
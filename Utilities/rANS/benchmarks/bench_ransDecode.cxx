@@ -9,9 +9,9 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 
-/// @file   bench_ransEncode.cxx
+/// @file   bench_ransDecode.cxx
 /// @author Michael Lettrich
-/// @brief  compares performance of different encoders
+/// @brief  compares performance of the symbol table and flat table decoders
 
 #include "rANS/internal/common/defines.h"
 
@@ -108,6 +108,7 @@ void ransDecodeBenchmark(benchmark::State& st, Args&&... args)
   auto args_tuple = std::make_tuple(std::move(args)...);
 
   const auto& inputData = std::get<0>(args_tuple).get();
+  constexpr CoderTag decoderTag = std::tuple_element_t<1, decltype(args_tuple)>::value;
 
   using input_data_type = std::remove_cv_t<std::remove_reference_t<decltype(inputData)>>;
   using source_type = typename input_data_type::value_type;
@@ -122,7 +123,7 @@ void ransDecodeBenchmark(benchmark::State& st, Args&&... args)
   auto encoder = makeDenseEncoder<>::fromRenormed(renormedHistogram);
   encodeBuffer.encodeBufferEnd = encoder.process(inputData.data(), inputData.data() + inputData.size(), encodeBuffer.buffer.data());
 
-  auto decoder = makeDecoder<>::fromRenormed(renormedHistogram);
+  auto decoder = makeDecoder<defaults::internal::RenormingLowerBound, decoderTag>::fromRenormed(renormedHistogram);
 #ifdef ENABLE_VTUNE_PROFILER
   __itt_resume();
 #endif
@@ -156,8 +157,16 @@ void ransDecodeBenchmark(benchmark::State& st, Args&&... args)
 // BENCHMARK_CAPTURE(ransDecodeBenchmark, decode_binomial_16, sourceMessageBinomial16);
 // BENCHMARK_CAPTURE(ransDecodeBenchmark, decode_binomial_32, sourceMessageBinomial32);
 
-BENCHMARK_CAPTURE(ransDecodeBenchmark, decode_uniform_8, sourceMessageUniform8);
-BENCHMARK_CAPTURE(ransDecodeBenchmark, decode_uniform_16, sourceMessageUniform16);
-BENCHMARK_CAPTURE(ransDecodeBenchmark, decode_uniform_32, sourceMessageUniform32);
+using scalarDecoder_type = std::integral_constant<CoderTag, CoderTag::Compat>;
+
+BENCHMARK_CAPTURE(ransDecodeBenchmark, decode_uniform_8_scalar, sourceMessageUniform8, scalarDecoder_type{});
+BENCHMARK_CAPTURE(ransDecodeBenchmark, decode_uniform_16_scalar, sourceMessageUniform16, scalarDecoder_type{});
+BENCHMARK_CAPTURE(ransDecodeBenchmark, decode_uniform_32_scalar, sourceMessageUniform32, scalarDecoder_type{});
+
+using flatDecoder_type = std::integral_constant<CoderTag, CoderTag::SingleStream>;
+
+BENCHMARK_CAPTURE(ransDecodeBenchmark, decode_uniform_8_flat, sourceMessageUniform8, flatDecoder_type{});
+BENCHMARK_CAPTURE(ransDecodeBenchmark, decode_uniform_16_flat, sourceMessageUniform16, flatDecoder_type{});
+BENCHMARK_CAPTURE(ransDecodeBenchmark, decode_uniform_32_flat, sourceMessageUniform32, flatDecoder_type{});
 
 BENCHMARK_MAIN();
\ No newline at end of file
@@ -48,6 +48,7 @@
 
 #include "rANS/internal/decode/Decoder.h"
 #include "rANS/internal/decode/DecoderImpl.h"
+#include "rANS/internal/decode/InterleavedDecoder.h"
 
 namespace o2::rans
 {
@@ -133,6 +134,21 @@ class makeEncoder
     return this_type::fromRenormed(renormedHistogram);
   };
 };
+
+// All decoders read the same N-way interleaved stream format, the number of streams is passed at decode time.
+// Compat uses the original symbol table lookup, all other tags the flat table of InterleavedDecoder.
+template <typename source_T, CoderTag coderTag_V, size_t renormingLowerBound_V>
+struct DecoderTraits {
+  using type = InterleavedDecoder<source_T, DecoderImpl<renormingLowerBound_V>>;
+};
+
+template <typename source_T, size_t renormingLowerBound_V>
+struct DecoderTraits<source_T, CoderTag::Compat, renormingLowerBound_V> {
+  using type = Decoder<source_T, DecoderImpl<renormingLowerBound_V>>;
+};
+
+template <typename source_T, CoderTag coderTag_V, size_t renormingLowerBound_V>
+using DecoderTraits_t = typename DecoderTraits<source_T, coderTag_V, renormingLowerBound_V>::type;
 } // namespace internal
 
 struct makeDenseHistogram : public internal::makeHistogram<DenseHistogram> {
@@ -184,11 +200,12 @@ template <CoderTag coderTag_V = defaults::DefaultTag,
           size_t renormingLowerBound_V = defaults::CoderPreset<coderTag_V>::renormingLowerBound>
 using makeSparseEncoder = internal::makeEncoder<SparseSymbolTable, coderTag_V, nStreams_V, renormingLowerBound_V>;
 
-template <size_t renormingLowerBound_V = defaults::internal::RenormingLowerBound>
+// The flat table InterleavedDecoder is the default, the original Decoder is available via CoderTag::Compat.
+template <size_t renormingLowerBound_V = defaults::internal::RenormingLowerBound, CoderTag coderTag_V = CoderTag::SingleStream>
 class makeDecoder
 {
 
-  using this_type = makeDecoder<renormingLowerBound_V>;
+  using this_type = makeDecoder<renormingLowerBound_V, coderTag_V>;
 
  public:
   template <typename source_T>
@@ -197,8 +214,7 @@ class makeDecoder
     using namespace internal;
 
     using source_type = source_T;
-    using coder_type = DecoderImpl<renormingLowerBound_V>;
-    using decoder_type = Decoder<source_type, coder_type>;
+    using decoder_type = DecoderTraits_t<source_type, coderTag_V, renormingLowerBound_V>;
 
     return decoder_type{renormed};
   };
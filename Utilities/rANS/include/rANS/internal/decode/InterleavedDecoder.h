@@ -0,0 +1,209 @@
+// Copyright 2019-2023 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// @file   InterleavedDecoder.h
+/// @brief  Decoder for N-way interleaved rANS streams using a flat per-slot lookup table.
+
+#ifndef RANS_INTERNAL_DECODE_INTERLEAVEDDECODER_H_
+#define RANS_INTERNAL_DECODE_INTERLEAVEDDECODER_H_
+
+#include <vector>
+#include <cstdint>
+#include <type_traits>
+
+#include <fairlogger/Logger.h>
+#include <gsl/span>
+
+#include "rANS/internal/common/defaults.h"
+#include "rANS/internal/common/utils.h"
+#include "rANS/internal/common/typetraits.h"
+#include "rANS/internal/common/exceptions.h"
+#include "rANS/internal/containers/RenormedHistogram.h"
+
+namespace o2::rans
+{
+
+/// Decodes the same N-way interleaved stream format as Decoder, but replaces the symbol lookup by a flat per-slot
+/// table, so that each state update is a single lookup and one multiply-add. For sources of up to 16 bits the
+/// symbol is stored in the table entry as well, larger sources keep it in a separate array.
+template <typename source_T, class decoder_T>
+class InterleavedDecoder
+{
+ public:
+  using source_type = source_T;
+  using coder_type = decoder_T;
+  using stream_type = typename coder_type::stream_type;
+  using state_type = typename coder_type::state_type;
+  using count_type = count_t;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  InterleavedDecoder() noexcept = default;
+
+  template <typename container_T>
+  explicit InterleavedDecoder(const RenormedHistogramConcept<container_T>& renormedHistogram);
+
+  [[nodiscard]] inline size_t getSymbolTablePrecision() const noexcept { return mSymbolTablePrecision; };
+
+  template <typename stream_IT, typename source_IT, typename literals_IT = std::nullptr_t>
+  void process(stream_IT inputEnd, source_IT outputBegin, size_t messageLength, size_t nStreams, literals_IT literalsEnd = nullptr) const;
+
+  template <typename literals_IT = std::nullptr_t>
+  inline void process(gsl::span<const stream_type> inputStream, gsl::span<source_type> outputStream, size_t messageLength, size_t nStreams, literals_IT literalsEnd = nullptr) const
+  {
+    process(inputStream.data() + inputStream.size(), outputStream.data(), messageLength, nStreams, literalsEnd);
+  };
+
+ private:
+  static constexpr state_type LowerBound = utils::pow2(internal::getStreamingLowerBound_v<coder_type>);
+  static constexpr state_type StreamBits = utils::toBits<stream_type>();
+
+  // table entry: frequency (up to 2^MaxRenormPrecisionBits) | bias within the symbol | symbol, if it fits
+  static constexpr size_t FrequencyBits = defaults::MaxRenormPrecisionBits + 1;
+  static constexpr size_t BiasBits = defaults::MaxRenormPrecisionBits;
+  static constexpr size_t SymbolShift = FrequencyBits + BiasBits;
+  static constexpr bool SymbolInTable = sizeof(source_type) * 8 <= 64 - SymbolShift;
+
+  [[nodiscard]] inline static constexpr uint64_t makeTableEntry(count_type frequency, count_type bias, source_type symbol) noexcept
+  {
+    uint64_t entry = static_cast<uint64_t>(frequency) | (static_cast<uint64_t>(bias) << FrequencyBits);
+    if constexpr (SymbolInTable) {
+      entry |= static_cast<uint64_t>(static_cast<std::make_unsigned_t<source_type>>(symbol)) << SymbolShift;
+    }
+    return entry;
+  };
+
+  template <typename literals_IT>
+  [[nodiscard]] inline source_type lookupSymbol(uint64_t slot, uint64_t tableEntry, literals_IT& literalsIter) const
+  {
+    if constexpr (!std::is_null_pointer_v<literals_IT>) {
+      if (slot >= mNCompressibleSlots) {
+        return *(--literalsIter);
+      }
+    }
+    if constexpr (SymbolInTable) {
+      return static_cast<source_type>(tableEntry >> SymbolShift);
+    } else {
+      return mSymbols[slot];
+    }
+  };
+
+  std::vector<uint64_t> mDecoderTable{};
+  std::vector<source_type> mSymbols{};
+  count_type mNCompressibleSlots{};
+  size_type mSymbolTablePrecision{};
+
+  static_assert(coder_type::getNstreams() == 1, "implementation supports only single stream encoders");
+  static_assert(std::is_same_v<stream_type, uint32_t>);
+  static_assert(std::is_same_v<state_type, uint64_t>);
+};
+
+template <typename source_T, class decoder_T>
+template <typename container_T>
+InterleavedDecoder<source_T, decoder_T>::InterleavedDecoder(const RenormedHistogramConcept<container_T>& renormedHistogram)
+{
+  if (renormedHistogram.empty()) {
+    LOG(warning) << "SymbolStatistics of empty message passed to " << __func__;
+  }
+
+  mSymbolTablePrecision = renormedHistogram.getRenormingBits();
+  const size_t nSlots = renormedHistogram.getNumSamples();
+  mDecoderTable.resize(nSlots);
+  if constexpr (!SymbolInTable) {
+    mSymbols.resize(nSlots);
+  }
+
+  count_type cumulatedFrequency = 0;
+  const auto [trimmedBegin, trimmedEnd] = internal::trim(renormedHistogram);
+  internal::forEachIndexValue(renormedHistogram, trimmedBegin, trimmedEnd, [&, this](const source_type& sourceSymbol, const count_type& frequency) {
+    for (count_type bias = 0; bias < frequency; ++bias) {
+      this->mDecoderTable[cumulatedFrequency + bias] = makeTableEntry(frequency, bias, sourceSymbol);
+      if constexpr (!SymbolInTable) {
+        this->mSymbols[cumulatedFrequency + bias] = sourceSymbol;
+      }
+    }
+    cumulatedFrequency += frequency;
+  });
+  mNCompressibleSlots = cumulatedFrequency;
+
+  // incompressible symbols occupy the tail of the cumulative frequency range
+  const count_type escapeFrequency = renormedHistogram.getIncompressibleSymbolFrequency();
+  assert(mNCompressibleSlots + escapeFrequency == nSlots);
+  for (count_type bias = 0; bias < escapeFrequency; ++bias) {
+    mDecoderTable[mNCompressibleSlots + bias] = makeTableEntry(escapeFrequency, bias, {});
+  }
+};
+
+template <typename source_T, class decoder_T>
+template <typename stream_IT, typename source_IT, typename literals_IT>
+void InterleavedDecoder<source_T, decoder_T>::process(stream_IT inputEnd, source_IT outputBegin, size_t messageLength, size_t nStreams, literals_IT literalsEnd) const
+{
+  static_assert(utils::isCompatibleIter_v<source_type, source_IT>);
+
+  if (messageLength == 0) {
+    LOG(warning) << "Empty message passed to decoder, skipping decode process";
+    return;
+  }
+
+  if (!(nStreams > 1 && internal::isPow2(nStreams))) {
+    throw DecodingError(fmt::format("Invalid number of decoder streams {}", nStreams));
+  }
+
+  stream_IT inputIter = inputEnd;
+  --inputIter;
+  source_IT outputIter = outputBegin;
+  literals_IT literalsIter = literalsEnd;
+
+  // same stream layout as DecoderImpl::init: every decoder reads its state from 2 words, back to front.
+  std::vector<state_type> states(nStreams);
+  for (auto& state : states) {
+    state = static_cast<state_type>(*inputIter);
+    --inputIter;
+    state |= static_cast<state_type>(*inputIter) << 32;
+    --inputIter;
+  }
+
+  const uint64_t slotMask = utils::pow2(mSymbolTablePrecision) - 1;
+  const uint64_t frequencyMask = utils::pow2(FrequencyBits) - 1;
+  const uint64_t biasMask = utils::pow2(BiasBits) - 1;
+
+  auto decode = [&, this](state_type& state) {
+    const uint64_t slot = state & slotMask;
+    const uint64_t tableEntry = mDecoderTable[slot];
+    *outputIter++ = lookupSymbol(slot, tableEntry, literalsIter);
+
+    // s, x = D(x)
+    state = (tableEntry & frequencyMask) * (state >> mSymbolTablePrecision) + ((tableEntry >> FrequencyBits) & biasMask);
+
+    // renormalize
+    if (state < LowerBound) {
+      state = (state << StreamBits) | *inputIter;
+      --inputIter;
+    }
+  };
+
+  const size_t nLoops = messageLength / nStreams;
+  const size_t nLoopRemainder = messageLength % nStreams;
+
+  for (size_t i = 0; i < nLoops; ++i) {
+    for (auto& state : states) {
+      decode(state);
+    }
+  }
+
+  for (size_t i = 0; i < nLoopRemainder; ++i) {
+    decode(states[i]);
+  }
+};
+
+} // namespace o2::rans
+
+#endif /* RANS_INTERNAL_DECODE_INTERLEAVEDDECODER_H_ */
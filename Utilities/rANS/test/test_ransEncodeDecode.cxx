@@ -144,6 +144,49 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(test_encodeDecode, test_types, testCase_types)
   BOOST_CHECK_EQUAL_COLLECTIONS(decodeBuffer.begin(), decodeBuffer.end(), encodeString.begin(), encodeString.end());
 };
 
+using decoder_types = boost::mp11::mp_list<std::integral_constant<CoderTag, CoderTag::Compat>,
+                                           std::integral_constant<CoderTag, CoderTag::SingleStream>>;
+
+using decoderSource_types = boost::mp11::mp_product<boost::mp11::mp_list, decoder_types, boost::mp11::mp_list<int16_t, int32_t>>;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(test_decodeInterleaved, test_types, decoderSource_types)
+{
+  using decoder_type = boost::mp11::mp_at_c<test_types, 0>;
+  using source_type = boost::mp11::mp_at_c<test_types, 1>;
+  using stream_type = uint32_t;
+  constexpr CoderTag decoderTag = decoder_type::value;
+
+  // dictionary built from a subset of the message, so that the remainder has to be stored as literals
+  const std::vector<source_type> message(str.begin(), str.end());
+  const std::vector<source_type> dictSamples(str.begin(), str.begin() + str.size() / 4);
+
+  auto renormed = renorm(makeDenseHistogram::fromSamples(dictSamples.begin(), dictSamples.end()), RansRenormingPrecision, RenormingPolicy::ForceIncompressible);
+  auto decoder = makeDecoder<defaults::internal::RenormingLowerBound, decoderTag>::fromRenormed(renormed);
+  BOOST_CHECK_EQUAL(decoder.getSymbolTablePrecision(), RansRenormingPrecision);
+
+  // 2 interleaved streams from the compat encoder, 16 from the SIMD ones; odd message lengths leave a remainder
+  auto checkDecode = [&](const auto& encoder, size_t messageLength) {
+    std::vector<source_type> literals(messageLength);
+    std::vector<stream_type> encodeBuffer(messageLength + 64);
+    auto [encodeBufferEnd, literalBufferEnd] = encoder.process(message.begin(), message.begin() + messageLength, encodeBuffer.begin(), literals.begin());
+    BOOST_CHECK(literalBufferEnd != literals.begin());
+
+    std::vector<source_type> decodeBuffer(messageLength);
+    decoder.process(encodeBuffer.data() + std::distance(encodeBuffer.begin(), encodeBufferEnd), decodeBuffer.begin(), messageLength, encoder.getNStreams(), literalBufferEnd);
+    BOOST_CHECK_EQUAL_COLLECTIONS(decodeBuffer.begin(), decodeBuffer.end(), message.begin(), message.begin() + messageLength);
+
+    // non-pointer stream iterators
+    std::fill(decodeBuffer.begin(), decodeBuffer.end(), 0);
+    decoder.process(encodeBufferEnd, decodeBuffer.begin(), messageLength, encoder.getNStreams(), literalBufferEnd);
+    BOOST_CHECK_EQUAL_COLLECTIONS(decodeBuffer.begin(), decodeBuffer.end(), message.begin(), message.begin() + messageLength);
+  };
+
+  for (size_t messageLength : {message.size(), message.size() - 7}) {
+    checkDecode(makeDenseEncoder<CoderTag::Compat>::fromRenormed(renormed), messageLength);
+    checkDecode(makeDenseEncoder<>::fromRenormed(renormed), messageLength);
+  }
+};
+
 #ifndef RANS_SINGLE_STREAM
 BOOST_AUTO_TEST_CASE(test_NoSingleStream)
 {
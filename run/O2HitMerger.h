@@ -81,6 +81,9 @@
 #endif
 
 #include <tbb/concurrent_unordered_map.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#include <typeindex>
 
 namespace o2
 {
@@ -142,6 +145,11 @@ class O2HitMerger : public fair::mq::Device
     mAsService = o2::conf::SimConfig::Instance().asService();
     mForwardKine = o2::conf::SimConfig::Instance().forwardKine();
     mWriteToDisc = o2::conf::SimConfig::Instance().writeToDisc();
+    mNMergerThreads = o2::conf::SimConfig::Instance().getNMergerThreads();
+    if (mNMergerThreads > 1) {
+      LOG(info) << "Merging and flushing detector hits with " << mNMergerThreads << " threads";
+      mMergerArena = std::make_unique<tbb::task_arena>(mNMergerThreads);
+    }
 
     mOutFileName = outfilename.c_str();
     if (mWriteToDisc) {
@@ -156,6 +164,7 @@ class O2HitMerger : public fair::mq::Device
     // detectors init only once
     if (mDetectorInstances.size() == 0) {
       initDetInstances();
+      initDetMergeGroups();
       // has to be after init of Detectors
       o2::utils::ShmManager::Instance().attachToGlobalSegment();
       initHitFiles(o2::conf::SimConfig::Instance().getOutPrefix());
@@ -249,6 +258,8 @@ class O2HitMerger : public fair::mq::Device
     mSubEventInfoBuffer.clear();
     mFlushableEvents.clear();
     mNextFlushID = 1;
+    mNMergedEvents = 0;
+    mMergeTime = 0.;
 
     return true;
   }
@@ -412,6 +423,10 @@ class O2HitMerger : public fair::mq::Device
         if (mMergerIOThread.joinable()) {
           mMergerIOThread.join();
         }
+        if (mMergeTime > 0.) {
+          LOG(info) << "Merged and flushed " << mNMergedEvents << " events in " << mMergeTime << " s (" << mNMergedEvents / mMergeTime
+                    << " events/s) using " << mNMergerThreads << " merger threads";
+        }
 
         expectmore = false;
       }
@@ -790,16 +805,31 @@ class O2HitMerger : public fair::mq::Device
       // c) do the merge procedure for all hits ... delegate this to detector specific functions
       // since they know about types; number of branches; etc.
       // this will also fix the trackIDs inside the hits
-      for (int id = 0; id < mDetectorInstances.size(); ++id) {
+      auto mergeDetectorHits = [&](int id) {
         auto& det = mDetectorInstances[id];
         if (det) {
-          auto hittree = mDetectorToTTreeMap[id];
+          auto hittree = mDetectorToTTreeMap.at(id);
           if (hittree) {
             det->mergeHitEntriesAndFlush(flusheventID, *hittree, trackoffsets, nprimaries, subevOrdered);
             hittree->SetEntries(hittree->GetEntries() + 1);
             LOG(info) << "flushing tree to file " << hittree->GetDirectory()->GetFile()->GetName();
           }
         }
+      };
+      if (mMergerArena) {
+        // every detector writes its own tree and file, so they can be treated concurrently; the event is
+        // completed for all detectors before moving to the next one, which keeps the flushing order
+        mMergerArena->execute([&]() {
+          tbb::parallel_for(0, (int)mDetMergeGroups.size(), [&](int group) {
+            for (auto id : mDetMergeGroups[group]) {
+              mergeDetectorHits(id);
+            }
+          });
+        });
+      } else {
+        for (int id = 0; id < mDetectorInstances.size(); ++id) {
+          mergeDetectorHits(id);
+        }
       }
 
       // increase the entry count in the tree
@@ -813,20 +843,34 @@ class O2HitMerger : public fair::mq::Device
       }
 
       cleanEvent(flusheventID);
-      LOG(info) << "Merge/flush for event " << flusheventID << " took " << timer.RealTime();
+      const auto mergetime = timer.RealTime();
+      mMergeTime += mergetime;
+      mNMergedEvents++;
+      LOG(info) << "Merge/flush for event " << flusheventID << " took " << mergetime;
       if (!checkIfNextFlushable()) {
         break;
       }
     } // end while
     if (mWriteToDisc && mOutFile) {
       LOG(info) << "Writing TTrees";
+      TStopwatch timer;
+      timer.Start();
       mOutFile->Write("", TObject::kOverwrite);
-      for (int id = 0; id < mDetectorInstances.size(); ++id) {
+      auto writeDetectorFile = [this](int id) {
         auto& det = mDetectorInstances[id];
-        if (det && mDetectorOutFiles[id]) {
-          mDetectorOutFiles[id]->Write("", TObject::kOverwrite);
+        auto outfile = mDetectorOutFiles.at(id);
+        if (det && outfile) {
+          outfile->Write("", TObject::kOverwrite);
+        }
+      };
+      if (mMergerArena) {
+        mMergerArena->execute([&]() { tbb::parallel_for(0, (int)mDetectorInstances.size(), writeDetectorFile); });
+      } else {
+        for (int id = 0; id < mDetectorInstances.size(); ++id) {
+          writeDetectorFile(id);
         }
       }
+      mMergeTime += timer.RealTime();
       if (mMCHeaderOnlyOutFile) {
         mMCHeaderOnlyOutFile->Write("", TObject::kOverwrite);
       }
@@ -851,6 +895,9 @@ class O2HitMerger : public fair::mq::Device
   // intermediate structures to collect data per event
   std::thread mMergerIOThread; //! a thread used to do hit merging and IO flushing asynchronously
   bool mergingInProgress = false;
+  int mNMergerThreads = 1;                       //! number of threads used to merge/flush the detector hits
+  std::unique_ptr<tbb::task_arena> mMergerArena; //! arena for the concurrent per-detector merging (when mNMergerThreads > 1)
+  std::vector<std::vector<int>> mDetMergeGroups; //! detector IDs grouped such that they can be merged concurrently
 
   Hashtable<int, std::vector<std::vector<o2::MCTrack>*>> mMCTrackBuffer;         //! vector of sub-event track vectors; one per event
   Hashtable<int, std::vector<std::vector<o2::TrackReference>*>> mTrackRefBuffer; //!
@@ -860,6 +907,8 @@ class O2HitMerger : public fair::mq::Device
   int mEventChecksum = 0;   //! checksum for events
   int mNExpectedEvents = 0; //! number of events that we expect to receive
   int mNextFlushID = 1;     //! EventID to be flushed next
+  int mNMergedEvents = 0;   //! number of events merged and flushed so far
+  double mMergeTime = 0.;   //! time spent in merging and flushing [s]
   TStopwatch mTimer;
 
   bool mAsService = false;  //! if run in deamonized mode
@@ -879,9 +928,29 @@ class O2HitMerger : public fair::mq::Device
 
   // init detector instances
   void initDetInstances();
+  void initDetMergeGroups();
   void initHitFiles(std::string prefix);
 };
 
+void O2HitMerger::initDetMergeGroups()
+{
+  // Detector instances of the same type share a static hit collector (see o2::base::DetImpl::collectHits),
+  // hence they have to be merged sequentially by the same task.
+  std::map<std::type_index, int> groupOfType;
+  mDetMergeGroups.clear();
+  for (int id = 0; id < mDetectorInstances.size(); ++id) {
+    auto& det = mDetectorInstances[id];
+    if (!det) {
+      continue;
+    }
+    auto [iter, inserted] = groupOfType.emplace(std::type_index(typeid(*det)), mDetMergeGroups.size());
+    if (inserted) {
+      mDetMergeGroups.emplace_back();
+    }
+    mDetMergeGroups[iter->second].push_back(id);
+  }
+}
+
 void O2HitMerger::initHitFiles(std::string prefix)
 {
   using o2::detectors::DetID;
@@ -894,6 +963,9 @@ void O2HitMerger::initHitFiles(std::string prefix)
     return active; };
 
   for (int i = DetID::First; i <= DetID::Last; ++i) {
+    // every detector gets an entry, such that the concurrent merging tasks only look them up
+    mDetectorOutFiles.emplace(i, nullptr);
+    mDetectorToTTreeMap.emplace(i, nullptr);
     if (!isActivated(DetID::getName(i))) {
       continue;
     }